@@ -50,6 +50,11 @@ int main(int argv, char** argc)
 		CHashedDocDotFeatures* feats = new CHashedDocDotFeatures(b, string_feats, tzer);
 		feats->benchmark_dense_dot_range();
 		feats->benchmark_add_to_dense_vector();
+
+		SG_SPRINT("With hashed documents cache\n");
+		feats->build_hashed_cache();
+		feats->benchmark_dense_dot_range();
+		feats->benchmark_add_to_dense_vector();
 	}
 	exit_shogun();
 }
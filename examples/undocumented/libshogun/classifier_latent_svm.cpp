@@ -61,6 +61,27 @@ class CObjectDetector: public CLatentModel
 			return psi_feats;
 		}
 
+		virtual SGVector<float64_t> get_psi_feature_vector(index_t idx)
+		{
+			int32_t dim = this->get_dim();
+			SGVector<float64_t> psi(dim);
+			CHOGFeatures* hf = (CHOGFeatures*) m_features->get_sample(idx);
+			CBoundingBox* bb = (CBoundingBox*) m_labels->get_latent_label(idx);
+			memcpy(psi.vector, hf->hog[bb->x_pos][bb->y_pos], dim*sizeof(float64_t));
+			SG_UNREF(bb);
+			SG_UNREF(hf);
+			return psi;
+		}
+
+		virtual bool latent_variable_equals(CData* h1, CData* h2) const
+		{
+			CBoundingBox* bb1 = (CBoundingBox*) h1;
+			CBoundingBox* bb2 = (CBoundingBox*) h2;
+			return bb1->x_pos == bb2->x_pos && bb1->y_pos == bb2->y_pos;
+		}
+
+		virtual bool is_thread_safe() const { return true; }
+
 		virtual CData* infer_latent_variable(const SGVector<float64_t>& w, index_t idx)
 		{
 			int32_t pos_x = 0, pos_y = 0;
@@ -9,6 +9,7 @@
  */
 
 %rename(EmbeddingConverter) CEmbeddingConverter;
+%rename(OutOfSampleEmbedding) COutOfSampleEmbedding;
 #ifdef USE_GPL_SHOGUN
 %rename(NeighborhoodPreservingEmbedding) CNeighborhoodPreservingEmbedding;
 %rename(LocalTangentSpaceAlignment) CLocalTangentSpaceAlignment;
@@ -36,11 +37,14 @@
 %rename(FastICA) CFastICA;
 
 %newobject shogun::CEmbeddingConverter::apply;
+%newobject shogun::CEmbeddingConverter::fit;
+%newobject shogun::COutOfSampleEmbedding::embed;
 %newobject shogun::*::embed_kernel;
 %newobject shogun::*::embed_distance;
 
 %include <shogun/converter/Converter.h>
 %include <shogun/converter/EmbeddingConverter.h>
+%include <shogun/converter/OutOfSampleEmbedding.h>
 #ifdef USE_GPL_SHOGUN
 %include <shogun/converter/LocallyLinearEmbedding.h>
 %include <shogun/converter/NeighborhoodPreservingEmbedding.h>
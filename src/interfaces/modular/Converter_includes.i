@@ -1,6 +1,7 @@
 %{
 #include <shogun/converter/Converter.h>
 #include <shogun/converter/EmbeddingConverter.h>
+#include <shogun/converter/OutOfSampleEmbedding.h>
 #ifdef USE_GPL_SHOGUN
 #include <shogun/converter/LocallyLinearEmbedding.h>
 #include <shogun/converter/NeighborhoodPreservingEmbedding.h>
@@ -89,6 +89,7 @@ PROTOCOLS_DENSELABELS(CRegressionLabels, RegressionLabels, float64_t, "d\0", NPY
 %rename(FKFeatures) CFKFeatures;
 %rename(TOPFeatures) CTOPFeatures;
 %rename(SNPFeatures) CSNPFeatures;
+%rename(PackedDNAStringFeatures) CPackedDNAStringFeatures;
 %rename(WDFeatures) CWDFeatures;
 %rename(HashedWDFeatures) CHashedWDFeatures;
 %rename(HashedWDFeaturesTransposed) CHashedWDFeaturesTransposed;
@@ -514,6 +515,7 @@ namespace shogun
 %include <shogun/features/FKFeatures.h>
 %include <shogun/features/TOPFeatures.h>
 %include <shogun/features/SNPFeatures.h>
+%include <shogun/features/PackedDNAStringFeatures.h>
 %include <shogun/features/WDFeatures.h>
 %include <shogun/features/hashed/HashedWDFeatures.h>
 %include <shogun/features/hashed/HashedWDFeaturesTransposed.h>
@@ -38,6 +38,7 @@
 #include <shogun/features/FKFeatures.h>
 #include <shogun/features/TOPFeatures.h>
 #include <shogun/features/SNPFeatures.h>
+#include <shogun/features/PackedDNAStringFeatures.h>
 #include <shogun/features/WDFeatures.h>
 #include <shogun/features/hashed/HashedWDFeatures.h>
 #include <shogun/features/hashed/HashedWDFeaturesTransposed.h>
@@ -97,6 +97,7 @@ PROTOCOLS_CUSTOMKERNEL(CustomKernel, float32_t, "f\0", NPY_FLOAT32)
 %rename(WeightedDegreeStringKernel) CWeightedDegreeStringKernel;
 %rename(WeightedDegreeRBFKernel) CWeightedDegreeRBFKernel;
 %rename(SpectrumMismatchRBFKernel) CSpectrumMismatchRBFKernel;
+%rename(HashedSpectrumStringKernel) CHashedSpectrumStringKernel;
 %rename(ZeroMeanCenterKernelNormalizer) CZeroMeanCenterKernelNormalizer;
 %rename(DotKernel) CDotKernel;
 %rename(RationalQuadraticKernel) CRationalQuadraticKernel;
@@ -112,6 +113,7 @@ PROTOCOLS_CUSTOMKERNEL(CustomKernel, float32_t, "f\0", NPY_FLOAT32)
 
 %rename(SubsequenceStringKernel) CSubsequenceStringKernel;
 %rename(PeriodicKernel) CPeriodicKernel;
+%rename(NystromApproximation) CNystromApproximation;
 
 /* Include Class Headers to make them visible from within the target language */
 %include <shogun/kernel/Kernel.h>
@@ -222,6 +224,7 @@ namespace shogun
 %include <shogun/kernel/string/WeightedDegreeStringKernel.h>
 %include <shogun/kernel/WeightedDegreeRBFKernel.h>
 %include <shogun/kernel/string/SpectrumMismatchRBFKernel.h>
+%include <shogun/kernel/string/HashedSpectrumStringKernel.h>
 %include <shogun/kernel/MultiquadricKernel.h>
 %include <shogun/kernel/RationalQuadraticKernel.h>
 %include <shogun/kernel/JensenShannonKernel.h>
@@ -232,5 +235,6 @@ namespace shogun
 #endif
 %include <shogun/kernel/string/SubsequenceStringKernel.h>
 %include <shogun/kernel/PeriodicKernel.h>
+%include <shogun/kernel/NystromApproximation.h>
 
 EXTEND_CUSTOMKERNEL(CustomKernel, float32_t, NPY_FLOAT32)
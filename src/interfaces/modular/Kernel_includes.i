@@ -67,6 +67,7 @@
 #include <shogun/kernel/string/WeightedDegreeStringKernel.h>
 #include <shogun/kernel/WeightedDegreeRBFKernel.h>
 #include <shogun/kernel/string/SpectrumMismatchRBFKernel.h>
+#include <shogun/kernel/string/HashedSpectrumStringKernel.h>
 #include <shogun/kernel/normalizer/ZeroMeanCenterKernelNormalizer.h>
 #include <shogun/kernel/RationalQuadraticKernel.h>
 #include <shogun/kernel/CircularKernel.h>
@@ -74,6 +75,7 @@
 #include <shogun/kernel/LinearKernel.h>
 #include <shogun/kernel/string/SubsequenceStringKernel.h>
 #include <shogun/kernel/PeriodicKernel.h>
+#include <shogun/kernel/NystromApproximation.h>
 #include <shogun/kernel/LinearKernel.h>
 #ifdef HAVE_LINALG_LIB
 #include <shogun/kernel/ExponentialARDKernel.h>
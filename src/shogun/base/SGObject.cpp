@@ -22,6 +22,7 @@
 #include <shogun/lib/Map.h>
 #include <shogun/lib/SGVector.h>
 #include <shogun/lib/SGStringList.h>
+#include <shogun/lib/Tracing.h>
 #include <shogun/io/SerializableFile.h>
 
 #include <shogun/base/class_list.h>
@@ -314,6 +315,7 @@ void CSGObject::print_serializable(const char* prefix)
 bool CSGObject::save_serializable(CSerializableFile* file,
 		const char* prefix)
 {
+	SG_TRACE_SCOPE("CSGObject::save_serializable");
 	SG_DEBUG("START SAVING CSGObject '%s'\n", get_name())
 	try
 	{
@@ -371,6 +373,7 @@ bool CSGObject::load_serializable(CSerializableFile* file,
 {
 	REQUIRE(file != NULL, "Serializable file object should be != NULL\n");
 
+	SG_TRACE_SCOPE("CSGObject::load_serializable");
 	SG_DEBUG("START LOADING CSGObject '%s'\n", get_name())
 	try
 	{
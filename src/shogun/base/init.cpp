@@ -11,6 +11,7 @@
 #include <shogun/base/init.h>
 #include <shogun/lib/memory.h>
 #include <shogun/lib/config.h>
+#include <shogun/lib/Tracing.h>
 
 #include <shogun/mathematics/Math.h>
 #include <shogun/mathematics/Random.h>
@@ -105,6 +106,17 @@ namespace shogun
 		sg_mallocs=NULL;
 		SG_UNREF(mallocs);
 #endif
+		if (getenv("SHOGUN_MEMORY_SUMMARY"))
+			sg_memory_summary(stdout);
+
+		char* trace_file=getenv("SHOGUN_TRACE");
+		if (trace_file && sg_trace_is_enabled())
+		{
+			sg_trace_enable(false);
+			if (!sg_trace_export_chrome(trace_file))
+				SG_SWARNING("Could not write trace to %s\n", trace_file)
+		}
+
 		sg_print_message=NULL;
 		sg_print_warning=NULL;
 		sg_print_error=NULL;
@@ -200,6 +212,9 @@ namespace shogun
 			else if(strncmp(env_log_val, "ERROR", 5) == 0)
 				io->set_loglevel(MSG_ERROR);
 		}
+
+		if (getenv("SHOGUN_TRACE"))
+			sg_trace_enable();
 		SG_UNREF(io);
 	}
 }
@@ -606,6 +606,7 @@ float64_t CMKL::compute_elasticnet_dual_objective()
 		{
 			CKernel* kn = ((CCombinedKernel*) kernel)->get_kernel(k_idx);
 			float64_t sum=0;
+			#pragma omp parallel for num_threads(parallel->get_num_threads()) reduction(+:sum)
 			for (int32_t i=0; i<n; i++)
 			{
 				int32_t ii=get_support_vector(i);
@@ -1503,6 +1504,8 @@ void CMKL::compute_sum_beta(float64_t* sumw)
 		 * so it may be freed safely afterwards. */
 		kernel->set_subkernel_weights(beta);
 
+		float64_t sum=0;
+		#pragma omp parallel for num_threads(parallel->get_num_threads()) reduction(+:sum)
 		for (int32_t i=0; i<nsv; i++)
 		{
 			int32_t ii=svm->get_support_vector(i);
@@ -1510,9 +1513,10 @@ void CMKL::compute_sum_beta(float64_t* sumw)
 			for (int32_t j=0; j<nsv; j++)
 			{
 				int32_t jj=svm->get_support_vector(j);
-				sumw[n]+=0.5*svm->get_alpha(i)*svm->get_alpha(j)*kernel->kernel(ii,jj);
+				sum+=0.5*svm->get_alpha(i)*svm->get_alpha(j)*kernel->kernel(ii,jj);
 			}
 		}
+		sumw[n]=sum;
 		beta[n]=0.0;
 	}
 
@@ -1539,6 +1543,7 @@ float64_t CMKL::compute_mkl_dual_objective()
 		{
 			CKernel* kn = ((CCombinedKernel*) kernel)->get_kernel(k_idx);
 			float64_t sum=0;
+			#pragma omp parallel for num_threads(parallel->get_num_threads()) reduction(+:sum)
 			for (int32_t i=0; i<n; i++)
 			{
 				int32_t ii=get_support_vector(i);
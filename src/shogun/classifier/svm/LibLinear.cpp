@@ -13,6 +13,7 @@
 #include <shogun/io/SGIO.h>
 #include <shogun/lib/Signal.h>
 #include <shogun/lib/Time.h>
+#include <shogun/lib/Tracing.h>
 #include <shogun/base/Parameter.h>
 #include <shogun/classifier/svm/LibLinear.h>
 #include <shogun/optimization/liblinear/tron.h>
@@ -257,6 +258,7 @@ bool CLibLinear::train_machine(CFeatures* data)
 void CLibLinear::solve_l2r_l1l2_svc(
 			const liblinear_problem *prob, double eps, double Cp, double Cn, LIBLINEAR_SOLVER_TYPE st)
 {
+	SG_TRACE_SCOPE("CLibLinear::solve_l2r_l1l2_svc");
 	int l = prob->l;
 	int w_size = prob->n;
 	int i, s, iter = 0;
@@ -457,6 +459,7 @@ void CLibLinear::solve_l2r_l1l2_svc(
 void CLibLinear::solve_l1r_l2_svc(
 	liblinear_problem *prob_col, double eps, double Cp, double Cn)
 {
+	SG_TRACE_SCOPE("CLibLinear::solve_l1r_l2_svc");
 	int l = prob_col->l;
 	int w_size = prob_col->n;
 	int j, s, iter = 0;
@@ -804,6 +807,7 @@ void CLibLinear::solve_l1r_lr(
 	const liblinear_problem *prob_col, double eps,
 	double Cp, double Cn)
 {
+	SG_TRACE_SCOPE("CLibLinear::solve_l1r_lr");
 	int l = prob_col->l;
 	int w_size = prob_col->n;
 	int j, s, iter = 0;
@@ -1174,6 +1178,7 @@ void CLibLinear::solve_l1r_lr(
 
 void CLibLinear::solve_l2r_lr_dual(const liblinear_problem *prob, double eps, double Cp, double Cn)
 {
+	SG_TRACE_SCOPE("CLibLinear::solve_l2r_lr_dual");
 	int l = prob->l;
 	int w_size = prob->n;
 	int i, s, iter = 0;
@@ -57,7 +57,8 @@ bool CMPDSVM::train_machine(CFeatures* data)
 	const float64_t dualeps=eps*n; //heuristic
 	int64_t niter=0;
 
-	kernel_cache = new CCache<KERNELCACHE_ELEM>(kernel->get_cache_size(), n, n);
+	kernel_cache = new CCache<KERNELCACHE_ELEM>(kernel->get_cache_size(), n, n,
+			MEMORY_TAG_KERNEL_CACHE);
 	float64_t* alphas=SG_MALLOC(float64_t, n);
 	float64_t* dalphas=SG_MALLOC(float64_t, n);
 	//float64_t* hessres=SG_MALLOC(float64_t, 2*n);
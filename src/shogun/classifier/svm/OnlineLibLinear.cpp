@@ -147,6 +147,15 @@ void COnlineLibLinear::train_one(SGVector<float32_t> ex, float64_t label)
 	else
 		y_current = -1;
 
+	// Expand w to the length of the example, there may be no features to
+	// tell the dimension in advance
+	if (ex.vlen > w_dim)
+	{
+		w = SG_REALLOC(float32_t, w, w_dim, ex.vlen);
+		memset(&w[w_dim], 0, (ex.vlen-w_dim) * sizeof(float32_t));
+		w_dim = ex.vlen;
+	}
+
 	QD = diag[y_current + 1];
 	// Dot product of vector with itself
 	QD += CMath::dot(ex.vector, ex.vector, ex.vlen);
@@ -66,11 +66,14 @@ void CSGDQN::set_loss_function(CLossFunction* loss_func)
 	loss=loss_func;
 }
 
-void CSGDQN::compute_ratio(float64_t* W,float64_t* W_1,float64_t* B,float64_t* dst,int32_t dim,float64_t lambda,float64_t loss_val)
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+template <class T>
+static void sgdqn_compute_ratio(T* W, T* W_1, T* B, T* dst, int32_t dim,
+		float64_t lambda, float64_t loss_val)
 {
 	for (int32_t i=0; i < dim;i++)
 	{
-		float64_t diffw=W_1[i]-W[i];
+		T diffw=W_1[i]-W[i];
 		if(diffw)
 			B[i]+=diffw/ (lambda*diffw+ loss_val*dst[i]);
 		else
@@ -78,17 +81,30 @@ void CSGDQN::compute_ratio(float64_t* W,float64_t* W_1,float64_t* B,float64_t* d
 	}
 }
 
-void CSGDQN::combine_and_clip(float64_t* Bc,float64_t* B,int32_t dim,float64_t c1,float64_t c2,float64_t v1,float64_t v2)
+template <class T>
+static void sgdqn_combine_and_clip(T* Bc, T* B, int32_t dim, float64_t c1,
+		float64_t c2, float64_t v1, float64_t v2)
 {
 	for (int32_t i=0; i < dim;i++)
 	{
 		if(B[i])
 		{
 			Bc[i] = Bc[i] * c1 + B[i] * c2;
-			Bc[i]= CMath::min(CMath::max(Bc[i],v1),v2);
+			Bc[i]= CMath::min(CMath::max(Bc[i],(T) v1),(T) v2);
 		}
 	}
 }
+#endif // DOXYGEN_SHOULD_SKIP_THIS
+
+void CSGDQN::compute_ratio(float64_t* W,float64_t* W_1,float64_t* B,float64_t* dst,int32_t dim,float64_t lambda,float64_t loss_val)
+{
+	sgdqn_compute_ratio(W, W_1, B, dst, dim, lambda, loss_val);
+}
+
+void CSGDQN::combine_and_clip(float64_t* Bc,float64_t* B,int32_t dim,float64_t c1,float64_t c2,float64_t v1,float64_t v2)
+{
+	sgdqn_combine_and_clip(Bc, B, dim, c1, c2, v1, v2);
+}
 
 bool CSGDQN::train(CFeatures* data)
 {
@@ -111,9 +127,6 @@ bool CSGDQN::train(CFeatures* data)
 	ASSERT(num_vec==num_train_labels)
 	ASSERT(num_vec>0)
 
-	w=SGVector<float64_t>(features->get_dim_feature_space());
-	w.zero();
-
 	float64_t lambda= 1.0/(C1*num_vec);
 
 	// Shift t in order to have a
@@ -126,19 +139,42 @@ bool CSGDQN::train(CFeatures* data)
 
 	SG_INFO("lambda=%f, epochs=%d, eta0=%f\n", lambda, epochs, eta0)
 
-
-	float64_t* Bc=SG_MALLOC(float64_t, w.vlen);
-	SGVector<float64_t>::fill_vector(Bc, w.vlen, 1/lambda);
-
-	float64_t* result=SG_MALLOC(float64_t, w.vlen);
-	float64_t* B=SG_MALLOC(float64_t, w.vlen);
-
 	//Calibrate
 	calibrate();
 
 	SG_INFO("Training on %d vectors\n", num_vec)
 	CSignal::clear_cancel();
 
+	if (m_float32_weights)
+	{
+		SGVector<float32_t> w32=train_weights<float32_t>(lambda);
+		w=SGVector<float64_t>(w32.vlen);
+		for (int32_t i=0; i<w.vlen; i++)
+			w[i]=w32[i];
+	}
+	else
+		w=train_weights<float64_t>(lambda);
+
+	return true;
+}
+
+template <class T>
+SGVector<T> CSGDQN::train_weights(float64_t lambda)
+{
+	int32_t num_vec=features->get_num_vectors();
+	int32_t dim=features->get_dim_feature_space();
+
+	SGVector<T> w_t(dim);
+	w_t.zero();
+
+	SGVector<T> Bc(dim);
+	Bc.set_const(1/lambda);
+
+	SGVector<T> result(dim);
+	SGVector<T> B(dim);
+	B.zero();
+	SGVector<T> v(dim);
+
 	ELossType loss_type = loss->get_loss_type();
 	bool is_log_loss = false;
 	if ((loss_type == L_LOGLOSS) || (loss_type == L_LOGLOSSMARGIN))
@@ -150,28 +186,28 @@ bool CSGDQN::train(CFeatures* data)
 		bool updateB=false;
 		for (int32_t i=0; i<num_vec; i++)
 		{
-			SGVector<float64_t> v = features->get_computed_dot_feature_vector(i);
-			ASSERT(w.vlen==v.vlen)
+			v.zero();
+			features->add_to_dense_vec((T) 1, i, v.vector, v.vlen);
 			float64_t eta = 1.0/t;
 			float64_t y = ((CBinaryLabels*) m_labels)->get_label(i);
-			float64_t z = y * features->dense_dot(i, w.vector, w.vlen);
+			float64_t z = y * features->dense_dot(i, w_t.vector, w_t.vlen);
 			if(updateB==true)
 			{
 				if (z < 1 || is_log_loss)
 				{
-					SGVector<float64_t> w_1=w.clone();
+					SGVector<T> w_1=w_t.clone();
 					float64_t loss_1=-loss->first_derivative(z,1);
-					SGVector<float64_t>::vector_multiply(result,Bc,v.vector,w.vlen);
-					SGVector<float64_t>::add(w.vector,eta*loss_1*y,result,1.0,w.vector,w.vlen);
-					float64_t z2 = y * features->dense_dot(i, w.vector, w.vlen);
+					SGVector<T>::vector_multiply(result,Bc,v.vector,dim);
+					SGVector<T>::add(w_t.vector,eta*loss_1*y,result,1.0,w_t.vector,dim);
+					float64_t z2 = y * features->dense_dot(i, w_t.vector, w_t.vlen);
 					float64_t diffloss = -loss->first_derivative(z2,1) - loss_1;
 					if(diffloss)
 					{
-						compute_ratio(w.vector,w_1.vector,B,v.vector,w.vlen,lambda,y*diffloss);
+						sgdqn_compute_ratio(w_t.vector,w_1.vector,B.vector,v.vector,dim,lambda,y*diffloss);
 						if(t>skip)
-							combine_and_clip(Bc,B,w.vlen,(t-skip)/(t+skip),2*skip/(t+skip),1/(100*lambda),100/lambda);
+							sgdqn_combine_and_clip(Bc.vector,B.vector,dim,(t-skip)/(t+skip),2*skip/(t+skip),1/(100*lambda),100/lambda);
 						else
-							combine_and_clip(Bc,B,w.vlen,t/(t+skip),skip/(t+skip),1/(100*lambda),100/lambda);
+							sgdqn_combine_and_clip(Bc.vector,B.vector,dim,t/(t+skip),skip/(t+skip),1/(100*lambda),100/lambda);
 					}
 				}
 				updateB=false;
@@ -180,29 +216,25 @@ bool CSGDQN::train(CFeatures* data)
 			{
 				if(--count<=0)
 				{
-					SGVector<float64_t>::vector_multiply(result,Bc,w.vector,w.vlen);
-					SGVector<float64_t>::add(w.vector,-skip*lambda*eta,result,1.0,w.vector,w.vlen);
+					SGVector<T>::vector_multiply(result,Bc,w_t.vector,dim);
+					SGVector<T>::add(w_t.vector,-skip*lambda*eta,result,1.0,w_t.vector,dim);
 					count = skip;
 					updateB=true;
 				}
 
 				if (z < 1 || is_log_loss)
 				{
-					SGVector<float64_t>::vector_multiply(result,Bc,v.vector,w.vlen);
-					SGVector<float64_t>::add(w.vector,eta*-loss->first_derivative(z,1)*y,result,1.0,w.vector,w.vlen);
+					SGVector<T>::vector_multiply(result,Bc,v.vector,dim);
+					SGVector<T>::add(w_t.vector,eta*-loss->first_derivative(z,1)*y,result,1.0,w_t.vector,dim);
 				}
 			}
 			t++;
 		}
 	}
-	SG_FREE(result);
-	SG_FREE(B);
 
-	return true;
+	return w_t;
 }
 
-
-
 void CSGDQN::calibrate()
 {
 	ASSERT(features)
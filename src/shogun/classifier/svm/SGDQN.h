@@ -137,6 +137,14 @@ class CSGDQN : public CLinearMachine
 	private:
 		void init();
 
+		/** run the SGD-QN epochs with weights of type T
+		 *
+		 * @param lambda regularization constant
+		 * @return trained weight vector
+		 */
+		template <class T>
+		SGVector<T> train_weights(float64_t lambda);
+
 	private:
 		float64_t t;
 		float64_t C1;
@@ -28,6 +28,7 @@
 #include <shogun/lib/Signal.h>
 #include <shogun/mathematics/Math.h>
 #include <shogun/lib/Time.h>
+#include <shogun/lib/Tracing.h>
 #include <shogun/mathematics/lapack.h>
 
 #include <shogun/classifier/svm/SVMLight.h>
@@ -566,6 +567,7 @@ int32_t CSVMLight::optimize_to_convergence(int32_t* docs, int32_t* label, int32_
      /* heldout: marks held-out example for leave-one-out (or -1) */
      /* retrain: selects training mode (1=regular / 2=holdout) */
 {
+  SG_TRACE_SCOPE("CSVMLight::optimize_to_convergence");
 
   int32_t *chosen,*key,i,j,jj,*last_suboptimal_at,noshrink;
   int32_t inconsistentnum,choosenum,already_chosen=0,iteration;
@@ -1538,23 +1540,22 @@ void CSVMLight::update_linear_component_mkl(
 	{
 		CCombinedKernel* k = (CCombinedKernel*) kernel;
 
-		int32_t n = 0, i, j ;
-
-		for (index_t k_idx=0; k_idx<k->get_num_kernels(); k_idx++)
+		// the unweighted subkernel rows are cached by the combined kernel
+		// and stay valid across MKL weight updates
+		for (int32_t i=0;i<num;i++)
 		{
-			CKernel* kn = k->get_kernel(k_idx);
-			for (i=0;i<num;i++)
+			if(a[i] != a_old[i])
 			{
-				if(a[i] != a_old[i])
+				SGMatrix<float64_t> rows=k->get_subkernel_rows(i);
+				float64_t coef=(a[i]-a_old[i])*(float64_t)label[i];
+
+				#pragma omp parallel for num_threads(parallel->get_num_threads())
+				for (int32_t j=0;j<num;j++)
 				{
-					kn->get_kernel_row(i,NULL,aicache, true);
-					for (j=0;j<num;j++)
-						W[j*num_kernels+n]+=(a[i]-a_old[i])*aicache[j]*(float64_t)label[i];
+					for (int32_t n=0;n<num_kernels;n++)
+						W[j*num_kernels+n]+=coef*rows(j,n);
 				}
 			}
-
-			SG_UNREF(kn);
-			n++ ;
 		}
 	}
 	else // hope the kernel is fast ...
@@ -1630,38 +1631,10 @@ void CSVMLight::update_linear_component_mkl_linadd(
 		}
 	}
 
-	if (parallel->get_num_threads() < 2)
-	{
-		// determine contributions of different kernels
-		for (int32_t i=0; i<num; i++)
-			kernel->compute_by_subkernel(i,&W[i*num_kernels]);
-	}
-#ifdef HAVE_PTHREAD
-	else
-	{
-		pthread_t* threads = SG_MALLOC(pthread_t, parallel->get_num_threads()-1);
-		S_THREAD_PARAM_SVMLIGHT* params = SG_MALLOC(S_THREAD_PARAM_SVMLIGHT, parallel->get_num_threads()-1);
-		int32_t step= num/parallel->get_num_threads();
-
-		for (int32_t t=0; t<parallel->get_num_threads()-1; t++)
-		{
-			params[t].kernel = kernel;
-			params[t].W = W;
-			params[t].start = t*step;
-			params[t].end = (t+1)*step;
-			pthread_create(&threads[t], NULL, CSVMLight::update_linear_component_mkl_linadd_helper, (void*)&params[t]);
-		}
-
-		for (int32_t i=params[parallel->get_num_threads()-2].end; i<num; i++)
-			kernel->compute_by_subkernel(i,&W[i*num_kernels]);
-
-		for (int32_t t=0; t<parallel->get_num_threads()-1; t++)
-			pthread_join(threads[t], NULL);
-
-		SG_FREE(params);
-		SG_FREE(threads);
-	}
-#endif
+	// determine contributions of different kernels
+	SGVector<int32_t> vec_idx(num);
+	vec_idx.range_fill();
+	kernel->compute_by_subkernel_batch(num, vec_idx.vector, W);
 
 	// restore old weights
 	kernel->set_subkernel_weights(SGVector<float64_t>(w_backup,num_weights));
@@ -1669,19 +1642,6 @@ void CSVMLight::update_linear_component_mkl_linadd(
 	call_mkl_callback(a, label, lin);
 }
 
-void* CSVMLight::update_linear_component_mkl_linadd_helper(void* p)
-{
-	S_THREAD_PARAM_SVMLIGHT* params = (S_THREAD_PARAM_SVMLIGHT*) p;
-
-	int32_t num_kernels=params->kernel->get_num_subkernels();
-
-	// determine contributions of different kernels
-	for (int32_t i=params->start; i<params->end; i++)
-		params->kernel->compute_by_subkernel(i,&(params->W[i*num_kernels]));
-
-	return NULL ;
-}
-
 void CSVMLight::call_mkl_callback(float64_t* a, int32_t* label, float64_t* lin)
 {
 	int32_t num = kernel->get_num_vec_rhs();
@@ -2402,6 +2362,8 @@ float64_t* CSVMLight::optimize_qp(
 	float64_t sigdig, dist, epsilon_loqo;
 	int32_t iter;
 
+	SG_TRACE_SCOPE("CSVMLight::optimize_qp");
+
 	if(!primal) { /* allocate memory at first call */
 		primal=SG_MALLOC(float64_t, nx*3);
 		dual=SG_MALLOC(float64_t, nx*2+1);
@@ -440,12 +440,6 @@ class CSVMLight : public CSVM
 	float64_t* a_old, int32_t *working2dnum, int32_t totdoc, float64_t *lin,
 	float64_t *aicache, float64_t* c);
 
-  /** helper for update linear component MKL linadd
-   *
-   * @param p p
-   */
-  static void* update_linear_component_mkl_linadd_helper(void* p);
-
   /** update linear component MKL
    *
    * @param docs docs
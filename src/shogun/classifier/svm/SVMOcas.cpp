@@ -85,7 +85,7 @@ bool CSVMOcas::train_machine(CFeatures* data)
 	bias=0;
 	old_bias=0;
 
-	tmp_a_buf=SG_CALLOC(float64_t, w.vlen);
+	tmp_a_buf=SG_CALLOC(float64_t, int64_t(w.vlen)*parallel->get_num_threads());
 	cp_value=SG_CALLOC(float64_t*, bufsize);
 	cp_index=SG_CALLOC(uint32_t*, bufsize);
 	cp_nz_dims=SG_CALLOC(uint32_t, bufsize);
@@ -158,11 +158,12 @@ float64_t CSVMOcas::update_W( float64_t t, void* ptr )
 {
   float64_t sq_norm_W = 0;
   CSVMOcas* o = (CSVMOcas*) ptr;
-  uint32_t nDim = (uint32_t) o->w.vlen;
+  int32_t nDim = o->w.vlen;
   float64_t* W=o->w.vector;
   float64_t* oldW=o->old_w;
 
-  for(uint32_t j=0; j <nDim; j++)
+  #pragma omp parallel for num_threads(o->parallel->get_num_threads()) reduction(+:sq_norm_W)
+  for(int32_t j=0; j <nDim; j++)
   {
 	  W[j] = oldW[j]*(1-t) + t*W[j];
 	  sq_norm_W += W[j]*W[j];
@@ -198,15 +199,36 @@ int CSVMOcas::add_new_cut(
 	float64_t sq_norm_a;
 	uint32_t i, j, nz_dims;
 
-	/* temporary vector */
+	/* temporary vector, each thread sums its share of the cut into its own
+	 * partial vector which are added up in a fixed order afterwards */
 	float64_t* new_a = o->tmp_a_buf;
-	memset(new_a, 0, sizeof(float64_t)*nDim);
+	int32_t nthreads=CMath::max(1, CMath::min(o->parallel->get_num_threads(), (int32_t) cut_length));
 
-	for(i=0; i < cut_length; i++)
+	#pragma omp parallel for num_threads(nthreads)
+	for(int32_t t=0; t < nthreads; t++)
 	{
-		f->add_to_dense_vec(y[new_cut[i]], new_cut[i], new_a, nDim);
+		float64_t* a = new_a + int64_t(t)*nDim;
+		memset(a, 0, sizeof(float64_t)*nDim);
 
-		if (o->use_bias)
+		uint32_t start = uint64_t(cut_length)*t/nthreads;
+		uint32_t end = uint64_t(cut_length)*(t+1)/nthreads;
+		for(uint32_t k=start; k < end; k++)
+			f->add_to_dense_vec(y[new_cut[k]], new_cut[k], a, nDim);
+	}
+
+	if (nthreads > 1)
+	{
+		#pragma omp parallel for num_threads(nthreads)
+		for(int32_t k=0; k < (int32_t) nDim; k++)
+		{
+			for(int32_t t=1; t < nthreads; t++)
+				new_a[k] += new_a[int64_t(t)*nDim + k];
+		}
+	}
+
+	if (o->use_bias)
+	{
+		for(i=0; i < cut_length; i++)
 			c_bias[nSel]+=y[new_cut[i]];
 	}
 
@@ -243,13 +265,14 @@ int CSVMOcas::add_new_cut(
 
 	new_col_H[nSel] = sq_norm_a;
 
-	for(i=0; i < nSel; i++)
+	#pragma omp parallel for num_threads(o->parallel->get_num_threads())
+	for(int32_t k=0; k < (int32_t) nSel; k++)
 	{
-		float64_t tmp = c_bias[nSel]*c_bias[i];
-		for(j=0; j < c_nzd[i]; j++)
-			tmp += new_a[c_idx[i][j]]*c_val[i][j];
+		float64_t tmp = c_bias[nSel]*c_bias[k];
+		for(uint32_t l=0; l < c_nzd[k]; l++)
+			tmp += new_a[c_idx[k][l]]*c_val[k][l];
 
-		new_col_H[i] = tmp;
+		new_col_H[k] = tmp;
 	}
 	//CMath::display_vector(new_col_H, nSel+1, "new_col_H");
 	//CMath::display_vector((int32_t*) c_idx[nSel], (int32_t) nz_dims, "c_idx");
@@ -299,11 +322,10 @@ void CSVMOcas::compute_W(
 	void* ptr )
 {
 	CSVMOcas* o = (CSVMOcas*) ptr;
-	uint32_t nDim= (uint32_t) o->w.vlen;
+	int32_t nDim= o->w.vlen;
 	CMath::swap(o->w.vector, o->old_w);
 	float64_t* W=o->w.vector;
 	float64_t* oldW=o->old_w;
-	memset(W, 0, sizeof(float64_t)*nDim);
 	float64_t old_bias=o->bias;
 	float64_t bias=0;
 
@@ -312,20 +334,50 @@ void CSVMOcas::compute_W(
 	uint32_t* c_nzd = o->cp_nz_dims;
 	float64_t* c_bias = o->cp_bias;
 
-	for(uint32_t i=0; i<nSel; i++)
+	/* each thread scatters its share of the cutting planes into its own
+	 * partial vector, which are summed up in a fixed order afterwards */
+	float64_t* partial = o->tmp_a_buf;
+	int32_t nthreads=CMath::max(1, CMath::min(o->parallel->get_num_threads(), (int32_t) nSel));
+
+	#pragma omp parallel for num_threads(nthreads)
+	for(int32_t t=0; t<nthreads; t++)
 	{
-		uint32_t nz_dims = c_nzd[i];
+		float64_t* a = partial + int64_t(t)*nDim;
+		memset(a, 0, sizeof(float64_t)*nDim);
 
-		if(nz_dims > 0 && alpha[i] > 0)
+		uint32_t start = uint64_t(nSel)*t/nthreads;
+		uint32_t end = uint64_t(nSel)*(t+1)/nthreads;
+		for(uint32_t i=start; i<end; i++)
 		{
-			for(uint32_t j=0; j < nz_dims; j++)
-				W[c_idx[i][j]] += alpha[i]*c_val[i][j];
+			uint32_t nz_dims = c_nzd[i];
+
+			if(nz_dims > 0 && alpha[i] > 0)
+			{
+				for(uint32_t j=0; j < nz_dims; j++)
+					a[c_idx[i][j]] += alpha[i]*c_val[i][j];
+			}
 		}
+	}
+
+	for(uint32_t i=0; i<nSel; i++)
 		bias += c_bias[i]*alpha[i];
+
+	float64_t sq_norm=0;
+	float64_t dp=0;
+	#pragma omp parallel for num_threads(o->parallel->get_num_threads()) reduction(+:sq_norm,dp)
+	for(int32_t j=0; j<nDim; j++)
+	{
+		float64_t w_j = partial[j];
+		for(int32_t t=1; t<nthreads; t++)
+			w_j += partial[int64_t(t)*nDim + j];
+
+		W[j] = w_j;
+		sq_norm += w_j*w_j;
+		dp += w_j*oldW[j];
 	}
 
-	*sq_norm_W = CMath::dot(W,W, nDim) + CMath::sq(bias);
-	*dp_WoldW = CMath::dot(W,oldW, nDim) + bias*old_bias;
+	*sq_norm_W = sq_norm + CMath::sq(bias);
+	*dp_WoldW = dp + bias*old_bias;
 	//SG_PRINT("nSel=%d sq_norm_W=%f dp_WoldW=%f\n", nSel, *sq_norm_W, *dp_WoldW)
 
 	o->bias = bias;
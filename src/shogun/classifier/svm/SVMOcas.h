@@ -216,7 +216,7 @@ class CSVMOcas : public CLinearMachine
 		float64_t* old_w;
 		/** old bias */
 		float64_t old_bias;
-		/** nDim big */
+		/** temporary vectors, nDim big, one per thread */
 		float64_t* tmp_a_buf;
 		/** labels */
 		SGVector<float64_t> lab;
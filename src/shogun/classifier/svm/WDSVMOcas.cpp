@@ -270,13 +270,14 @@ float64_t CWDSVMOcas::update_W( float64_t t, void* ptr )
 {
   float64_t sq_norm_W = 0;
   CWDSVMOcas* o = (CWDSVMOcas*) ptr;
-  uint32_t nDim = (uint32_t) o->w_dim;
+  int32_t nDim = o->w_dim;
   float32_t* W=o->w;
   float32_t* oldW=o->old_w;
   float64_t bias=o->bias;
   float64_t old_bias=bias;
 
-  for(uint32_t j=0; j <nDim; j++)
+  #pragma omp parallel for num_threads(o->parallel->get_num_threads()) reduction(+:sq_norm_W)
+  for(int32_t j=0; j <nDim; j++)
   {
 	  W[j] = oldW[j]*(1-t) + t*W[j];
 	  sq_norm_W += W[j]*W[j];
@@ -362,63 +363,26 @@ int CWDSVMOcas::add_new_cut(
 	float32_t** cuts=o->cuts;
 	float32_t* new_a=SG_MALLOC(float32_t, nDim);
 	memset(new_a, 0, sizeof(float32_t)*nDim);
-#ifdef HAVE_PTHREAD
-
-	wdocas_thread_params_add* params_add=SG_MALLOC(wdocas_thread_params_add, o->parallel->get_num_threads());
-	pthread_t* threads=SG_MALLOC(pthread_t, o->parallel->get_num_threads());
 
+	/* every thread handles a range of string positions, which own disjoint
+	 * blocks of new_a */
 	int32_t string_length = o->string_length;
-	int32_t t;
-	int32_t nthreads=o->parallel->get_num_threads()-1;
-	int32_t step= string_length/o->parallel->get_num_threads();
-
-	if (step<1)
-	{
-		nthreads=string_length-1;
-		step=1;
-	}
+	int32_t nthreads=CMath::max(1, CMath::min(o->parallel->get_num_threads(), string_length));
+	wdocas_thread_params_add* params_add=SG_MALLOC(wdocas_thread_params_add, nthreads);
 
-	for (t=0; t<nthreads; t++)
+	#pragma omp parallel for num_threads(nthreads)
+	for (int32_t t=0; t<nthreads; t++)
 	{
 		params_add[t].wdocas=o;
-		//params_add[t].new_a=NULL;
 		params_add[t].new_a=new_a;
 		params_add[t].new_cut=new_cut;
-		params_add[t].start = step*t;
-		params_add[t].end = step*(t+1);
+		params_add[t].start = int64_t(string_length)*t/nthreads;
+		params_add[t].end = int64_t(string_length)*(t+1)/nthreads;
 		params_add[t].cut_length = cut_length;
-
-		if (pthread_create(&threads[t], NULL, &CWDSVMOcas::add_new_cut_helper, (void*)&params_add[t]) != 0)
-		{
-			nthreads=t;
-			SG_SWARNING("thread creation failed\n")
-			break;
-		}
+		add_new_cut_helper(&params_add[t]);
 	}
-
-	params_add[t].wdocas=o;
-	//params_add[t].new_a=NULL;
-	params_add[t].new_a=new_a;
-	params_add[t].new_cut=new_cut;
-	params_add[t].start = step*t;
-	params_add[t].end = string_length;
-	params_add[t].cut_length = cut_length;
-	add_new_cut_helper(&params_add[t]);
-	//float32_t* new_a=params_add[t].new_a;
-
-	for (t=0; t<nthreads; t++)
-	{
-		if (pthread_join(threads[t], NULL) != 0)
-			SG_SWARNING("pthread_join failed\n")
-
-		//float32_t* a=params_add[t].new_a;
-		//for (i=0; i<nDim; i++)
-		//	new_a[i]+=a[i];
-		//SG_FREE(a);
-	}
-	SG_FREE(threads);
 	SG_FREE(params_add);
-#endif /* HAVE_PTHREAD */
+
 	for(i=0; i < cut_length; i++)
 	{
 		if (o->use_bias)
@@ -426,8 +390,9 @@ int CWDSVMOcas::add_new_cut(
 	}
 
 	// insert new_a into the last column of sparse_A
-	for(i=0; i < nSel; i++)
-		new_col_H[i] = CMath::dot(new_a, cuts[i], nDim) + c_bias[nSel]*c_bias[i];
+	#pragma omp parallel for num_threads(o->parallel->get_num_threads())
+	for(int32_t k=0; k < (int32_t) nSel; k++)
+		new_col_H[k] = CMath::dot(new_a, cuts[k], nDim) + c_bias[nSel]*c_bias[k];
 	new_col_H[nSel] = CMath::dot(new_a, new_a, nDim) + CMath::sq(c_bias[nSel]);
 
 	cuts[nSel]=new_a;
@@ -543,63 +508,32 @@ void* CWDSVMOcas::compute_output_helper(void* ptr)
 
 int CWDSVMOcas::compute_output( float64_t *output, void* ptr )
 {
-#ifdef HAVE_PTHREAD
 	CWDSVMOcas* o = (CWDSVMOcas*) ptr;
 	int32_t nData=o->num_vec;
-	wdocas_thread_params_output* params_output=SG_MALLOC(wdocas_thread_params_output, o->parallel->get_num_threads());
-	pthread_t* threads = SG_MALLOC(pthread_t, o->parallel->get_num_threads());
 
 	float32_t* out=SG_MALLOC(float32_t, nData);
 	int32_t* val=SG_MALLOC(int32_t, nData);
 	memset(out, 0, sizeof(float32_t)*nData);
 
-	int32_t t;
-	int32_t nthreads=o->parallel->get_num_threads()-1;
-	int32_t step= nData/o->parallel->get_num_threads();
-
-	if (step<1)
-	{
-		nthreads=nData-1;
-		step=1;
-	}
+	/* every thread computes the outputs of a range of examples */
+	int32_t nthreads=CMath::max(1, CMath::min(o->parallel->get_num_threads(), nData));
+	wdocas_thread_params_output* params_output=SG_MALLOC(wdocas_thread_params_output, nthreads);
 
-	for (t=0; t<nthreads; t++)
+	#pragma omp parallel for num_threads(nthreads)
+	for (int32_t t=0; t<nthreads; t++)
 	{
 		params_output[t].wdocas=o;
 		params_output[t].output=output;
 		params_output[t].out=out;
 		params_output[t].val=val;
-		params_output[t].start = step*t;
-		params_output[t].end = step*(t+1);
-
-		//SG_SPRINT("t=%d start=%d end=%d output=%p\n", t, params_output[t].start, params_output[t].end, params_output[t].output)
-		if (pthread_create(&threads[t], NULL, &CWDSVMOcas::compute_output_helper, (void*)&params_output[t]) != 0)
-		{
-			nthreads=t;
-			SG_SWARNING("thread creation failed\n")
-			break;
-		}
+		params_output[t].start = int64_t(nData)*t/nthreads;
+		params_output[t].end = int64_t(nData)*(t+1)/nthreads;
+		compute_output_helper(&params_output[t]);
 	}
 
-	params_output[t].wdocas=o;
-	params_output[t].output=output;
-	params_output[t].out=out;
-	params_output[t].val=val;
-	params_output[t].start = step*t;
-	params_output[t].end = nData;
-	compute_output_helper(&params_output[t]);
-	//SG_SPRINT("t=%d start=%d end=%d output=%p\n", t, params_output[t].start, params_output[t].end, params_output[t].output)
-
-	for (t=0; t<nthreads; t++)
-	{
-		if (pthread_join(threads[t], NULL) != 0)
-			SG_SWARNING("pthread_join failed\n")
-	}
-	SG_FREE(threads);
 	SG_FREE(params_output);
 	SG_FREE(val);
 	SG_FREE(out);
-#endif /* HAVE_PTHREAD */
 	return 0;
 }
 /*----------------------------------------------------------------------
@@ -621,21 +555,40 @@ void CWDSVMOcas::compute_W(
 	float32_t* W=o->w;
 	float32_t* oldW=o->old_w;
 	float32_t** cuts=o->cuts;
-	memset(W, 0, sizeof(float32_t)*nDim);
 	float64_t* c_bias = o->cp_bias;
 	float64_t old_bias=o->bias;
 	float64_t bias=0;
 
 	for (uint32_t i=0; i<nSel; i++)
+		bias += c_bias[i]*alpha[i];
+
+	/* W is built block-wise, every block summing up the cutting planes in
+	 * the same order as a sequential pass would */
+	const int32_t block_size=4096;
+	int32_t num_blocks=(nDim+block_size-1)/block_size;
+	float64_t sq_norm=0;
+	float64_t dp=0;
+
+	#pragma omp parallel for num_threads(o->parallel->get_num_threads()) reduction(+:sq_norm,dp)
+	for (int32_t b=0; b<num_blocks; b++)
 	{
-		if (alpha[i] > 0)
-			SGVector<float32_t>::vec1_plus_scalar_times_vec2(W, (float32_t) alpha[i], cuts[i], nDim);
+		int32_t start=b*block_size;
+		int32_t len=CMath::min(block_size, int32_t(nDim)-start);
+		float32_t* W_b=W+start;
+		memset(W_b, 0, sizeof(float32_t)*len);
 
-		bias += c_bias[i]*alpha[i];
+		for (uint32_t i=0; i<nSel; i++)
+		{
+			if (alpha[i] > 0)
+				SGVector<float32_t>::vec1_plus_scalar_times_vec2(W_b, (float32_t) alpha[i], cuts[i]+start, len);
+		}
+
+		sq_norm += CMath::dot(W_b, W_b, len);
+		dp += CMath::dot(W_b, oldW+start, len);
 	}
 
-	*sq_norm_W = CMath::dot(W,W, nDim) +CMath::sq(bias);
-	*dp_WoldW = CMath::dot(W,oldW, nDim) + bias*old_bias;;
+	*sq_norm_W = sq_norm + CMath::sq(bias);
+	*dp_WoldW = dp + bias*old_bias;
 	//SG_PRINT("nSel=%d sq_norm_W=%f dp_WoldW=%f\n", nSel, *sq_norm_W, *dp_WoldW)
 
 	o->bias = bias;
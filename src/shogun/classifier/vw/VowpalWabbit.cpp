@@ -53,9 +53,9 @@ CVowpalWabbit::CVowpalWabbit(CVowpalWabbit *vw)
 	reg_dump_text = vw->reg_dump_text;
 	save_predictions = vw->save_predictions;
 	prediction_fd = vw->prediction_fd;
+	num_learner_threads = vw->num_learner_threads;
 
 	w = reg->weight_vectors[0];
-	reg->weight_vectors[0] = NULL;
 	copy(vw->w, vw->w+vw->w_dim, w);
 	w_dim = vw->w_dim;
 	bias = vw->bias;
@@ -63,6 +63,11 @@ CVowpalWabbit::CVowpalWabbit(CVowpalWabbit *vw)
 
 CVowpalWabbit::~CVowpalWabbit()
 {
+	/* the learners update w through the regressor, but it is owned
+	 * and freed by COnlineLinearMachine */
+	if (reg && reg->weight_vectors)
+		reg->weight_vectors[0] = NULL;
+
 	SG_UNREF(env);
 	SG_UNREF(reg);
 	SG_UNREF(learner);
@@ -79,7 +84,6 @@ void CVowpalWabbit::reinitialize_weights()
 
 	reg->init(env);
 	w = reg->weight_vectors[0];
-	reg->weight_vectors[0] = NULL;
 }
 
 void CVowpalWabbit::set_adaptive(bool adaptive_learning)
@@ -109,8 +113,8 @@ void CVowpalWabbit::set_exact_adaptive_norm(bool exact_adaptive)
 void CVowpalWabbit::load_regressor(char* file_name)
 {
 	reg->load_regressor(file_name);
+	SG_FREE(w);
 	w = reg->weight_vectors[0];
-	reg->weight_vectors[0] = NULL;
 	w_dim = 1 << env->num_bits;
 }
 
@@ -159,6 +163,9 @@ bool CVowpalWabbit::train_machine(CFeatures* feat)
 	}
 
 	features->start_parser();
+	if (num_learner_threads > 1 && !no_training)
+		train_parallel();
+
 	while (env->passes_complete < env->num_passes)
 	{
 		while (features->get_next_example())
@@ -205,6 +212,69 @@ bool CVowpalWabbit::train_machine(CFeatures* feat)
 	return true;
 }
 
+void CVowpalWabbit::train_parallel()
+{
+	/* the parser hands out one example at a time, so examples are copied
+	 * into batches large enough to keep all learner threads busy */
+	int32_t batch_size = 64 * num_learner_threads;
+	VwExample* batch = new VwExample[batch_size];
+	int32_t num_examples = 0;
+	vw_size_t current_pass = 0;
+
+	while (env->passes_complete < env->num_passes)
+	{
+		while (features->get_next_example())
+		{
+			VwExample* example = features->get_example();
+
+			if (example->pass != current_pass)
+			{
+				train_batch(batch, num_examples);
+				num_examples = 0;
+				env->eta *= env->eta_decay_rate;
+				current_pass = example->pass;
+			}
+
+			/* statistics are updated once the copy has been learned */
+			batch[num_examples++].copy_from(example);
+			features->release_example_without_statistics();
+
+			if (num_examples == batch_size)
+			{
+				train_batch(batch, num_examples);
+				num_examples = 0;
+			}
+		}
+		env->passes_complete++;
+		if (env->passes_complete < env->num_passes)
+			features->reset_stream();
+	}
+	train_batch(batch, num_examples);
+
+	delete[] batch;
+}
+
+void CVowpalWabbit::train_batch(VwExample* batch, int32_t num_examples)
+{
+	#pragma omp parallel for schedule(dynamic, 4) num_threads(num_learner_threads)
+	for (int32_t i = 0; i < num_examples; i++)
+	{
+		VwExample* example = &batch[i];
+		predict_and_finalize(example);
+
+		learner->train(example, example->eta_round);
+		example->eta_round = 0.;
+	}
+
+	for (int32_t i = 0; i < num_examples; i++)
+	{
+		VwExample* example = &batch[i];
+		output_example(example);
+		features->update_statistics(example);
+		example->reset_members();
+	}
+}
+
 float32_t CVowpalWabbit::predict_and_finalize(VwExample* ex)
 {
 	float32_t prediction;
@@ -227,6 +297,7 @@ float32_t CVowpalWabbit::predict_and_finalize(VwExample* ex)
 			float32_t sum_abs_x = 0.;
 			float32_t exact_norm = compute_exact_norm(ex, sum_abs_x);
 			update = (env->eta * exact_norm)/sum_abs_x;
+			#pragma omp atomic
 			env->update_sum += update;
 			ex->eta_round = reg->get_update(ex->final_prediction, ex->ld->label, update, exact_norm);
 		}
@@ -235,6 +306,7 @@ float32_t CVowpalWabbit::predict_and_finalize(VwExample* ex)
 			update = (env->eta)/pow(t, env->power_t) * ex->ld->weight;
 			ex->eta_round = reg->get_update(ex->final_prediction, ex->ld->label, update, ex->total_sum_feat_sq);
 		}
+		#pragma omp atomic
 		env->update_sum += update;
 	}
 
@@ -264,9 +336,9 @@ void CVowpalWabbit::init(CStreamingVwFeatures* feat)
 	reg_dump_text = true;
 	save_predictions = false;
 	prediction_fd = -1;
+	num_learner_threads = 1;
 
 	w = reg->weight_vectors[0];
-	reg->weight_vectors[0] = NULL;
 	w_dim = 1 << env->num_bits;
 	bias = 0.;
 }
@@ -314,7 +386,7 @@ float32_t CVowpalWabbit::inline_predict(VwExample* &ex)
 
 	float32_t* weights = reg->weight_vectors[thread_num];
 	vw_size_t thread_mask = env->thread_mask;
-	prediction += features->dense_dot(weights, 0);
+	prediction += features->dense_dot(ex, weights);
 
 	for (int32_t k = 0; k < env->pairs.get_num_elements(); k++)
 	{
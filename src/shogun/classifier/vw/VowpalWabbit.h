@@ -108,6 +108,28 @@ public:
 		env->num_passes = passes;
 	}
 
+	/**
+	 * Set number of learner threads. With more than one thread, examples
+	 * are taken from the parser in mini-batches and the examples of a
+	 * batch are learned concurrently by several threads updating the
+	 * shared weight vector without locking (Hogwild). Predictions and
+	 * statistics are still output in input order.
+	 *
+	 * @param num_threads number of learner threads, 1 by default
+	 */
+	void set_num_learner_threads(int32_t num_threads)
+	{
+		REQUIRE(num_threads > 0, "Number of learner threads must be positive!\n")
+		num_learner_threads = num_threads;
+	}
+
+	/**
+	 * Get number of learner threads
+	 *
+	 * @return number of learner threads
+	 */
+	int32_t get_num_learner_threads() { return num_learner_threads; }
+
 	/**
 	 * Load regressor from a dump file
 	 *
@@ -216,6 +238,21 @@ private:
 	 */
 	virtual void init(CStreamingVwFeatures* feat = NULL);
 
+	/**
+	 * Run all passes over the stream with several learner threads
+	 */
+	void train_parallel();
+
+	/**
+	 * Predict, learn and output a mini-batch of examples. The examples
+	 * are learned concurrently, then output and accounted in the
+	 * statistics of the environment in stream order.
+	 *
+	 * @param batch examples
+	 * @param num_examples number of examples in the batch
+	 */
+	void train_batch(VwExample* batch, int32_t num_examples);
+
 	/**
 	 * Predict with l1 regularization
 	 *
@@ -310,6 +347,9 @@ private:
 	bool save_predictions;
 	/// Descriptor of prediction file
 	int32_t prediction_fd;
+
+	/// Number of threads learning concurrently
+	int32_t num_learner_threads;
 };
 
 }
@@ -184,6 +184,9 @@ bool CVwNativeCacheReader::read_cached_example(VwExample* const ae)
 
 		char *end = c + storage;
 
+		/* every feature takes at least one byte, so storage bounds
+		 * the number of features and the array is grown only once */
+		ours->grow(storage);
 		vw_size_t last = 0;
 
 		for (; c!=end; )
@@ -212,7 +215,7 @@ bool CVwNativeCacheReader::read_cached_example(VwExample* const ae)
 			last = f.weight_index;
 			f.weight_index = f.weight_index & mask;
 
-			ours->push(f);
+			*(ours->end++) = f;
 		}
 		buf.set(c);
 	}
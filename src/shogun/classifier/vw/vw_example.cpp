@@ -51,3 +51,72 @@ void VwExample::reset_members()
 	indices.erase();
 	tag.erase();
 }
+
+void VwExample::copy_from(VwExample* ex)
+{
+	reset_members();
+
+	*ld = *ex->ld;
+	tag.push_many(ex->tag.begin, ex->tag.index());
+	indices.push_many(ex->indices.begin, ex->indices.index());
+	for (vw_size_t* i = ex->indices.begin; i != ex->indices.end; i++)
+	{
+		atomics[*i].push_many(ex->atomics[*i].begin, ex->atomics[*i].index());
+		sum_feat_sq[*i] = ex->sum_feat_sq[*i];
+	}
+
+	num_features = ex->num_features;
+	pass = ex->pass;
+	final_prediction = ex->final_prediction;
+	loss = ex->loss;
+	eta_round = ex->eta_round;
+	global_weight = ex->global_weight;
+	example_t = ex->example_t;
+	total_sum_feat_sq = ex->total_sum_feat_sq;
+	example_counter = ex->example_counter;
+	sorted = ex->sorted;
+}
+
+namespace shogun
+{
+#ifdef TRACE_MEMORY_ALLOCS
+template<> VwExample* sg_generic_malloc<VwExample>(size_t len, const char* file, int line)
+{
+	return new VwExample[len]();
+}
+
+template<> VwExample* sg_generic_calloc<VwExample>(size_t len, const char* file, int line)
+{
+	return new VwExample[len]();
+}
+
+template<> VwExample* sg_generic_realloc<VwExample>(VwExample* ptr, size_t old_len, size_t len, const char* file, int line)
+#else // TRACE_MEMORY_ALLOCS
+template<> VwExample* sg_generic_malloc<VwExample>(size_t len)
+{
+	return new VwExample[len]();
+}
+
+template<> VwExample* sg_generic_calloc<VwExample>(size_t len)
+{
+	return new VwExample[len]();
+}
+
+template<> VwExample* sg_generic_realloc<VwExample>(VwExample* ptr, size_t old_len, size_t len)
+#endif // TRACE_MEMORY_ALLOCS
+{
+	VwExample* new_ptr = new VwExample[len]();
+	size_t min_len=old_len;
+	if (len<min_len)
+		min_len=len;
+	for (size_t i=0; i<min_len; i++)
+		new_ptr[i].copy_from(&ptr[i]);
+	delete[] ptr;
+	return new_ptr;
+}
+
+template<> void sg_generic_free<VwExample>(VwExample* ptr)
+{
+	delete[] ptr;
+}
+}
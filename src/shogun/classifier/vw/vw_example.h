@@ -74,6 +74,14 @@ public:
 	 */
 	void reset_members();
 
+	/**
+	 * Copy the label, features and state of another example
+	 * into this one, reusing the already allocated arrays
+	 *
+	 * @param ex example to copy
+	 */
+	void copy_from(VwExample* ex);
+
 public:
 	/// Label object
 	VwLabel* ld;
@@ -111,5 +119,19 @@ public:
 	bool sorted;
 };
 
+/* examples own their label and feature arrays, so SG_MALLOC/SG_FREE have
+ * to construct and destroy them like for the SGVector types in memory.h */
+#ifdef TRACE_MEMORY_ALLOCS
+template<> VwExample* sg_generic_malloc<VwExample>(size_t len, const char* file, int line);
+template<> VwExample* sg_generic_calloc<VwExample>(size_t len, const char* file, int line);
+template<> VwExample* sg_generic_realloc<VwExample>(VwExample* ptr, size_t old_len, size_t len, const char* file, int line);
+template<> void sg_generic_free<VwExample>(VwExample* ptr);
+#else // TRACE_MEMORY_ALLOCS
+template<> VwExample* sg_generic_malloc<VwExample>(size_t len);
+template<> VwExample* sg_generic_calloc<VwExample>(size_t len);
+template<> VwExample* sg_generic_realloc<VwExample>(VwExample* ptr, size_t old_len, size_t len);
+template<> void sg_generic_free<VwExample>(VwExample* ptr);
+#endif // TRACE_MEMORY_ALLOCS
+
 }
 #endif // _VW_EXAMPLE_H__
@@ -78,6 +78,7 @@ CFeatures* CDiffusionMaps::apply(CFeatures* features)
 CDenseFeatures<float64_t>* CDiffusionMaps::embed_distance(CDistance* distance)
 {
 	TAPKEE_PARAMETERS_FOR_SHOGUN parameters;
+	parameters.num_threads = parallel->get_num_threads();
 	parameters.n_timesteps = m_t;
 	parameters.gaussian_kernel_width = m_width;
 	parameters.method = SHOGUN_DIFFUSION_MAPS;
@@ -9,6 +9,7 @@
  */
 
 #include <shogun/converter/EmbeddingConverter.h>
+#include <shogun/converter/OutOfSampleEmbedding.h>
 #include <shogun/kernel/LinearKernel.h>
 #include <shogun/distance/EuclideanDistance.h>
 
@@ -21,7 +22,9 @@ CEmbeddingConverter::CEmbeddingConverter()
 {
 	m_target_dim = 1;
 	m_distance = new CEuclideanDistance();
+	SG_REF(m_distance);
 	m_kernel = new CLinearKernel();
+	SG_REF(m_kernel);
 
 	init();
 }
@@ -37,6 +40,24 @@ CDenseFeatures<float64_t>* CEmbeddingConverter::embed(CFeatures* features)
 	return (CDenseFeatures<float64_t>*)apply(features);
 }
 
+COutOfSampleEmbedding* CEmbeddingConverter::fit(CFeatures* features, int32_t k)
+{
+	REQUIRE(features, "Features must be provided\n")
+	REQUIRE(features->get_feature_class()==C_DENSE &&
+			features->get_feature_type()==F_DREAL,
+			"Out-of-sample embedding requires dense real-valued features\n")
+
+	SG_REF(features);
+	CDenseFeatures<float64_t>* embedding = embed(features);
+	COutOfSampleEmbedding* model = new COutOfSampleEmbedding(
+			(CDenseFeatures<float64_t>*)features,
+			embedding->get_feature_matrix(), m_distance, k);
+	SG_UNREF(embedding);
+	SG_UNREF(features);
+
+	return model;
+}
+
 void CEmbeddingConverter::set_target_dim(int32_t dim)
 {
 	ASSERT(dim>0)
@@ -25,6 +25,7 @@ namespace shogun
 class CFeatures;
 class CDistance;
 class CKernel;
+class COutOfSampleEmbedding;
 
 /** @brief class EmbeddingConverter (part of the Efficient Dimensionality
  * Reduction Toolkit) used to construct embeddings of
@@ -53,6 +54,16 @@ public:
 	 */
 	virtual CDenseFeatures<float64_t>* embed(CFeatures* features);
 
+	/** embeds given features and returns fitted embedding model
+	 * that can embed new feature vectors without recomputing
+	 * the whole embedding (see COutOfSampleEmbedding)
+	 *
+	 * @param features dense real-valued features to embed
+	 * @param k number of neighbors used to embed new vectors
+	 * @return fitted embedding model
+	 */
+	COutOfSampleEmbedding* fit(CFeatures* features, int32_t k=10);
+
 	/** setter for target dimension
 	 * @param dim target dimension
 	 */
@@ -61,6 +61,7 @@ float64_t CFactorAnalysis::get_epsilon() const
 CFeatures* CFactorAnalysis::apply(CFeatures* features)
 {
 	TAPKEE_PARAMETERS_FOR_SHOGUN parameters;
+	parameters.num_threads = parallel->get_num_threads();
 	parameters.max_iteration = m_max_iteration;
 	parameters.features = (CDotFeatures*)features;
 	parameters.fa_epsilon = m_epsilon;
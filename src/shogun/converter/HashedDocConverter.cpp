@@ -87,21 +87,43 @@ CFeatures* CHashedDocConverter::apply(CFeatures* features)
 	CStringFeatures<char>* s_features = (CStringFeatures<char>*) features;
 
 	int32_t dim = CMath::pow(2, num_bits);
-	SGSparseMatrix<float64_t> matrix(dim,features->get_num_vectors());
-	for (index_t vec_idx=0; vec_idx<s_features->get_num_vectors(); vec_idx++)
+	index_t num_vectors = s_features->get_num_vectors();
+	SGSparseMatrix<float64_t> matrix(dim, num_vectors);
+
+	#pragma omp parallel num_threads(parallel->get_num_threads())
 	{
-		SGVector<char> doc = s_features->get_feature_vector(vec_idx);
-		matrix[vec_idx] = apply(doc);
-		s_features->free_feature_vector(doc, vec_idx);
+		/* tokenizers keep the current text, so every thread needs its own */
+		CTokenizer* local_tzer = tokenizer->get_copy();
+
+		#pragma omp for schedule(dynamic, 16)
+		for (index_t vec_idx=0; vec_idx<num_vectors; vec_idx++)
+		{
+			SGVector<char> doc = s_features->get_feature_vector(vec_idx);
+			matrix[vec_idx] = apply(doc, local_tzer);
+			s_features->free_feature_vector(doc, vec_idx);
+		}
+
+		SG_UNREF(local_tzer);
 	}
 
 	return (CFeatures*) new CSparseFeatures<float64_t>(matrix);
 }
 
 SGSparseVector<float64_t> CHashedDocConverter::apply(SGVector<char> document)
+{
+	return apply(document, tokenizer);
+}
+
+SGSparseVector<float64_t> CHashedDocConverter::apply(SGVector<char> document, CTokenizer* tzer)
 {
 	ASSERT(document.size()>0)
-	const int32_t array_size = 1024*1024;
+	ASSERT(tzer)
+
+	/** there are hardly ever more tokens than characters, each generating
+	 * at most (n-1)(k+1)+1 hashes, so avoid allocating the maximum size
+	 * for short documents */
+	const int64_t max_hashes = (int64_t) (document.size()+1) * ((ngrams-1)*(tokens_to_skip+1) + 1);
+	const int32_t array_size = CMath::min((int64_t) 1024*1024, max_hashes);
 	/** the array will contain all the hashes generated from the tokens */
 	CDynamicArray<uint32_t> hashed_indices(array_size);
 
@@ -118,20 +140,20 @@ SGSparseVector<float64_t> CHashedDocConverter::apply(SGVector<char> document)
 
 	/** Reading n+s-1 tokens */
 	const int32_t seed = 0xdeadbeaf;
-	tokenizer->set_text(document);
+	tzer->set_text(document);
 	index_t token_start = 0;
-	while (hashes_end<ngrams-1+tokens_to_skip && tokenizer->has_next())
+	while (hashes_end<ngrams-1+tokens_to_skip && tzer->has_next())
 	{
-		index_t end = tokenizer->next_token_idx(token_start);
+		index_t end = tzer->next_token_idx(token_start);
 		uint32_t token_hash = CHash::MurmurHash3((uint8_t* ) &document.vector[token_start],
 				end-token_start, seed);
 		cached_hashes[hashes_end++] = token_hash;
 	}
 
 	/** Reading token and storing index to hashed_indices */
-	while (tokenizer->has_next())
+	while (tzer->has_next())
 	{
-		index_t end = tokenizer->next_token_idx(token_start);
+		index_t end = tzer->next_token_idx(token_start);
 		uint32_t token_hash = CHash::MurmurHash3((uint8_t* ) &document.vector[token_start],
 				end-token_start, seed);
 		cached_hashes[hashes_end] = token_hash;
@@ -80,6 +80,16 @@ public:
 	 */
 	SGSparseVector<float64_t> apply(SGVector<char> document);
 
+	/** Hashes the tokens contained in document using the given tokenizer
+	 * instead of the converter's own one. Does not modify the converter,
+	 * so it can be called concurrently with a tokenizer per thread.
+	 *
+	 * @param document the char vector to tokenize and hash
+	 * @param tzer the tokenizer to use
+	 * @return a SGSparseVector with the hashed representation of the document
+	 */
+	SGSparseVector<float64_t> apply(SGVector<char> document, CTokenizer* tzer);
+
 	/** Generates all the k-skip n-grams combinations for the pre-hashed tokens in hashes,
 	 * starting from hashes[hashes_start] and going up to hashes[1+len] in a circular manner.
 	 * The generated tokens (maximun (n-1)(k+1)+1) are stored in ngram_hashes. The number of
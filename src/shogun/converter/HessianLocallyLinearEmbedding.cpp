@@ -33,6 +33,7 @@ CFeatures* CHessianLocallyLinearEmbedding::apply(CFeatures* features)
 {
 	CKernel* kernel = new CLinearKernel((CDotFeatures*)features,(CDotFeatures*)features);
 	TAPKEE_PARAMETERS_FOR_SHOGUN parameters;
+	parameters.num_threads = parallel->get_num_threads();
 	parameters.n_neighbors = m_k;
 	parameters.eigenshift = m_nullspace_shift;
 	parameters.method = SHOGUN_HESSIAN_LOCALLY_LINEAR_EMBEDDING;
@@ -50,6 +50,7 @@ const char* CIsomap::get_name() const
 CDenseFeatures<float64_t>* CIsomap::embed_distance(CDistance* distance)
 {
 	TAPKEE_PARAMETERS_FOR_SHOGUN parameters;
+	parameters.num_threads = parallel->get_num_threads();
 	if (m_landmark)
 	{
 		parameters.method = SHOGUN_LANDMARK_ISOMAP;
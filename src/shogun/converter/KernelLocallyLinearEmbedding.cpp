@@ -61,6 +61,7 @@ CFeatures* CKernelLocallyLinearEmbedding::apply(CFeatures* features)
 CDenseFeatures<float64_t>* CKernelLocallyLinearEmbedding::embed_kernel(CKernel* kernel)
 {
 	TAPKEE_PARAMETERS_FOR_SHOGUN parameters;
+	parameters.num_threads = parallel->get_num_threads();
 	parameters.n_neighbors = m_k;
 	parameters.eigenshift = m_nullspace_shift;
 	parameters.method = SHOGUN_KERNEL_LOCALLY_LINEAR_EMBEDDING;
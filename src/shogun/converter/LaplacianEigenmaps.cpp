@@ -82,6 +82,7 @@ CFeatures* CLaplacianEigenmaps::apply(CFeatures* features)
 CDenseFeatures<float64_t>* CLaplacianEigenmaps::embed_distance(CDistance* distance)
 {
 	TAPKEE_PARAMETERS_FOR_SHOGUN parameters;
+	parameters.num_threads = parallel->get_num_threads();
 	parameters.n_neighbors = m_k;
 	parameters.gaussian_kernel_width = m_tau;
 	parameters.method = SHOGUN_LAPLACIAN_EIGENMAPS;
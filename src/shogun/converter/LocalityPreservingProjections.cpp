@@ -32,6 +32,7 @@ const char* CLocalityPreservingProjections::get_name() const
 CFeatures* CLocalityPreservingProjections::apply(CFeatures* features)
 {
 	TAPKEE_PARAMETERS_FOR_SHOGUN parameters;
+	parameters.num_threads = parallel->get_num_threads();
 	m_distance->init(features,features);
 	parameters.n_neighbors = m_k;
 	parameters.gaussian_kernel_width = m_tau;
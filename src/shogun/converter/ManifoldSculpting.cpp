@@ -84,6 +84,7 @@ CFeatures* CManifoldSculpting::apply(CFeatures* features)
 	new CEuclideanDistance(feats, feats);
 
 	TAPKEE_PARAMETERS_FOR_SHOGUN parameters;
+	parameters.num_threads = parallel->get_num_threads();
 	parameters.n_neighbors = m_k;
 	parameters.squishing_rate = m_squishing_rate;
 	parameters.max_iteration = m_max_iteration;
@@ -80,6 +80,7 @@ const char* CMultidimensionalScaling::get_name() const
 CDenseFeatures<float64_t>* CMultidimensionalScaling::embed_distance(CDistance* distance)
 {
 	TAPKEE_PARAMETERS_FOR_SHOGUN parameters;
+	parameters.num_threads = parallel->get_num_threads();
 	if (m_landmark)
 	{
 		parameters.method = SHOGUN_LANDMARK_MULTIDIMENSIONAL_SCALING;
@@ -34,6 +34,7 @@ CFeatures* CNeighborhoodPreservingEmbedding::apply(CFeatures* features)
 {
 	CKernel* kernel = new CLinearKernel((CDotFeatures*)features,(CDotFeatures*)features);
 	TAPKEE_PARAMETERS_FOR_SHOGUN parameters;
+	parameters.num_threads = parallel->get_num_threads();
 	parameters.n_neighbors = m_k;
 	parameters.eigenshift = m_nullspace_shift;
 	parameters.method = SHOGUN_NEIGHBORHOOD_PRESERVING_EMBEDDING;
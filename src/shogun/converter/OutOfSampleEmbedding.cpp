@@ -0,0 +1,273 @@
+/*
+ * Copyright (c) The Shogun Machine Learning Toolbox
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation are those
+ * of the authors and should not be interpreted as representing official policies,
+ * either expressed or implied, of the Shogun Development Team.
+ *
+ */
+
+#include <shogun/converter/OutOfSampleEmbedding.h>
+#include <shogun/multiclass/tree/KDTree.h>
+#include <shogun/mathematics/Math.h>
+#include <shogun/mathematics/eigen3.h>
+#include <shogun/base/Parallel.h>
+#include <shogun/io/SGIO.h>
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+using namespace shogun;
+using namespace Eigen;
+
+COutOfSampleEmbedding::COutOfSampleEmbedding() : CSGObject()
+{
+	init();
+}
+
+COutOfSampleEmbedding::COutOfSampleEmbedding(CDenseFeatures<float64_t>* features,
+		SGMatrix<float64_t> embedding, CDistance* distance, int32_t k)
+: CSGObject()
+{
+	init();
+
+	REQUIRE(features, "Training features must be provided\n")
+	REQUIRE(distance, "Distance must be provided\n")
+	REQUIRE(embedding.num_cols==features->get_num_vectors(),
+			"Number of embedded vectors (%d) does not match number of "
+			"training vectors (%d)\n", embedding.num_cols,
+			features->get_num_vectors())
+
+	SG_REF(features);
+	m_features = features;
+	// a private copy without features, so that neither the caller nor
+	// concurrent embeddings see each other's features on it
+	m_distance = (CDistance*) distance->clone();
+	REQUIRE(m_distance, "Could not copy distance %s\n", distance->get_name())
+	m_distance->remove_lhs_and_rhs();
+	m_embedding = embedding;
+	set_k(k);
+}
+
+COutOfSampleEmbedding::~COutOfSampleEmbedding()
+{
+	SG_UNREF(m_features);
+	SG_UNREF(m_distance);
+	SG_UNREF(m_tree);
+}
+
+void COutOfSampleEmbedding::init()
+{
+	m_features = NULL;
+	m_distance = NULL;
+	m_tree = NULL;
+	m_tree_built = false;
+	m_k = 10;
+	m_reconstruction_shift = 1e-3;
+
+	SG_ADD((CSGObject**)&m_features, "features", "training features",
+			MS_NOT_AVAILABLE);
+	SG_ADD(&m_embedding, "embedding", "embedding of training features",
+			MS_NOT_AVAILABLE);
+	SG_ADD((CSGObject**)&m_distance, "distance",
+			"distance used to find neighbors", MS_NOT_AVAILABLE);
+	SG_ADD(&m_k, "k", "number of neighbors", MS_AVAILABLE);
+	SG_ADD(&m_reconstruction_shift, "reconstruction_shift",
+			"regularization of local gram matrices", MS_AVAILABLE);
+}
+
+void COutOfSampleEmbedding::set_k(int32_t k)
+{
+	REQUIRE(k>0, "Number of neighbors (%d) must be positive\n", k)
+	m_k = k;
+}
+
+int32_t COutOfSampleEmbedding::get_k() const
+{
+	return m_k;
+}
+
+void COutOfSampleEmbedding::set_reconstruction_shift(float64_t shift)
+{
+	REQUIRE(shift>=0, "Reconstruction shift (%f) must be non-negative\n", shift)
+	m_reconstruction_shift = shift;
+}
+
+float64_t COutOfSampleEmbedding::get_reconstruction_shift() const
+{
+	return m_reconstruction_shift;
+}
+
+SGMatrix<float64_t> COutOfSampleEmbedding::get_embedding() const
+{
+	return m_embedding;
+}
+
+int32_t COutOfSampleEmbedding::get_target_dim() const
+{
+	return m_embedding.num_rows;
+}
+
+void COutOfSampleEmbedding::build_tree()
+{
+	if (m_tree_built)
+		return;
+
+	m_tree_built = true;
+	EDistanceType type = m_distance->get_distance_type();
+	if (type==D_EUCLIDEAN || type==D_MANHATTAN)
+	{
+		m_tree = new CKDTree(10, type);
+		SG_REF(m_tree);
+		m_tree->build_tree(m_features);
+	}
+}
+
+SGMatrix<index_t> COutOfSampleEmbedding::find_neighbors(CDenseFeatures<float64_t>* query)
+{
+	const index_t n_train = m_features->get_num_vectors();
+	const index_t n_query = query->get_num_vectors();
+	const index_t k = CMath::min(m_k, n_train);
+
+	m_tree_lock.lock();
+	build_tree();
+	if (m_tree)
+	{
+		m_tree->query_knn(query, k);
+		SGMatrix<index_t> neighbors = m_tree->get_knn_indices();
+		m_tree_lock.unlock();
+		return neighbors;
+	}
+	m_tree_lock.unlock();
+
+	SGMatrix<index_t> neighbors(k, n_query);
+	CDistance* distance = (CDistance*) m_distance->clone();
+	distance->init(m_features, query);
+
+	#pragma omp parallel for num_threads(parallel->get_num_threads())
+	for (index_t i=0; i<n_query; i++)
+	{
+		std::vector<std::pair<float64_t,index_t> > candidates(n_train);
+		for (index_t j=0; j<n_train; j++)
+			candidates[j] = std::make_pair(distance->distance(j,i), j);
+
+		std::partial_sort(candidates.begin(), candidates.begin()+k,
+				candidates.end());
+
+		for (index_t j=0; j<k; j++)
+			neighbors(j,i) = candidates[j].second;
+	}
+
+	SG_UNREF(distance);
+
+	return neighbors;
+}
+
+SGVector<float64_t> COutOfSampleEmbedding::compute_weights(SGVector<float64_t> vec,
+		const index_t* neighbors)
+{
+	const index_t k = CMath::min(m_k, m_features->get_num_vectors());
+	const index_t dim = vec.vlen;
+
+	MatrixXd local(dim, k);
+	for (index_t j=0; j<k; j++)
+	{
+		SGVector<float64_t> neighbor = m_features->get_feature_vector(neighbors[j]);
+		for (index_t d=0; d<dim; d++)
+			local(d,j) = neighbor[d]-vec[d];
+		m_features->free_feature_vector(neighbor, neighbors[j]);
+	}
+
+	MatrixXd gram = local.transpose()*local;
+	float64_t trace = gram.trace();
+
+	SGVector<float64_t> weights(k);
+	Map<VectorXd> eigen_weights(weights.vector, k);
+	if (trace>0)
+	{
+		gram.diagonal().array() += m_reconstruction_shift*trace;
+		eigen_weights = gram.ldlt().solve(VectorXd::Ones(k));
+		eigen_weights /= eigen_weights.sum();
+	}
+	else
+	{
+		// all neighbors coincide with the vector
+		eigen_weights.setConstant(1.0/k);
+	}
+
+	return weights;
+}
+
+SGVector<float64_t> COutOfSampleEmbedding::embed_vector(SGVector<float64_t> vec)
+{
+	SGMatrix<float64_t> vec_matrix(vec.vector, vec.vlen, 1, false);
+	CDenseFeatures<float64_t>* query = new CDenseFeatures<float64_t>(vec_matrix);
+	SG_REF(query);
+	CDenseFeatures<float64_t>* embedded = embed(query);
+	SGVector<float64_t> result = embedded->get_feature_vector(0).clone();
+	SG_UNREF(embedded);
+	SG_UNREF(query);
+
+	return result;
+}
+
+CDenseFeatures<float64_t>* COutOfSampleEmbedding::embed(CDenseFeatures<float64_t>* features)
+{
+	REQUIRE(m_features, "Embedding was not fitted\n")
+	REQUIRE(features, "Features to embed must be provided\n")
+	REQUIRE(features->get_num_features()==m_features->get_num_features(),
+			"Dimension of features to embed (%d) does not match dimension "
+			"of training features (%d)\n", features->get_num_features(),
+			m_features->get_num_features())
+
+	SG_REF(features);
+
+	const index_t n_query = features->get_num_vectors();
+	const index_t target_dim = m_embedding.num_rows;
+	SGMatrix<index_t> neighbors = find_neighbors(features);
+	SGMatrix<float64_t> result(target_dim, n_query);
+	result.zero();
+
+	#pragma omp parallel for num_threads(parallel->get_num_threads())
+	for (index_t i=0; i<n_query; i++)
+	{
+		SGVector<float64_t> vec = features->get_feature_vector(i);
+		SGVector<float64_t> weights = compute_weights(vec,
+				neighbors.get_column_vector(i));
+		features->free_feature_vector(vec, i);
+
+		for (index_t j=0; j<weights.vlen; j++)
+		{
+			const float64_t* neighbor_embedding =
+				m_embedding.get_column_vector(neighbors(j,i));
+			for (index_t t=0; t<target_dim; t++)
+				result(t,i) += weights[j]*neighbor_embedding[t];
+		}
+	}
+
+	SG_UNREF(features);
+
+	return new CDenseFeatures<float64_t>(result);
+}
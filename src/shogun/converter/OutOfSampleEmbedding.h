@@ -0,0 +1,204 @@
+/*
+ * Copyright (c) The Shogun Machine Learning Toolbox
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation are those
+ * of the authors and should not be interpreted as representing official policies,
+ * either expressed or implied, of the Shogun Development Team.
+ *
+ */
+
+#ifndef OUTOFSAMPLEEMBEDDING_H_
+#define OUTOFSAMPLEEMBEDDING_H_
+
+#include <shogun/lib/config.h>
+
+#include <shogun/base/SGObject.h>
+#include <shogun/lib/SGMatrix.h>
+#include <shogun/lib/SGVector.h>
+#include <shogun/features/DenseFeatures.h>
+#include <shogun/distance/Distance.h>
+#include <shogun/lib/Lock.h>
+
+namespace shogun
+{
+class CKDTree;
+
+/** @brief Fitted embedding model returned by CEmbeddingConverter::fit
+ * that maps previously unseen feature vectors into an already computed
+ * embedding without recomputing it.
+ *
+ * A new vector \f$x\f$ is embedded by finding its \f$k\f$ nearest
+ * training vectors \f$x_{n_1},\dots,x_{n_k}\f$ with respect to the
+ * distance used for embedding, computing the barycentric reconstruction
+ * weights
+ *
+ * \f[
+ *	\min_w \| x - \sum_{j=1}^k w_j x_{n_j} \|^2, \quad \sum_j w_j = 1
+ * \f]
+ *
+ * (the same local model used by Locally Linear Embedding) and mapping
+ * \f$x\f$ to \f$y = \sum_j w_j y_{n_j}\f$ where \f$y_{n_j}\f$ are the
+ * embedded training vectors. Since the reconstruction weights are
+ * invariant to rotation, scaling and translation of the neighborhood
+ * the extension is consistent for all local and spectral methods.
+ *
+ * Neighbors are found with a kd-tree built on the training vectors for
+ * Euclidean and Manhattan distances, which in low dimensions takes about
+ * \f$O(d \log N)\f$ per vector instead of the \f$O(N d)\f$ of scanning
+ * all \f$N\f$ training vectors; other distances are scanned. Once
+ * neighbors are found, embedding a vector costs \f$O(k^2 d + k^3)\f$.
+ *
+ * Embedding may be called from several threads at once.
+ */
+class COutOfSampleEmbedding : public CSGObject
+{
+public:
+
+	/** default constructor */
+	COutOfSampleEmbedding();
+
+	/** constructor
+	 *
+	 * @param features training features the embedding was computed for
+	 * @param embedding embedding of training features with
+	 * target dimension rows and one column per training vector
+	 * @param distance distance used to find neighbors
+	 * @param k number of neighbors used for the extension
+	 */
+	COutOfSampleEmbedding(CDenseFeatures<float64_t>* features,
+			SGMatrix<float64_t> embedding, CDistance* distance, int32_t k);
+
+	/** destructor */
+	virtual ~COutOfSampleEmbedding();
+
+	/** embeds new features into the fitted embedding
+	 *
+	 * @param features features to embed, must have the same
+	 * dimensionality as training features
+	 * @return embedded features
+	 */
+	CDenseFeatures<float64_t>* embed(CDenseFeatures<float64_t>* features);
+
+	/** embeds a single new vector into the fitted embedding
+	 *
+	 * @param vec vector to embed
+	 * @return embedded vector of target dimension
+	 */
+	SGVector<float64_t> embed_vector(SGVector<float64_t> vec);
+
+	/** setter for number of neighbors
+	 * @param k number of neighbors
+	 */
+	void set_k(int32_t k);
+
+	/** getter for number of neighbors
+	 * @return number of neighbors
+	 */
+	int32_t get_k() const;
+
+	/** setter for regularization of local gram matrices
+	 * @param shift regularization relative to the trace of
+	 * local gram matrix
+	 */
+	void set_reconstruction_shift(float64_t shift);
+
+	/** getter for regularization of local gram matrices
+	 * @return regularization relative to the trace of
+	 * local gram matrix
+	 */
+	float64_t get_reconstruction_shift() const;
+
+	/** getter for embedding of training features
+	 * @return embedding matrix
+	 */
+	SGMatrix<float64_t> get_embedding() const;
+
+	/** getter for target dimension
+	 * @return target dimension
+	 */
+	int32_t get_target_dim() const;
+
+	/** @return object name */
+	virtual const char* get_name() const { return "OutOfSampleEmbedding"; }
+
+protected:
+
+	/** finds neighbors of each query vector in training features
+	 *
+	 * @param query query features
+	 * @return matrix of neighbor indices with k rows and
+	 * one column per query vector
+	 */
+	SGMatrix<index_t> find_neighbors(CDenseFeatures<float64_t>* query);
+
+	/** builds m_tree if the distance allows it and it was not done yet,
+	 * m_tree_lock has to be held */
+	void build_tree();
+
+	/** computes barycentric reconstruction weights of vector
+	 * from its neighbors
+	 *
+	 * @param vec vector to reconstruct
+	 * @param neighbors indices of neighbors of vector
+	 * @return reconstruction weights summing to one
+	 */
+	SGVector<float64_t> compute_weights(SGVector<float64_t> vec,
+			const index_t* neighbors);
+
+private:
+
+	/** register parameters */
+	void init();
+
+protected:
+
+	/** training features */
+	CDenseFeatures<float64_t>* m_features;
+
+	/** embedding of training features */
+	SGMatrix<float64_t> m_embedding;
+
+	/** distance used to find neighbors, without features */
+	CDistance* m_distance;
+
+	/** kd-tree on training features, NULL if not built (yet) or not
+	 * supported for the distance */
+	CKDTree* m_tree;
+
+	/** whether building m_tree has been attempted */
+	bool m_tree_built;
+
+	/** serializes building and querying m_tree */
+	CLock m_tree_lock;
+
+	/** number of neighbors */
+	int32_t m_k;
+
+	/** regularization of local gram matrices */
+	float64_t m_reconstruction_shift;
+};
+
+}
+
+#endif /* OUTOFSAMPLEEMBEDDING_H_ */
@@ -62,6 +62,7 @@ float64_t CTDistributedStochasticNeighborEmbedding::get_perplexity() const
 CFeatures* CTDistributedStochasticNeighborEmbedding::apply(CFeatures* features)
 {
 	TAPKEE_PARAMETERS_FOR_SHOGUN parameters;
+	parameters.num_threads = parallel->get_num_threads();
 	parameters.sne_theta = m_theta;
 	parameters.sne_perplexity = m_perplexity;
 	parameters.features = (CDotFeatures*)features;
@@ -0,0 +1,148 @@
+/*
+ * Copyright (c) The Shogun Machine Learning Toolbox
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation are those
+ * of the authors and should not be interpreted as representing official policies,
+ * either expressed or implied, of the Shogun Development Team.
+ *
+ */
+
+#include <shogun/distance/BlockedDistanceMatrix.h>
+#include <shogun/features/DenseFeatures.h>
+#include <shogun/mathematics/Math.h>
+#include <shogun/mathematics/eigen3.h>
+
+#include <vector>
+
+using namespace shogun;
+using namespace Eigen;
+
+/** number of vectors per block, a pair of blocks of vectors with a few
+ * hundred dimensions fits into L2 cache */
+#define DISTANCE_BLOCK_SIZE 256
+
+template <class T>
+bool shogun::blocked_distance_matrix(SGMatrix<T> result, CFeatures* lhs,
+		CFeatures* rhs, EBlockedDistance type, int32_t num_threads)
+{
+	if (!lhs || !rhs ||
+			lhs->get_feature_class()!=C_DENSE || rhs->get_feature_class()!=C_DENSE ||
+			lhs->get_feature_type()!=F_DREAL || rhs->get_feature_type()!=F_DREAL)
+		return false;
+
+	CDenseFeatures<float64_t>* lhs_dense=(CDenseFeatures<float64_t>*) lhs;
+	CDenseFeatures<float64_t>* rhs_dense=(CDenseFeatures<float64_t>*) rhs;
+	int32_t dim=lhs_dense->get_num_features();
+	if (dim!=rhs_dense->get_num_features())
+		return false;
+
+	// features computed on the fly have no matrix to work on
+	SGMatrix<float64_t> lhs_matrix=lhs_dense->get_feature_matrix();
+	SGMatrix<float64_t> rhs_matrix=lhs==rhs ? lhs_matrix : rhs_dense->get_feature_matrix();
+	if (!lhs_matrix.matrix || !rhs_matrix.matrix)
+		return false;
+
+	int32_t m=lhs_dense->get_num_vectors();
+	int32_t n=rhs_dense->get_num_vectors();
+	REQUIRE(result.num_rows==m && result.num_cols==n, "Distance matrix of size "
+			"%dx%d expected, got %dx%d\n", m, n, result.num_rows, result.num_cols)
+
+	bool symmetric=lhs==rhs;
+	Map<MatrixXd> a(lhs_matrix.matrix, dim, m);
+	Map<MatrixXd> b(rhs_matrix.matrix, dim, n);
+
+	VectorXd a_sq, b_sq;
+	if (type!=BLOCKED_MANHATTAN)
+	{
+		a_sq=a.colwise().squaredNorm().transpose();
+		b_sq=symmetric ? a_sq : VectorXd(b.colwise().squaredNorm().transpose());
+	}
+
+	int32_t num_lhs_blocks=(m+DISTANCE_BLOCK_SIZE-1)/DISTANCE_BLOCK_SIZE;
+	int32_t num_rhs_blocks=(n+DISTANCE_BLOCK_SIZE-1)/DISTANCE_BLOCK_SIZE;
+	std::vector<std::pair<int32_t, int32_t> > blocks;
+	for (int32_t bi=0; bi<num_lhs_blocks; bi++)
+	{
+		for (int32_t bj=symmetric ? bi : 0; bj<num_rhs_blocks; bj++)
+			blocks.push_back(std::make_pair(bi, bj));
+	}
+
+	int64_t num_blocks=blocks.size();
+#pragma omp parallel for schedule(dynamic) num_threads(num_threads)
+	for (int64_t k=0; k<num_blocks; k++)
+	{
+		int32_t i_start=blocks[k].first*DISTANCE_BLOCK_SIZE;
+		int32_t j_start=blocks[k].second*DISTANCE_BLOCK_SIZE;
+		int32_t i_len=CMath::min(DISTANCE_BLOCK_SIZE, m-i_start);
+		int32_t j_len=CMath::min(DISTANCE_BLOCK_SIZE, n-j_start);
+		bool mirror=symmetric && i_start!=j_start;
+
+		MatrixXd dot;
+		if (type!=BLOCKED_MANHATTAN)
+			dot.noalias()=a.middleCols(i_start, i_len).transpose()*b.middleCols(j_start, j_len);
+
+		for (int32_t j=0; j<j_len; j++)
+		{
+			int32_t col=j_start+j;
+			for (int32_t i=0; i<i_len; i++)
+			{
+				int32_t row=i_start+i;
+				float64_t d;
+
+				switch (type)
+				{
+					case BLOCKED_EUCLIDEAN:
+					case BLOCKED_SQUARED_EUCLIDEAN:
+						// cancellation may leave tiny negative values
+						d=CMath::max(a_sq[row]+b_sq[col]-2*dot(i, j), 0.0);
+						if (symmetric && row==col)
+							d=0;
+						if (type==BLOCKED_EUCLIDEAN)
+							d=CMath::sqrt(d);
+						break;
+					case BLOCKED_COSINE:
+					{
+						float64_t s=CMath::sqrt(a_sq[row])*CMath::sqrt(b_sq[col]);
+						d=s==0 ? 0 : CMath::max(1-dot(i, j)/s, 0.0);
+						break;
+					}
+					default:
+						d=(a.col(row)-b.col(col)).cwiseAbs().sum();
+						break;
+				}
+
+				result(row, col)=(T) d;
+				if (mirror)
+					result(col, row)=(T) d;
+			}
+		}
+	}
+
+	return true;
+}
+
+template bool shogun::blocked_distance_matrix<float32_t>(SGMatrix<float32_t> result,
+		CFeatures* lhs, CFeatures* rhs, EBlockedDistance type, int32_t num_threads);
+template bool shogun::blocked_distance_matrix<float64_t>(SGMatrix<float64_t> result,
+		CFeatures* lhs, CFeatures* rhs, EBlockedDistance type, int32_t num_threads);
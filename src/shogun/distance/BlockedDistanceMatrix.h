@@ -0,0 +1,76 @@
+/*
+ * Copyright (c) The Shogun Machine Learning Toolbox
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation are those
+ * of the authors and should not be interpreted as representing official policies,
+ * either expressed or implied, of the Shogun Development Team.
+ *
+ */
+
+#ifndef _BLOCKEDDISTANCEMATRIX_H__
+#define _BLOCKEDDISTANCEMATRIX_H__
+
+#include <shogun/lib/config.h>
+
+#include <shogun/lib/common.h>
+#include <shogun/lib/SGMatrix.h>
+
+namespace shogun
+{
+class CFeatures;
+
+/** distances with a blocked distance matrix implementation */
+enum EBlockedDistance
+{
+	BLOCKED_EUCLIDEAN,
+	BLOCKED_SQUARED_EUCLIDEAN,
+	BLOCKED_COSINE,
+	BLOCKED_MANHATTAN
+};
+
+/** compute the distance matrix between two sets of dense float64 features
+ * block by block
+ *
+ * Blocks of lhs and rhs vectors are processed in parallel. Euclidean and
+ * cosine distances are computed from the squared norms of the vectors and a
+ * matrix product (GEMM) of each pair of blocks; the Manhattan distance
+ * compares the vectors of a pair of blocks while they are in cache. If lhs
+ * and rhs are the same features only the blocks on and above the diagonal
+ * are computed and mirrored.
+ *
+ * @param result matrix of size (number of lhs vectors)x(number of rhs
+ * vectors) to write the distances to, it may wrap any storage (e.g. memory
+ * mapped from a file)
+ * @param lhs features of left-hand side
+ * @param rhs features of right-hand side
+ * @param type distance to compute
+ * @param num_threads number of threads to use
+ * @return false if the features are not dense float64 features with a
+ * feature matrix, in which case result is unchanged
+ */
+template <class T>
+bool blocked_distance_matrix(SGMatrix<T> result, CFeatures* lhs,
+		CFeatures* rhs, EBlockedDistance type, int32_t num_threads);
+}
+#endif /* _BLOCKEDDISTANCEMATRIX_H__ */
@@ -316,22 +316,39 @@ template <class T> void* CDistance::get_distance_matrix_helper(void* p)
 template <class T>
 SGMatrix<T> CDistance::get_distance_matrix()
 {
-	T* result = NULL;
+	REQUIRE(has_features(), "no features assigned to distance\n")
+
+	SGMatrix<T> result(get_num_vec_lhs(), get_num_vec_rhs());
+	compute_distance_matrix(result);
+
+	return result;
+}
 
+template <class T>
+void CDistance::compute_distance_matrix(SGMatrix<T> distance_matrix)
+{
 	REQUIRE(has_features(), "no features assigned to distance\n")
 
 	int32_t m=get_num_vec_lhs();
 	int32_t n=get_num_vec_rhs();
+	REQUIRE(distance_matrix.num_rows==m && distance_matrix.num_cols==n,
+			"Distance matrix of size %dx%d expected, got %dx%d\n", m, n,
+			distance_matrix.num_rows, distance_matrix.num_cols)
+
+	SG_DEBUG("computing distance matrix of size %dx%d\n", m, n)
 
+	if (compute_distance_matrix_blocked(distance_matrix))
+	{
+		SG_DONE()
+		return;
+	}
+
+	T* result=distance_matrix.matrix;
 	int64_t total_num = int64_t(m)*n;
 
 	// if lhs == rhs and sizes match assume k(i,j)=k(j,i)
 	bool symmetric= (lhs && lhs==rhs && m==n);
 
-	SG_DEBUG("returning distance matrix of size %dx%d\n", m, n)
-
-		result=SG_MALLOC(T, total_num);
-
 	int32_t num_threads=parallel->get_num_threads();
 	if (num_threads < 2)
 	{
@@ -405,12 +422,12 @@ SGMatrix<T> CDistance::get_distance_matrix()
 	}
 
 	SG_DONE()
-
-	return SGMatrix<T>(result,m,n,true);
 }
 
 template SGMatrix<float64_t> CDistance::get_distance_matrix<float64_t>();
 template SGMatrix<float32_t> CDistance::get_distance_matrix<float32_t>();
+template void CDistance::compute_distance_matrix<float64_t>(SGMatrix<float64_t> result);
+template void CDistance::compute_distance_matrix<float32_t>(SGMatrix<float32_t> result);
 
 template void* CDistance::get_distance_matrix_helper<float64_t>(void* p);
 template void* CDistance::get_distance_matrix_helper<float32_t>(void* p);
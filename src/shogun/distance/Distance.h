@@ -164,6 +164,15 @@ class CDistance : public CSGObject
 		 */
 		template <class T> SGMatrix<T> get_distance_matrix();
 
+		/** compute the distance matrix into a matrix provided by the caller,
+		 * e.g. a float32 matrix or one wrapping memory mapped storage for
+		 * matrices that do not fit into memory
+		 *
+		 * @param result matrix of size
+		 * get_num_vec_lhs()xget_num_vec_rhs() to write the distances to
+		 */
+		template <class T> void compute_distance_matrix(SGMatrix<T> result);
+
 		/** compute row start offset for parallel kernel matrix computation
 		 *
 		 * @param offs offset
@@ -351,6 +360,28 @@ class CDistance : public CSGObject
 		/// in the corresponding feature object
 		virtual float64_t compute(int32_t idx_a, int32_t idx_b)=0;
 
+		/** compute the whole distance matrix at once, for distances with a
+		 * faster way than computing every element by itself
+		 *
+		 * @param result distance matrix to fill
+		 * @return false if not supported (the default) for this distance or
+		 * its features, in which case compute() is used for every element
+		 */
+		virtual bool compute_distance_matrix_blocked(SGMatrix<float64_t> result)
+		{
+			return false;
+		}
+
+		/** compute the whole distance matrix at once in single precision
+		 *
+		 * @param result distance matrix to fill
+		 * @return false if not supported (the default)
+		 */
+		virtual bool compute_distance_matrix_blocked(SGMatrix<float32_t> result)
+		{
+			return false;
+		}
+
 		/// matrix precomputation
 		void do_precompute_matrix();
 
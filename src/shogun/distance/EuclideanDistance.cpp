@@ -11,6 +11,8 @@
 #include <shogun/lib/common.h>
 #include <shogun/io/SGIO.h>
 #include <shogun/distance/EuclideanDistance.h>
+#include <shogun/distance/BlockedDistanceMatrix.h>
+#include <shogun/base/Parallel.h>
 
 #ifdef HAVE_LINALG_LIB
 #include <shogun/mathematics/linalg/linalg.h>
@@ -168,3 +170,15 @@ float64_t CEuclideanDistance::distance_upper_bounded(int32_t idx_a, int32_t idx_
 	else
 		return CMath::sqrt(result);
 }
+
+bool CEuclideanDistance::compute_distance_matrix_blocked(SGMatrix<float64_t> result)
+{
+	EBlockedDistance type=disable_sqrt ? BLOCKED_SQUARED_EUCLIDEAN : BLOCKED_EUCLIDEAN;
+	return blocked_distance_matrix(result, lhs, rhs, type, parallel->get_num_threads());
+}
+
+bool CEuclideanDistance::compute_distance_matrix_blocked(SGMatrix<float32_t> result)
+{
+	EBlockedDistance type=disable_sqrt ? BLOCKED_SQUARED_EUCLIDEAN : BLOCKED_EUCLIDEAN;
+	return blocked_distance_matrix(result, lhs, rhs, type, parallel->get_num_threads());
+}
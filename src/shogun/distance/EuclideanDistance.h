@@ -149,6 +149,20 @@ class CEuclideanDistance: public CRealDistance
 		/// in the corresponding feature object
 		virtual float64_t compute(int32_t idx_a, int32_t idx_b);
 
+		/** compute the distance matrix with blocked_distance_matrix()
+		 *
+		 * @param result distance matrix to fill
+		 * @return false if the features have no feature matrix
+		 */
+		virtual bool compute_distance_matrix_blocked(SGMatrix<float64_t> result);
+
+		/** compute the distance matrix with blocked_distance_matrix()
+		 *
+		 * @param result distance matrix to fill
+		 * @return false if the features have no feature matrix
+		 */
+		virtual bool compute_distance_matrix_blocked(SGMatrix<float32_t> result);
+
 	private:
 		void init();
 
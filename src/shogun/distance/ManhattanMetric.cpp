@@ -12,6 +12,8 @@
 #include <shogun/lib/common.h>
 #include <shogun/io/SGIO.h>
 #include <shogun/distance/ManhattanMetric.h>
+#include <shogun/distance/BlockedDistanceMatrix.h>
+#include <shogun/base/Parallel.h>
 #include <shogun/features/Features.h>
 
 using namespace shogun;
@@ -70,3 +72,15 @@ float64_t CManhattanMetric::compute(int32_t idx_a, int32_t idx_b)
 
 	return result;
 }
+
+bool CManhattanMetric::compute_distance_matrix_blocked(SGMatrix<float64_t> result)
+{
+	return blocked_distance_matrix(result, lhs, rhs,
+			BLOCKED_MANHATTAN, parallel->get_num_threads());
+}
+
+bool CManhattanMetric::compute_distance_matrix_blocked(SGMatrix<float32_t> result)
+{
+	return blocked_distance_matrix(result, lhs, rhs,
+			BLOCKED_MANHATTAN, parallel->get_num_threads());
+}
@@ -45,7 +45,8 @@ float64_t CPRCEvaluation::evaluate(CLabels* predicted, CLabels* ground_truth)
 		idxs[i] = i;
 
 	// sort indexes by labels ascending
-	CMath::qsort_backward_index(labels,idxs,length);
+	CMath::parallel_sort_backward_index(labels,idxs,length,
+		parallel->get_num_threads());
 
 	// clean and initialize graph and auPRC
 	SG_FREE(labels);
@@ -54,7 +54,8 @@ float64_t CROCEvaluation::evaluate_roc(CLabels* predicted, CLabels* ground_truth
 	for(i=0; i<length; i++)
 		idxs[i] = i;
 
-	CMath::qsort_backward_index(labels,idxs.vector,idxs.vlen);
+	CMath::parallel_sort_backward_index(labels,idxs.vector,idxs.vlen,
+		parallel->get_num_threads());
 
 	// number of different predicted labels
 	int32_t diff_count=1;
@@ -118,32 +118,37 @@ template<class ST> ST* CDenseFeatures<ST>::get_feature_vector(int32_t num, int32
 
 	if (get_num_preprocessors())
 	{
-		int32_t tmp_len = len;
-		ST* tmp_feat_before = feat;
-		ST* tmp_feat_after = NULL;
-
+		// preprocessors that can work in place do so, the vectors returned by
+		// the others own their memory (which may come from an SGArena) and
+		// are released by reference counting
+		SGVector<ST> applied(feat, len, false);
 		for (int32_t i = 0; i < get_num_preprocessors(); i++)
 		{
 			CDensePreprocessor<ST>* p =
 					(CDensePreprocessor<ST>*) get_preprocessor(i);
-			// temporary hack
-			SGVector<ST> applied = p->apply_to_feature_vector(
-					SGVector<ST>(tmp_feat_before, tmp_len));
-			tmp_feat_after = applied.vector;
+			if (!p->apply_in_place(applied))
+				applied = p->apply_to_feature_vector(applied);
 			SG_UNREF(p);
-
-			if (i != 0) // delete feature vector, except for the the first one, i.e., feat
-				SG_FREE(tmp_feat_before);
-			tmp_feat_before = tmp_feat_after;
 		}
 
-		// note: tmp_feat_after should be checked as it is used by memcpy
-		if (tmp_feat_after)
+		if (applied.vector && applied.vector!=feat)
 		{
-			memcpy(feat, tmp_feat_after, sizeof(ST) * tmp_len);
-			SG_FREE(tmp_feat_after);
-
-			len = tmp_len;
+			// preprocessors may grow the dimension, which only fits if feat
+			// is not a cache entry of num_features elements
+			if (applied.vlen > len)
+			{
+				if (!dofree)
+				{
+					feature_cache->unlock_entry(real_num);
+					SG_ERROR("Preprocessed vector %d has %d features, which do "
+							"not fit into a cache entry of %d features\n", num,
+							applied.vlen, len);
+				}
+				SG_FREE(feat);
+				feat = SG_MALLOC(ST, applied.vlen);
+			}
+			memcpy(feat, applied.vector, sizeof(ST) * applied.vlen);
+			len = applied.vlen;
 		}
 	}
 	return feat;
@@ -545,6 +550,56 @@ void CDenseFeatures<float64_t>::add_to_dense_vec(float64_t alpha, int32_t vec_id
 	free_feature_vector(vec1, vec_idx1, vfree);
 }
 
+template<class ST> void CDenseFeatures<ST>::add_to_dense_vec(float32_t alpha, int32_t vec_idx1,
+		float32_t* vec2, int32_t vec2_len, bool abs_val)
+{
+	ASSERT(vec2_len == num_features)
+
+	int32_t vlen;
+	bool vfree;
+	ST* vec1 = get_feature_vector(vec_idx1, vlen, vfree);
+
+	ASSERT(vlen == num_features)
+
+	if (abs_val)
+	{
+		for (int32_t i = 0; i < num_features; i++)
+			vec2[i] += alpha * CMath::abs(vec1[i]);
+	}
+	else
+	{
+		for (int32_t i = 0; i < num_features; i++)
+			vec2[i] += alpha * vec1[i];
+	}
+
+	free_feature_vector(vec1, vec_idx1, vfree);
+}
+
+template<>
+void CDenseFeatures<float32_t>::add_to_dense_vec(float32_t alpha, int32_t vec_idx1,
+		float32_t* vec2, int32_t vec2_len, bool abs_val)
+{
+	ASSERT(vec2_len == num_features)
+
+	int32_t vlen;
+	bool vfree;
+	float32_t* vec1 = get_feature_vector(vec_idx1, vlen, vfree);
+
+	ASSERT(vlen == num_features)
+
+	if (abs_val)
+	{
+		for (int32_t i = 0; i < num_features; i++)
+			vec2[i] += alpha * CMath::abs(vec1[i]);
+	}
+	else
+	{
+		SGVector<float32_t>::vec1_plus_scalar_times_vec2(vec2, alpha, vec1, num_features);
+	}
+
+	free_feature_vector(vec1, vec_idx1, vfree);
+}
+
 template<class ST> int32_t CDenseFeatures<ST>::get_nnz_features_for_vector(int32_t num)
 {
 	return num_features;
@@ -939,6 +994,43 @@ template<> float64_t CDenseFeatures<floatmax_t>::dense_dot(
 	return result;
 }
 
+template<class ST> float32_t CDenseFeatures<ST>::dense_dot(
+		int32_t vec_idx1, const float32_t* vec2, int32_t vec2_len)
+{
+	ASSERT(vec2_len == num_features)
+
+	int32_t vlen;
+	bool vfree;
+	ST* vec1 = get_feature_vector(vec_idx1, vlen, vfree);
+
+	ASSERT(vlen == num_features)
+	float32_t result = 0;
+
+	for (int32_t i = 0; i < num_features; i++)
+		result += vec1[i] * vec2[i];
+
+	free_feature_vector(vec1, vec_idx1, vfree);
+
+	return result;
+}
+
+template<> float32_t CDenseFeatures<float32_t>::dense_dot(
+		int32_t vec_idx1, const float32_t* vec2, int32_t vec2_len)
+{
+	ASSERT(vec2_len == num_features)
+
+	int32_t vlen;
+	bool vfree;
+	float32_t* vec1 = get_feature_vector(vec_idx1, vlen, vfree);
+
+	ASSERT(vlen == num_features)
+	float32_t result = CMath::dot(vec1, vec2, num_features);
+
+	free_feature_vector(vec1, vec_idx1, vfree);
+
+	return result;
+}
+
 template<class ST> bool CDenseFeatures<ST>::is_equal(CDenseFeatures* rhs)
 {
 	if ( num_features != rhs->num_features || num_vectors != rhs->num_vectors )
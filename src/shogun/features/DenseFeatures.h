@@ -390,6 +390,31 @@ public:
 	virtual void add_to_dense_vec(float64_t alpha, int32_t vec_idx1,
 			float64_t* vec2, int32_t vec2_len, bool abs_val = false);
 
+	/** compute dot product between vector1 and a single precision dense
+	 * vector
+	 *
+	 * possible with subset
+	 *
+	 * @param vec_idx1 index of first vector
+	 * @param vec2 pointer to single precision vector
+	 * @param vec2_len length of single precision vector
+	 */
+	virtual float32_t dense_dot(int32_t vec_idx1, const float32_t* vec2,
+			int32_t vec2_len);
+
+	/** add vector 1 multiplied with alpha to single precision dense vector2
+	 *
+	 * possible with subset
+	 *
+	 * @param alpha scalar alpha
+	 * @param vec_idx1 index of first vector
+	 * @param vec2 pointer to single precision vector
+	 * @param vec2_len length of single precision vector
+	 * @param abs_val if true add the absolute value
+	 */
+	virtual void add_to_dense_vec(float32_t alpha, int32_t vec_idx1,
+			float32_t* vec2, int32_t vec2_len, bool abs_val = false);
+
 	/** get number of non-zero features in vector
 	 *
 	 * @param num which vector
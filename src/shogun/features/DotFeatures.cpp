@@ -64,6 +64,40 @@ float64_t CDotFeatures::dense_dot_sgvec(int32_t vec_idx1, SGVector<float64_t> ve
 	return dense_dot(vec_idx1, vec2.vector, vec2.vlen);
 }
 
+float32_t CDotFeatures::dense_dot(int32_t vec_idx1, const float32_t* vec2, int32_t vec2_len)
+{
+	SGVector<float64_t> vec(vec2_len);
+	for (int32_t i=0; i<vec2_len; i++)
+		vec[i]=vec2[i];
+
+	return dense_dot(vec_idx1, vec.vector, vec2_len);
+}
+
+void CDotFeatures::add_to_dense_vec(float32_t alpha, int32_t vec_idx1, float32_t* vec2, int32_t vec2_len, bool abs_val)
+{
+	SGVector<float64_t> vec(vec2_len);
+	vec.zero();
+	add_to_dense_vec(alpha, vec_idx1, vec.vector, vec2_len, abs_val);
+
+	for (int32_t i=0; i<vec2_len; i++)
+		vec2[i]+=vec[i];
+}
+
+void CDotFeatures::dense_dot_range(float64_t* output, int32_t start, int32_t stop, float64_t* alphas, float32_t* vec, int32_t dim, float64_t b)
+{
+	ASSERT(output)
+	ASSERT(start>=0)
+	ASSERT(start<stop)
+	ASSERT(stop<=get_num_vectors())
+
+	#pragma omp parallel for num_threads(parallel->get_num_threads())
+	for (int32_t i=start; i<stop; i++)
+	{
+		float64_t dot=dense_dot(i, vec, dim);
+		output[i-start]=alphas ? alphas[i]*dot+b : dot+b;
+	}
+}
+
 void CDotFeatures::dense_dot_range(float64_t* output, int32_t start, int32_t stop, float64_t* alphas, float64_t* vec, int32_t dim, float64_t b)
 {
 	ASSERT(output)
@@ -105,6 +105,33 @@ class CDotFeatures : public CFeatures
 		 */
 		virtual void add_to_dense_vec(float64_t alpha, int32_t vec_idx1, float64_t* vec2, int32_t vec2_len, bool abs_val=false)=0;
 
+		/** compute dot product between vector1 and a single precision dense
+		 * vector
+		 *
+		 * The default implementation converts vec2 to double precision and
+		 * calls the float64_t variant; features with single precision storage
+		 * override it to avoid the conversion.
+		 *
+		 * @param vec_idx1 index of first vector
+		 * @param vec2 pointer to single precision vector
+		 * @param vec2_len length of single precision vector
+		 */
+		virtual float32_t dense_dot(int32_t vec_idx1, const float32_t* vec2, int32_t vec2_len);
+
+		/** add vector 1 multiplied with alpha to single precision dense
+		 * vector2
+		 *
+		 * The default implementation goes through a double precision buffer,
+		 * see dense_dot(int32_t, const float32_t*, int32_t).
+		 *
+		 * @param alpha scalar alpha
+		 * @param vec_idx1 index of first vector
+		 * @param vec2 pointer to single precision vector
+		 * @param vec2_len length of single precision vector
+		 * @param abs_val if true add the absolute value
+		 */
+		virtual void add_to_dense_vec(float32_t alpha, int32_t vec_idx1, float32_t* vec2, int32_t vec2_len, bool abs_val=false);
+
 		/** Compute the dot product for a range of vectors. This function makes use of dense_dot
 		 * alphas[i] * sparse[i]^T * w + b
 		 *
@@ -120,6 +147,26 @@ class CDotFeatures : public CFeatures
 		 */
 		virtual void dense_dot_range(float64_t* output, int32_t start, int32_t stop, float64_t* alphas, float64_t* vec, int32_t dim, float64_t b);
 
+		/** Compute the dot product with a single precision dense vector for a
+		 * range of vectors
+		 * alphas[i] * sparse[i]^T * w + b
+		 *
+		 * The default implementation calls
+		 * dense_dot(int32_t, const float32_t*, int32_t) for every vector in
+		 * parallel; features that process ranges in batches override it.
+		 *
+		 * @param output result for the given vector range
+		 * @param start start vector range from this idx
+		 * @param stop stop vector range at this idx
+		 * @param alphas scalars to multiply with, may be NULL
+		 * @param vec single precision dense vector to compute dot product with
+		 * @param dim length of the dense vector
+		 * @param b bias
+		 *
+		 * note that the result will be written to output[0...(stop-start-1)]
+		 */
+		virtual void dense_dot_range(float64_t* output, int32_t start, int32_t stop, float64_t* alphas, float32_t* vec, int32_t dim, float64_t b);
+
 		/** Compute the dot product for a subset of vectors. This function makes use of dense_dot
 		 * alphas[i] * sparse[i]^T * w + b
 		 *
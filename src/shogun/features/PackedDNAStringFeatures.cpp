@@ -0,0 +1,308 @@
+/*
+ * Copyright (c) The Shogun Machine Learning Toolbox
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation are those
+ * of the authors and should not be interpreted as representing official policies,
+ * either expressed or implied, of the Shogun Development Team.
+ *
+ */
+
+
+#include <shogun/features/PackedDNAStringFeatures.h>
+#include <shogun/features/Alphabet.h>
+
+using namespace shogun;
+
+CPackedDNAStringFeatures::CPackedDNAStringFeatures()
+: CStringFeatures<char>(DNA)
+{
+	init();
+}
+
+CPackedDNAStringFeatures::CPackedDNAStringFeatures(SGStringList<char> strings)
+: CStringFeatures<char>(DNA)
+{
+	init();
+	pack(strings.strings, strings.num_strings);
+}
+
+CPackedDNAStringFeatures::CPackedDNAStringFeatures(CStringFeatures<char>* sf)
+: CStringFeatures<char>(DNA)
+{
+	init();
+	REQUIRE(sf, "String features must be set\n");
+
+	int32_t num_strings=sf->get_num_vectors();
+	SGString<char>* strings=SG_MALLOC(SGString<char>, num_strings);
+	bool* free_vecs=SG_MALLOC(bool, num_strings);
+	for (int32_t i=0; i<num_strings; i++)
+	{
+		int32_t len;
+		char* vec=sf->get_feature_vector(i, len, free_vecs[i]);
+		strings[i]=SGString<char>(vec, len, false);
+	}
+
+	pack(strings, num_strings);
+
+	for (int32_t i=0; i<num_strings; i++)
+		sf->free_feature_vector(strings[i].string, i, free_vecs[i]);
+	SG_FREE(free_vecs);
+	SG_FREE(strings);
+}
+
+CPackedDNAStringFeatures::CPackedDNAStringFeatures(const CPackedDNAStringFeatures& orig)
+: CStringFeatures<char>(orig)
+{
+	init();
+	m_packed=orig.m_packed;
+	m_offsets=orig.m_offsets;
+	m_lengths=orig.m_lengths;
+	m_n_mask=orig.m_n_mask;
+}
+
+CPackedDNAStringFeatures::~CPackedDNAStringFeatures()
+{
+	/* the base destructor can only handle strings it stores itself */
+	cleanup();
+}
+
+void CPackedDNAStringFeatures::init()
+{
+	/* strings are only available through compute_feature_vector */
+	enable_on_the_fly_preprocessing();
+
+	SG_ADD(&m_packed, "packed", "Packed nucleotides", MS_NOT_AVAILABLE);
+	SG_ADD(&m_offsets, "offsets", "First word of each string", MS_NOT_AVAILABLE);
+	SG_ADD(&m_lengths, "lengths", "Length of each string", MS_NOT_AVAILABLE);
+	SG_ADD(&m_n_mask, "n_mask", "Positions of ambiguous nucleotides",
+		MS_NOT_AVAILABLE);
+}
+
+void CPackedDNAStringFeatures::cleanup()
+{
+	CStringFeatures<char>::cleanup();
+
+	m_packed=SGVector<uint64_t>();
+	m_offsets=SGVector<int64_t>();
+	m_lengths=SGVector<int32_t>();
+	m_n_mask=SGVector<uint32_t>();
+	max_string_length=0;
+}
+
+void CPackedDNAStringFeatures::subset_changed_post()
+{
+	max_string_length=0;
+	for (int32_t i=0; i<get_num_vectors(); i++)
+	{
+		max_string_length=CMath::max(max_string_length,
+			m_lengths[m_subset_stack->subset_idx_conversion(i)]);
+	}
+}
+
+CFeatures* CPackedDNAStringFeatures::duplicate() const
+{
+	return new CPackedDNAStringFeatures(*this);
+}
+
+void CPackedDNAStringFeatures::pack(SGString<char>* strings, int32_t num_strings)
+{
+	cleanup();
+
+	m_offsets=SGVector<int64_t>(num_strings);
+	m_lengths=SGVector<int32_t>(num_strings);
+
+	int64_t num_words=0;
+	bool has_n=false;
+	for (int32_t i=0; i<num_strings; i++)
+	{
+		m_offsets[i]=num_words;
+		m_lengths[i]=strings[i].slen;
+		num_words+=(strings[i].slen+31)/32;
+		max_string_length=CMath::max(max_string_length, strings[i].slen);
+	}
+
+	m_packed=SGVector<uint64_t>(num_words+1);
+	m_packed.zero();
+
+	uint32_t* n_mask=SG_CALLOC(uint32_t, num_words+1);
+	for (int32_t i=0; i<num_strings; i++)
+	{
+		uint64_t* words=&m_packed.vector[m_offsets[i]];
+		uint32_t* mask=&n_mask[m_offsets[i]];
+		const char* str=strings[i].string;
+
+		for (int32_t p=0; p<strings[i].slen; p++)
+		{
+			uint64_t code=0;
+			switch (str[p])
+			{
+				case 'A': case 'a': code=0; break;
+				case 'C': case 'c': code=1; break;
+				case 'G': case 'g': code=2; break;
+				case 'T': case 't': code=3; break;
+				case 'N': case 'n':
+					mask[p>>5]|=((uint32_t) 1)<<(p&31);
+					has_n=true;
+					break;
+				default:
+					SG_FREE(n_mask);
+					SG_ERROR("Invalid nucleotide '%c' at position %d of string %d\n",
+						str[p], p, i)
+			}
+			words[p>>5]|=code<<(62-2*(p&31));
+		}
+	}
+
+	if (has_n)
+		m_n_mask=SGVector<uint32_t>(n_mask, num_words+1);
+	else
+		SG_FREE(n_mask);
+
+	num_vectors=num_strings;
+}
+
+char* CPackedDNAStringFeatures::compute_feature_vector(int32_t num, int32_t& len)
+{
+	ASSERT(num<get_num_vectors())
+
+	int32_t real_num=m_subset_stack->subset_idx_conversion(num);
+	len=m_lengths[real_num];
+	if (len<=0)
+		return NULL;
+
+	const char acgt[4]={ 'A', 'C', 'G', 'T' };
+	char* target=SG_MALLOC(char, len);
+	get_codes(num, target, 0, len);
+	for (int32_t p=0; p<len; p++)
+		target[p]=acgt[(uint8_t) target[p]];
+
+	if (m_n_mask.vlen)
+	{
+		const uint32_t* mask=&m_n_mask.vector[m_offsets[real_num]];
+		for (int32_t p=0; p<len; p++)
+		{
+			if (mask[p>>5] & (((uint32_t) 1)<<(p&31)))
+				target[p]='N';
+		}
+	}
+
+	return target;
+}
+
+char CPackedDNAStringFeatures::get_feature(int32_t vec_num, int32_t feat_num)
+{
+	ASSERT(vec_num<get_num_vectors())
+
+	int32_t real_num=m_subset_stack->subset_idx_conversion(vec_num);
+	ASSERT(feat_num>=0 && feat_num<m_lengths[real_num])
+
+	if (is_ambiguous(vec_num, feat_num))
+		return 'N';
+
+	uint8_t code;
+	get_codes(vec_num, &code, feat_num, 1);
+	return "ACGT"[code];
+}
+
+int32_t CPackedDNAStringFeatures::get_vector_length(int32_t vec_num)
+{
+	ASSERT(vec_num<get_num_vectors())
+	return m_lengths[m_subset_stack->subset_idx_conversion(vec_num)];
+}
+
+void CPackedDNAStringFeatures::get_unambiguous_lengths(int32_t num, int32_t* target)
+{
+	int32_t len=get_vector_length(num);
+	int32_t run=0;
+	for (int32_t p=len-1; p>=0; p--)
+	{
+		run=is_ambiguous(num, p) ? 0 : run+1;
+		target[p]=run;
+	}
+}
+
+SGString<char>* CPackedDNAStringFeatures::get_features(int32_t& num_str, int32_t& max_str_len)
+{
+	SG_ERROR("%s does not store char strings, use copy_features() or "
+			"get_feature_vector() instead\n", get_name())
+	return NULL;
+}
+
+void CPackedDNAStringFeatures::set_feature_vector(int32_t num, char* string, int32_t len)
+{
+	SG_ERROR("%s are read only\n", get_name())
+}
+
+CFeatures* CPackedDNAStringFeatures::copy_subset(SGVector<index_t> indices)
+{
+	CPackedDNAStringFeatures* result=new CPackedDNAStringFeatures();
+
+	int32_t num_strings=indices.vlen;
+	result->m_offsets=SGVector<int64_t>(num_strings);
+	result->m_lengths=SGVector<int32_t>(num_strings);
+
+	int64_t num_words=0;
+	for (int32_t i=0; i<num_strings; i++)
+	{
+		int32_t real_num=m_subset_stack->subset_idx_conversion(indices[i]);
+		result->m_offsets[i]=num_words;
+		result->m_lengths[i]=m_lengths[real_num];
+		num_words+=(m_lengths[real_num]+31)/32;
+		result->max_string_length=CMath::max(result->max_string_length,
+			m_lengths[real_num]);
+	}
+
+	result->m_packed=SGVector<uint64_t>(num_words+1);
+	result->m_packed.zero();
+	if (m_n_mask.vlen)
+	{
+		result->m_n_mask=SGVector<uint32_t>(num_words+1);
+		result->m_n_mask.zero();
+	}
+
+	for (int32_t i=0; i<num_strings; i++)
+	{
+		int32_t real_num=m_subset_stack->subset_idx_conversion(indices[i]);
+		int32_t words=(m_lengths[real_num]+31)/32;
+		memcpy(&result->m_packed.vector[result->m_offsets[i]],
+			&m_packed.vector[m_offsets[real_num]], words*sizeof(uint64_t));
+		if (m_n_mask.vlen)
+		{
+			memcpy(&result->m_n_mask.vector[result->m_offsets[i]],
+				&m_n_mask.vector[m_offsets[real_num]], words*sizeof(uint32_t));
+		}
+	}
+
+	/* the selected strings may not contain any 'N' */
+	bool has_n=false;
+	for (int32_t i=0; i<result->m_n_mask.vlen && !has_n; i++)
+		has_n=result->m_n_mask[i]!=0;
+	if (!has_n)
+		result->m_n_mask=SGVector<uint32_t>();
+
+	result->num_vectors=num_strings;
+	SG_REF(result);
+
+	return result;
+}
@@ -0,0 +1,364 @@
+/*
+ * Copyright (c) The Shogun Machine Learning Toolbox
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation are those
+ * of the authors and should not be interpreted as representing official policies,
+ * either expressed or implied, of the Shogun Development Team.
+ *
+ */
+
+
+#ifndef _PACKEDDNASTRINGFEATURES__H__
+#define _PACKEDDNASTRINGFEATURES__H__
+
+#include <shogun/lib/config.h>
+
+#include <shogun/lib/common.h>
+#include <shogun/lib/SGVector.h>
+#include <shogun/lib/SGStringList.h>
+#include <shogun/features/StringFeatures.h>
+
+namespace shogun
+{
+
+/** @brief DNA string features stored with 2 bits per nucleotide.
+ *
+ * Nucleotides are stored as their CAlphabet DNA codes (A=0, C=1, G=2, T=3),
+ * 32 per 64 bit word with the first nucleotide in the most significant bits.
+ * Each string starts at a word boundary. Ambiguous nucleotides ('N') are
+ * stored as 'A' and marked in a separate bit mask, so that unpacking gives
+ * back the original string.
+ *
+ * The class is a CStringFeatures<char>: get_feature_vector() unpacks a
+ * string on the fly, so that all char based string kernels work unchanged.
+ * Consumers that only need DNA codes (CWeightedDegreeStringKernel,
+ * CHashedWDFeatures, CStringFeatures::obtain_from_packed_dna) read them with
+ * get_codes() and get_kmers(), where a k-mer is cut out of at most two words
+ * with shifts instead of being assembled symbol by symbol. Both read 'N' as
+ * 'A'; get_unambiguous_lengths() and the flags of get_kmers() tell which
+ * positions and k-mers overlap an 'N'.
+ *
+ * No char strings are stored, so get_features() cannot hand out the
+ * internal strings (use copy_features() instead) and methods that modify
+ * the strings in place (set_feature_vector(), append_features(),
+ * obtain_by_sliding_window(), ...) are not supported.
+ */
+class CPackedDNAStringFeatures : public CStringFeatures<char>
+{
+	public:
+		/** default constructor */
+		CPackedDNAStringFeatures();
+
+		/** constructor
+		 *
+		 * @param strings DNA strings (ACGTN, case insensitive)
+		 */
+		CPackedDNAStringFeatures(SGStringList<char> strings);
+
+		/** constructor
+		 *
+		 * @param sf char string features with DNA strings (ACGTN,
+		 * case insensitive) to be packed
+		 */
+		CPackedDNAStringFeatures(CStringFeatures<char>* sf);
+
+		/** copy constructor */
+		CPackedDNAStringFeatures(const CPackedDNAStringFeatures& orig);
+
+		/** destructor */
+		virtual ~CPackedDNAStringFeatures();
+
+		/** cleanup packed strings */
+		virtual void cleanup();
+
+		/** post method when subset is changed, the maximum string length is
+		 * determined from the packed lengths */
+		virtual void subset_changed_post();
+
+		/** duplicate feature object
+		 *
+		 * @return feature object
+		 */
+		virtual CFeatures* duplicate() const;
+
+		/** get feature
+		 *
+		 * possible with subset
+		 *
+		 * @param vec_num which vector
+		 * @param feat_num which feature
+		 * @return feature
+		 */
+		virtual char get_feature(int32_t vec_num, int32_t feat_num);
+
+		/** get vector length
+		 *
+		 * possible with subset
+		 *
+		 * @param vec_num which vector
+		 * @return length of vector
+		 */
+		virtual int32_t get_vector_length(int32_t vec_num);
+
+		/** not supported, the strings are not stored as chars
+		 *
+		 * @param num_str number of strings
+		 * @param max_str_len maximal string length
+		 * @return nothing, raises an error
+		 */
+		virtual SGString<char>* get_features(int32_t& num_str, int32_t& max_str_len);
+
+		/** not supported, packed strings are read only
+		 *
+		 * @param num index of string
+		 * @param string new string
+		 * @param len length of string
+		 */
+		virtual void set_feature_vector(int32_t num, char* string, int32_t len);
+
+		/** create a new packed object from a subset of this one, the
+		 * packed words are copied without unpacking
+		 *
+		 * possible with subset
+		 *
+		 * @param indices indices of strings to copy
+		 * @return new CPackedDNAStringFeatures instance
+		 */
+		virtual CFeatures* copy_subset(SGVector<index_t> indices);
+
+		/** check whether ambiguous nucleotides ('N') are stored
+		 *
+		 * @return if any string contains 'N'
+		 */
+		inline bool has_ambiguous_nucleotides() const { return m_n_mask.vlen>0; }
+
+		/** get number of 64 bit words used for the packed strings
+		 *
+		 * @return number of words
+		 */
+		inline int64_t get_num_words() const { return m_packed.vlen; }
+
+		/** get the packed words of a string, 32 nucleotides per word
+		 * with the first one in the most significant bits
+		 *
+		 * possible with subset
+		 *
+		 * @param num index of the string
+		 * @param len length of the string in nucleotides
+		 * @return words, see get_packed_code()
+		 */
+		inline const uint64_t* get_packed_words(int32_t num, int32_t& len)
+		{
+			int32_t real_num=m_subset_stack->subset_idx_conversion(num);
+			len=m_lengths[real_num];
+			return &m_packed.vector[m_offsets[real_num]];
+		}
+
+		/** get the DNA code (0-3) at a position of packed words
+		 *
+		 * @param words words of a string, see get_packed_words()
+		 * @param pos position in the string
+		 * @return code, 'N' gives the code of 'A'
+		 */
+		static inline uint8_t get_packed_code(const uint64_t* words, int32_t pos)
+		{
+			return (uint8_t) ((words[pos>>5]>>(62-2*(pos&31))) & 3);
+		}
+
+		/** get DNA codes (0-3) of a string, 'N' gives the code of 'A'
+		 *
+		 * possible with subset
+		 *
+		 * @param num index of the string
+		 * @param target array of at least len elements
+		 * @param start first position
+		 * @param len number of codes, must not exceed the string end
+		 */
+		template <class T>
+		void get_codes(int32_t num, T* target, int32_t start, int32_t len)
+		{
+			int32_t real_num=m_subset_stack->subset_idx_conversion(num);
+			REQUIRE(start>=0 && start+len<=m_lengths[real_num],
+				"Positions %d to %d exceed the length (%d) of string %d\n",
+				start, start+len, m_lengths[real_num], num);
+
+			const uint64_t* words=&m_packed.vector[m_offsets[real_num]];
+			int32_t p=start;
+			int32_t end=start+len;
+			while (p<end)
+			{
+				uint64_t w=words[p>>5]<<(2*(p&31));
+				int32_t stop=CMath::min(end, (p|31)+1);
+				for (; p<stop; p++)
+				{
+					*target++=(T) (w>>62);
+					w<<=2;
+				}
+			}
+		}
+
+		/** check whether a position holds an ambiguous nucleotide ('N')
+		 *
+		 * possible with subset
+		 *
+		 * @param num index of the string
+		 * @param pos position in the string
+		 * @return if the nucleotide at pos is 'N'
+		 */
+		inline bool is_ambiguous(int32_t num, int32_t pos)
+		{
+			if (!m_n_mask.vlen)
+				return false;
+
+			int32_t real_num=m_subset_stack->subset_idx_conversion(num);
+			return (m_n_mask[m_offsets[real_num]+(pos>>5)] &
+				(((uint32_t) 1)<<(pos&31)))!=0;
+		}
+
+		/** get for each position of a string the number of nucleotides up
+		 * to the next 'N' (or the end of the string), i.e. the length of
+		 * the longest k-mer starting there that does not overlap an 'N'
+		 *
+		 * possible with subset
+		 *
+		 * @param num index of the string
+		 * @param target array of at least get_vector_length(num) elements
+		 */
+		void get_unambiguous_lengths(int32_t num, int32_t* target);
+
+		/** get all k-mers of a string as integers
+		 *
+		 * The k-mer starting at position i is written to target[i], with the
+		 * first nucleotide in the most significant bits (like
+		 * CStringFeatures::obtain_from_char with start=k-1). 'N' is read as
+		 * 'A', if ambiguous is given, ambiguous[i] tells whether the k-mer
+		 * starting at position i overlaps an 'N'.
+		 *
+		 * possible with subset
+		 *
+		 * @param num index of the string
+		 * @param k length of the k-mers, at most 32 and 4*sizeof(ST)
+		 * @param target array of at least get_vector_length(num)-k+1 elements
+		 * @param ambiguous NULL or array of as many elements as target
+		 * @return number of k-mers written
+		 */
+		template <class ST>
+		int32_t get_kmers(int32_t num, int32_t k, ST* target, bool* ambiguous=NULL)
+		{
+			int32_t real_num=m_subset_stack->subset_idx_conversion(num);
+			int32_t num_kmers=CMath::max(m_lengths[real_num]-k+1, 0);
+			get_kmer_range(num, k, target, 0, num_kmers);
+
+			if (ambiguous && num_kmers>0)
+			{
+				/* nearest 'N' at or after each position, walking backwards */
+				int32_t next_n=m_lengths[real_num];
+				for (int32_t p=m_lengths[real_num]-1; p>=0; p--)
+				{
+					if (is_ambiguous(num, p))
+						next_n=p;
+					if (p<num_kmers)
+						ambiguous[p]=next_n<p+k;
+				}
+			}
+
+			return num_kmers;
+		}
+
+		/** get the k-mers starting at positions first to first+count-1 of a
+		 * string, read from the packed words, see get_kmers()
+		 *
+		 * possible with subset
+		 *
+		 * @param num index of the string
+		 * @param k length of the k-mers, at most 32 and 4*sizeof(ST)
+		 * @param target array of at least count elements
+		 * @param first position of the first k-mer
+		 * @param count number of k-mers, the last must end in the string
+		 */
+		template <class ST>
+		void get_kmer_range(int32_t num, int32_t k, ST* target, int32_t first,
+				int32_t count)
+		{
+			REQUIRE(k>0 && k<=32 && k<=(int32_t) (4*sizeof(ST)),
+				"k (%d) must be in 1..%d\n", k, CMath::min(32, (int32_t) (4*sizeof(ST))));
+
+			int32_t real_num=m_subset_stack->subset_idx_conversion(num);
+			REQUIRE(first>=0 && (count<=0 || first+count+k-1<=m_lengths[real_num]),
+				"k-mers %d to %d exceed the length (%d) of string %d\n",
+				first, first+count-1, m_lengths[real_num], num);
+
+			const uint64_t* words=&m_packed.vector[m_offsets[real_num]];
+			int32_t shift=64-2*k;
+
+			for (int32_t i=first; i<first+count; i++)
+			{
+				int32_t q=i>>5;
+				int32_t r=2*(i&31);
+				uint64_t w=words[q]<<r;
+				if (r)
+					w|=words[q+1]>>(64-r);
+				*target++=(ST) (w>>shift);
+			}
+		}
+
+		/** @return object name */
+		virtual const char* get_name() const { return "PackedDNAStringFeatures"; }
+
+	protected:
+		/** unpack a string into chars
+		 *
+		 * @param num which vector
+		 * @param len length of vector
+		 * @return unpacked string
+		 */
+		virtual char* compute_feature_vector(int32_t num, int32_t& len);
+
+		/** pack strings
+		 *
+		 * @param strings strings to pack
+		 * @param num_strings number of strings
+		 */
+		void pack(SGString<char>* strings, int32_t num_strings);
+
+	private:
+		/** init */
+		void init();
+
+	protected:
+		/** packed nucleotides, one padding word at the end */
+		SGVector<uint64_t> m_packed;
+
+		/** first word of each string */
+		SGVector<int64_t> m_offsets;
+
+		/** length of each string */
+		SGVector<int32_t> m_lengths;
+
+		/** one bit per nucleotide marking 'N', per word of m_packed,
+		 * empty if there is no 'N' */
+		SGVector<uint32_t> m_n_mask;
+};
+}
+#endif // _PACKEDDNASTRINGFEATURES__H__
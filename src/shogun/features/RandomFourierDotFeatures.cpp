@@ -11,22 +11,47 @@
 #include <shogun/base/Parameter.h>
 #include <shogun/mathematics/Math.h>
 #include <shogun/features/RandomFourierDotFeatures.h>
+#include <shogun/mathematics/eigen3.h>
+
+using namespace Eigen;
 
 namespace shogun {
 
 enum KernelName;
 
+/** in-place unnormalized Walsh-Hadamard transform of n=2^k values */
+static void walsh_hadamard_transform(float64_t* x, int32_t n)
+{
+	for (int32_t h=1; h<n; h*=2)
+	{
+		for (int32_t i=0; i<n; i+=2*h)
+		{
+			for (int32_t j=i; j<i+h; j++)
+			{
+				float64_t a=x[j];
+				float64_t b=x[j+h];
+				x[j]=a+b;
+				x[j+h]=a-b;
+			}
+		}
+	}
+}
+
 CRandomFourierDotFeatures::CRandomFourierDotFeatures()
 {
-	init(NOT_SPECIFIED, SGVector<float64_t>());
+	init(NOT_SPECIFIED, SGVector<float64_t>(), RFP_DENSE);
 }
 
 CRandomFourierDotFeatures::CRandomFourierDotFeatures(CDotFeatures* features,
-	int32_t D, KernelName kernel_name, SGVector<float64_t> params)
+	int32_t D, KernelName kernel_name, SGVector<float64_t> params,
+	ERFProjection projection)
 : CRandomKitchenSinksDotFeatures(features, D)
 {
-	init(kernel_name, params);
-	random_coeff = generate_random_coefficients();
+	init(kernel_name, params, projection);
+	if (m_projection==RFP_FASTFOOD)
+		generate_fastfood_coefficients();
+	else
+		random_coeff = generate_random_coefficients();
 }
 
 CRandomFourierDotFeatures::CRandomFourierDotFeatures(CDotFeatures* features,
@@ -34,7 +59,7 @@ CRandomFourierDotFeatures::CRandomFourierDotFeatures(CDotFeatures* features,
 	SGMatrix<float64_t> coeff)
 : CRandomKitchenSinksDotFeatures(features, D, coeff)
 {
-	init(kernel_name, params);
+	init(kernel_name, params, RFP_DENSE);
 }
 
 CRandomFourierDotFeatures::CRandomFourierDotFeatures(CFile* loader)
@@ -45,17 +70,25 @@ CRandomFourierDotFeatures::CRandomFourierDotFeatures(CFile* loader)
 CRandomFourierDotFeatures::CRandomFourierDotFeatures(const CRandomFourierDotFeatures& orig)
 : CRandomKitchenSinksDotFeatures(orig)
 {
-	init(orig.kernel, orig.kernel_params);
+	init(orig.kernel, orig.kernel_params, orig.m_projection);
+	m_ff_dim = orig.m_ff_dim;
+	m_ff_signs = orig.m_ff_signs;
+	m_ff_perm = orig.m_ff_perm;
+	m_ff_gauss = orig.m_ff_gauss;
+	m_ff_scale = orig.m_ff_scale;
 }
 
 CRandomFourierDotFeatures::~CRandomFourierDotFeatures()
 {
 }
 
-void CRandomFourierDotFeatures::init(KernelName kernel_name, SGVector<float64_t> params)
+void CRandomFourierDotFeatures::init(KernelName kernel_name, SGVector<float64_t> params,
+	ERFProjection projection)
 {
 	kernel = kernel_name;
 	kernel_params = params;
+	m_projection = projection;
+	m_ff_dim = 0;
 
 	constant = num_samples>0 ? CMath::sqrt(2.0 / num_samples) : 1;
 	m_parameters->add(&kernel_params, "kernel_params",
@@ -64,6 +97,14 @@ void CRandomFourierDotFeatures::init(KernelName kernel_name, SGVector<float64_t>
 			"The kernel to approximate", MS_NOT_AVAILABLE);
 	SG_ADD(&constant, "constant", "A constant needed",
 			MS_NOT_AVAILABLE);
+	SG_ADD((machine_int_t* ) &m_projection, "projection",
+			"How the random projections are computed", MS_NOT_AVAILABLE);
+	SG_ADD(&m_ff_dim, "ff_dim", "Padded input dimension of fastfood",
+			MS_NOT_AVAILABLE);
+	m_parameters->add(&m_ff_signs, "ff_signs", "Random signs of fastfood");
+	m_parameters->add(&m_ff_perm, "ff_perm", "Random permutations of fastfood");
+	m_parameters->add(&m_ff_gauss, "ff_gauss", "Gaussian diagonals of fastfood");
+	m_parameters->add(&m_ff_scale, "ff_scale", "Scaling diagonals of fastfood");
 }
 
 CFeatures* CRandomFourierDotFeatures::duplicate() const
@@ -76,12 +117,147 @@ const char* CRandomFourierDotFeatures::get_name() const
 	return "RandomFourierDotFeatures";
 }
 
+ERFProjection CRandomFourierDotFeatures::get_projection() const
+{
+	return m_projection;
+}
+
 float64_t CRandomFourierDotFeatures::post_dot(float64_t dot_result, index_t par_idx)
 {
 	dot_result += random_coeff(random_coeff.num_rows-1, par_idx);
 	return CMath::cos(dot_result) * constant;
 }
 
+void CRandomFourierDotFeatures::post_dot_block(SGMatrix<float64_t> projected)
+{
+	Map<MatrixXd> z(projected.matrix, projected.num_rows, projected.num_cols);
+	Map<VectorXd, 0, InnerStride<> > b(random_coeff.matrix+random_coeff.num_rows-1,
+		num_samples, InnerStride<>(random_coeff.num_rows));
+
+	z.colwise() += b;
+	z = z.array().cos()*constant;
+}
+
+float64_t CRandomFourierDotFeatures::dot(index_t vec_idx, index_t par_idx)
+{
+	if (m_projection==RFP_DENSE)
+		return CRandomKitchenSinksDotFeatures::dot(vec_idx, par_idx);
+
+	int32_t dim = feats->get_dim_feature_space();
+	SGVector<float64_t> input(dim);
+	SGVector<float64_t> projected(num_samples);
+	SGVector<float64_t> buffer(2*m_ff_dim);
+
+	input.zero();
+	feats->add_to_dense_vec(1.0, vec_idx, input.vector, dim);
+	fastfood_project(input.vector, projected.vector, buffer.vector);
+	return projected[par_idx];
+}
+
+void CRandomFourierDotFeatures::project_block(SGMatrix<float64_t> inputs,
+	SGMatrix<float64_t> projected)
+{
+	if (m_projection==RFP_DENSE)
+	{
+		CRandomKitchenSinksDotFeatures::project_block(inputs, projected);
+		return;
+	}
+
+	SGVector<float64_t> buffer(2*m_ff_dim);
+	for (index_t j=0; j<inputs.num_cols; j++)
+	{
+		fastfood_project(inputs.get_column_vector(j),
+			projected.get_column_vector(j), buffer.vector);
+	}
+}
+
+void CRandomFourierDotFeatures::transform_vector(int32_t vec_idx, float64_t* result)
+{
+	if (m_projection==RFP_DENSE)
+	{
+		CRandomKitchenSinksDotFeatures::transform_vector(vec_idx, result);
+		return;
+	}
+
+	SGMatrix<float64_t> input(feats->get_dim_feature_space(), 1);
+	transform_block(NULL, vec_idx, 1, input,
+		SGMatrix<float64_t>(result, num_samples, 1, false));
+}
+
+void CRandomFourierDotFeatures::fastfood_project(const float64_t* input,
+	float64_t* projected, float64_t* buffer)
+{
+	int32_t dim = feats->get_dim_feature_space();
+	float64_t* hb = buffer;
+	float64_t* hgphb = buffer+m_ff_dim;
+
+	for (index_t s=0; s<m_ff_signs.num_cols; s++)
+	{
+		for (index_t i=0; i<dim; i++)
+			hb[i] = input[i]*m_ff_signs(i,s);
+		for (index_t i=dim; i<m_ff_dim; i++)
+			hb[i] = 0;
+		walsh_hadamard_transform(hb, m_ff_dim);
+
+		for (index_t i=0; i<m_ff_dim; i++)
+			hgphb[i] = hb[m_ff_perm(i,s)]*m_ff_gauss(i,s);
+		walsh_hadamard_transform(hgphb, m_ff_dim);
+
+		index_t offset = s*m_ff_dim;
+		index_t num = CMath::min(m_ff_dim, num_samples-offset);
+		for (index_t i=0; i<num; i++)
+			projected[offset+i] = hgphb[i]*m_ff_scale(i,s);
+	}
+}
+
+void CRandomFourierDotFeatures::generate_fastfood_coefficients()
+{
+	REQUIRE(kernel==GAUSSIAN, "Fastfood projections only support the GAUSSIAN kernel\n");
+
+	int32_t dim = feats->get_dim_feature_space();
+	m_ff_dim = 1;
+	while (m_ff_dim<dim)
+		m_ff_dim *= 2;
+
+	int32_t num_stacks = (num_samples+m_ff_dim-1)/m_ff_dim;
+	m_ff_signs = SGMatrix<float64_t>(m_ff_dim, num_stacks);
+	m_ff_perm = SGMatrix<int32_t>(m_ff_dim, num_stacks);
+	m_ff_gauss = SGMatrix<float64_t>(m_ff_dim, num_stacks);
+	m_ff_scale = SGMatrix<float64_t>(m_ff_dim, num_stacks);
+
+	// rows of H G P H B have norm sqrt(d)*|G|, S rescales them to the
+	// chi distributed norms of gaussian vectors with variance 2/width
+	float64_t width_scale = CMath::sqrt(2.0/kernel_params[0]);
+	SGVector<int32_t> perm(m_ff_dim);
+	for (index_t s=0; s<num_stacks; s++)
+	{
+		float64_t gauss_norm = 0;
+		for (index_t i=0; i<m_ff_dim; i++)
+		{
+			m_ff_signs(i,s) = CMath::random(0, 1) ? 1.0 : -1.0;
+			m_ff_gauss(i,s) = CMath::normal_random(0.0, 1);
+			gauss_norm += m_ff_gauss(i,s)*m_ff_gauss(i,s);
+		}
+
+		perm.range_fill();
+		CMath::permute(perm);
+		memcpy(m_ff_perm.get_column_vector(s), perm.vector, sizeof(int32_t)*m_ff_dim);
+
+		for (index_t i=0; i<m_ff_dim; i++)
+		{
+			float64_t chi = 0;
+			for (index_t k=0; k<m_ff_dim; k++)
+				chi += CMath::sq(CMath::normal_random(0.0, 1));
+
+			m_ff_scale(i,s) = width_scale*CMath::sqrt(chi/(m_ff_dim*gauss_norm));
+		}
+	}
+
+	random_coeff = SGMatrix<float64_t>(1, num_samples);
+	for (index_t i=0; i<num_samples; i++)
+		random_coeff(0,i) = CMath::random(0.0, 2 * CMath::PI);
+}
+
 SGVector<float64_t> CRandomFourierDotFeatures::generate_random_parameter_vector()
 {
 	SGVector<float64_t> vec(feats->get_dim_feature_space()+1);
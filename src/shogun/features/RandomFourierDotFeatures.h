@@ -35,6 +35,18 @@ enum KernelName
 	NOT_SPECIFIED
 };
 
+/** how the random projections \f$w^{\top}x\f$ are computed */
+enum ERFProjection
+{
+	/** dense gaussian matrix, O(D d) per vector */
+	RFP_DENSE,
+
+	/** structured fastfood projection built from Walsh-Hadamard transforms
+	 * and diagonal matrices, O(D log d) per vector (supports GAUSSIAN only)
+	 */
+	RFP_FASTFOOD
+};
+
 /** @brief This class implements the random fourier features for the DotFeatures
  *  framework.
  *  Basically upon the object creation it computes the random coefficients, namely w and b,
@@ -42,8 +54,16 @@ enum KernelName
  *  based on the following formula z(x) = sqrt(2/D) * cos(w'*x + b), where D is the number
  *  of samples that are used.
  *
- *  For more detailed information you can take a look at this source:
+ *  With RFP_FASTFOOD, the gaussian matrix of the w is replaced by stacks of
+ *  \f$S H G \Pi H B\f$, where H is the Walsh-Hadamard transform of the input
+ *  zero-padded to a power of two, B, G and S are random diagonal matrices and
+ *  \f$\Pi\f$ is a random permutation. Only the offsets b are then stored in
+ *  the random coefficients.
+ *
+ *  For more detailed information you can take a look at these sources:
  *  i) Random Features for Large-Scale Kernel Machines - Ali Rahimi and Ben Recht
+ *  ii) Fastfood - Approximating Kernel Expansions in Loglinear Time - Quoc Le,
+ *  Tamas Sarlos and Alex Smola
  */
 class CRandomFourierDotFeatures : public CRandomKitchenSinksDotFeatures
 {
@@ -59,9 +79,10 @@ public:
 	 * @param D the number of random fourier samples to draw / dimensionality of new feature space
 	 * @param kernel_name the name of the kernel to approximate
 	 * @param params kernel parameters (see kernel's description in KernelName to see what each kernel expects)
+	 * @param projection how to compute the random projections
 	 */
 	CRandomFourierDotFeatures(CDotFeatures* features, int32_t D, KernelName kernel_name,
-			SGVector<float64_t> params);
+			SGVector<float64_t> params, ERFProjection projection=RFP_DENSE);
 
 	/** constructor that uses the specified random coefficients.
 	 *
@@ -92,7 +113,41 @@ public:
 	/** @return object name */
 	virtual const char* get_name() const;
 
+	/** @return how the random projections are computed */
+	ERFProjection get_projection() const;
+
+	using CRandomKitchenSinksDotFeatures::dot;
+
 protected:
+	/** dot product between a feature vector and a parameter vector
+	 *
+	 * @param vec_idx the feature vector index
+	 * @param par_idx the parameter vector index
+	 */
+	virtual float64_t dot(index_t vec_idx, index_t par_idx);
+
+	/** project a block of input vectors, densely or with fastfood
+	 *
+	 * @param inputs dense input vectors in the columns
+	 * @param projected num_samples x inputs.num_cols matrix receiving the
+	 * dot products
+	 */
+	virtual void project_block(SGMatrix<float64_t> inputs,
+			SGMatrix<float64_t> projected);
+
+	/** add the offsets and take the scaled cosine of a whole block
+	 *
+	 * @param projected num_samples x n matrix of dot results, modified in place
+	 */
+	virtual void post_dot_block(SGMatrix<float64_t> projected);
+
+	/** compute one transformed vector
+	 *
+	 * @param vec_idx the feature vector index
+	 * @param result num_samples values receiving the transformed vector
+	 */
+	virtual void transform_vector(int32_t vec_idx, float64_t* result);
+
 
 	/** subclass must override this to perform any operations
 	 * on the dot result between a feature vector and a parameter vector w
@@ -110,7 +165,22 @@ protected:
 	virtual SGVector<float64_t> generate_random_parameter_vector();
 
 private:
-	void init(KernelName kernel_name, SGVector<float64_t> params);
+	void init(KernelName kernel_name, SGVector<float64_t> params,
+			ERFProjection projection);
+
+	/** draw the diagonal matrices and permutations of the fastfood stacks
+	 * and the offsets b
+	 */
+	void generate_fastfood_coefficients();
+
+	/** project one input vector with the fastfood stacks
+	 *
+	 * @param input vector of the input dimension
+	 * @param projected num_samples values receiving the projections
+	 * @param buffer 2*m_ff_dim values of scratch space
+	 */
+	void fastfood_project(const float64_t* input, float64_t* projected,
+			float64_t* buffer);
 
 private:
 	/** the kernel to approximate */
@@ -121,6 +191,26 @@ private:
 
 	/** norm const */
 	float64_t constant;
+
+	/** how the random projections are computed */
+	ERFProjection m_projection;
+
+	/** input dimension padded to a power of two, for fastfood */
+	int32_t m_ff_dim;
+
+	/** random signs B of the fastfood stacks, one column per stack */
+	SGMatrix<float64_t> m_ff_signs;
+
+	/** random permutations of the fastfood stacks, one column per stack */
+	SGMatrix<int32_t> m_ff_perm;
+
+	/** gaussian diagonals G of the fastfood stacks, one column per stack */
+	SGMatrix<float64_t> m_ff_gauss;
+
+	/** scaling diagonals S of the fastfood stacks, including the kernel
+	 * width and the normalization of the transforms
+	 */
+	SGMatrix<float64_t> m_ff_scale;
 };
 }
 
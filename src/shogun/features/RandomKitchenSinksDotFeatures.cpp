@@ -10,11 +10,17 @@
 
 #include <shogun/features/RandomKitchenSinksDotFeatures.h>
 #include <shogun/features/DenseFeatures.h>
+#include <shogun/mathematics/eigen3.h>
 #include <typeinfo>
 
+using namespace Eigen;
+
 namespace shogun
 {
 
+/** number of vectors transformed at once */
+static const int32_t RKS_BLOCK_SIZE=256;
+
 class CRKSFunctions;
 
 CRandomKitchenSinksDotFeatures::CRandomKitchenSinksDotFeatures()
@@ -66,6 +72,7 @@ CRandomKitchenSinksDotFeatures::CRandomKitchenSinksDotFeatures(
 
 CRandomKitchenSinksDotFeatures::~CRandomKitchenSinksDotFeatures()
 {
+	set_cache_transformed(false);
 	SG_UNREF(feats);
 }
 
@@ -94,16 +101,15 @@ float64_t CRandomKitchenSinksDotFeatures::dot(int32_t vec_idx1, CDotFeatures* df
 	CRandomKitchenSinksDotFeatures* other = (CRandomKitchenSinksDotFeatures* ) df;
 	ASSERT(get_dim_feature_space()==other->get_dim_feature_space());
 
+	SGVector<float64_t> buffer_1(num_samples);
+	SGVector<float64_t> buffer_2(num_samples);
+	const float64_t* vec1 = get_transformed_vector(vec_idx1, buffer_1.vector);
+	const float64_t* vec2 = other->get_transformed_vector(vec_idx2, buffer_2.vector);
+
 	float64_t dot_product = 0;
 	for (index_t i=0; i<num_samples; i++)
-	{
-		float64_t tmp_dot_1 = dot(vec_idx1, i);
-		float64_t tmp_dot_2 = other->dot(vec_idx2, i);
+		dot_product += vec1[i] * vec2[i];
 
-		tmp_dot_1 = post_dot(tmp_dot_1, i);
-		tmp_dot_2 = other->post_dot(tmp_dot_2, i);
-		dot_product += tmp_dot_1 * tmp_dot_2;
-	}
 	return dot_product;
 }
 
@@ -113,13 +119,13 @@ float64_t CRandomKitchenSinksDotFeatures::dense_dot(
 	SG_DEBUG("entering dense_dot()\n");
 	ASSERT(vec2_len == get_dim_feature_space());
 
+	SGVector<float64_t> buffer(num_samples);
+	const float64_t* vec1 = get_transformed_vector(vec_idx1, buffer.vector);
+
 	float64_t dot_product = 0;
 	for (index_t i=0; i<num_samples; i++)
-	{
-		float64_t tmp_dot = dot(vec_idx1, i);
-		tmp_dot = post_dot(tmp_dot, i);
-		dot_product += tmp_dot * vec2[i];
-	}
+		dot_product += vec1[i] * vec2[i];
+
 	SG_DEBUG("Leaving dense_dot()\n");
 	return dot_product;
 }
@@ -130,18 +136,114 @@ void CRandomKitchenSinksDotFeatures::add_to_dense_vec(float64_t alpha,
 	SG_DEBUG("Entering add_to_dense()\n");
 	ASSERT(vec2_len == get_dim_feature_space());
 
+	SGVector<float64_t> buffer(num_samples);
+	const float64_t* vec1 = get_transformed_vector(vec_idx1, buffer.vector);
+
 	for (index_t i=0; i<num_samples; i++)
 	{
-		float64_t tmp_dot = dot(vec_idx1, i);
-		tmp_dot = post_dot(tmp_dot, i);
 		if (abs_val)
-			vec2[i] += CMath::abs(alpha * tmp_dot);
+			vec2[i] += CMath::abs(alpha * vec1[i]);
 		else
-			vec2[i] += alpha * tmp_dot;
+			vec2[i] += alpha * vec1[i];
 	}
 	SG_DEBUG("Leaving add_to_dense()\n");
 }
 
+void CRandomKitchenSinksDotFeatures::dense_dot_range(float64_t* output,
+	int32_t start, int32_t stop, float64_t* alphas, float64_t* vec,
+	int32_t dim, float64_t b)
+{
+	ASSERT(output)
+	ASSERT(start>=0)
+	ASSERT(start<stop)
+	ASSERT(stop<=get_num_vectors())
+	ASSERT(dim==get_dim_feature_space())
+
+	dense_dot_blocks(NULL, start, stop-start, output, alphas, vec, b);
+}
+
+void CRandomKitchenSinksDotFeatures::dense_dot_range(float64_t* output,
+	int32_t start, int32_t stop, float64_t* alphas, float32_t* vec,
+	int32_t dim, float64_t b)
+{
+	ASSERT(output)
+	ASSERT(start>=0)
+	ASSERT(start<stop)
+	ASSERT(stop<=get_num_vectors())
+	ASSERT(dim==get_dim_feature_space())
+
+	// the transformed vectors are double precision, so is the product
+	SGVector<float64_t> vec64(dim);
+	for (index_t i=0; i<dim; i++)
+		vec64[i] = vec[i];
+
+	dense_dot_blocks(NULL, start, stop-start, output, alphas, vec64.vector, b);
+}
+
+void CRandomKitchenSinksDotFeatures::dense_dot_range_subset(int32_t* sub_index,
+	int32_t num, float64_t* output, float64_t* alphas, float64_t* vec,
+	int32_t dim, float64_t b)
+{
+	ASSERT(sub_index)
+	ASSERT(output)
+	ASSERT(dim==get_dim_feature_space())
+
+	dense_dot_blocks(sub_index, 0, num, output, alphas, vec, b);
+}
+
+void CRandomKitchenSinksDotFeatures::dense_dot_blocks(int32_t* sub_index,
+	int32_t start, int32_t num, float64_t* output, float64_t* alphas,
+	float64_t* vec, float64_t b)
+{
+	int32_t dim = feats->get_dim_feature_space();
+	int32_t num_blocks = (num+RKS_BLOCK_SIZE-1)/RKS_BLOCK_SIZE;
+	Map<VectorXd> w(vec, num_samples);
+
+	#pragma omp parallel num_threads(parallel->get_num_threads())
+	{
+		SGMatrix<float64_t> inputs;
+		SGMatrix<float64_t> block;
+		if (!m_transformed.matrix)
+		{
+			inputs = SGMatrix<float64_t>(dim, RKS_BLOCK_SIZE);
+			block = SGMatrix<float64_t>(num_samples, RKS_BLOCK_SIZE);
+		}
+
+		#pragma omp for schedule(dynamic)
+		for (int32_t k=0; k<num_blocks; k++)
+		{
+			int32_t first = k*RKS_BLOCK_SIZE;
+			int32_t n = CMath::min(RKS_BLOCK_SIZE, num-first);
+
+			if (m_transformed.matrix)
+			{
+				for (int32_t j=0; j<n; j++)
+				{
+					int32_t idx = sub_index ? sub_index[start+first+j] : start+first+j;
+					output[first+j] = CMath::dot(
+						m_transformed.get_column_vector(idx), vec, num_samples);
+				}
+			}
+			else
+			{
+				transform_block(sub_index, start+first, n, inputs, block);
+				Map<MatrixXd> z(block.matrix, num_samples, n);
+				Map<VectorXd> out(output+first, n);
+				out.noalias() = z.transpose()*w;
+			}
+
+			for (int32_t j=0; j<n; j++)
+			{
+				int32_t idx = sub_index ? sub_index[start+first+j] : start+first+j;
+				if (alphas)
+					output[first+j] = alphas[idx]*output[first+j]+b;
+				else
+					output[first+j] += b;
+			}
+		}
+	}
+}
+
 int32_t CRandomKitchenSinksDotFeatures::get_nnz_features_for_vector(int32_t num)
 {
 	return num_samples;
@@ -180,6 +282,122 @@ int32_t CRandomKitchenSinksDotFeatures::get_num_vectors() const
 	return feats->get_num_vectors();
 }
 
+SGMatrix<float64_t> CRandomKitchenSinksDotFeatures::get_transformed_vectors(
+	int32_t start, int32_t stop)
+{
+	REQUIRE(start>=0 && start<=stop && stop<=get_num_vectors(),
+		"Invalid range [%d, %d) of %d vectors\n", start, stop, get_num_vectors());
+
+	int32_t num = stop-start;
+	SGMatrix<float64_t> result(num_samples, num);
+	if (m_transformed.matrix)
+	{
+		memcpy(result.matrix, m_transformed.get_column_vector(start),
+			sizeof(float64_t)*num_samples*int64_t(num));
+		return result;
+	}
+
+	int32_t dim = feats->get_dim_feature_space();
+	int32_t num_blocks = (num+RKS_BLOCK_SIZE-1)/RKS_BLOCK_SIZE;
+
+	#pragma omp parallel num_threads(parallel->get_num_threads())
+	{
+		SGMatrix<float64_t> inputs(dim, RKS_BLOCK_SIZE);
+
+		#pragma omp for schedule(dynamic)
+		for (int32_t k=0; k<num_blocks; k++)
+		{
+			int32_t first = k*RKS_BLOCK_SIZE;
+			int32_t n = CMath::min(RKS_BLOCK_SIZE, num-first);
+			SGMatrix<float64_t> block(result.get_column_vector(first),
+				num_samples, n, false);
+			transform_block(NULL, start+first, n, inputs, block);
+		}
+	}
+
+	return result;
+}
+
+void CRandomKitchenSinksDotFeatures::set_cache_transformed(bool cache)
+{
+	if (m_transformed.matrix)
+	{
+		sg_memory_release(MEMORY_TAG_FEATURE_CACHE, sizeof(float64_t)*
+			int64_t(m_transformed.num_rows)*m_transformed.num_cols);
+		m_transformed = SGMatrix<float64_t>();
+	}
+
+	if (cache)
+	{
+		SGMatrix<float64_t> transformed = get_transformed_vectors(0, get_num_vectors());
+		sg_memory_charge(MEMORY_TAG_FEATURE_CACHE, sizeof(float64_t)*
+			int64_t(transformed.num_rows)*transformed.num_cols);
+		m_transformed = transformed;
+	}
+}
+
+bool CRandomKitchenSinksDotFeatures::get_cache_transformed() const
+{
+	return m_transformed.matrix!=NULL;
+}
+
+void CRandomKitchenSinksDotFeatures::transform_block(int32_t* sub_index,
+	int32_t start, int32_t num, SGMatrix<float64_t> inputs,
+	SGMatrix<float64_t> result)
+{
+	ASSERT(num<=inputs.num_cols && num<=result.num_cols)
+
+	int32_t dim = inputs.num_rows;
+	SGMatrix<float64_t> block_inputs(inputs.matrix, dim, num, false);
+	SGMatrix<float64_t> block_result(result.matrix, num_samples, num, false);
+
+	block_inputs.zero();
+	for (int32_t j=0; j<num; j++)
+	{
+		int32_t idx = sub_index ? sub_index[start+j] : start+j;
+		feats->add_to_dense_vec(1.0, idx, block_inputs.get_column_vector(j), dim);
+	}
+
+	project_block(block_inputs, block_result);
+	post_dot_block(block_result);
+}
+
+void CRandomKitchenSinksDotFeatures::project_block(SGMatrix<float64_t> inputs,
+	SGMatrix<float64_t> projected)
+{
+	Map<MatrixXd> w(random_coeff.matrix, random_coeff.num_rows, random_coeff.num_cols);
+	Map<MatrixXd> x(inputs.matrix, inputs.num_rows, inputs.num_cols);
+	Map<MatrixXd> z(projected.matrix, projected.num_rows, projected.num_cols);
+
+	z.noalias() = w.topRows(inputs.num_rows).transpose()*x;
+}
+
+void CRandomKitchenSinksDotFeatures::post_dot_block(SGMatrix<float64_t> projected)
+{
+	for (index_t j=0; j<projected.num_cols; j++)
+	{
+		for (index_t i=0; i<num_samples; i++)
+			projected(i,j) = post_dot(projected(i,j), i);
+	}
+}
+
+void CRandomKitchenSinksDotFeatures::transform_vector(int32_t vec_idx,
+	float64_t* result)
+{
+	for (index_t i=0; i<num_samples; i++)
+		result[i] = post_dot(dot(vec_idx, i), i);
+}
+
+const float64_t* CRandomKitchenSinksDotFeatures::get_transformed_vector(
+	int32_t vec_idx, float64_t* buffer)
+{
+	if (m_transformed.matrix)
+		return m_transformed.get_column_vector(vec_idx);
+
+	transform_vector(vec_idx, buffer);
+	return buffer;
+}
+
 const char* CRandomKitchenSinksDotFeatures::get_name() const
 {
 	return "RandomKitchenSinksDotFeatures";
@@ -38,6 +38,10 @@ namespace shogun
  *		  for vector \f$\alpha\f$, either through least squares when \f$c(y', y)\f$ is the quadratic loss or through a linear SVM when \f$c(y', y)\f$ is the hinge loss.
  *
  * This class implements the vector transformation on-the-fly whenever it is needed.
+ * Ranges of vectors (dense_dot_range(), get_transformed_vectors()) are transformed
+ * in blocks, each with one matrix product with the random coefficients followed by
+ * post_dot_block(), and set_cache_transformed() keeps all transformed vectors in
+ * memory for solvers that access them repeatedly.
  * In order for it to work, the class expects the user to implement a subclass of
  * CRKSFunctions and implement in there the functions \f$\phi\f$ and \f$p\f$ and then pass an
  * instantiated object of that class to the constructor. For example, in the derived class CRandomFourierDotFeatures,
@@ -132,6 +136,52 @@ public:
 	virtual void add_to_dense_vec(float64_t alpha, int32_t vec_idx1,
 			float64_t* vec2, int32_t vec2_len, bool abs_val = false);
 
+	/** Compute the dot product for a range of vectors, transforming them in
+	 * blocks
+	 * alphas[i] * z(x_i)^T * w + b
+	 *
+	 * @param output result for the given vector range
+	 * @param start start vector range from this idx
+	 * @param stop stop vector range at this idx
+	 * @param alphas scalars to multiply with, may be NULL
+	 * @param vec dense vector to compute dot product with
+	 * @param dim length of the dense vector
+	 * @param b bias
+	 */
+	virtual void dense_dot_range(float64_t* output, int32_t start, int32_t stop,
+			float64_t* alphas, float64_t* vec, int32_t dim, float64_t b);
+
+	/** Compute the dot product with a single precision vector for a range
+	 * of vectors, transforming them in blocks
+	 * alphas[i] * z(x_i)^T * w + b
+	 *
+	 * @param output result for the given vector range
+	 * @param start start vector range from this idx
+	 * @param stop stop vector range at this idx
+	 * @param alphas scalars to multiply with, may be NULL
+	 * @param vec single precision dense vector to compute dot product with
+	 * @param dim length of the dense vector
+	 * @param b bias
+	 */
+	virtual void dense_dot_range(float64_t* output, int32_t start, int32_t stop,
+			float64_t* alphas, float32_t* vec, int32_t dim, float64_t b);
+
+	/** Compute the dot product for a subset of vectors, transforming them
+	 * in blocks
+	 * alphas[i] * z(x_i)^T * w + b
+	 *
+	 * @param sub_index index for which to compute outputs
+	 * @param num length of index
+	 * @param output result for the given vector range
+	 * @param alphas scalars to multiply with, may be NULL
+	 * @param vec dense vector to compute dot product with
+	 * @param dim length of the dense vector
+	 * @param b bias
+	 */
+	virtual void dense_dot_range_subset(int32_t* sub_index, int32_t num,
+			float64_t* output, float64_t* alphas, float64_t* vec, int32_t dim,
+			float64_t b);
+
 	/** get number of non-zero features in vector
 	 *
 	 * @param num which vector
@@ -205,10 +255,68 @@ public:
 	 */
 	SGMatrix<float64_t> get_random_coefficients();
 
+	/** transform a range of vectors
+	 *
+	 * @param start index of the first vector
+	 * @param stop index after the last vector
+	 * @return matrix with the transformed vectors in its columns
+	 */
+	SGMatrix<float64_t> get_transformed_vectors(int32_t start, int32_t stop);
+
+	/** keep all transformed vectors in memory
+	 *
+	 * The vectors are transformed once when enabling the cache, which has
+	 * to be enabled again after the underlying features changed.
+	 *
+	 * @param cache whether to cache the transformed vectors
+	 */
+	void set_cache_transformed(bool cache);
+
+	/** @return whether the transformed vectors are cached */
+	bool get_cache_transformed() const;
+
 	/** @return object name */
 	const char* get_name() const;
 
 protected:
+	/** project a block of input vectors on the random parameter vectors
+	 *
+	 * Subclasses that override dot(index_t, index_t) or do not store their
+	 * parameter vectors in random_coeff have to override this as well.
+	 *
+	 * @param inputs dense input vectors in the columns
+	 * @param projected num_samples x inputs.num_cols matrix receiving the
+	 * dot products
+	 */
+	virtual void project_block(SGMatrix<float64_t> inputs,
+			SGMatrix<float64_t> projected);
+
+	/** apply post_dot() to every element of a projected block,
+	 * subclasses should override this with a vectorized version
+	 *
+	 * @param projected num_samples x n matrix of dot results, modified in place
+	 */
+	virtual void post_dot_block(SGMatrix<float64_t> projected);
+
+	/** compute one transformed vector
+	 *
+	 * @param vec_idx the feature vector index
+	 * @param result num_samples values receiving the transformed vector
+	 */
+	virtual void transform_vector(int32_t vec_idx, float64_t* result);
+
+	/** transform the vectors with indices start..start+num-1, or
+	 * sub_index[start..start+num-1] if given, block-wise
+	 *
+	 * @param sub_index indices of the vectors, may be NULL
+	 * @param start first position
+	 * @param num number of vectors, at most the number of columns of result
+	 * @param inputs d x n buffer for the input vectors
+	 * @param result num_samples x n matrix receiving the transformed vectors
+	 */
+	void transform_block(int32_t* sub_index, int32_t start, int32_t num,
+			SGMatrix<float64_t> inputs, SGMatrix<float64_t> result);
+
 	/** Method used before computing the dot product between
 	 * a feature vector and a parameter vector
 	 *
@@ -244,6 +352,19 @@ protected:
 
 	/** random coefficients of the function phi, drawn from p */
 	SGMatrix<float64_t> random_coeff;
+
+private:
+	/** @return transformed vector vec_idx, taken from the cache or
+	 * computed into buffer
+	 */
+	const float64_t* get_transformed_vector(int32_t vec_idx, float64_t* buffer);
+
+	/** dense_dot_range() for contiguous vectors or a subset of them */
+	void dense_dot_blocks(int32_t* sub_index, int32_t start, int32_t num,
+			float64_t* output, float64_t* alphas, float64_t* vec, float64_t b);
+
+	/** transformed vectors, if cached */
+	SGMatrix<float64_t> m_transformed;
 };
 }
 
@@ -1,4 +1,5 @@
 #include <shogun/features/StringFeatures.h>
+#include <shogun/features/PackedDNAStringFeatures.h>
 #include <shogun/preprocessor/Preprocessor.h>
 #include <shogun/preprocessor/StringPreprocessor.h>
 #include <shogun/io/MemoryMappedFile.h>
@@ -71,19 +72,18 @@ template<class ST> CStringFeatures<ST>::CStringFeatures(CAlphabet* alpha)
 }
 
 template<class ST> CStringFeatures<ST>::CStringFeatures(const CStringFeatures & orig)
-: CFeatures(orig), num_vectors(orig.num_vectors),
-	single_string(orig.single_string),
-	length_of_single_string(orig.length_of_single_string),
-	max_string_length(orig.max_string_length),
-	num_symbols(orig.num_symbols),
-	original_num_symbols(orig.original_num_symbols),
-	order(orig.order), preprocess_on_get(false),
-	feature_cache(NULL)
+: CFeatures(orig)
 {
 	init();
 
 	ASSERT(orig.single_string == NULL) //not implemented
 
+	num_vectors=orig.num_vectors;
+	max_string_length=orig.max_string_length;
+	num_symbols=orig.num_symbols;
+	original_num_symbols=orig.original_num_symbols;
+	order=orig.order;
+
 	alphabet=orig.alphabet;
 	SG_REF(alphabet);
 
@@ -222,7 +222,7 @@ template<class ST> CFeatures* CStringFeatures<ST>::duplicate() const
 
 template<class ST> SGVector<ST> CStringFeatures<ST>::get_feature_vector(int32_t num)
 {
-	ASSERT(features)
+	ASSERT(features || preprocess_on_get)
 	if (num>=get_num_vectors())
 	{
 		SG_ERROR("Index out of bounds (number of strings %d, you "
@@ -274,7 +274,7 @@ template<class ST> void CStringFeatures<ST>::disable_on_the_fly_preprocessing()
 
 template<class ST> ST* CStringFeatures<ST>::get_feature_vector(int32_t num, int32_t& len, bool& dofree)
 {
-	ASSERT(features)
+	ASSERT(features || preprocess_on_get)
 	if (num>=get_num_vectors())
 		SG_ERROR("Requested feature vector with index %d while total num is", num, get_num_vectors())
 
@@ -2050,6 +2050,91 @@ bool CStringFeatures<ST>::obtain_from_char_features(CStringFeatures<CT>* sf, int
 	return true;
 }
 
+template<class ST> bool CStringFeatures<ST>::obtain_from_packed_dna(
+		CPackedDNAStringFeatures* sf, int32_t start, int32_t p_order)
+{
+	remove_all_subsets();
+	ASSERT(sf)
+	REQUIRE(p_order>0 && start>=0, "Order (%d) must be positive and start (%d) "
+			"non-negative\n", p_order, start);
+
+	const int32_t max_val=2;
+	this->order=p_order;
+	cleanup();
+
+	original_num_symbols=4;
+	if (p_order>1)
+		num_symbols=CMath::powl((floatmax_t) 2, (floatmax_t) max_val*p_order);
+	else
+		num_symbols=original_num_symbols;
+	SG_INFO("max_val (bit): %d order: %d -> results in num_symbols: %.0Lf\n", max_val, p_order, num_symbols)
+
+	if ( ((floatmax_t) num_symbols) > CMath::powl(((floatmax_t) 2),((floatmax_t) sizeof(ST)*8)) )
+	{
+		SG_ERROR("symbol does not fit into datatype \"%c\" (%d)\n", (char) max_val, (int) max_val)
+		return false;
+	}
+
+	num_vectors=sf->get_num_vectors();
+	ASSERT(num_vectors>0)
+	max_string_length=CMath::max(sf->get_max_vector_length()-start, 0);
+	features=SG_MALLOC(SGString<ST>, num_vectors);
+
+	uint8_t* prefix=SG_MALLOC(uint8_t, p_order);
+	for (int32_t i=0; i<num_vectors; i++)
+	{
+		int32_t len=sf->get_vector_length(i);
+		int32_t slen=CMath::max(len-start, 0);
+		features[i].slen=slen;
+		features[i].string=SG_MALLOC(ST, CMath::max(slen, 1));
+		ST* str=features[i].string;
+
+		/* positions ending before a full k-mer hold the symbols seen so far */
+		int32_t num_partial=CMath::min(CMath::min(p_order-1, len)-start, slen);
+		if (num_partial>0)
+		{
+			sf->get_codes(i, prefix, 0, start+num_partial);
+			for (int32_t m=0; m<num_partial; m++)
+			{
+				uint64_t value=0;
+				for (int32_t j=0; j<=m+start; j++)
+					value=(value<<max_val) | prefix[j];
+				str[m]=(ST) value;
+			}
+		}
+		else
+			num_partial=0;
+
+		/* the k-mer ending at m+start starts at m+start-p_order+1 */
+		if (len>=p_order && slen>num_partial)
+		{
+			sf->get_kmer_range(i, p_order, &str[num_partial],
+				num_partial+start-p_order+1, slen-num_partial);
+		}
+	}
+	SG_FREE(prefix);
+
+	compute_symbol_mask_table(max_val);
+
+	return true;
+}
+
+template<> bool CStringFeatures<float32_t>::obtain_from_packed_dna(
+		CPackedDNAStringFeatures* sf, int32_t start, int32_t p_order)
+{
+	return false;
+}
+template<> bool CStringFeatures<float64_t>::obtain_from_packed_dna(
+		CPackedDNAStringFeatures* sf, int32_t start, int32_t p_order)
+{
+	return false;
+}
+template<> bool CStringFeatures<floatmax_t>::obtain_from_packed_dna(
+		CPackedDNAStringFeatures* sf, int32_t start, int32_t p_order)
+{
+	return false;
+}
+
 template class CStringFeatures<bool>;
 template class CStringFeatures<char>;
 template class CStringFeatures<int8_t>;
@@ -28,6 +28,7 @@
 namespace shogun
 {
 class CAlphabet;
+class CPackedDNAStringFeatures;
 template <class T> class CDynamicArray;
 class CFile;
 template <class T> class SGString;
@@ -557,6 +558,24 @@ template <class ST> class CStringFeatures : public CFeatures
 			bool obtain_from_char_features(CStringFeatures<CT>* sf, int32_t start,
 					int32_t p_order, int32_t gap, bool rev);
 
+		/** obtain string features from 2-bit packed DNA features
+		 *
+		 * gives the same result as obtain_from_char(sf, start, p_order, 0,
+		 * false) on the unpacked strings, but k-mers are read from the packed
+		 * words directly instead of from an intermediate copy. As with the
+		 * DNA alphabet, 'N' gives the code of 'A', k-mers overlapping an 'N'
+		 * can be found with CPackedDNAStringFeatures::get_kmers
+		 *
+		 * any subset is removed before, subset of parameter sf is possible
+		 *
+		 * @param sf packed DNA string features
+		 * @param start start
+		 * @param p_order order
+		 * @return if obtaining was successful
+		 */
+		bool obtain_from_packed_dna(CPackedDNAStringFeatures* sf, int32_t start,
+				int32_t p_order);
+
 		/** check if length of each vector in this feature object equals the
 		 * given length. if existant, only subset is checked
 		 *
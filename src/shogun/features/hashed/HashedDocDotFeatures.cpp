@@ -13,6 +13,8 @@
 #include <shogun/lib/Hash.h>
 #include <shogun/mathematics/Math.h>
 
+#include <limits>
+
 namespace shogun
 {
 CHashedDocDotFeatures::CHashedDocDotFeatures(int32_t hash_bits, CStringFeatures<char>* docs,
@@ -32,6 +34,9 @@ CHashedDocDotFeatures::CHashedDocDotFeatures(const CHashedDocDotFeatures& orig)
 {
 	init(orig.num_bits, orig.doc_collection, orig.tokenizer, orig.should_normalize,
 			orig.ngrams, orig.tokens_to_skip);
+	cache_offsets = orig.cache_offsets;
+	cache_indices = orig.cache_indices;
+	cache_values = orig.cache_values;
 }
 
 CHashedDocDotFeatures::CHashedDocDotFeatures(CFile* loader)
@@ -89,20 +94,127 @@ float64_t CHashedDocDotFeatures::dot(int32_t vec_idx1, CDotFeatures* df, int32_t
 
 	CHashedDocDotFeatures* hddf = (CHashedDocDotFeatures*) df;
 
-	SGVector<char> sv1 = doc_collection->get_feature_vector(vec_idx1);
-	SGVector<char> sv2 = hddf->doc_collection->get_feature_vector(vec_idx2);
+	if (has_hashed_cache() && hddf->has_hashed_cache())
+	{
+		float64_t result = 0;
+		index_t i = cache_offsets[vec_idx1];
+		index_t j = hddf->cache_offsets[vec_idx2];
+		const index_t end1 = cache_offsets[vec_idx1+1];
+		const index_t end2 = hddf->cache_offsets[vec_idx2+1];
+		while (i<end1 && j<end2)
+		{
+			if (cache_indices[i] < hddf->cache_indices[j])
+				i++;
+			else if (cache_indices[i] > hddf->cache_indices[j])
+				j++;
+			else
+				result += cache_values[i++] * hddf->cache_values[j++];
+		}
+		return result;
+	}
+
+	SGSparseVector<float64_t> cv1 = get_hashed_vector(vec_idx1);
+	SGSparseVector<float64_t> cv2 = hddf->get_hashed_vector(vec_idx2);
+
+	return SGSparseVector<float64_t>::sparse_dot(cv1,cv2);
+}
+
+SGSparseVector<float64_t> CHashedDocDotFeatures::get_hashed_vector(int32_t vec_idx)
+{
+	if (has_hashed_cache())
+	{
+		index_t start = cache_offsets[vec_idx];
+		SGSparseVector<float64_t> cv(cache_offsets[vec_idx+1]-start);
+		for (index_t i=0; i<cv.num_feat_entries; i++)
+		{
+			cv.features[i].feat_index = cache_indices[start+i];
+			cv.features[i].entry = cache_values[start+i];
+		}
+		return cv;
+	}
+
+	SGVector<char> sv = doc_collection->get_feature_vector(vec_idx);
 
 	CHashedDocConverter* converter = new CHashedDocConverter(tokenizer, num_bits,
 			should_normalize, ngrams, tokens_to_skip);
-	SGSparseVector<float64_t> cv1 = converter->apply(sv1);
-	SGSparseVector<float64_t> cv2 = converter->apply(sv2);
-	float64_t result = SGSparseVector<float64_t>::sparse_dot(cv1,cv2);
+	SGSparseVector<float64_t> cv = converter->apply(sv);
 
-	doc_collection->free_feature_vector(sv1, vec_idx1);
-	hddf->doc_collection->free_feature_vector(sv2, vec_idx2);
+	doc_collection->free_feature_vector(sv, vec_idx);
 	SG_UNREF(converter);
 
-	return result;
+	return cv;
+}
+
+void CHashedDocDotFeatures::build_hashed_cache()
+{
+	REQUIRE(doc_collection, "No document collection set!\n")
+
+	int32_t num_vectors = get_num_vectors();
+	SGSparseMatrix<float64_t> hashed_docs(get_dim_feature_space(), num_vectors);
+
+	CHashedDocConverter* converter = new CHashedDocConverter(tokenizer, num_bits,
+			should_normalize, ngrams, tokens_to_skip);
+
+	#pragma omp parallel num_threads(parallel->get_num_threads())
+	{
+		CTokenizer* local_tzer = tokenizer->get_copy();
+
+		#pragma omp for schedule(dynamic, 16)
+		for (int32_t i=0; i<num_vectors; i++)
+		{
+			SGVector<char> sv = doc_collection->get_feature_vector(i);
+			hashed_docs[i] = converter->apply(sv, local_tzer);
+			doc_collection->free_feature_vector(sv, i);
+		}
+
+		SG_UNREF(local_tzer);
+	}
+	SG_UNREF(converter);
+
+	// the cache is addressed with index_t, count in 64 bit to detect overflow
+	int64_t num_entries = 0;
+	for (int32_t i=0; i<num_vectors; i++)
+		num_entries += hashed_docs[i].num_feat_entries;
+
+	REQUIRE(num_entries <= std::numeric_limits<index_t>::max(),
+			"The %d hashed documents have %lld features in total, which is more "
+			"than the hashed cache can address (%d), use the features uncached\n",
+			num_vectors, (long long int) num_entries,
+			std::numeric_limits<index_t>::max());
+
+	SGVector<index_t> offsets(num_vectors+1);
+	offsets[0] = 0;
+	for (int32_t i=0; i<num_vectors; i++)
+		offsets[i+1] = offsets[i] + hashed_docs[i].num_feat_entries;
+
+	SGVector<index_t> indices(offsets[num_vectors]);
+	SGVector<float64_t> values(offsets[num_vectors]);
+
+	#pragma omp parallel for num_threads(parallel->get_num_threads())
+	for (int32_t i=0; i<num_vectors; i++)
+	{
+		for (index_t j=0; j<hashed_docs[i].num_feat_entries; j++)
+		{
+			indices[offsets[i]+j] = hashed_docs[i].features[j].feat_index;
+			values[offsets[i]+j] = hashed_docs[i].features[j].entry;
+		}
+	}
+
+	cache_offsets = offsets;
+	cache_indices = indices;
+	cache_values = values;
+}
+
+void CHashedDocDotFeatures::free_hashed_cache()
+{
+	cache_offsets = SGVector<index_t>();
+	cache_indices = SGVector<index_t>();
+	cache_values = SGVector<float64_t>();
+}
+
+bool CHashedDocDotFeatures::has_hashed_cache() const
+{
+	return cache_offsets.vlen > 0;
 }
 
 float64_t CHashedDocDotFeatures::dense_dot_sgvec(int32_t vec_idx1, const SGVector<float64_t> vec2)
@@ -114,6 +226,14 @@ float64_t CHashedDocDotFeatures::dense_dot(int32_t vec_idx1, const float64_t* ve
 {
 	ASSERT(vec2_len == CMath::pow(2,num_bits))
 
+	if (has_hashed_cache())
+	{
+		float64_t result = 0;
+		for (index_t i=cache_offsets[vec_idx1]; i<cache_offsets[vec_idx1+1]; i++)
+			result += cache_values[i] * vec2[cache_indices[i]];
+		return result;
+	}
+
 	SGVector<char> sv = doc_collection->get_feature_vector(vec_idx1);
 
 	/** this vector will maintain the current n+k active tokens
@@ -191,6 +311,13 @@ void CHashedDocDotFeatures::add_to_dense_vec(float64_t alpha, int32_t vec_idx1,
 	if (abs_val)
 		alpha = CMath::abs(alpha);
 
+	if (has_hashed_cache())
+	{
+		for (index_t i=cache_offsets[vec_idx1]; i<cache_offsets[vec_idx1+1]; i++)
+			vec2[cache_indices[i]] += alpha * cache_values[i];
+		return;
+	}
+
 	SGVector<char> sv = doc_collection->get_feature_vector(vec_idx1);
 	const float64_t value = should_normalize ? alpha / CMath::sqrt((float64_t) sv.size()) : alpha;
 
@@ -270,10 +397,14 @@ void CHashedDocDotFeatures::set_doc_collection(CStringFeatures<char>* docs)
 {
 	SG_UNREF(doc_collection);
 	doc_collection = docs;
+	free_hashed_cache();
 }
 
 int32_t CHashedDocDotFeatures::get_nnz_features_for_vector(int32_t num)
 {
+	if (has_hashed_cache())
+		return cache_offsets[num+1] - cache_offsets[num];
+
 	SGVector<char> sv = doc_collection->get_feature_vector(num);
 	int32_t num_nnz_features = sv.size();
 	doc_collection->free_feature_vector(sv, num);
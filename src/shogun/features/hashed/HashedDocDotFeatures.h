@@ -155,6 +155,22 @@ public:
 	 */
 	void set_doc_collection(CStringFeatures<char>* docs);
 
+	/** hash all documents once, in parallel, and keep the hashed sparse
+	 * vectors in compressed sparse row form. dot(), dense_dot() and
+	 * add_to_dense_vec() then read the stored vectors instead of
+	 * tokenizing and hashing the documents on every call.
+	 * The cache is dropped when the document collection is replaced.
+	 * An error is raised if the documents have more hashed features in
+	 * total than index_t can address.
+	 */
+	void build_hashed_cache();
+
+	/** free the hashed documents cache */
+	void free_hashed_cache();
+
+	/** @return whether the hashed documents are cached */
+	bool has_hashed_cache() const;
+
 	virtual const char* get_name() const;
 
 	/** duplicate feature object
@@ -196,6 +212,13 @@ private:
 	void init(int32_t hash_bits, CStringFeatures<char>* docs, CTokenizer* tzer,
 		bool normalize, int32_t n_grams, int32_t skips);
 
+	/** get the hashed representation of a document
+	 *
+	 * @param vec_idx index of the document
+	 * @return hashed sparse vector
+	 */
+	SGSparseVector<float64_t> get_hashed_vector(int32_t vec_idx);
+
 protected:
 	/** the document collection*/
 	CStringFeatures<char>* doc_collection;
@@ -214,6 +237,15 @@ protected:
 
 	/** tokens to skip when combining tokens */
 	int32_t tokens_to_skip;
+
+	/** start of each document in the cache, empty if not cached */
+	SGVector<index_t> cache_offsets;
+
+	/** sorted hashed feature indices of all documents, one after another */
+	SGVector<index_t> cache_indices;
+
+	/** values of the hashed features, normalized if requested */
+	SGVector<float64_t> cache_values;
 };
 }
 
@@ -9,15 +9,66 @@
  */
 
 #include <shogun/features/hashed/HashedWDFeatures.h>
+#include <shogun/features/PackedDNAStringFeatures.h>
 #include <shogun/io/SGIO.h>
 
+#ifdef HAVE_CXX11_ATOMIC
+#include <vector>
+#endif
+
 using namespace shogun;
 
+#ifdef HAVE_CXX11_ATOMIC
+/* hash states and prefix symbols, reused by all dot products of a thread */
+static thread_local std::vector<uint32_t> hash_states;
+static thread_local std::vector<uint8_t> prefix_symbols;
+#endif
+
+/* scratch space for the hash state of each position of a string */
+static inline uint32_t* get_hash_states(int32_t len)
+{
+#ifdef HAVE_CXX11_ATOMIC
+	if (hash_states.size()<(size_t) len)
+		hash_states.resize(len);
+	return hash_states.data();
+#else
+	return SG_MALLOC(uint32_t, len);
+#endif
+}
+
+/* scratch space for the symbols of a prefix */
+static inline uint8_t* get_prefix_symbols(int32_t len)
+{
+#ifdef HAVE_CXX11_ATOMIC
+	if (prefix_symbols.size()<(size_t) len)
+		prefix_symbols.resize(len);
+	return prefix_symbols.data();
+#else
+	return SG_MALLOC(uint8_t, len);
+#endif
+}
+
+template <class T> static inline void free_scratch(T* scratch)
+{
+#ifndef HAVE_CXX11_ATOMIC
+	SG_FREE(scratch);
+#endif
+}
+
+/* symbol at pos of a string given by its bytes or its packed DNA words */
+static inline uint8_t get_symbol(const uint8_t* vec, const uint64_t* words,
+		int32_t pos)
+{
+	return words ? CPackedDNAStringFeatures::get_packed_code(words, pos) :
+		vec[pos];
+}
+
 CHashedWDFeatures::CHashedWDFeatures() :CDotFeatures()
 {
 	SG_UNSTABLE("CHashedWDFeatures::CHashedWDFeatures()", "\n")
 
 	strings = NULL;
+	packed_strings = NULL;
 
 	degree = 0;
 	start_degree = 0;
@@ -38,21 +89,47 @@ CHashedWDFeatures::CHashedWDFeatures(CStringFeatures<uint8_t>* str,
 		int32_t start_order, int32_t order, int32_t from_order,
 		int32_t hash_bits) : CDotFeatures()
 {
-	ASSERT(start_order>=0)
-	ASSERT(start_order<order)
-	ASSERT(order<=from_order)
-	ASSERT(hash_bits>0)
 	ASSERT(str)
 	ASSERT(str->have_same_length())
 	SG_REF(str);
 
 	strings=str;
+	packed_strings=NULL;
 	string_length=str->get_max_vector_length();
 	num_strings=str->get_num_vectors();
 	CAlphabet* alpha=str->get_alphabet();
 	alphabet_size=alpha->get_num_symbols();
 	SG_UNREF(alpha);
 
+	init(start_order, order, from_order, hash_bits);
+}
+
+CHashedWDFeatures::CHashedWDFeatures(CPackedDNAStringFeatures* str,
+		int32_t start_order, int32_t order, int32_t from_order,
+		int32_t hash_bits) : CDotFeatures()
+{
+	ASSERT(str)
+	ASSERT(str->have_same_length())
+	SG_REF(str);
+
+	/* codes are read from the packed words per string when hashing */
+	strings=NULL;
+	packed_strings=str;
+	string_length=str->get_max_vector_length();
+	num_strings=str->get_num_vectors();
+	alphabet_size=4;
+
+	init(start_order, order, from_order, hash_bits);
+}
+
+void CHashedWDFeatures::init(int32_t start_order, int32_t order,
+		int32_t from_order, int32_t hash_bits)
+{
+	ASSERT(start_order>=0)
+	ASSERT(start_order<order)
+	ASSERT(order<=from_order)
+	ASSERT(hash_bits>0)
+
 	degree=order;
 	start_degree=start_order;
 	from_degree=from_order;
@@ -61,15 +138,45 @@ CHashedWDFeatures::CHashedWDFeatures(CStringFeatures<uint8_t>* str,
 	set_normalization_const();
 }
 
+uint8_t* CHashedWDFeatures::get_symbols(int32_t num, int32_t& len,
+		bool& free_vec, const uint64_t*& words, int32_t*& limit)
+{
+	words=NULL;
+	limit=NULL;
+	if (strings)
+		return strings->get_feature_vector(num, len, free_vec);
+
+	free_vec=false;
+	words=packed_strings->get_packed_words(num, len);
+
+	if (packed_strings->has_ambiguous_nucleotides())
+	{
+		limit=SG_MALLOC(int32_t, len);
+		packed_strings->get_unambiguous_lengths(num, limit);
+	}
+
+	return NULL;
+}
+
+void CHashedWDFeatures::free_symbols(uint8_t* vec, int32_t num, bool free_vec,
+		int32_t* limit)
+{
+	if (strings)
+		strings->free_feature_vector(vec, num, free_vec);
+
+	SG_FREE(limit);
+}
+
 CHashedWDFeatures::CHashedWDFeatures(const CHashedWDFeatures& orig)
 	: CDotFeatures(orig), strings(orig.strings),
-	degree(orig.degree), start_degree(orig.start_degree),
+	packed_strings(orig.packed_strings), degree(orig.degree), start_degree(orig.start_degree),
 	from_degree(orig.from_degree), m_hash_bits(orig.m_hash_bits),
 	normalization_const(orig.normalization_const)
 {
 
 
 	SG_REF(strings);
+	SG_REF(packed_strings);
 	if (strings)
 	{
 		string_length=strings->get_max_vector_length();
@@ -78,6 +185,12 @@ CHashedWDFeatures::CHashedWDFeatures(const CHashedWDFeatures& orig)
 		alphabet_size=alpha->get_num_symbols();
 		SG_UNREF(alpha);
 	}
+	else if (packed_strings)
+	{
+		string_length=packed_strings->get_max_vector_length();
+		num_strings=packed_strings->get_num_vectors();
+		alphabet_size=4;
+	}
 	else
 	{
 		string_length = 0;
@@ -92,6 +205,7 @@ CHashedWDFeatures::CHashedWDFeatures(const CHashedWDFeatures& orig)
 CHashedWDFeatures::~CHashedWDFeatures()
 {
 	SG_UNREF(strings);
+	SG_UNREF(packed_strings);
 	SG_FREE(wd_weights);
 }
 
@@ -104,9 +218,13 @@ float64_t CHashedWDFeatures::dot(int32_t vec_idx1, CDotFeatures* df, int32_t vec
 
 	int32_t len1, len2;
 	bool free_vec1, free_vec2;
+	const uint64_t* words1;
+	const uint64_t* words2;
+	int32_t* limit1;
+	int32_t* limit2;
 
-	uint8_t* vec1=strings->get_feature_vector(vec_idx1, len1, free_vec1);
-	uint8_t* vec2=wdf->strings->get_feature_vector(vec_idx2, len2, free_vec2);
+	uint8_t* vec1=get_symbols(vec_idx1, len1, free_vec1, words1, limit1);
+	uint8_t* vec2=wdf->get_symbols(vec_idx2, len2, free_vec2, words2, limit2);
 
 	ASSERT(len1==len2)
 
@@ -114,16 +232,22 @@ float64_t CHashedWDFeatures::dot(int32_t vec_idx1, CDotFeatures* df, int32_t vec
 
 	for (int32_t i=0; i<len1; i++)
 	{
-		for (int32_t j=0; (i+j<len1) && (j<degree); j++)
+		int32_t lim=degree;
+		if (limit1)
+			lim=CMath::min(lim, limit1[i]);
+		if (limit2)
+			lim=CMath::min(lim, limit2[i]);
+
+		for (int32_t j=0; (i+j<len1) && (j<lim); j++)
 		{
-			if (vec1[i+j]!=vec2[i+j])
+			if (get_symbol(vec1, words1, i+j)!=get_symbol(vec2, words2, i+j))
 				break;
 			if (j>=start_degree)
 				sum += wd_weights[j]*wd_weights[j];
 		}
 	}
-	strings->free_feature_vector(vec1, vec_idx1, free_vec1);
-	wdf->strings->free_feature_vector(vec2, vec_idx2, free_vec2);
+	free_symbols(vec1, vec_idx1, free_vec1, limit1);
+	wdf->free_symbols(vec2, vec_idx2, free_vec2, limit2);
 	return sum/CMath::sq(normalization_const);
 }
 
@@ -136,16 +260,28 @@ float64_t CHashedWDFeatures::dense_dot(int32_t vec_idx1, const float64_t* vec2,
 	int32_t lim=CMath::min(degree, string_length);
 	int32_t len;
 	bool free_vec1;
-	uint8_t* vec = strings->get_feature_vector(vec_idx1, len, free_vec1);
-	uint32_t* val=SG_MALLOC(uint32_t, len);
+	const uint64_t* words;
+	int32_t* limit;
+	uint8_t* vec = get_symbols(vec_idx1, len, free_vec1, words, limit);
+	uint32_t* val=get_hash_states(len);
 
 	uint32_t offs=0;
 
 	if (start_degree>0)
 	{
 		// compute hash for strings of length start_degree-1
+		uint8_t* prefix=words ? get_prefix_symbols(start_degree) : NULL;
 		for (int32_t i=0; i+start_degree < len; i++)
-			val[i]=CHash::MurmurHash3(&vec[i], start_degree, 0xDEADBEAF);
+		{
+			if (words)
+			{
+				for (int32_t j=0; j<start_degree; j++)
+					prefix[j]=get_symbol(vec, words, i+j);
+			}
+			val[i]=CHash::MurmurHash3(words ? prefix : &vec[i], start_degree, 0xDEADBEAF);
+		}
+		if (prefix)
+			free_scratch(prefix);
 	}
 	else
 		SGVector<uint32_t>::fill_vector(val, len, 0xDEADBEAF);
@@ -161,13 +297,15 @@ float64_t CHashedWDFeatures::dense_dot(int32_t vec_idx1, const float64_t* vec2,
 		for (int32_t i=0; i+k < len; i++)
 		{
 			chunk++;
-			CHash::IncrementalMurmurHash3(&(val[i]), &carry, &(vec[i+k]), 1);
+			uint8_t sym=get_symbol(vec, words, i+k);
+			CHash::IncrementalMurmurHash3(&(val[i]), &carry, &sym, 1);
 			uint32_t h =
 					CHash::FinalizeIncrementalMurmurHash3(val[i], carry, chunk);
 #ifdef DEBUG_HASHEDWD
-			SG_PRINT("vec[i]=%d, k=%d, offs=%d o=%d\n", vec[i], k,offs, o)
+			SG_PRINT("vec[i]=%d, k=%d, offs=%d o=%d\n", get_symbol(vec, words, i), k,offs, o)
 #endif
-			sum+=vec2[o+(h & mask)]*wd;
+			if (!limit || k<limit[i])
+				sum+=vec2[o+(h & mask)]*wd;
 			val[i] = h;
 			o+=partial_w_dim;
 		}
@@ -175,8 +313,8 @@ float64_t CHashedWDFeatures::dense_dot(int32_t vec_idx1, const float64_t* vec2,
 				CHash::FinalizeIncrementalMurmurHash3(val[len-k-1], carry, chunk);
 		offs+=partial_w_dim*len;
 	}
-	SG_FREE(val);
-	strings->free_feature_vector(vec, vec_idx1, free_vec1);
+	free_scratch(val);
+	free_symbols(vec, vec_idx1, free_vec1, limit);
 
 	return sum/normalization_const;
 }
@@ -189,16 +327,28 @@ void CHashedWDFeatures::add_to_dense_vec(float64_t alpha, int32_t vec_idx1, floa
 	int32_t lim=CMath::min(degree, string_length);
 	int32_t len;
 	bool free_vec1;
-	uint8_t* vec = strings->get_feature_vector(vec_idx1, len, free_vec1);
-	uint32_t* val=SG_MALLOC(uint32_t, len);
+	const uint64_t* words;
+	int32_t* limit;
+	uint8_t* vec = get_symbols(vec_idx1, len, free_vec1, words, limit);
+	uint32_t* val=get_hash_states(len);
 
 	uint32_t offs=0;
 
 	if (start_degree>0)
 	{
 		// compute hash for strings of length start_degree-1
+		uint8_t* prefix=words ? get_prefix_symbols(start_degree) : NULL;
 		for (int32_t i=0; i+start_degree < len; i++)
-			val[i]=CHash::MurmurHash3(&vec[i], start_degree, 0xDEADBEAF);
+		{
+			if (words)
+			{
+				for (int32_t j=0; j<start_degree; j++)
+					prefix[j]=get_symbol(vec, words, i+j);
+			}
+			val[i]=CHash::MurmurHash3(words ? prefix : &vec[i], start_degree, 0xDEADBEAF);
+		}
+		if (prefix)
+			free_scratch(prefix);
 	}
 	else
 		SGVector<uint32_t>::fill_vector(val, len, 0xDEADBEAF);
@@ -217,14 +367,16 @@ void CHashedWDFeatures::add_to_dense_vec(float64_t alpha, int32_t vec_idx1, floa
 		for (int32_t i=0; i+k < len; i++)
 		{
 			chunk++;
-			CHash::IncrementalMurmurHash3(&(val[i]), &carry, &(vec[i+k]), 1);
+			uint8_t sym=get_symbol(vec, words, i+k);
+			CHash::IncrementalMurmurHash3(&(val[i]), &carry, &sym, 1);
 			uint32_t h = CHash::FinalizeIncrementalMurmurHash3(val[i], carry, chunk);
 
 #ifdef DEBUG_HASHEDWD
 			SG_PRINT("offs=%d o=%d h=%d \n", offs, o, h)
-			SG_PRINT("vec[i]=%d, k=%d, offs=%d o=%d\n", vec[i], k,offs, o)
+			SG_PRINT("vec[i]=%d, k=%d, offs=%d o=%d\n", get_symbol(vec, words, i), k,offs, o)
 #endif
-			vec2[o+(h & mask)]+=wd;
+			if (!limit || k<limit[i])
+				vec2[o+(h & mask)]+=wd;
 			val[i] = h;
 			o+=partial_w_dim;
 		}
@@ -234,8 +386,8 @@ void CHashedWDFeatures::add_to_dense_vec(float64_t alpha, int32_t vec_idx1, floa
 		offs+=partial_w_dim*len;
 	}
 
-	SG_FREE(val);
-	strings->free_feature_vector(vec, vec_idx1, free_vec1);
+	free_scratch(val);
+	free_symbols(vec, vec_idx1, free_vec1, limit);
 }
 
 void CHashedWDFeatures::set_wd_weights()
@@ -283,9 +435,14 @@ CFeatures* CHashedWDFeatures::duplicate() const
 int32_t CHashedWDFeatures::get_nnz_features_for_vector(int32_t num)
 {
 	int32_t vlen=-1;
-	bool free_vec;
-	uint8_t* vec=strings->get_feature_vector(num, vlen, free_vec);
-	strings->free_feature_vector(vec, num, free_vec);
+	if (packed_strings)
+		vlen=packed_strings->get_vector_length(num);
+	else
+	{
+		bool free_vec;
+		uint8_t* vec=strings->get_feature_vector(num, vlen, free_vec);
+		strings->free_feature_vector(vec, num, free_vec);
+	}
 	return degree*vlen;
 }
 
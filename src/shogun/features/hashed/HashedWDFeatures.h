@@ -21,6 +21,7 @@
 namespace shogun
 {
 template<class ST> class CStringFeatures;
+class CPackedDNAStringFeatures;
 
 /** @brief Features that compute the Weighted Degreee Kernel feature space
  * explicitly.
@@ -44,6 +45,18 @@ public:
 	CHashedWDFeatures(CStringFeatures<uint8_t>* str, int32_t start_order,
 			int32_t order, int32_t from_order, int32_t hash_bits=12);
 
+	/** constructor from 2-bit packed DNA
+	 *
+	 * @param str packed DNA string features, substrings overlapping an
+	 * 'N' do not contribute
+	 * @param start_order do degrees starting with start_order up to order
+	 * @param order of wd kernel
+	 * @param from_order use first order weights from higher order weighting
+	 * @param hash_bits number of bits in hash
+	 */
+	CHashedWDFeatures(CPackedDNAStringFeatures* str, int32_t start_order,
+			int32_t order, int32_t from_order, int32_t hash_bits=12);
+
 	/** copy constructor */
 	CHashedWDFeatures(const CHashedWDFeatures & orig);
 
@@ -195,6 +208,33 @@ public:
 
 protected:
 
+	/** initialize degrees and weights, see constructor */
+	void init(int32_t start_order, int32_t order, int32_t from_order,
+			int32_t hash_bits);
+
+	/** get the symbols of a string, either as bytes or, for packed DNA,
+	 * as the packed words which are read without unpacking them
+	 *
+	 * @param num index of string
+	 * @param len length of string
+	 * @param free_vec whether free_symbols has to free the symbols
+	 * @param words NULL, or the packed words of the string
+	 * @param limit NULL, or for packed DNA with 'N' the number of
+	 * positions from each position on that do not overlap an 'N'
+	 * @return symbols, NULL for packed DNA
+	 */
+	uint8_t* get_symbols(int32_t num, int32_t& len, bool& free_vec,
+			const uint64_t*& words, int32_t*& limit);
+
+	/** free symbols obtained by get_symbols
+	 *
+	 * @param vec symbols
+	 * @param num index of string
+	 * @param free_vec as returned by get_symbols
+	 * @param limit as returned by get_symbols
+	 */
+	void free_symbols(uint8_t* vec, int32_t num, bool free_vec, int32_t* limit);
+
 	/** create wd kernel weighting heuristic */
 	void set_wd_weights();
 
@@ -202,6 +242,9 @@ protected:
 	/** stringfeatures the wdfeatures are based on*/
 	CStringFeatures<uint8_t>* strings;
 
+	/** packed DNA the wdfeatures are based on instead of strings */
+	CPackedDNAStringFeatures* packed_strings;
+
 	/** degree */
 	int32_t degree;
 	/** start_degree */
@@ -276,20 +276,29 @@ float64_t CStreamingVwFeatures::get_label()
 }
 
 void CStreamingVwFeatures::release_example()
+{
+	update_statistics(current_example);
+	release_example_without_statistics();
+}
+
+void CStreamingVwFeatures::release_example_without_statistics()
+{
+	current_example->reset_members();
+	parser.finalize_example();
+}
+
+void CStreamingVwFeatures::update_statistics(VwExample* ex)
 {
 	env->example_number++;
-	env->weighted_examples += current_example->ld->weight;
+	env->weighted_examples += ex->ld->weight;
 
-	if (current_example->ld->label == FLT_MAX)
+	if (ex->ld->label == FLT_MAX)
 		env->weighted_labels += 0;
 	else
-		env->weighted_labels += current_example->ld->label * current_example->ld->weight;
-
-	env->total_features += current_example->num_features;
-	env->sum_loss += current_example->loss;
+		env->weighted_labels += ex->ld->label * ex->ld->weight;
 
-	current_example->reset_members();
-	parser.finalize_example();
+	env->total_features += ex->num_features;
+	env->sum_loss += ex->loss;
 }
 
 int32_t CStreamingVwFeatures::get_dim_feature_space() const
@@ -176,6 +176,23 @@ public:
 	 */
 	virtual void release_example();
 
+	/**
+	 * Release the current example like release_example(), but
+	 * leave accounting it in the environment's statistics to
+	 * the caller, see update_statistics().
+	 *
+	 * Used by learners that process a copy of the example later.
+	 */
+	void release_example_without_statistics();
+
+	/**
+	 * Account an example in the running statistics of the
+	 * environment (example counts, weights, labels, loss).
+	 *
+	 * @param ex processed example
+	 */
+	void update_statistics(VwExample* ex);
+
 	/**
 	 * Expand the vector passed so that it its length is equal to
 	 * the dimensionality of the features. The previous values are
@@ -11,6 +11,7 @@
 
 #include <shogun/io/SerializableFile.h>
 #include <shogun/io/SGIO.h>
+#include <shogun/lib/Tracing.h>
 
 using namespace shogun;
 
@@ -132,6 +133,7 @@ CSerializableFile::write_scalar(
 	const TSGDataType* type, const char* name, const char* prefix,
 	const void* param)
 {
+	SG_TRACE_HOT_SCOPE("CSerializableFile::write_scalar");
 	if (!is_task_warn('w', name, prefix)) return false;
 
 	if (!write_scalar_wrapped(type, param))
@@ -145,6 +147,7 @@ CSerializableFile::read_scalar(
 	const TSGDataType* type, const char* name, const char* prefix,
 	void* param)
 {
+	SG_TRACE_HOT_SCOPE("CSerializableFile::read_scalar");
 	if (!is_task_warn('r', name, prefix)) return false;
 
 	if (!m_reader->read_scalar_wrapped(type, param))
@@ -17,6 +17,7 @@
 #ifdef HAVE_PTHREAD
 
 #include <shogun/io/SGIO.h>
+#include <shogun/lib/Tracing.h>
 #include <shogun/io/streaming/StreamingFile.h>
 #include <shogun/io/streaming/ParseBuffer.h>
 #include <pthread.h>
@@ -481,6 +482,7 @@ template <class T>
                               int32_t &length,
                               float64_t &label)
 {
+    SG_TRACE_HOT_SCOPE("CInputParser::get_vector_and_label");
     (input_source->*read_vector_and_label)(feature_vector, length, label);
 
     if (length < 1)
@@ -496,6 +498,7 @@ template <class T>
     int32_t CInputParser<T>::get_vector_only(T* &feature_vector,
                          int32_t &length)
 {
+    SG_TRACE_HOT_SCOPE("CInputParser::get_vector_only");
     (input_source->*read_vector)(feature_vector, length);
 
     if (length < 1)
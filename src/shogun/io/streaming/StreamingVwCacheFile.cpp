@@ -38,18 +38,42 @@ CStreamingVwCacheFile::~CStreamingVwCacheFile()
 
 void CStreamingVwCacheFile::get_vector(VwExample* &ex, int32_t& len)
 {
+	/* ring slots are empty until the parser first fills them */
+	bool new_example = (ex == NULL);
+	if (new_example)
+		ex = SG_MALLOC(VwExample, 1);
+
 	if (cache_reader->read_cached_example(ex))
 		len = 1;
 	else
+	{
 		len = -1;
+		if (new_example)
+		{
+			SG_FREE(ex);
+			ex = NULL;
+		}
+	}
 }
 
 void CStreamingVwCacheFile::get_vector_and_label(VwExample* &ex, int32_t &len, float64_t &label)
 {
+	/* ring slots are empty until the parser first fills them */
+	bool new_example = (ex == NULL);
+	if (new_example)
+		ex = SG_MALLOC(VwExample, 1);
+
 	if (cache_reader->read_cached_example(ex))
 		len = 1;
 	else
+	{
 		len = -1;
+		if (new_example)
+		{
+			SG_FREE(ex);
+			ex = NULL;
+		}
+	}
 }
 
 void CStreamingVwCacheFile::set_env(CVwEnvironment* env_to_use)
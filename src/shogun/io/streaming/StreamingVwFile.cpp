@@ -53,16 +53,40 @@ void CStreamingVwFile::set_parser_type(E_VW_PARSER_TYPE type)
 
 void CStreamingVwFile::get_vector(VwExample* &ex, int32_t &len)
 {
+	/* ring slots are empty until the parser first fills them */
+	bool new_example = (ex == NULL);
+	if (new_example)
+		ex = SG_MALLOC(VwExample, 1);
+
 	len = (parser->*parse_example)(buf, ex);
 	if (len == 0)
+	{
 		len = -1;	// indicates failure
+		if (new_example)
+		{
+			SG_FREE(ex);
+			ex = NULL;
+		}
+	}
 }
 
 void CStreamingVwFile::get_vector_and_label(VwExample* &ex, int32_t &len, float64_t &label)
 {
+	/* ring slots are empty until the parser first fills them */
+	bool new_example = (ex == NULL);
+	if (new_example)
+		ex = SG_MALLOC(VwExample, 1);
+
 	len = (parser->*parse_example)(buf, ex);
 	if (len == 0)
+	{
 		len = -1;	// indicates failure
+		if (new_example)
+		{
+			SG_FREE(ex);
+			ex = NULL;
+		}
+	}
 }
 
 void CStreamingVwFile::init()
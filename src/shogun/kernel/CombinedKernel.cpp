@@ -165,12 +165,14 @@ bool CCombinedKernel::init(CFeatures* l, CFeatures* r)
 		SG_ERROR("CombinedKernel: Number of features/kernels does not match - bailing out\n")
 
 	init_normalizer();
+	clear_subkernel_row_cache();
 	initialized=true;
 	return true;
 }
 
 void CCombinedKernel::remove_lhs()
 {
+	clear_subkernel_row_cache();
 	delete_optimization();
 
 	for (index_t k_idx=0; k_idx<get_num_kernels(); k_idx++)
@@ -188,6 +190,7 @@ void CCombinedKernel::remove_lhs()
 
 void CCombinedKernel::remove_rhs()
 {
+	clear_subkernel_row_cache();
 	delete_optimization();
 
 	for (index_t k_idx=0; k_idx<get_num_kernels(); k_idx++)
@@ -205,6 +208,7 @@ void CCombinedKernel::remove_rhs()
 
 void CCombinedKernel::remove_lhs_and_rhs()
 {
+	clear_subkernel_row_cache();
 	delete_optimization();
 
 	for (index_t k_idx=0; k_idx<get_num_kernels(); k_idx++)
@@ -224,6 +228,7 @@ void CCombinedKernel::remove_lhs_and_rhs()
 
 void CCombinedKernel::cleanup()
 {
+	clear_subkernel_row_cache();
 	for (index_t k_idx=0; k_idx<get_num_kernels(); k_idx++)
 	{
 		CKernel* k = get_kernel(k_idx);
@@ -635,6 +640,116 @@ void CCombinedKernel::compute_by_subkernel(
 	}
 }
 
+void CCombinedKernel::compute_by_subkernel_batch(int32_t num_vec,
+	int32_t* vec_idx, float64_t* subkernel_contrib)
+{
+	int32_t num_subkernels=get_num_subkernels();
+	int32_t i=0;
+
+	for (index_t k_idx=0; k_idx<get_num_kernels(); k_idx++)
+	{
+		CKernel* k = get_kernel(k_idx);
+		int32_t num=1;
+		if (append_subkernel_weights)
+			k->get_subkernel_weights(num);
+
+		if (append_subkernel_weights && num>1)
+		{
+			float64_t* contrib=SG_CALLOC(float64_t, int64_t(num_vec)*num);
+			k->compute_by_subkernel_batch(num_vec, vec_idx, contrib);
+
+			for (int32_t v=0; v<num_vec; v++)
+			{
+				for (int32_t j=0; j<num; j++)
+					subkernel_contrib[int64_t(v)*num_subkernels+i+j]+=contrib[int64_t(v)*num+j];
+			}
+			SG_FREE(contrib);
+		}
+		else
+		{
+			float64_t weight=k->get_combined_kernel_weight();
+			if (weight!=0)
+			{
+				#pragma omp parallel for num_threads(parallel->get_num_threads())
+				for (int32_t v=0; v<num_vec; v++)
+					subkernel_contrib[int64_t(v)*num_subkernels+i]+=weight*k->compute_optimized(vec_idx[v]);
+			}
+		}
+
+		SG_UNREF(k);
+		i += num;
+	}
+}
+
+SGMatrix<float64_t> CCombinedKernel::get_subkernel_rows(int32_t idx)
+{
+	REQUIRE(idx>=0 && idx<num_lhs, "%s::get_subkernel_rows(): index %d out "
+			"of range [0,%d)\n", get_name(), idx, num_lhs);
+
+	int32_t num_kernels=get_num_kernels();
+	int64_t row_size=int64_t(num_rhs)*num_kernels;
+	SGMatrix<float64_t> rows(num_rhs, num_kernels);
+
+	int32_t num_slots=0;
+	if (cache_size>0 && row_size>0)
+	{
+		num_slots=CMath::min(int64_t(num_lhs),
+				int64_t(cache_size)*1024*1024/(row_size*int64_t(sizeof(float64_t))));
+	}
+
+	if (num_slots>0 && m_row_cache_idx.vlen!=num_slots)
+	{
+		m_row_cache=SGVector<float64_t>(num_slots*row_size);
+		m_row_cache_idx=SGVector<int32_t>(num_slots);
+		m_row_cache_idx.set_const(-1);
+	}
+
+	int32_t slot=num_slots>0 ? idx%num_slots : -1;
+	if (slot>=0 && m_row_cache_idx[slot]==idx)
+	{
+		memcpy(rows.matrix, &m_row_cache[slot*row_size], row_size*sizeof(float64_t));
+		return rows;
+	}
+
+	CKernel** kernels=SG_MALLOC(CKernel*, num_kernels);
+	for (index_t k_idx=0; k_idx<num_kernels; k_idx++)
+		kernels[k_idx]=get_kernel(k_idx);
+
+	/* blocks of a row of every subkernel are evaluated in parallel */
+	const int32_t block_size=256;
+	int32_t num_blocks=(num_rhs+block_size-1)/block_size;
+
+	#pragma omp parallel for schedule(dynamic) num_threads(parallel->get_num_threads())
+	for (int32_t b=0; b<num_kernels*num_blocks; b++)
+	{
+		int32_t k_idx=b/num_blocks;
+		int32_t start=(b%num_blocks)*block_size;
+		int32_t end=CMath::min(start+block_size, num_rhs);
+		float64_t* col=rows.get_column_vector(k_idx);
+
+		for (int32_t j=start; j<end; j++)
+			col[j]=kernels[k_idx]->kernel(idx, j);
+	}
+
+	for (index_t k_idx=0; k_idx<num_kernels; k_idx++)
+		SG_UNREF(kernels[k_idx]);
+	SG_FREE(kernels);
+
+	if (slot>=0)
+	{
+		memcpy(&m_row_cache[slot*row_size], rows.matrix, row_size*sizeof(float64_t));
+		m_row_cache_idx[slot]=idx;
+	}
+
+	return rows;
+}
+
+void CCombinedKernel::clear_subkernel_row_cache()
+{
+	m_row_cache=SGVector<float64_t>();
+	m_row_cache_idx=SGVector<int32_t>();
+}
+
 const float64_t* CCombinedKernel::get_subkernel_weights(int32_t& num_weights)
 {
 	SG_DEBUG("entering CCombinedKernel::get_subkernel_weights()\n")
@@ -695,6 +810,9 @@ void CCombinedKernel::set_subkernel_weights(SGVector<float64_t> weights)
 {
 	if (append_subkernel_weights)
 	{
+		/* weights inside of subkernels change their rows */
+		clear_subkernel_row_cache();
+
 		int32_t i=0 ;
 		for (index_t k_idx=0; k_idx<get_num_kernels(); k_idx++)
 		{
@@ -753,6 +871,7 @@ bool CCombinedKernel::precompute_subkernels()
 	SG_UNREF(kernel_array);
 	kernel_array=new_kernel_array;
 	SG_REF(kernel_array);
+	clear_subkernel_row_cache();
 
 	return true;
 }
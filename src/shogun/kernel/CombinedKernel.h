@@ -151,6 +151,7 @@ class CCombinedKernel : public CKernel
 			if (!(k->has_property(KP_LINADD)))
 				unset_property(KP_LINADD);
 
+			clear_subkernel_row_cache();
 			return kernel_array->insert_element(k, idx);
 		}
 
@@ -167,6 +168,7 @@ class CCombinedKernel : public CKernel
 			if (!(k->has_property(KP_LINADD)))
 				unset_property(KP_LINADD);
 
+			clear_subkernel_row_cache();
 			int n = get_num_kernels();
 			kernel_array->push_back(k);
 			return n+1==get_num_kernels();
@@ -180,6 +182,7 @@ class CCombinedKernel : public CKernel
 		 */
 		inline bool delete_kernel(int32_t idx)
 		{
+			clear_subkernel_row_cache();
 			bool succesful_deletion = kernel_array->delete_element(idx);
 
 			if (get_num_kernels()==0)
@@ -330,6 +333,31 @@ class CCombinedKernel : public CKernel
 		virtual void compute_by_subkernel(
 			int32_t idx, float64_t * subkernel_contrib);
 
+		/** compute by subkernel for a batch of vectors, evaluating one
+		 * subkernel at a time for all vectors in parallel
+		 *
+		 * @param num_vec number of vectors
+		 * @param vec_idx indices of the vectors
+		 * @param subkernel_contrib subkernel contributions, get_num_subkernels()
+		 * consecutive entries per vector
+		 */
+		virtual void compute_by_subkernel_batch(int32_t num_vec,
+			int32_t* vec_idx, float64_t* subkernel_contrib);
+
+		/** get the unweighted rows of all contained kernels for a lhs vector,
+		 * i.e. column k holds \f$k_k(x_{idx}, y_j)\f$ for all rhs vectors
+		 * \f$y_j\f$. The subkernels are evaluated in parallel.
+		 *
+		 * Rows are kept in a per-subkernel row cache of cache_size MB. As the
+		 * rows do not depend on the combined kernel weights, they stay valid
+		 * when the weights change, e.g. between MKL steps. The cache is
+		 * cleared when features or kernels are changed through this class.
+		 *
+		 * @param idx index of the lhs vector
+		 * @return matrix of size num_rhs x get_num_kernels()
+		 */
+		SGMatrix<float64_t> get_subkernel_rows(int32_t idx);
+
 		/** get subkernel weights
 		 *
 		 * @param num_weights where number of weights is stored
@@ -451,6 +479,9 @@ class CCombinedKernel : public CKernel
 				initialized=false;
 		}
 
+		/** invalidate all rows in the subkernel row cache */
+		void clear_subkernel_row_cache();
+
 	private:
 		void init();
 
@@ -469,6 +500,12 @@ class CCombinedKernel : public CKernel
 		bool append_subkernel_weights;
 		/** whether kernel is ready to be used */
 		bool initialized;
+
+	private:
+		/** cached subkernel rows, num_rhs x get_num_kernels() per slot */
+		SGVector<float64_t> m_row_cache;
+		/** lhs index of the row stored in each cache slot, -1 if empty */
+		SGVector<int32_t> m_row_cache_idx;
 };
 }
 #endif /* _COMBINEDKERNEL_H__ */
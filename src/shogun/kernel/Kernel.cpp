@@ -211,6 +211,9 @@ void CKernel::kernel_cache_init(int32_t buffsize, bool regression_hack)
 	kernel_cache.buffer = SG_MALLOC(KERNELCACHE_ELEM, buffer_size);
 	kernel_cache.buffsize=buffer_size;
 	kernel_cache.max_elems=(int32_t) (kernel_cache.buffsize/totdoc);
+	kernel_cache.num_bytes=buffer_size*sizeof(KERNELCACHE_ELEM)+
+		6*((int64_t) totdoc)*sizeof(int32_t);
+	sg_memory_charge(MEMORY_TAG_KERNEL_CACHE, kernel_cache.num_bytes);
 
 	if(kernel_cache.max_elems>totdoc) {
 		kernel_cache.max_elems=totdoc;
@@ -311,6 +314,8 @@ void CKernel::cache_kernel_row(int32_t m)
 
 	if(!kernel_cache_check(m))   // not cached yet
 	{
+		SG_TRACE_SCOPE("CKernel::cache_kernel_row");
+		SG_TRACE_COUNT("kernel cache row misses", 1);
 		cache = kernel_cache_clean_and_malloc(m);
 		if(cache) {
 			l=kernel_cache.totdoc2active[m];
@@ -375,6 +380,7 @@ void* CKernel::cache_multiple_kernel_row_helper(void* p)
 // Fills cache for the rows in key
 void CKernel::cache_multiple_kernel_rows(int32_t* rows, int32_t num_rows)
 {
+	SG_TRACE_SCOPE("CKernel::cache_multiple_kernel_rows");
 #ifdef HAVE_PTHREAD
 	int32_t nthreads=parallel->get_num_threads();
 
@@ -495,6 +501,7 @@ void CKernel::cache_multiple_kernel_rows(int32_t* rows, int32_t num_rows)
 void CKernel::kernel_cache_shrink(
 	int32_t totdoc, int32_t numshrink, int32_t *after)
 {
+	SG_TRACE_SCOPE("CKernel::kernel_cache_shrink");
 	ASSERT(totdoc > 0);
 	register int32_t i,j,jj,scount;     // 0 in after.
 	KERNELCACHE_IDX from=0,to=0;
@@ -566,6 +573,9 @@ void CKernel::kernel_cache_reset_lru()
 
 void CKernel::kernel_cache_cleanup()
 {
+	if (kernel_cache.num_bytes)
+		sg_memory_release(MEMORY_TAG_KERNEL_CACHE, kernel_cache.num_bytes);
+
 	SG_FREE(kernel_cache.index);
 	SG_FREE(kernel_cache.occu);
 	SG_FREE(kernel_cache.lru);
@@ -766,6 +776,7 @@ void CKernel::list_kernel()
 		ENUM_CASE(K_CIRCULAR)
 		ENUM_CASE(K_INVERSEMULTIQUADRIC)
 		ENUM_CASE(K_SPECTRUMMISMATCHRBF)
+		ENUM_CASE(K_HASHEDSPECTRUM)
 		ENUM_CASE(K_DISTANTSEGMENTS)
 		ENUM_CASE(K_BESSEL)
 		ENUM_CASE(K_JENSENSHANNON)
@@ -872,6 +883,16 @@ void CKernel::compute_by_subkernel(
    SG_ERROR("kernel compute_by_subkernel not implemented\n")
 }
 
+void CKernel::compute_by_subkernel_batch(int32_t num_vec, int32_t* vec_idx,
+	float64_t* subkernel_contrib)
+{
+	int32_t num_subkernels=get_num_subkernels();
+
+	#pragma omp parallel for num_threads(parallel->get_num_threads())
+	for (int32_t i=0; i<num_vec; i++)
+		compute_by_subkernel(vec_idx[i], &subkernel_contrib[int64_t(i)*num_subkernels]);
+}
+
 const float64_t* CKernel::get_subkernel_weights(int32_t &num_weights)
 {
 	num_weights=1 ;
@@ -19,6 +19,7 @@
 
 #include <shogun/lib/common.h>
 #include <shogun/lib/Signal.h>
+#include <shogun/lib/Tracing.h>
 #include <shogun/io/SGIO.h>
 #include <shogun/io/File.h>
 #include <shogun/mathematics/Math.h>
@@ -78,6 +79,7 @@ enum EKernelType
 	K_COMMULONGSTRING = 121,
 	K_SPECTRUMRBF = 122,
 	K_SPECTRUMMISMATCHRBF = 123,
+	K_HASHEDSPECTRUM = 124,
 	K_COMBINED = 140,
 	K_AUC = 150,
 	K_CUSTOM = 160,
@@ -210,6 +212,7 @@ class CKernel : public CSGObject
 				"%s::kernel(): index out of Range: idx_a=%d/%d idx_b=%d/%d\n",
 				get_name(), idx_a,num_lhs, idx_b,num_rhs);
 
+			SG_TRACE_HOT_SCOPE("CKernel::kernel");
 			return normalizer->normalize(compute(idx_a, idx_b), idx_a, idx_b);
 		}
 
@@ -822,6 +825,19 @@ class CKernel : public CSGObject
 		virtual void compute_by_subkernel(
 			int32_t vector_idx, float64_t * subkernel_contrib);
 
+		/** compute by subkernel for a batch of vectors
+		 *
+		 * The default implementation calls compute_by_subkernel for the
+		 * vectors in parallel.
+		 *
+		 * @param num_vec number of vectors
+		 * @param vec_idx indices of the vectors
+		 * @param subkernel_contrib subkernel contributions, get_num_subkernels()
+		 * consecutive entries per vector
+		 */
+		virtual void compute_by_subkernel_batch(int32_t num_vec,
+			int32_t* vec_idx, float64_t* subkernel_contrib);
+
 		/** get subkernel weights
 		 *
 		 * @param num_weights number of weights will be stored here
@@ -1006,6 +1022,8 @@ class CKernel : public CSGObject
 			KERNELCACHE_ELEM  *buffer;
 			/** buffer size */
 			KERNELCACHE_IDX   buffsize;
+			/** bytes charged to the kernel cache memory tag */
+			int64_t   num_bytes;
 		};
 
 		/** kernel thread parameters */
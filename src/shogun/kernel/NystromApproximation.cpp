@@ -0,0 +1,420 @@
+/*
+ * Copyright (c) The Shogun Machine Learning Toolbox
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation are those
+ * of the authors and should not be interpreted as representing official policies,
+ * either expressed or implied, of the Shogun Development Team.
+ *
+ */
+
+#include <shogun/kernel/NystromApproximation.h>
+#include <shogun/mathematics/Math.h>
+#include <shogun/mathematics/eigen3.h>
+#include <shogun/base/Parallel.h>
+#include <shogun/io/SGIO.h>
+
+using namespace shogun;
+using namespace Eigen;
+
+CNystromApproximation::CNystromApproximation() : CSGObject()
+{
+	init();
+}
+
+CNystromApproximation::CNystromApproximation(CKernel* kernel,
+		int32_t num_landmarks, ENystromLandmarkSelection selection)
+: CSGObject()
+{
+	init();
+	set_kernel(kernel);
+	set_num_landmarks(num_landmarks);
+	m_landmark_selection = selection;
+}
+
+CNystromApproximation::~CNystromApproximation()
+{
+	SG_UNREF(m_kernel);
+	SG_UNREF(m_features);
+}
+
+void CNystromApproximation::init()
+{
+	m_kernel = NULL;
+	m_features = NULL;
+	m_num_landmarks = 100;
+	m_landmark_selection = NLS_UNIFORM;
+	m_leverage_ridge = 1e-3;
+
+	SG_ADD((CSGObject**)&m_kernel, "kernel", "kernel to approximate",
+			MS_AVAILABLE);
+	SG_ADD((CSGObject**)&m_features, "features", "training features",
+			MS_NOT_AVAILABLE);
+	SG_ADD(&m_num_landmarks, "num_landmarks", "number of landmarks",
+			MS_AVAILABLE);
+	SG_ADD((machine_int_t*) &m_landmark_selection, "landmark_selection",
+			"landmark selection strategy", MS_NOT_AVAILABLE);
+	SG_ADD(&m_leverage_ridge, "leverage_ridge",
+			"ridge used to estimate leverage scores", MS_AVAILABLE);
+	SG_ADD(&m_landmarks, "landmarks", "indices of landmarks",
+			MS_NOT_AVAILABLE);
+	SG_ADD(&m_factor, "factor", "low-rank factor of kernel matrix",
+			MS_NOT_AVAILABLE);
+	SG_ADD(&m_landmark_transform, "landmark_transform",
+			"transform of landmark kernel values into factor space",
+			MS_NOT_AVAILABLE);
+}
+
+bool CNystromApproximation::compute(CFeatures* features)
+{
+	REQUIRE(m_kernel, "Kernel must be set\n")
+	REQUIRE(features, "Features must be provided\n")
+
+	SG_REF(features);
+	SG_UNREF(m_features);
+	m_features = features;
+
+	int32_t num_vectors = features->get_num_vectors();
+	int32_t num_landmarks = CMath::min(m_num_landmarks, num_vectors);
+	if (num_landmarks<m_num_landmarks)
+	{
+		SG_WARNING("Number of landmarks (%d) exceeds number of vectors (%d)\n",
+				m_num_landmarks, num_vectors)
+	}
+
+	m_kernel->init(features, features);
+
+	SGMatrix<float64_t> columns;
+	switch (m_landmark_selection)
+	{
+		case NLS_UNIFORM:
+			m_landmarks = select_uniform(num_vectors);
+			columns = compute_columns(m_landmarks);
+			break;
+		case NLS_KMEANS_PLUS_PLUS:
+			m_landmarks = select_kmeans_plus_plus(num_vectors, columns);
+			break;
+		case NLS_LEVERAGE_SCORES:
+			m_landmarks = select_leverage_scores(num_vectors);
+			columns = compute_columns(m_landmarks);
+			break;
+		default:
+			SG_ERROR("Unknown landmark selection strategy %d\n",
+					m_landmark_selection)
+	}
+
+	compute_factor_from_columns(columns, m_landmarks, m_factor,
+			m_landmark_transform);
+	SG_DEBUG("Nystrom approximation of rank %d from %d landmarks\n",
+			m_factor.num_cols, m_landmarks.vlen)
+
+	return true;
+}
+
+SGMatrix<float64_t> CNystromApproximation::compute_columns(SGVector<index_t> landmarks)
+{
+	int32_t num_vectors = m_kernel->get_num_vec_lhs();
+	int32_t num_landmarks = landmarks.vlen;
+	SGMatrix<float64_t> columns(num_vectors, num_landmarks);
+
+	#pragma omp parallel for num_threads(parallel->get_num_threads())
+	for (int32_t i=0; i<num_vectors; i++)
+	{
+		for (int32_t j=0; j<num_landmarks; j++)
+			columns(i,j) = m_kernel->kernel(i, landmarks[j]);
+	}
+
+	return columns;
+}
+
+void CNystromApproximation::compute_factor_from_columns(SGMatrix<float64_t> columns,
+		SGVector<index_t> landmarks, SGMatrix<float64_t>& factor,
+		SGMatrix<float64_t>& transform)
+{
+	int32_t num_vectors = columns.num_rows;
+	int32_t num_landmarks = landmarks.vlen;
+	Map<MatrixXd> eigen_columns(columns.matrix, num_vectors, num_landmarks);
+
+	MatrixXd landmark_matrix(num_landmarks, num_landmarks);
+	for (int32_t i=0; i<num_landmarks; i++)
+		landmark_matrix.row(i) = eigen_columns.row(landmarks[i]);
+
+	SelfAdjointEigenSolver<MatrixXd> solver(landmark_matrix);
+	const VectorXd& eigenvalues = solver.eigenvalues();
+
+	// drop numerically zero (and negative) eigenvalues, they are ascending
+	float64_t tolerance = CMath::max(eigenvalues.maxCoeff(), 0.0)*
+		num_landmarks*CMath::MACHINE_EPSILON;
+	int32_t rank = 0;
+	while (rank<num_landmarks && eigenvalues[num_landmarks-rank-1]>tolerance)
+		rank++;
+	REQUIRE(rank>0, "Kernel matrix of landmarks is numerically zero\n")
+
+	transform = SGMatrix<float64_t>(num_landmarks, rank);
+	Map<MatrixXd> eigen_transform(transform.matrix, num_landmarks, rank);
+	for (int32_t j=0; j<rank; j++)
+	{
+		int32_t idx = num_landmarks-j-1;
+		eigen_transform.col(j) = solver.eigenvectors().col(idx)/
+			CMath::sqrt(eigenvalues[idx]);
+	}
+
+	factor = SGMatrix<float64_t>(num_vectors, rank);
+	Map<MatrixXd> eigen_factor(factor.matrix, num_vectors, rank);
+	eigen_factor = eigen_columns*eigen_transform;
+}
+
+SGMatrix<float64_t> CNystromApproximation::compute_factor(CFeatures* features)
+{
+	REQUIRE(m_features, "Approximation was not computed\n")
+	REQUIRE(features, "Features must be provided\n")
+
+	m_kernel->init(features, m_features);
+	SGMatrix<float64_t> columns = compute_columns(m_landmarks);
+
+	int32_t rank = m_landmark_transform.num_cols;
+	SGMatrix<float64_t> factor(columns.num_rows, rank);
+	Map<MatrixXd> eigen_columns(columns.matrix, columns.num_rows, columns.num_cols);
+	Map<MatrixXd> eigen_transform(m_landmark_transform.matrix,
+			m_landmark_transform.num_rows, rank);
+	Map<MatrixXd> eigen_factor(factor.matrix, columns.num_rows, rank);
+	eigen_factor = eigen_columns*eigen_transform;
+
+	return factor;
+}
+
+SGVector<index_t> CNystromApproximation::select_uniform(int32_t num_vectors)
+{
+	int32_t num_landmarks = CMath::min(m_num_landmarks, num_vectors);
+
+	SGVector<index_t> permutation(num_vectors);
+	permutation.range_fill();
+	CMath::permute(permutation);
+
+	SGVector<index_t> landmarks(num_landmarks);
+	for (int32_t i=0; i<num_landmarks; i++)
+		landmarks[i] = permutation[i];
+
+	return landmarks;
+}
+
+SGVector<index_t> CNystromApproximation::select_kmeans_plus_plus(int32_t num_vectors,
+		SGMatrix<float64_t>& columns)
+{
+	int32_t num_landmarks = CMath::min(m_num_landmarks, num_vectors);
+
+	SGVector<index_t> landmarks(num_landmarks);
+	columns = SGMatrix<float64_t>(num_vectors, num_landmarks);
+
+	SGVector<float64_t> diagonal(num_vectors);
+	for (int32_t i=0; i<num_vectors; i++)
+		diagonal[i] = m_kernel->kernel(i,i);
+
+	// squared feature space distance to closest landmark so far
+	SGVector<float64_t> min_distance(num_vectors);
+	min_distance.set_const(CMath::INFTY);
+
+	landmarks[0] = CMath::random(0, num_vectors-1);
+	for (int32_t j=0; j<num_landmarks; j++)
+	{
+		index_t landmark = landmarks[j];
+		float64_t total = 0.0;
+
+		#pragma omp parallel for num_threads(parallel->get_num_threads()) reduction(+:total)
+		for (int32_t i=0; i<num_vectors; i++)
+		{
+			columns(i,j) = m_kernel->kernel(i, landmark);
+			float64_t distance = CMath::max(0.0,
+					diagonal[i]-2*columns(i,j)+diagonal[landmark]);
+			min_distance[i] = CMath::min(min_distance[i], distance);
+			total += min_distance[i];
+		}
+
+		if (j+1==num_landmarks)
+			break;
+
+		// all remaining vectors coincide with landmarks in feature space
+		if (total<=0.0)
+		{
+			SG_WARNING("Only %d distinct landmarks could be selected\n", j+1)
+			landmarks.resize_vector(j+1);
+			SGMatrix<float64_t> selected(num_vectors, j+1);
+			memcpy(selected.matrix, columns.matrix, sizeof(float64_t)*num_vectors*(j+1));
+			columns = selected;
+			break;
+		}
+
+		float64_t threshold = CMath::random(0.0, total);
+		float64_t cumulative = 0.0;
+		index_t next = num_vectors-1;
+		for (int32_t i=0; i<num_vectors; i++)
+		{
+			cumulative += min_distance[i];
+			if (min_distance[i]>0 && cumulative>=threshold)
+			{
+				next = i;
+				break;
+			}
+		}
+		landmarks[j+1] = next;
+	}
+
+	return landmarks;
+}
+
+SGVector<index_t> CNystromApproximation::select_leverage_scores(int32_t num_vectors)
+{
+	int32_t num_landmarks = CMath::min(m_num_landmarks, num_vectors);
+
+	// pilot approximation from uniform landmarks
+	SGVector<index_t> pilot_landmarks = select_uniform(num_vectors);
+	SGMatrix<float64_t> pilot_columns = compute_columns(pilot_landmarks);
+	SGMatrix<float64_t> pilot_factor;
+	SGMatrix<float64_t> pilot_transform;
+	compute_factor_from_columns(pilot_columns, pilot_landmarks, pilot_factor,
+			pilot_transform);
+
+	int32_t rank = pilot_factor.num_cols;
+	Map<MatrixXd> factor(pilot_factor.matrix, num_vectors, rank);
+
+	// ridge leverage scores l_i = f_i^T (F^T F + lambda I)^{-1} f_i
+	MatrixXd gram = factor.transpose()*factor;
+	float64_t ridge = m_leverage_ridge*gram.trace()/rank;
+	gram.diagonal().array() += ridge;
+	MatrixXd solved = gram.llt().solve(factor.transpose());
+
+	SGVector<float64_t> scores(num_vectors);
+	for (int32_t i=0; i<num_vectors; i++)
+		scores[i] = CMath::max(factor.row(i).dot(solved.col(i)), 0.0);
+
+	// weighted sampling without replacement
+	SGVector<index_t> landmarks(num_landmarks);
+	float64_t total = SGVector<float64_t>::sum(scores);
+	for (int32_t j=0; j<num_landmarks; j++)
+	{
+		index_t next = -1;
+		if (total>0)
+		{
+			float64_t threshold = CMath::random(0.0, total);
+			float64_t cumulative = 0.0;
+			for (int32_t i=0; i<num_vectors; i++)
+			{
+				cumulative += scores[i];
+				if (scores[i]>0 && cumulative>=threshold)
+				{
+					next = i;
+					break;
+				}
+			}
+		}
+
+		// remaining scores vanished, fall back to first unused vector
+		if (next<0)
+		{
+			for (int32_t i=0; i<num_vectors && next<0; i++)
+			{
+				if (scores[i]>=0)
+					next = i;
+			}
+		}
+
+		landmarks[j] = next;
+		total -= scores[next];
+		scores[next] = -1.0;
+		total = CMath::max(total, 0.0);
+	}
+
+	return landmarks;
+}
+
+SGMatrix<float64_t> CNystromApproximation::get_factor() const
+{
+	return m_factor;
+}
+
+SGMatrix<float64_t> CNystromApproximation::get_landmark_transform() const
+{
+	return m_landmark_transform;
+}
+
+SGVector<index_t> CNystromApproximation::get_landmarks() const
+{
+	return m_landmarks;
+}
+
+CFeatures* CNystromApproximation::get_features() const
+{
+	SG_REF(m_features);
+	return m_features;
+}
+
+int32_t CNystromApproximation::get_rank() const
+{
+	return m_factor.num_cols;
+}
+
+void CNystromApproximation::set_kernel(CKernel* kernel)
+{
+	SG_REF(kernel);
+	SG_UNREF(m_kernel);
+	m_kernel = kernel;
+}
+
+CKernel* CNystromApproximation::get_kernel() const
+{
+	SG_REF(m_kernel);
+	return m_kernel;
+}
+
+void CNystromApproximation::set_num_landmarks(int32_t num_landmarks)
+{
+	REQUIRE(num_landmarks>0, "Number of landmarks (%d) must be positive\n",
+			num_landmarks)
+	m_num_landmarks = num_landmarks;
+}
+
+int32_t CNystromApproximation::get_num_landmarks() const
+{
+	return m_num_landmarks;
+}
+
+void CNystromApproximation::set_landmark_selection(ENystromLandmarkSelection selection)
+{
+	m_landmark_selection = selection;
+}
+
+ENystromLandmarkSelection CNystromApproximation::get_landmark_selection() const
+{
+	return m_landmark_selection;
+}
+
+void CNystromApproximation::set_leverage_ridge(float64_t ridge)
+{
+	REQUIRE(ridge>0, "Leverage ridge (%f) must be positive\n", ridge)
+	m_leverage_ridge = ridge;
+}
+
+float64_t CNystromApproximation::get_leverage_ridge() const
+{
+	return m_leverage_ridge;
+}
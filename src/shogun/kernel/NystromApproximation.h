@@ -0,0 +1,261 @@
+/*
+ * Copyright (c) The Shogun Machine Learning Toolbox
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation are those
+ * of the authors and should not be interpreted as representing official policies,
+ * either expressed or implied, of the Shogun Development Team.
+ *
+ */
+
+#ifndef NYSTROMAPPROXIMATION_H_
+#define NYSTROMAPPROXIMATION_H_
+
+#include <shogun/lib/config.h>
+
+#include <shogun/base/SGObject.h>
+#include <shogun/lib/SGMatrix.h>
+#include <shogun/lib/SGVector.h>
+#include <shogun/features/Features.h>
+#include <shogun/kernel/Kernel.h>
+
+namespace shogun
+{
+
+/** strategy to select landmarks of Nystrom approximation */
+enum ENystromLandmarkSelection
+{
+	/** landmarks are sampled uniformly without replacement */
+	NLS_UNIFORM = 0,
+	/** landmarks are sampled with k-means++ seeding in kernel
+	 * induced feature space, i.e. proportionally to squared distance
+	 * to the closest landmark chosen so far
+	 */
+	NLS_KMEANS_PLUS_PLUS = 10,
+	/** landmarks are sampled without replacement proportionally to
+	 * ridge leverage scores estimated from a uniform pilot sample
+	 */
+	NLS_LEVERAGE_SCORES = 20
+};
+
+/** @brief Nystrom low-rank approximation of a kernel matrix.
+ *
+ * Given \f$m\f$ landmarks \f$l_1,\dots,l_m\f$ selected among the
+ * \f$n\f$ training vectors, the kernel matrix is approximated as
+ *
+ * \f[
+ *	K \approx C W^{+} C^T = F F^T
+ * \f]
+ *
+ * where \f$C_{ij}=k(x_i,l_j)\f$, \f$W_{ij}=k(l_i,l_j)\f$ and
+ * \f$F = C U \Lambda^{-1/2}\f$ with \f$W=U\Lambda U^T\f$ (eigenvalues that
+ * are numerically zero are dropped). Rows of the \f$n\times r\f$ factor
+ * \f$F\f$ act as explicit \f$r\f$-dimensional feature maps of training
+ * vectors, new vectors are mapped with compute_factor using only \f$m\f$
+ * kernel evaluations each.
+ *
+ * Computing the approximation takes \f$O(nm)\f$ kernel evaluations and
+ * \f$O(nm^2)\f$ time, the kernel matrix is never formed.
+ *
+ * See Williams, C., & Seeger, M. (2001). Using the Nystrom method to
+ * speed up kernel machines. Advances in Neural Information Processing
+ * Systems 13 and Alaoui, A., & Mahoney, M. W. (2015). Fast randomized
+ * kernel ridge regression with statistical guarantees. Advances in
+ * Neural Information Processing Systems 28 (leverage score sampling).
+ */
+class CNystromApproximation : public CSGObject
+{
+public:
+
+	/** default constructor */
+	CNystromApproximation();
+
+	/** constructor
+	 *
+	 * @param kernel kernel to approximate
+	 * @param num_landmarks number of landmarks
+	 * @param selection landmark selection strategy
+	 */
+	CNystromApproximation(CKernel* kernel, int32_t num_landmarks,
+			ENystromLandmarkSelection selection=NLS_UNIFORM);
+
+	/** destructor */
+	virtual ~CNystromApproximation();
+
+	/** selects landmarks among given features and computes the
+	 * low-rank factor of their kernel matrix
+	 *
+	 * @param features training features
+	 * @return whether computation was successful
+	 */
+	bool compute(CFeatures* features);
+
+	/** maps features to the space spanned by the low-rank factor,
+	 * i.e. computes \f$\Lambda^{-1/2} U^T k_l(x)\f$ for each vector
+	 * where \f$k_l(x)\f$ are kernel values between the vector and
+	 * the landmarks
+	 *
+	 * @param features features to map (compatible with kernel)
+	 * @return factor with one row per vector and rank columns
+	 */
+	SGMatrix<float64_t> compute_factor(CFeatures* features);
+
+	/** @return low-rank factor of training kernel matrix with one row
+	 * per training vector and rank columns
+	 */
+	SGMatrix<float64_t> get_factor() const;
+
+	/** @return transform of kernel values against landmarks into the
+	 * factor space, \f$U\Lambda^{-1/2}\f$ with one row per landmark and
+	 * rank columns
+	 */
+	SGMatrix<float64_t> get_landmark_transform() const;
+
+	/** @return indices of landmarks in training features */
+	SGVector<index_t> get_landmarks() const;
+
+	/** @return features the approximation was computed for */
+	CFeatures* get_features() const;
+
+	/** @return rank of the approximation */
+	int32_t get_rank() const;
+
+	/** setter for kernel
+	 * @param kernel kernel to approximate
+	 */
+	void set_kernel(CKernel* kernel);
+
+	/** @return kernel */
+	CKernel* get_kernel() const;
+
+	/** setter for number of landmarks
+	 * @param num_landmarks number of landmarks
+	 */
+	void set_num_landmarks(int32_t num_landmarks);
+
+	/** @return number of landmarks */
+	int32_t get_num_landmarks() const;
+
+	/** setter for landmark selection strategy
+	 * @param selection landmark selection strategy
+	 */
+	void set_landmark_selection(ENystromLandmarkSelection selection);
+
+	/** @return landmark selection strategy */
+	ENystromLandmarkSelection get_landmark_selection() const;
+
+	/** setter for ridge used to estimate leverage scores, relative
+	 * to the mean eigenvalue of the pilot approximation
+	 * @param ridge ridge
+	 */
+	void set_leverage_ridge(float64_t ridge);
+
+	/** @return ridge used to estimate leverage scores */
+	float64_t get_leverage_ridge() const;
+
+	/** @return object name */
+	virtual const char* get_name() const { return "NystromApproximation"; }
+
+protected:
+
+	/** computes kernel values between all training vectors and
+	 * the given landmarks, kernel must be initialized with training
+	 * features on both sides
+	 *
+	 * @param landmarks indices of landmarks
+	 * @return matrix with one row per training vector and one column
+	 * per landmark
+	 */
+	SGMatrix<float64_t> compute_columns(SGVector<index_t> landmarks);
+
+	/** computes factor and landmark transform from kernel columns
+	 * of landmarks
+	 *
+	 * @param columns kernel values between training vectors and landmarks
+	 * @param landmarks indices of landmarks
+	 * @param factor computed low-rank factor
+	 * @param transform computed landmark transform
+	 */
+	void compute_factor_from_columns(SGMatrix<float64_t> columns,
+			SGVector<index_t> landmarks, SGMatrix<float64_t>& factor,
+			SGMatrix<float64_t>& transform);
+
+	/** selects landmarks uniformly without replacement
+	 * @param num_vectors number of training vectors
+	 * @return indices of landmarks
+	 */
+	SGVector<index_t> select_uniform(int32_t num_vectors);
+
+	/** selects landmarks with kernel k-means++ seeding, the kernel
+	 * columns of the landmarks are computed along the way
+	 *
+	 * @param num_vectors number of training vectors
+	 * @param columns computed kernel columns of landmarks
+	 * @return indices of landmarks
+	 */
+	SGVector<index_t> select_kmeans_plus_plus(int32_t num_vectors,
+			SGMatrix<float64_t>& columns);
+
+	/** selects landmarks proportionally to ridge leverage scores
+	 * estimated with a uniform pilot approximation
+	 *
+	 * @param num_vectors number of training vectors
+	 * @return indices of landmarks
+	 */
+	SGVector<index_t> select_leverage_scores(int32_t num_vectors);
+
+private:
+
+	/** register parameters */
+	void init();
+
+protected:
+
+	/** kernel to approximate */
+	CKernel* m_kernel;
+
+	/** training features */
+	CFeatures* m_features;
+
+	/** number of landmarks */
+	int32_t m_num_landmarks;
+
+	/** landmark selection strategy */
+	ENystromLandmarkSelection m_landmark_selection;
+
+	/** ridge used to estimate leverage scores */
+	float64_t m_leverage_ridge;
+
+	/** indices of landmarks */
+	SGVector<index_t> m_landmarks;
+
+	/** low-rank factor of training kernel matrix */
+	SGMatrix<float64_t> m_factor;
+
+	/** transform of landmark kernel values into factor space */
+	SGMatrix<float64_t> m_landmark_transform;
+};
+
+}
+
+#endif /* NYSTROMAPPROXIMATION_H_ */
@@ -0,0 +1,408 @@
+/*
+ * Copyright (c) The Shogun Machine Learning Toolbox
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation are those
+ * of the authors and should not be interpreted as representing official policies,
+ * either expressed or implied, of the Shogun Development Team.
+ *
+ */
+
+
+#include <shogun/lib/common.h>
+#include <shogun/kernel/string/HashedSpectrumStringKernel.h>
+#include <shogun/kernel/normalizer/SqrtDiagKernelNormalizer.h>
+#include <shogun/features/StringFeatures.h>
+#include <shogun/mathematics/Math.h>
+#include <shogun/base/Parallel.h>
+#include <shogun/io/SGIO.h>
+
+using namespace shogun;
+
+CHashedSpectrumStringKernel::CHashedSpectrumStringKernel(int32_t size,
+		int32_t hash_bits, bool use_sign)
+: CStringKernel<uint64_t>(size)
+{
+	init();
+	REQUIRE(hash_bits>=0 && hash_bits<64, "Number of hash bits (%d) must be "
+			"in 0..63\n", hash_bits);
+	m_hash_bits=hash_bits;
+	m_use_sign=use_sign;
+}
+
+CHashedSpectrumStringKernel::CHashedSpectrumStringKernel(
+	CStringFeatures<uint64_t>* l, CStringFeatures<uint64_t>* r,
+	int32_t hash_bits, bool use_sign, int32_t size)
+: CStringKernel<uint64_t>(size)
+{
+	init();
+	REQUIRE(hash_bits>=0 && hash_bits<64, "Number of hash bits (%d) must be "
+			"in 0..63\n", hash_bits);
+	m_hash_bits=hash_bits;
+	m_use_sign=use_sign;
+	init(l, r);
+}
+
+CHashedSpectrumStringKernel::~CHashedSpectrumStringKernel()
+{
+	cleanup();
+}
+
+void CHashedSpectrumStringKernel::init()
+{
+	properties |= KP_LINADD | KP_BATCHEVALUATION;
+	m_hash_bits=0;
+	m_use_sign=false;
+	m_num_normal_entries=0;
+	m_spectra_lhs=NULL;
+	set_normalizer(new CSqrtDiagKernelNormalizer());
+
+	SG_ADD(&m_hash_bits, "hash_bits", "Number of bits k-mers are hashed to",
+		MS_NOT_AVAILABLE);
+	SG_ADD(&m_use_sign, "use_sign", "Whether only presence of k-mers counts",
+		MS_NOT_AVAILABLE);
+}
+
+bool CHashedSpectrumStringKernel::init(CFeatures* l, CFeatures* r)
+{
+	CStringKernel<uint64_t>::init(l,r);
+
+	compute_spectra((CStringFeatures<uint64_t>*) lhs, m_lhs_keys,
+			m_lhs_counts, m_lhs_offsets);
+	m_spectra_lhs=lhs;
+	if (lhs==rhs)
+	{
+		m_rhs_keys=m_lhs_keys;
+		m_rhs_counts=m_lhs_counts;
+		m_rhs_offsets=m_lhs_offsets;
+	}
+	else
+	{
+		compute_spectra((CStringFeatures<uint64_t>*) rhs, m_rhs_keys,
+				m_rhs_counts, m_rhs_offsets);
+	}
+
+	return init_normalizer();
+}
+
+void CHashedSpectrumStringKernel::cleanup()
+{
+	delete_optimization();
+
+	m_lhs_keys=SGVector<uint64_t>();
+	m_lhs_counts=SGVector<float64_t>();
+	m_lhs_offsets=SGVector<int64_t>();
+	m_rhs_keys=SGVector<uint64_t>();
+	m_rhs_counts=SGVector<float64_t>();
+	m_rhs_offsets=SGVector<int64_t>();
+	m_spectra_lhs=NULL;
+
+	CKernel::cleanup();
+}
+
+void CHashedSpectrumStringKernel::remove_lhs()
+{
+	delete_optimization();
+
+	if (rhs==lhs)
+	{
+		m_rhs_keys=SGVector<uint64_t>();
+		m_rhs_counts=SGVector<float64_t>();
+		m_rhs_offsets=SGVector<int64_t>();
+	}
+	m_lhs_keys=SGVector<uint64_t>();
+	m_lhs_counts=SGVector<float64_t>();
+	m_lhs_offsets=SGVector<int64_t>();
+	m_spectra_lhs=NULL;
+
+	CStringKernel<uint64_t>::remove_lhs();
+}
+
+void CHashedSpectrumStringKernel::remove_rhs()
+{
+	m_rhs_keys=SGVector<uint64_t>();
+	m_rhs_counts=SGVector<float64_t>();
+	m_rhs_offsets=SGVector<int64_t>();
+
+	CStringKernel<uint64_t>::remove_rhs();
+}
+
+void CHashedSpectrumStringKernel::compute_spectra(CStringFeatures<uint64_t>* f,
+		SGVector<uint64_t>& keys, SGVector<float64_t>& counts,
+		SGVector<int64_t>& offsets)
+{
+	ASSERT(f)
+	int32_t num_vectors=f->get_num_vectors();
+
+	/* k-mers of string i are sorted and counted in place at start[i] */
+	SGVector<int64_t> start(num_vectors+1);
+	start[0]=0;
+	for (int32_t i=0; i<num_vectors; i++)
+		start[i+1]=start[i]+f->get_vector_length(i);
+
+	SGVector<uint64_t> buf_keys(CMath::max(start[num_vectors], (int64_t) 1));
+	SGVector<float64_t> buf_counts(buf_keys.vlen);
+	SGVector<int64_t> num_keys(num_vectors);
+	uint64_t mask=m_hash_bits ? (((uint64_t) 1)<<m_hash_bits)-1 : 0;
+
+	#pragma omp parallel for num_threads(parallel->get_num_threads())
+	for (int32_t i=0; i<num_vectors; i++)
+	{
+		int32_t len;
+		bool free_vec;
+		uint64_t* vec=f->get_feature_vector(i, len, free_vec);
+		uint64_t* k=&buf_keys.vector[start[i]];
+		float64_t* c=&buf_counts.vector[start[i]];
+
+		if (m_hash_bits)
+		{
+			for (int32_t j=0; j<len; j++)
+				k[j]=mix(vec[j]) & mask;
+		}
+		else
+			memcpy(k, vec, sizeof(uint64_t)*len);
+		f->free_feature_vector(vec, i, free_vec);
+
+		CMath::qsort(k, len);
+
+		int64_t n=0;
+		for (int32_t j=0; j<len; j++)
+		{
+			if (n>0 && k[n-1]==k[j])
+				c[n-1]++;
+			else
+			{
+				k[n]=k[j];
+				c[n]=1;
+				n++;
+			}
+		}
+
+		if (m_use_sign)
+		{
+			for (int64_t j=0; j<n; j++)
+				c[j]=1;
+		}
+		num_keys[i]=n;
+	}
+
+	offsets=SGVector<int64_t>(num_vectors+1);
+	offsets[0]=0;
+	for (int32_t i=0; i<num_vectors; i++)
+		offsets[i+1]=offsets[i]+num_keys[i];
+
+	keys=SGVector<uint64_t>(CMath::max(offsets[num_vectors], (int64_t) 1));
+	counts=SGVector<float64_t>(keys.vlen);
+
+	#pragma omp parallel for num_threads(parallel->get_num_threads())
+	for (int32_t i=0; i<num_vectors; i++)
+	{
+		memcpy(&keys.vector[offsets[i]], &buf_keys.vector[start[i]],
+				sizeof(uint64_t)*num_keys[i]);
+		memcpy(&counts.vector[offsets[i]], &buf_counts.vector[start[i]],
+				sizeof(float64_t)*num_keys[i]);
+	}
+
+	SG_DEBUG("%d strings with %ld k-mers have %ld distinct keys\n",
+			num_vectors, start[num_vectors], offsets[num_vectors])
+}
+
+float64_t CHashedSpectrumStringKernel::compute(int32_t idx_a, int32_t idx_b)
+{
+	/* normalizers temporarily put the features of one side on both sides */
+	bool a_lhs=(lhs==m_spectra_lhs);
+	const SGVector<uint64_t>& a_keys=a_lhs ? m_lhs_keys : m_rhs_keys;
+	const SGVector<float64_t>& a_counts=a_lhs ? m_lhs_counts : m_rhs_counts;
+	const SGVector<int64_t>& a_offsets=a_lhs ? m_lhs_offsets : m_rhs_offsets;
+
+	bool b_lhs=(rhs==m_spectra_lhs);
+	const SGVector<uint64_t>& b_keys=b_lhs ? m_lhs_keys : m_rhs_keys;
+	const SGVector<float64_t>& b_counts=b_lhs ? m_lhs_counts : m_rhs_counts;
+	const SGVector<int64_t>& b_offsets=b_lhs ? m_lhs_offsets : m_rhs_offsets;
+
+	const uint64_t* akeys=&a_keys.vector[a_offsets[idx_a]];
+	const float64_t* acounts=&a_counts.vector[a_offsets[idx_a]];
+	int64_t alen=a_offsets[idx_a+1]-a_offsets[idx_a];
+
+	const uint64_t* bkeys=&b_keys.vector[b_offsets[idx_b]];
+	const float64_t* bcounts=&b_counts.vector[b_offsets[idx_b]];
+	int64_t blen=b_offsets[idx_b+1]-b_offsets[idx_b];
+
+	float64_t result=0;
+	int64_t left_idx=0;
+	int64_t right_idx=0;
+
+	while (left_idx<alen && right_idx<blen)
+	{
+		if (akeys[left_idx]==bkeys[right_idx])
+		{
+			result+=acounts[left_idx]*bcounts[right_idx];
+			left_idx++;
+			right_idx++;
+		}
+		else if (akeys[left_idx]<bkeys[right_idx])
+			left_idx++;
+		else
+			right_idx++;
+	}
+
+	return result;
+}
+
+void CHashedSpectrumStringKernel::resize_normal(int64_t capacity)
+{
+	SGVector<uint64_t> old_keys=m_normal_keys;
+	SGVector<float64_t> old_weights=m_normal_weights;
+	SGVector<bool> old_used=m_normal_used;
+
+	m_normal_keys=SGVector<uint64_t>(capacity);
+	m_normal_weights=SGVector<float64_t>(capacity);
+	m_normal_used=SGVector<bool>(capacity);
+	m_normal_used.set_const(false);
+
+	for (int64_t i=0; i<old_used.vlen; i++)
+	{
+		if (old_used[i])
+		{
+			int64_t slot=find_slot(old_keys[i]);
+			m_normal_used[slot]=true;
+			m_normal_keys[slot]=old_keys[i];
+			m_normal_weights[slot]=old_weights[i];
+		}
+	}
+}
+
+void CHashedSpectrumStringKernel::add_to_normal(int32_t idx, float64_t weight)
+{
+	ASSERT(lhs)
+	int64_t first=m_lhs_offsets[idx];
+	int64_t len=m_lhs_offsets[idx+1]-first;
+
+	/* keep the table at most half full */
+	int64_t capacity=CMath::max(m_normal_keys.vlen, 16);
+	while (2*(m_num_normal_entries+len)>capacity)
+		capacity*=2;
+	if (capacity!=m_normal_keys.vlen)
+		resize_normal(capacity);
+
+	float64_t w=normalizer->normalize_lhs(weight, idx);
+	for (int64_t i=first; i<first+len; i++)
+	{
+		int64_t slot=find_slot(m_lhs_keys[i]);
+		if (m_normal_used[slot])
+			m_normal_weights[slot]+=w*m_lhs_counts[i];
+		else
+		{
+			m_normal_used[slot]=true;
+			m_normal_keys[slot]=m_lhs_keys[i];
+			m_normal_weights[slot]=w*m_lhs_counts[i];
+			m_num_normal_entries++;
+		}
+	}
+
+	set_is_initialized(true);
+}
+
+void CHashedSpectrumStringKernel::clear_normal()
+{
+	m_normal_keys=SGVector<uint64_t>();
+	m_normal_weights=SGVector<float64_t>();
+	m_normal_used=SGVector<bool>();
+	m_num_normal_entries=0;
+	set_is_initialized(false);
+}
+
+bool CHashedSpectrumStringKernel::init_optimization(
+	int32_t count, int32_t* IDX, float64_t* weights)
+{
+	clear_normal();
+
+	if (count<=0)
+	{
+		set_is_initialized(true);
+		SG_DEBUG("empty set of SVs\n")
+		return true;
+	}
+
+	SG_DEBUG("initializing CHashedSpectrumStringKernel optimization\n")
+
+	for (int32_t i=0; i<count; i++)
+		add_to_normal(IDX[i], weights[i]);
+
+	SG_DEBUG("%ld distinct keys in normal vector\n", m_num_normal_entries)
+	set_is_initialized(true);
+	return true;
+}
+
+bool CHashedSpectrumStringKernel::delete_optimization()
+{
+	SG_DEBUG("deleting CHashedSpectrumStringKernel optimization\n")
+	clear_normal();
+	return true;
+}
+
+float64_t CHashedSpectrumStringKernel::score_rhs(int32_t idx) const
+{
+	if (!m_num_normal_entries)
+		return 0;
+
+	float64_t result=0;
+	for (int64_t i=m_rhs_offsets[idx]; i<m_rhs_offsets[idx+1]; i++)
+	{
+		int64_t slot=find_slot(m_rhs_keys[i]);
+		if (m_normal_used[slot])
+			result+=m_normal_weights[slot]*m_rhs_counts[i];
+	}
+
+	return result;
+}
+
+float64_t CHashedSpectrumStringKernel::compute_optimized(int32_t idx)
+{
+	if (!get_is_initialized())
+	{
+		SG_ERROR("CHashedSpectrumStringKernel optimization not initialized\n")
+		return 0;
+	}
+
+	return normalizer->normalize_rhs(score_rhs(idx), idx);
+}
+
+void CHashedSpectrumStringKernel::compute_batch(
+	int32_t num_vec, int32_t* vec_idx, float64_t* target,
+	int32_t num_suppvec, int32_t* IDX, float64_t* alphas, float64_t factor)
+{
+	ASSERT(rhs)
+	ASSERT(num_vec<=rhs->get_num_vectors())
+	ASSERT(vec_idx)
+	ASSERT(target)
+
+	init_optimization(num_suppvec, IDX, alphas);
+
+	#pragma omp parallel for num_threads(parallel->get_num_threads())
+	for (int32_t i=0; i<num_vec; i++)
+	{
+		target[i]+=factor*normalizer->normalize_rhs(score_rhs(vec_idx[i]),
+				vec_idx[i]);
+	}
+}
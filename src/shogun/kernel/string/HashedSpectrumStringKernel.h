@@ -0,0 +1,287 @@
+/*
+ * Copyright (c) The Shogun Machine Learning Toolbox
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation are those
+ * of the authors and should not be interpreted as representing official policies,
+ * either expressed or implied, of the Shogun Development Team.
+ *
+ */
+
+
+#ifndef _HASHEDSPECTRUMSTRINGKERNEL_H___
+#define _HASHEDSPECTRUMSTRINGKERNEL_H___
+
+#include <shogun/lib/config.h>
+
+#include <shogun/lib/common.h>
+#include <shogun/lib/SGVector.h>
+#include <shogun/kernel/string/StringKernel.h>
+
+namespace shogun
+{
+template <class ST> class CStringFeatures;
+
+/** @brief The Hashed Spectrum kernel computes the spectrum kernel on
+ * (optionally hashed) k-mer count vectors.
+ *
+ * It operates on strings of k-mers as obtained by
+ * CStringFeatures<uint64_t>::obtain_from_char, i.e. any order up to 32.
+ * Unlike CCommUlongStringKernel the k-mers need not be sorted: when features
+ * are attached, every string is turned once into a sorted sparse count
+ * vector which is cached and merged on kernel evaluation
+ *
+ * \f[
+ * k({\bf x},{\bf x'})= \sum_{u} \phi_u({\bf x}) \phi_u({\bf x'})
+ * \f]
+ *
+ * where \f$\phi_u({\bf x})\f$ is the number of occurrences of k-mer (or hash
+ * bucket, if hash_bits>0) \f$u\f$ in \f${\bf x}\f$. If use_sign is set, only
+ * presence is counted.
+ *
+ * For linadd the normal vector is kept in an open-addressing hash table whose
+ * size only depends on the number of distinct k-mers in the support vectors,
+ * in contrast to the dense \f$4^k\f$ dictionary of CCommWordStringKernel.
+ * compute_batch() scores many vectors against it in parallel.
+ */
+class CHashedSpectrumStringKernel: public CStringKernel<uint64_t>
+{
+	public:
+		/** default constructor
+		 *
+		 * @param size cache size
+		 * @param hash_bits number of bits k-mers are hashed to, 0 to use
+		 * the k-mers themselves
+		 * @param use_sign if sign shall be used
+		 */
+		CHashedSpectrumStringKernel(int32_t size=10, int32_t hash_bits=0,
+				bool use_sign=false);
+
+		/** constructor
+		 *
+		 * @param l features of left-hand side
+		 * @param r features of right-hand side
+		 * @param hash_bits number of bits k-mers are hashed to, 0 to use
+		 * the k-mers themselves
+		 * @param use_sign if sign shall be used
+		 * @param size cache size
+		 */
+		CHashedSpectrumStringKernel(
+			CStringFeatures<uint64_t>* l, CStringFeatures<uint64_t>* r,
+			int32_t hash_bits=0, bool use_sign=false, int32_t size=10);
+
+		virtual ~CHashedSpectrumStringKernel();
+
+		/** initialize kernel and compute the sparse count vectors
+		 *
+		 * @param l features of left-hand side
+		 * @param r features of right-hand side
+		 * @return if initializing was successful
+		 */
+		virtual bool init(CFeatures* l, CFeatures* r);
+
+		/** clean up kernel */
+		virtual void cleanup();
+
+		/** return what type of kernel we are
+		 *
+		 * @return kernel type HASHEDSPECTRUM
+		 */
+		virtual EKernelType get_kernel_type() { return K_HASHEDSPECTRUM; }
+
+		/** return the kernel's name
+		 *
+		 * @return name HashedSpectrumStringKernel
+		 */
+		virtual const char* get_name() const { return "HashedSpectrumStringKernel"; }
+
+		/** initialize optimization
+		 *
+		 * @param count count
+		 * @param IDX index
+		 * @param weights weights
+		 * @return if initializing was successful
+		 */
+		virtual bool init_optimization(
+			int32_t count, int32_t* IDX, float64_t* weights);
+
+		/** delete optimization
+		 *
+		 * @return if deleting was successful
+		 */
+		virtual bool delete_optimization();
+
+		/** compute optimized
+		 *
+		 * @param idx index to compute
+		 * @return optimized value at given index
+		 */
+		virtual float64_t compute_optimized(int32_t idx);
+
+		/** compute the outputs of a batch of vectors in parallel
+		 *
+		 * @param num_vec number of vectors
+		 * @param vec_idx indices of the vectors (rhs)
+		 * @param target outputs are added to this array
+		 * @param num_suppvec number of support vectors
+		 * @param IDX indices of the support vectors (lhs)
+		 * @param alphas weights of the support vectors
+		 * @param factor factor the outputs are multiplied with
+		 */
+		virtual void compute_batch(
+			int32_t num_vec, int32_t* vec_idx, float64_t* target,
+			int32_t num_suppvec, int32_t* IDX, float64_t* alphas,
+			float64_t factor=1.0);
+
+		/** add to normal vector
+		 *
+		 * @param idx where to add
+		 * @param weight what to add
+		 */
+		virtual void add_to_normal(int32_t idx, float64_t weight);
+
+		/** clear normal vector */
+		virtual void clear_normal();
+
+		/** remove lhs from kernel */
+		virtual void remove_lhs();
+
+		/** remove rhs from kernel */
+		virtual void remove_rhs();
+
+		/** return feature type the kernel can deal with
+		 *
+		 * @return feature type ULONG
+		 */
+		virtual EFeatureType get_feature_type() { return F_ULONG; }
+
+		/** @return number of bits k-mers are hashed to (0 if not hashed) */
+		inline int32_t get_hash_bits() const { return m_hash_bits; }
+
+		/** @return number of distinct entries in the normal vector */
+		inline int64_t get_num_normal_entries() const { return m_num_normal_entries; }
+
+	protected:
+		/** compute kernel function for features a and b
+		 * idx_{a,b} denote the index of the feature vectors
+		 * in the corresponding feature object
+		 *
+		 * @param idx_a index a
+		 * @param idx_b index b
+		 * @return computed kernel function at indices a,b
+		 */
+		virtual float64_t compute(int32_t idx_a, int32_t idx_b);
+
+		/** turn all strings of a feature object into sorted sparse count
+		 * vectors, stored back to back
+		 *
+		 * @param f k-mer string features
+		 * @param keys distinct k-mers (or buckets) of all strings
+		 * @param counts occurrences of the keys
+		 * @param offsets first key of each string, num_vectors+1 entries
+		 */
+		void compute_spectra(CStringFeatures<uint64_t>* f,
+				SGVector<uint64_t>& keys, SGVector<float64_t>& counts,
+				SGVector<int64_t>& offsets);
+
+		/** score a rhs vector against the normal vector
+		 *
+		 * @param idx index of rhs vector
+		 * @return unnormalized score
+		 */
+		float64_t score_rhs(int32_t idx) const;
+
+		/** find the slot of a key in the normal vector table
+		 *
+		 * @param key key to look up
+		 * @return slot holding key or the empty slot it would go to
+		 */
+		inline int64_t find_slot(uint64_t key) const
+		{
+			uint64_t mask=m_normal_keys.vlen-1;
+			uint64_t slot=mix(key) & mask;
+			while (m_normal_used[slot] && m_normal_keys[slot]!=key)
+				slot=(slot+1) & mask;
+			return slot;
+		}
+
+		/** resize the normal vector table, keeping its entries
+		 *
+		 * @param capacity new number of slots, a power of two
+		 */
+		void resize_normal(int64_t capacity);
+
+		/** 64 bit mixing function (finalizer of splitmix64)
+		 *
+		 * @param x value
+		 * @return mixed value
+		 */
+		static inline uint64_t mix(uint64_t x)
+		{
+			x^=x>>30;
+			x*=0xbf58476d1ce4e5b9ULL;
+			x^=x>>27;
+			x*=0x94d049bb133111ebULL;
+			x^=x>>31;
+			return x;
+		}
+
+	private:
+		/** register parameters and set defaults */
+		void init();
+
+	protected:
+		/** number of bits k-mers are hashed to, 0 for no hashing */
+		int32_t m_hash_bits;
+
+		/** if sign shall be used */
+		bool m_use_sign;
+
+		/** distinct keys of the lhs strings */
+		SGVector<uint64_t> m_lhs_keys;
+		/** key counts of the lhs strings */
+		SGVector<float64_t> m_lhs_counts;
+		/** first key of each lhs string */
+		SGVector<int64_t> m_lhs_offsets;
+
+		/** distinct keys of the rhs strings */
+		SGVector<uint64_t> m_rhs_keys;
+		/** key counts of the rhs strings */
+		SGVector<float64_t> m_rhs_counts;
+		/** first key of each rhs string */
+		SGVector<int64_t> m_rhs_offsets;
+
+		/** features the lhs spectra were computed from */
+		CFeatures* m_spectra_lhs;
+
+		/** keys of the normal vector table (open addressing) */
+		SGVector<uint64_t> m_normal_keys;
+		/** weights of the normal vector table */
+		SGVector<float64_t> m_normal_weights;
+		/** occupied slots of the normal vector table */
+		SGVector<bool> m_normal_used;
+		/** number of occupied slots */
+		int64_t m_num_normal_entries;
+};
+}
+#endif /* _HASHEDSPECTRUMSTRINGKERNEL_H___ */
@@ -20,6 +20,7 @@
 #include <shogun/kernel/normalizer/FirstElementKernelNormalizer.h>
 #include <shogun/features/Features.h>
 #include <shogun/features/StringFeatures.h>
+#include <shogun/features/PackedDNAStringFeatures.h>
 
 #ifndef WIN32
 #include <pthread.h>
@@ -36,6 +37,7 @@ struct S_THREAD_PARAM_WD
 	float64_t* weights;
 	CWeightedDegreeStringKernel* kernel;
 	CTrie<DNATrie>* tries;
+	CCompactTrie* compact_tries;
 	float64_t factor;
 	int32_t j;
 	int32_t start;
@@ -110,6 +112,8 @@ CWeightedDegreeStringKernel::~CWeightedDegreeStringKernel()
 
 	SG_FREE(weights_buffer);
 	weights_buffer=NULL;
+
+	SG_UNREF(compact_tries);
 }
 
 
@@ -239,7 +243,15 @@ bool CWeightedDegreeStringKernel::init_optimization(int32_t count, int32_t* IDX,
 	if (tree_num<0)
 		SG_DONE()
 
-	//tries.compact_nodes(NO_CHILD, 0, weights) ;
+	if (use_compact_tries)
+	{
+		compact_tries->build(tries, weights, (length!=0), tree_num);
+		compact_tries->set_position_weights(position_weights);
+
+		// lookups only use the compact copy, the full tries can be huge
+		tries->delete_trees(max_mismatch==0);
+		tries->shrink_tree_mem();
+	}
 
 	set_is_initialized(true) ;
 	return true ;
@@ -251,6 +263,7 @@ bool CWeightedDegreeStringKernel::delete_optimization()
 	{
 		if (tries!=NULL)
 			tries->delete_trees(max_mismatch==0);
+		compact_tries->clear();
 		set_is_initialized(false);
 		return true;
 	}
@@ -517,19 +530,37 @@ float64_t CWeightedDegreeStringKernel::compute_by_tree(int32_t idx)
 	ASSERT(alphabet->get_alphabet()==DNA || alphabet->get_alphabet()==RNA)
 
 	int32_t len=0;
-	bool free_vec;
-	char* char_vec=((CStringFeatures<char>*) rhs)->get_feature_vector(idx, len, free_vec);
-	ASSERT(char_vec && len>0)
-	int32_t *vec=SG_MALLOC(int32_t, len);
+	int32_t *vec=NULL;
+	CPackedDNAStringFeatures* packed=dynamic_cast<CPackedDNAStringFeatures*>(rhs);
+	if (packed)
+	{
+		/* 2-bit codes already are the trie's symbol indices */
+		len=packed->get_vector_length(idx);
+		ASSERT(len>0)
+		vec=SG_MALLOC(int32_t, len);
+		packed->get_codes(idx, vec, 0, len);
+	}
+	else
+	{
+		bool free_vec;
+		char* char_vec=((CStringFeatures<char>*) rhs)->get_feature_vector(idx, len, free_vec);
+		ASSERT(char_vec && len>0)
+		vec=SG_MALLOC(int32_t, len);
 
-	for (int32_t i=0; i<len; i++)
-		vec[i]=alphabet->remap_to_bin(char_vec[i]);
-	((CStringFeatures<char>*) lhs)->free_feature_vector(char_vec, idx, free_vec);
+		for (int32_t i=0; i<len; i++)
+			vec[i]=alphabet->remap_to_bin(char_vec[i]);
+		((CStringFeatures<char>*) lhs)->free_feature_vector(char_vec, idx, free_vec);
+	}
 
 	float64_t sum=0;
 	ASSERT(tries)
 	for (int32_t i=0; i<len; i++)
-		sum+=tries->compute_by_tree_helper(vec, len, i, i, i, weights, (length!=0));
+	{
+		if (compact_tries->has_tree(i))
+			sum+=compact_tries->compute_by_tree_helper(vec, len, i, i, i, weights, (length!=0));
+		else
+			sum+=tries->compute_by_tree_helper(vec, len, i, i, i, weights, (length!=0));
+	}
 
 	SG_FREE(vec);
 	return normalizer->normalize_rhs(sum, idx);
@@ -542,21 +573,40 @@ void CWeightedDegreeStringKernel::compute_by_tree(
 	ASSERT(alphabet->get_alphabet()==DNA || alphabet->get_alphabet()==RNA)
 
 	int32_t len ;
-	bool free_vec;
-	char* char_vec=((CStringFeatures<char>*) rhs)->get_feature_vector(idx, len, free_vec);
+	int32_t *vec = NULL;
+	CPackedDNAStringFeatures* packed=dynamic_cast<CPackedDNAStringFeatures*>(rhs);
+	if (packed)
+	{
+		len=packed->get_vector_length(idx);
+		vec=SG_MALLOC(int32_t, len);
+		packed->get_codes(idx, vec, 0, len);
+	}
+	else
+	{
+		bool free_vec;
+		char* char_vec=((CStringFeatures<char>*) rhs)->get_feature_vector(idx, len, free_vec);
 
-	int32_t *vec = SG_MALLOC(int32_t, len);
+		vec = SG_MALLOC(int32_t, len);
 
-	for (int32_t i=0; i<len; i++)
-		vec[i]=alphabet->remap_to_bin(char_vec[i]);
-	((CStringFeatures<char>*) lhs)->free_feature_vector(char_vec, idx, free_vec);
+		for (int32_t i=0; i<len; i++)
+			vec[i]=alphabet->remap_to_bin(char_vec[i]);
+		((CStringFeatures<char>*) lhs)->free_feature_vector(char_vec, idx, free_vec);
+	}
 
 	ASSERT(tries)
+	float64_t factor=normalizer->normalize_rhs(1.0, idx);
 	for (int32_t i=0; i<len; i++)
 	{
-		tries->compute_by_tree_helper(vec, len, i, i, i, LevelContrib,
-				normalizer->normalize_rhs(1.0, idx),
-				mkl_stepsize, weights, (length!=0));
+		if (compact_tries->has_tree(i))
+		{
+			compact_tries->compute_by_tree_helper(vec, len, i, i, i,
+					LevelContrib, factor, mkl_stepsize, weights, (length!=0));
+		}
+		else
+		{
+			tries->compute_by_tree_helper(vec, len, i, i, i, LevelContrib,
+					factor, mkl_stepsize, weights, (length!=0));
+		}
 	}
 
 	SG_FREE(vec);
@@ -565,6 +615,9 @@ void CWeightedDegreeStringKernel::compute_by_tree(
 float64_t *CWeightedDegreeStringKernel::compute_abs_weights(int32_t &len)
 {
 	ASSERT(tries)
+	if (compact_tries->get_num_nodes()>0)
+		return compact_tries->compute_abs_weights(len);
+
 	return tries->compute_abs_weights(len);
 }
 
@@ -660,6 +713,7 @@ bool CWeightedDegreeStringKernel::set_position_weights(
 		position_weights=NULL;
 		ASSERT(tries)
 		tries->set_position_weights(position_weights);
+		compact_tries->set_position_weights(position_weights);
 	}
 
 	if (seq_length!=len)
@@ -670,6 +724,7 @@ bool CWeightedDegreeStringKernel::set_position_weights(
 	position_weights_len=len;
 	ASSERT(tries)
 	tries->set_position_weights(position_weights);
+	compact_tries->set_position_weights(position_weights);
 
 	if (position_weights)
 	{
@@ -829,6 +884,7 @@ void* CWeightedDegreeStringKernel::compute_batch_helper(void* p)
 	int32_t j=params->j;
 	CWeightedDegreeStringKernel* wd=params->kernel;
 	CTrie<DNATrie>* tries=params->tries;
+	CCompactTrie* compact_tries=params->compact_tries;
 	float64_t* weights=params->weights;
 	int32_t length=params->length;
 	int32_t* vec=params->vec;
@@ -837,21 +893,36 @@ void* CWeightedDegreeStringKernel::compute_batch_helper(void* p)
 	int32_t* vec_idx=params->vec_idx;
 
 	CStringFeatures<char>* rhs_feat=((CStringFeatures<char>*) wd->get_rhs());
+	CPackedDNAStringFeatures* packed=dynamic_cast<CPackedDNAStringFeatures*>(rhs_feat);
 	CAlphabet* alpha=wd->alphabet;
 
 	for (int32_t i=params->start; i<params->end; i++)
 	{
 		int32_t len=0;
-		bool free_vec;
-		char* char_vec=rhs_feat->get_feature_vector(vec_idx[i], len, free_vec);
-		for (int32_t k=j; k<CMath::min(len,j+wd->get_degree()); k++)
-			vec[k]=alpha->remap_to_bin(char_vec[k]);
-		rhs_feat->free_feature_vector(char_vec, vec_idx[i], free_vec);
+		if (packed)
+		{
+			len=packed->get_vector_length(vec_idx[i]);
+			int32_t end=CMath::min(len,j+wd->get_degree());
+			if (end>j)
+				packed->get_codes(vec_idx[i], &vec[j], j, end-j);
+		}
+		else
+		{
+			bool free_vec;
+			char* char_vec=rhs_feat->get_feature_vector(vec_idx[i], len, free_vec);
+			for (int32_t k=j; k<CMath::min(len,j+wd->get_degree()); k++)
+				vec[k]=alpha->remap_to_bin(char_vec[k]);
+			rhs_feat->free_feature_vector(char_vec, vec_idx[i], free_vec);
+		}
 
 		ASSERT(tries)
 
-		result[i]+=factor*
-			wd->normalizer->normalize_rhs(tries->compute_by_tree_helper(vec, len, j, j, j, weights, (length!=0)), vec_idx[i]);
+		float64_t score;
+		if (compact_tries->has_tree(j))
+			score=compact_tries->compute_by_tree_helper(vec, len, j, j, j, weights, (length!=0));
+		else
+			score=tries->compute_by_tree_helper(vec, len, j, j, j, weights, (length!=0));
+		result[i]+=factor*wd->normalizer->normalize_rhs(score, vec_idx[i]);
 	}
 
 	SG_UNREF(rhs_feat);
@@ -895,6 +966,7 @@ void CWeightedDegreeStringKernel::compute_batch(
 			params.weights=weights;
 			params.kernel=this;
 			params.tries=tries;
+			params.compact_tries=compact_tries;
 			params.factor=factor;
 			params.j=j;
 			params.start=0;
@@ -925,6 +997,7 @@ void CWeightedDegreeStringKernel::compute_batch(
 				params[t].weights=weights;
 				params[t].kernel=this;
 				params[t].tries=tries;
+				params[t].compact_tries=compact_tries;
 				params[t].factor=factor;
 				params[t].j=j;
 				params[t].start = t*step;
@@ -938,6 +1011,7 @@ void CWeightedDegreeStringKernel::compute_batch(
 			params[t].weights=weights;
 			params[t].kernel=this;
 			params[t].tries=tries;
+			params[t].compact_tries=compact_tries;
 			params[t].factor=factor;
 			params[t].j=j;
 			params[t].start=t*step;
@@ -998,6 +1072,9 @@ void CWeightedDegreeStringKernel::init()
 	type=E_WD;
 	which_degree=-1;
 	tries=NULL;
+	compact_tries=new CCompactTrie();
+	SG_REF(compact_tries);
+	use_compact_tries=true;
 
 	tree_initialized=false;
 	alphabet=NULL;
@@ -1020,6 +1097,8 @@ void CWeightedDegreeStringKernel::init()
 			"Number of allowed mismatches.", MS_AVAILABLE);
 	SG_ADD(&block_computation, "block_computation",
 			"If block computation shall be used.", MS_NOT_AVAILABLE);
+	SG_ADD(&use_compact_tries, "use_compact_tries",
+			"If compact tries shall be used for lookups.", MS_NOT_AVAILABLE);
 	SG_ADD((machine_int_t*) &type, "type",
 			"WeightedDegree kernel type.", MS_AVAILABLE);
 	SG_ADD(&which_degree, "which_degree",
@@ -16,6 +16,7 @@
 
 #include <shogun/lib/common.h>
 #include <shogun/lib/Trie.h>
+#include <shogun/lib/CompactTrie.h>
 #include <shogun/kernel/string/StringKernel.h>
 #include <shogun/transfer/multitask/MultitaskKernelMklNormalizer.h>
 #include <shogun/features/StringFeatures.h>
@@ -202,6 +203,7 @@ class CWeightedDegreeStringKernel: public CStringKernel<char>
 					SG_ERROR("not implemented")
 
 				tries->delete_trees(max_mismatch==0);
+				compact_tries->clear();
 				set_is_initialized(false);
 			}
 		}
@@ -217,11 +219,16 @@ class CWeightedDegreeStringKernel: public CStringKernel<char>
 			if (normalizer && normalizer->get_normalizer_type()==N_MULTITASK)
 				SG_ERROR("not implemented")
 
+			REQUIRE(!get_is_initialized() || compact_tries->get_num_nodes()==0,
+				"The tries were released after building their compact copy, "
+				"call clear_normal() before adding to the normal\n");
+
 			if (max_mismatch==0)
 				add_example_to_tree(idx, weight);
 			else
 				add_example_to_tree_mismatch(idx, weight);
 
+			compact_tries->clear();
 			set_is_initialized(true);
 		}
 
@@ -568,6 +575,39 @@ class CWeightedDegreeStringKernel: public CStringKernel<char>
 		 */
 		inline bool get_use_block_computation() { return block_computation; }
 
+		/** set if a compact copy of the tries shall be built by
+		 * init_optimization and used by compute_optimized and compute_batch.
+		 * The full tries are released once the compact copy is built, so
+		 * turning this off drops an existing optimization.
+		 *
+		 * @param compact if compact tries shall be used
+		 */
+		inline void set_use_compact_tries(bool compact)
+		{
+			use_compact_tries=compact;
+			if (!compact)
+			{
+				if (compact_tries->get_num_nodes()>0)
+					delete_optimization();
+				compact_tries->clear();
+			}
+		}
+
+		/** check if compact tries are used
+		 *
+		 * @return if compact tries are used
+		 */
+		inline bool get_use_compact_tries() { return use_compact_tries; }
+
+		/** get number of nodes used by the (non compact) tries
+		 *
+		 * @return number of used trie nodes
+		 */
+		inline int32_t get_num_used_trie_nodes()
+		{
+			return tries ? tries->get_num_used_nodes() : 0;
+		}
+
 		/** set MKL steps ize
 		 *
 		 * @param step new step size
@@ -754,6 +794,12 @@ class CWeightedDegreeStringKernel: public CStringKernel<char>
 		/** tries */
 		CTrie<DNATrie>* tries;
 
+		/** read-only compact copy of tries used for lookups */
+		CCompactTrie* compact_tries;
+
+		/** if compact tries are built in init_optimization */
+		bool use_compact_tries;
+
 		/** if tree is initialized */
 		bool tree_initialized;
 
@@ -10,6 +10,7 @@
 
 #include <shogun/latent/LatentModel.h>
 #include <shogun/labels/BinaryLabels.h>
+#include <shogun/base/Parallel.h>
 
 using namespace shogun;
 
@@ -50,6 +51,7 @@ void CLatentModel::set_labels(CLatentLabels* labs)
 	SG_REF(labs);
 	SG_UNREF(m_labels);
 	m_labels = labs;
+	reset_psi_cache();
 }
 
 CLatentLabels* CLatentModel::get_labels() const
@@ -63,6 +65,7 @@ void CLatentModel::set_features(CLatentFeatures* feats)
 	SG_REF(feats);
 	SG_UNREF(m_features);
 	m_features = feats;
+	reset_psi_cache();
 }
 
 void CLatentModel::argmax_h(const SGVector<float64_t>& w)
@@ -72,16 +75,61 @@ void CLatentModel::argmax_h(const SGVector<float64_t>& w)
 	ASSERT(num > 0)
 	ASSERT(num == m_labels->get_num_labels())
 
+	if (m_psi_dirty.vlen != num)
+	{
+		m_psi_dirty = SGVector<bool>(num);
+		m_psi_dirty.set_const(true);
+	}
+
 	// argmax_h only for positive examples
+	SGVector<index_t> positives(num);
+	int32_t num_positives = 0;
 	for (int32_t i = 0; i < num; ++i)
 	{
 		if (y->get_label(i) == 1)
-		{
-			// infer h and set it for the argmax_h <w,psi(x,h)>
-			CData* latent_data = infer_latent_variable(w, i);
-			m_labels->set_latent_label(i, latent_data);
-		}
+			positives[num_positives++] = i;
+	}
+
+	// infer h for the argmax_h <w,psi(x,h)>
+	CData** latent_data = SG_CALLOC(CData*, num_positives);
+	if (is_thread_safe())
+	{
+		#pragma omp parallel for schedule(dynamic) num_threads(parallel->get_num_threads())
+		for (int32_t i = 0; i < num_positives; ++i)
+			latent_data[i] = infer_latent_variable(w, positives[i]);
+	}
+	else
+	{
+		for (int32_t i = 0; i < num_positives; ++i)
+			latent_data[i] = infer_latent_variable(w, positives[i]);
+	}
+
+	for (int32_t i = 0; i < num_positives; ++i)
+	{
+		index_t idx = positives[i];
+		CData* old_data = m_labels->get_latent_label(idx);
+		if (!old_data || !latent_variable_equals(old_data, latent_data[i]))
+			m_psi_dirty[idx] = true;
+
+		m_labels->set_latent_label(idx, latent_data[i]);
+		SG_UNREF(old_data);
 	}
+	SG_FREE(latent_data);
+}
+
+SGVector<float64_t> CLatentModel::get_psi_feature_vector(index_t idx)
+{
+	return SGVector<float64_t>();
+}
+
+bool CLatentModel::latent_variable_equals(CData* h1, CData* h2) const
+{
+	return h1 == h2;
+}
+
+bool CLatentModel::is_thread_safe() const
+{
+	return false;
 }
 
 void CLatentModel::register_parameters()
@@ -101,13 +149,82 @@ CLatentFeatures* CLatentModel::get_features() const
 
 void CLatentModel::cache_psi_features()
 {
-	if (m_do_caching)
+	if (!m_do_caching)
+		return;
+
+	int32_t num = get_num_vectors();
+	int32_t dim = get_dim();
+	bool rebuild = m_psi_matrix.num_rows != dim || m_psi_matrix.num_cols != num;
+	if (rebuild || m_psi_dirty.vlen != num)
 	{
-		if (m_cached_psi)
-			SG_UNREF(m_cached_psi);
+		m_psi_dirty = SGVector<bool>(num);
+		m_psi_dirty.set_const(true);
+	}
+
+	// probe whether the model computes PSI vectors per example
+	SGVector<float64_t> psi;
+	if (num > 0 && (rebuild || m_psi_dirty[0]))
+		psi = get_psi_feature_vector(0);
+
+	if (rebuild && psi.vlen == 0)
+	{
+		SG_UNREF(m_cached_psi);
 		m_cached_psi = this->get_psi_feature_vectors();
 		SG_REF(m_cached_psi);
+		return;
 	}
+
+	if (rebuild)
+	{
+		REQUIRE(psi.vlen == dim, "PSI vector has dimension %d, expected %d!\n",
+				psi.vlen, dim)
+		m_psi_matrix = SGMatrix<float64_t>(dim, num);
+
+		SG_UNREF(m_cached_psi);
+		m_cached_psi = new CDenseFeatures<float64_t>(m_psi_matrix);
+		SG_REF(m_cached_psi);
+	}
+
+	if (psi.vlen)
+	{
+		REQUIRE(psi.vlen == dim, "PSI vector has dimension %d, expected %d!\n",
+				psi.vlen, dim)
+		memcpy(m_psi_matrix.get_column_vector(0), psi.vector, dim*sizeof(float64_t));
+		m_psi_dirty[0] = false;
+	}
+
+	SGVector<index_t> dirty(num);
+	int32_t num_dirty = 0;
+	for (int32_t i = 0; i < num; ++i)
+	{
+		if (m_psi_dirty[i])
+			dirty[num_dirty++] = i;
+	}
+
+	SG_DEBUG("Recomputing %d of %d PSI vectors\n", num_dirty, num)
+	int32_t num_invalid = 0;
+	#pragma omp parallel for schedule(dynamic) num_threads(parallel->get_num_threads()) \
+		reduction(+:num_invalid) if (is_thread_safe())
+	for (int32_t i = 0; i < num_dirty; ++i)
+	{
+		SGVector<float64_t> psi_i = get_psi_feature_vector(dirty[i]);
+		if (psi_i.vlen != dim)
+		{
+			num_invalid++;
+			continue;
+		}
+		memcpy(m_psi_matrix.get_column_vector(dirty[i]), psi_i.vector, dim*sizeof(float64_t));
+	}
+	REQUIRE(num_invalid == 0, "%d PSI vectors do not have dimension %d!\n",
+			num_invalid, dim)
+
+	m_psi_dirty.set_const(false);
+}
+
+void CLatentModel::reset_psi_cache()
+{
+	m_psi_matrix = SGMatrix<float64_t>();
+	m_psi_dirty = SGVector<bool>();
 }
 
 CDotFeatures* CLatentModel::get_cached_psi_features() const
@@ -89,6 +89,39 @@ namespace shogun
 			 */
 			virtual CDotFeatures* get_psi_feature_vectors()=0;
 
+			/** Calculate the PSI vector \f$\Psi(\bold{x_i},\bold{h_i})\f$ of a
+			 * single example with its current latent variable.
+			 *
+			 * Optional. If implemented, cache_psi_features() only recomputes
+			 * the PSI vectors of the examples whose latent variable changed in
+			 * the last argmax_h() call. The default implementation returns an
+			 * empty vector, in which case get_psi_feature_vectors() is used.
+			 *
+			 * @param idx index of the example
+			 * @return PSI vector of length get_dim()
+			 */
+			virtual SGVector<float64_t> get_psi_feature_vector(index_t idx);
+
+			/** Compare two latent variables of the same example. Used by
+			 * argmax_h() to decide whether the cached PSI vector of the
+			 * example is still valid. The default implementation only
+			 * considers identical objects equal.
+			 *
+			 * @param h1 first latent variable
+			 * @param h2 second latent variable
+			 * @return true if both latent variables are equal
+			 */
+			virtual bool latent_variable_equals(CData* h1, CData* h2) const;
+
+			/** Whether infer_latent_variable() and get_psi_feature_vector()
+			 * can be called concurrently for different examples. If so,
+			 * argmax_h() and cache_psi_features() process the examples in
+			 * parallel. False by default.
+			 *
+			 * @return true if the per example methods are thread-safe
+			 */
+			virtual bool is_thread_safe() const;
+
 			/** User defined \f$h^{*} = argmax_{h} \langle \bold{w},\Psi(\bold{x},\bold{h}) \rangle\f$
 			 * This function has to be defined the user as it is applications specific, since
 			 * it depends on the user defined latent feature and latent label.
@@ -154,6 +187,14 @@ namespace shogun
 		private:
 			/** register the parameters */
 			void register_parameters();
+
+			/** drop the per example PSI cache */
+			void reset_psi_cache();
+
+			/** PSI vectors of the incremental cache, one column per example */
+			SGMatrix<float64_t> m_psi_matrix;
+			/** examples whose PSI vector has to be recomputed */
+			SGVector<bool> m_psi_dirty;
 	};
 }
 
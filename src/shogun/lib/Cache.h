@@ -55,6 +55,8 @@ template<class T> class CCache : public CSGObject
 		cache_is_full=false;
 		nr_cache_lines=0;
 		entry_size=0;
+		memory_tag=MEMORY_TAG_FEATURE_CACHE;
+		num_bytes=0;
 
 		set_generic<T>();
 	}
@@ -68,10 +70,14 @@ template<class T> class CCache : public CSGObject
 	 * @param cache_size cache size in Megabytes
 	 * @param obj_size object size
 	 * @param num_entries number of cached objects
+	 * @param tag memory accounting tag the cache is charged to
 	 */
-	CCache(int64_t cache_size, int64_t obj_size, int64_t num_entries)
+	CCache(int64_t cache_size, int64_t obj_size, int64_t num_entries,
+			EMemoryTag tag=MEMORY_TAG_FEATURE_CACHE)
 	: CSGObject()
 	{
+		memory_tag=tag;
+
 		if (cache_size==0 || obj_size==0 || num_entries==0)
 		{
 			SG_INFO("doing without cache.\n")
@@ -81,6 +87,7 @@ template<class T> class CCache : public CSGObject
 			cache_is_full=false;
 			nr_cache_lines=0;
 			entry_size=0;
+			num_bytes=0;
 			return;
 		}
 
@@ -96,6 +103,10 @@ template<class T> class CCache : public CSGObject
 		ASSERT(lookup_table)
 		ASSERT(cache_table)
 
+		num_bytes=obj_size*nr_cache_lines*sizeof(T)+
+			num_entries*sizeof(TEntry)+nr_cache_lines*sizeof(TEntry*);
+		sg_memory_charge(memory_tag, num_bytes);
+
 		int64_t i;
 		for (i=0; i<nr_cache_lines; i++)
 			cache_table[i]=NULL;
@@ -117,6 +128,9 @@ template<class T> class CCache : public CSGObject
 
 	virtual ~CCache()
 	{
+		if (num_bytes)
+			sg_memory_release(memory_tag, num_bytes);
+
 		SG_FREE(cache_block);
 		SG_FREE(lookup_table);
 		SG_FREE(cache_table);
@@ -262,6 +276,10 @@ template<class T> class CCache : public CSGObject
 	TEntry** cache_table;
 	/** cache block */
 	T* cache_block;
+	/** memory accounting tag the cache is charged to */
+	EMemoryTag memory_tag;
+	/** bytes charged to memory_tag */
+	int64_t num_bytes;
 };
 }
 #endif
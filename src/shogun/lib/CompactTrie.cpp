@@ -0,0 +1,285 @@
+/*
+ * Copyright (c) The Shogun Machine Learning Toolbox
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation are those
+ * of the authors and should not be interpreted as representing official policies,
+ * either expressed or implied, of the Shogun Development Team.
+ *
+ */
+
+
+#include <shogun/lib/CompactTrie.h>
+#include <vector>
+
+using namespace shogun;
+
+const uint8_t CCompactTrie::popcount4[16]=
+	{ 0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4 };
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+namespace
+{
+/** node of the compact trie whose children still have to be emitted */
+struct PendingNode
+{
+	/** index in the compact arrays */
+	int32_t out;
+	/** node in tree memory */
+	int32_t src;
+	/** depth of the node, the root has depth 0 */
+	int32_t depth;
+	/** offset in the sequence of a terminal node, -1 for regular nodes */
+	int32_t seq_offset;
+};
+
+struct CompactArrays
+{
+	std::vector<uint8_t> mask;
+	std::vector<int32_t> first_child;
+	std::vector<float32_t> weights;
+
+	int32_t add_node(float64_t weight)
+	{
+		mask.push_back(0);
+		first_child.push_back(-1);
+		weights.push_back((float32_t) weight);
+		return (int32_t) mask.size()-1;
+	}
+};
+
+/* emits the nodes of one tree in level order and returns its root */
+int32_t compact_tree(CTrie<DNATrie>* trie, int32_t tree_pos,
+	const float64_t* weights_column, bool weights_in_tree, CompactArrays& out)
+{
+	int32_t degree=trie->get_degree();
+	std::vector<PendingNode> queue;
+
+	PendingNode root={ out.add_node(0.0), trie->get_tree_root(tree_pos), 0, -1 };
+	queue.push_back(root);
+
+	for (size_t q=0; q<queue.size(); q++)
+	{
+		PendingNode p=queue[q];
+		const DNATrie& node=trie->get_tree_node(p.src);
+		out.first_child[p.out]=(int32_t) out.mask.size();
+
+		if (p.seq_offset>=0)
+		{
+			/* one more symbol of a terminal node, stepping at depth p.depth */
+			int32_t k=p.seq_offset+1;
+			if (p.depth>=degree || k>=16 || node.seq[k]>=4)
+				continue;
+
+			float64_t w=node.weight;
+			if (weights_in_tree)
+				w*=weights_column[p.depth];
+			PendingNode child={ out.add_node(w), p.src, p.depth+1, k };
+			out.mask[p.out]=(uint8_t) (1<<node.seq[k]);
+			queue.push_back(child);
+		}
+		else if (p.depth==degree-1)
+		{
+			/* last level stores the weights of the children in place */
+			for (int32_t sym=0; sym<4; sym++)
+			{
+				if (node.child_weights[sym]==0)
+					continue;
+				out.add_node(node.child_weights[sym]);
+				out.mask[p.out]|=(uint8_t) (1<<sym);
+			}
+		}
+		else if (p.depth<degree-1)
+		{
+			for (int32_t sym=0; sym<4; sym++)
+			{
+				int32_t c=node.children[sym];
+				if (c==NO_CHILD)
+					continue;
+
+				out.mask[p.out]|=(uint8_t) (1<<sym);
+				if (c>=0)
+				{
+					PendingNode child={ out.add_node(trie->get_tree_node(c).weight),
+						c, p.depth+1, -1 };
+					queue.push_back(child);
+				}
+				else
+				{
+					/* terminal node, its first symbol is sym */
+					float64_t w=trie->get_tree_node(-c).weight;
+					if (weights_in_tree)
+						w*=weights_column[p.depth];
+					PendingNode child={ out.add_node(w), -c, p.depth+1, 0 };
+					queue.push_back(child);
+				}
+			}
+		}
+	}
+
+	return root.out;
+}
+}
+#endif // DOXYGEN_SHOULD_SKIP_THIS
+
+CCompactTrie::CCompactTrie() : CSGObject()
+{
+	init();
+}
+
+CCompactTrie::~CCompactTrie()
+{
+}
+
+void CCompactTrie::init()
+{
+	degree=0;
+	weights_in_tree=true;
+	position_weights=NULL;
+}
+
+void CCompactTrie::clear()
+{
+	m_roots=SGVector<int32_t>();
+	m_child_mask=SGVector<uint8_t>();
+	m_first_child=SGVector<int32_t>();
+	m_weights=SGVector<float32_t>();
+}
+
+void CCompactTrie::build(CTrie<DNATrie>* trie, float64_t* weights,
+	bool degree_times_position_weights, int32_t tree_num)
+{
+	REQUIRE(trie, "Trie must be set\n");
+	REQUIRE(weights, "Weights must be set\n");
+
+	degree=trie->get_degree();
+	weights_in_tree=trie->get_weights_in_tree();
+
+	int32_t num_trees=trie->get_length();
+	REQUIRE(tree_num<num_trees, "Tree %d does not exist (%d trees)\n",
+		tree_num, num_trees);
+
+	CompactArrays out;
+	if (tree_num<0)
+		out.mask.reserve(trie->get_num_used_nodes());
+
+	m_roots=SGVector<int32_t>(num_trees);
+	m_roots.set_const(-1);
+
+	for (int32_t i=0; i<num_trees; i++)
+	{
+		if (tree_num>=0 && i!=tree_num)
+			continue;
+
+		const float64_t* weights_column=weights;
+		if (degree_times_position_weights)
+			weights_column=&weights[i*degree];
+		m_roots[i]=compact_tree(trie, i, weights_column, weights_in_tree, out);
+	}
+
+	int32_t num_nodes=(int32_t) out.mask.size();
+	m_child_mask=SGVector<uint8_t>(num_nodes);
+	m_first_child=SGVector<int32_t>(num_nodes);
+	m_weights=SGVector<float32_t>(num_nodes);
+	if (num_nodes>0)
+	{
+		memcpy(m_child_mask.vector, &out.mask[0], sizeof(uint8_t)*num_nodes);
+		memcpy(m_first_child.vector, &out.first_child[0], sizeof(int32_t)*num_nodes);
+		memcpy(m_weights.vector, &out.weights[0], sizeof(float32_t)*num_nodes);
+	}
+
+	SG_DEBUG("compacted %d trie nodes into %d nodes\n",
+		trie->get_num_used_nodes(), num_nodes)
+}
+
+void CCompactTrie::compute_by_tree_helper(
+	const int32_t* vec, int32_t len, int32_t seq_pos, int32_t tree_pos,
+	int32_t weight_pos, float64_t* LevelContrib, float64_t factor,
+	int32_t mkl_stepsize, const float64_t* weights,
+	bool degree_times_position_weights) const
+{
+	if (position_weights!=NULL)
+		factor*=position_weights[weight_pos];
+	if (factor==0)
+		return;
+
+	const float64_t* weights_column=weights;
+	if (degree_times_position_weights)
+		weights_column=&weights[weight_pos*degree];
+
+	int32_t node=m_roots[tree_pos];
+	for (int32_t j=0; (j<degree) && (seq_pos+j<len); j++)
+	{
+		int32_t sym=vec[seq_pos+j];
+		uint8_t m=m_child_mask[node];
+		if (!(m & (1<<sym)))
+			break;
+
+		node=m_first_child[node]+popcount4[m & ((1<<sym)-1)];
+		float64_t contrib=factor*m_weights[node];
+		if (!weights_in_tree)
+			contrib*=weights_column[j];
+
+		/* with position weights all levels of a position share one entry */
+		int32_t level=j;
+		if (position_weights!=NULL)
+			level=weight_pos;
+		else if (degree_times_position_weights)
+			level=j+degree*weight_pos;
+		LevelContrib[level/mkl_stepsize]+=contrib;
+	}
+}
+
+float64_t* CCompactTrie::compute_abs_weights(int32_t &len) const
+{
+	int32_t num_trees=m_roots.vlen;
+	float64_t* sum=SG_CALLOC(float64_t, num_trees*4);
+	len=num_trees;
+
+	std::vector<int32_t> stack;
+	for (int32_t i=0; i<num_trees; i++)
+	{
+		if (!has_tree(i))
+			continue;
+
+		int32_t root=m_roots[i];
+		uint8_t m=m_child_mask[root];
+		for (int32_t k=0; k<4; k++)
+		{
+			if (!(m & (1<<k)))
+				continue;
+
+			stack.push_back(m_first_child[root]+popcount4[m & ((1<<k)-1)]);
+			while (!stack.empty())
+			{
+				int32_t node=stack.back();
+				stack.pop_back();
+				sum[i*4+k]+=m_weights[node];
+				for (int32_t c=0; c<popcount4[m_child_mask[node]]; c++)
+					stack.push_back(m_first_child[node]+c);
+			}
+		}
+	}
+
+	return sum;
+}
@@ -0,0 +1,229 @@
+/*
+ * Copyright (c) The Shogun Machine Learning Toolbox
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation are those
+ * of the authors and should not be interpreted as representing official policies,
+ * either expressed or implied, of the Shogun Development Team.
+ *
+ */
+
+
+#ifndef _COMPACTTRIE_H___
+#define _COMPACTTRIE_H___
+
+#include <shogun/lib/config.h>
+
+#include <shogun/lib/common.h>
+#include <shogun/lib/SGVector.h>
+#include <shogun/lib/Trie.h>
+#include <shogun/base/SGObject.h>
+
+namespace shogun
+{
+
+/** @brief Read-only, cache-compact copy of the trees of a CTrie<DNATrie>.
+ *
+ * Nodes of every tree are stored level by level in flat arrays. A node keeps
+ * a 4 bit child mask, the index of its first child and a float32 weight;
+ * the child for symbol s is found at first_child+popcount(mask & ((1<<s)-1)),
+ * as children of a node are stored next to each other.
+ * Terminal sequence nodes (see CTrie::get_use_compact_terminal_nodes) are
+ * expanded into chains and the float weights of the last level become leaves
+ * without children, so that a lookup is a single loop without branching on
+ * the node type.
+ *
+ * It is built once from a fully constructed trie (eg, after
+ * CWeightedDegreeStringKernel::init_optimization) and must be rebuilt when
+ * the trie changes. compute_by_tree_helper() returns the same value as
+ * CTrie::compute_by_tree_helper() up to float32 rounding of the weights.
+ */
+class CCompactTrie : public CSGObject
+{
+	public:
+		/** default constructor */
+		CCompactTrie();
+
+		/** destructor */
+		virtual ~CCompactTrie();
+
+		/** build the compact representation
+		 *
+		 * @param trie trie to be compacted
+		 * @param weights weights the trie was built with
+		 * @param degree_times_position_weights if degree times position
+		 *                                      weights are used
+		 * @param tree_num only compact this tree if non-negative,
+		 *                 all trees otherwise
+		 */
+		void build(CTrie<DNATrie>* trie, float64_t* weights,
+			bool degree_times_position_weights, int32_t tree_num=-1);
+
+		/** drop the compact representation */
+		void clear();
+
+		/** check whether a tree has been compacted
+		 *
+		 * @param tree_pos tree position
+		 * @return if the tree is available
+		 */
+		inline bool has_tree(int32_t tree_pos) const
+		{
+			return tree_pos>=0 && tree_pos<m_roots.vlen && m_roots[tree_pos]>=0;
+		}
+
+		/** get number of stored nodes
+		 *
+		 * @return number of nodes
+		 */
+		inline int32_t get_num_nodes() const
+		{
+			return m_child_mask.vlen;
+		}
+
+		/** set position weights
+		 *
+		 * @param p_position_weights new position weights
+		 */
+		inline void set_position_weights(float64_t* p_position_weights)
+		{
+			position_weights=p_position_weights;
+		}
+
+		/** compute by tree helper, see CTrie::compute_by_tree_helper()
+		 *
+		 * @param vec vector
+		 * @param len length
+		 * @param seq_pos sequence position
+		 * @param tree_pos tree position
+		 * @param weight_pos weight position
+		 * @param weights
+		 * @param degree_times_position_weights if degree times position
+		 *                                      weights shall be applied
+		 * @return a computed value
+		 */
+		inline float64_t compute_by_tree_helper(
+			const int32_t* vec, int32_t len, int32_t seq_pos, int32_t tree_pos,
+			int32_t weight_pos, const float64_t* weights,
+			bool degree_times_position_weights) const
+		{
+			if ((position_weights!=NULL) && (position_weights[weight_pos]==0))
+				return 0.0;
+
+			const float64_t* weights_column=NULL;
+			if (!weights_in_tree)
+			{
+				if (degree_times_position_weights)
+					weights_column=&weights[weight_pos*degree];
+				else
+					weights_column=weights;
+			}
+
+			const uint8_t* mask=m_child_mask.vector;
+			const int32_t* first_child=m_first_child.vector;
+			const float32_t* node_weights=m_weights.vector;
+
+			int32_t node=m_roots[tree_pos];
+			float64_t sum=0;
+			for (int32_t j=0; (j<degree) && (seq_pos+j<len); j++)
+			{
+				int32_t sym=vec[seq_pos+j];
+				uint8_t m=mask[node];
+				if (!(m & (1<<sym)))
+					break;
+
+				node=first_child[node]+popcount4[m & ((1<<sym)-1)];
+				if (weights_column)
+					sum+=node_weights[node]*weights_column[j];
+				else
+					sum+=node_weights[node];
+			}
+
+			if (position_weights!=NULL)
+				return sum*position_weights[weight_pos];
+			else
+				return sum;
+		}
+
+		/** compute by tree helper adding the contribution of each level,
+		 * see CTrie::compute_by_tree_helper()
+		 *
+		 * @param vec vector
+		 * @param len length
+		 * @param seq_pos sequence position
+		 * @param tree_pos tree position
+		 * @param weight_pos weight position
+		 * @param LevelContrib level contribution
+		 * @param factor factor
+		 * @param mkl_stepsize MKL stepsize
+		 * @param weights
+		 * @param degree_times_position_weights if degree times position
+		 *                                      weights shall be applied
+		 */
+		void compute_by_tree_helper(
+			const int32_t* vec, int32_t len, int32_t seq_pos, int32_t tree_pos,
+			int32_t weight_pos, float64_t* LevelContrib, float64_t factor,
+			int32_t mkl_stepsize, const float64_t* weights,
+			bool degree_times_position_weights) const;
+
+		/** compute absolute weights, see CTrie::compute_abs_weights()
+		 *
+		 * @param len length, set to the number of trees
+		 * @return sum of the weights below each child of each root
+		 */
+		float64_t* compute_abs_weights(int32_t &len) const;
+
+		/** @return object name */
+		virtual const char* get_name() const { return "CompactTrie"; }
+
+	private:
+		/** init */
+		void init();
+
+	protected:
+		/** degree */
+		int32_t degree;
+
+		/** if weights are in tree */
+		bool weights_in_tree;
+
+		/** position weights (not owned) */
+		float64_t* position_weights;
+
+		/** root node of each tree, -1 if the tree was not compacted */
+		SGVector<int32_t> m_roots;
+
+		/** child mask of each node */
+		SGVector<uint8_t> m_child_mask;
+
+		/** index of the first child of each node */
+		SGVector<int32_t> m_first_child;
+
+		/** weight of each node */
+		SGVector<float32_t> m_weights;
+
+		/** number of set bits of a 4 bit mask */
+		static const uint8_t popcount4[16];
+};
+}
+#endif // _COMPACTTRIE_H___
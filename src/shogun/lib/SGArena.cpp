@@ -0,0 +1,212 @@
+/*
+ * Copyright (c) The Shogun Machine Learning Toolbox
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation are those
+ * of the authors and should not be interpreted as representing official policies,
+ * either expressed or implied, of the Shogun Development Team.
+ *
+ */
+
+
+#include <shogun/lib/SGArena.h>
+#include <shogun/lib/RefCount.h>
+#include <shogun/lib/memory.h>
+#include <shogun/io/SGIO.h>
+
+#include <new>
+
+using namespace shogun;
+
+namespace shogun
+{
+/** header in front of the reference counter and data of a block */
+struct SGArenaBlock
+{
+	/** arena the block belongs to */
+	SGArena* arena;
+	/** size class of the block */
+	int32_t size_class;
+	/** next block in the free list */
+	SGArenaBlock* next;
+};
+}
+
+namespace
+{
+/** size of the smallest size class, each class doubles it */
+const size_t MIN_BLOCK_BYTES=64;
+
+/** @return n rounded up to a multiple of 16 */
+inline size_t align16(size_t n)
+{
+	return (n+15) & ~size_t(15);
+}
+
+const size_t REFCOUNT_OFFSET=align16(sizeof(SGArenaBlock));
+const size_t DATA_OFFSET=align16(REFCOUNT_OFFSET+sizeof(RefCount));
+
+inline SGArenaBlock* block_of(RefCount* refcount)
+{
+	return (SGArenaBlock*) ((char*) refcount-REFCOUNT_OFFSET);
+}
+
+inline RefCount* refcount_of(SGArenaBlock* block)
+{
+	return (RefCount*) ((char*) block+REFCOUNT_OFFSET);
+}
+
+#ifdef HAVE_CXX11_ATOMIC
+thread_local SGArena* current_arena=NULL;
+#endif
+}
+
+const size_t SGArena::MAX_DATA_BYTES=(MIN_BLOCK_BYTES<<(SGArena::NUM_SIZE_CLASSES-1))-DATA_OFFSET;
+
+SGArena::SGArena() : m_open(true), m_num_heap_blocks(0), m_num_reused_blocks(0)
+{
+#ifdef HAVE_CXX11_ATOMIC
+	m_refs=1;
+	m_owner=std::this_thread::get_id();
+#endif
+	for (int32_t i=0; i<NUM_SIZE_CLASSES; i++)
+		m_free[i]=NULL;
+}
+
+SGArena::~SGArena()
+{
+}
+
+SGArena* SGArena::current()
+{
+#ifdef HAVE_CXX11_ATOMIC
+	return current_arena;
+#else
+	return NULL;
+#endif
+}
+
+RefCount* SGArena::allocate(size_t bytes)
+{
+#ifdef HAVE_CXX11_ATOMIC
+	if (bytes>MAX_DATA_BYTES)
+		return NULL;
+
+	int32_t size_class=0;
+	while ((MIN_BLOCK_BYTES<<size_class)<DATA_OFFSET+bytes)
+		size_class++;
+
+	SGArenaBlock* block=m_free[size_class];
+	if (block)
+	{
+		m_free[size_class]=block->next;
+		m_num_reused_blocks++;
+	}
+	else
+	{
+		block=(SGArenaBlock*) SG_MALLOC(char, MIN_BLOCK_BYTES<<size_class);
+		block->arena=this;
+		block->size_class=size_class;
+		m_num_heap_blocks++;
+	}
+	block->next=NULL;
+	m_refs.fetch_add(1, std::memory_order_relaxed);
+
+	return new (refcount_of(block)) RefCount(0);
+#else
+	return NULL;
+#endif
+}
+
+void SGArena::release(RefCount* refcount)
+{
+	if (!refcount)
+		return;
+
+	SGArenaBlock* block=block_of(refcount);
+	SGArena* arena=block->arena;
+	refcount->~RefCount();
+
+#ifdef HAVE_CXX11_ATOMIC
+	if (arena->m_owner==std::this_thread::get_id() && arena->m_open)
+	{
+		block->next=arena->m_free[block->size_class];
+		arena->m_free[block->size_class]=block;
+	}
+	else
+		SG_FREE((char*) block);
+#endif
+
+	arena->unref();
+}
+
+void* SGArena::get_data(RefCount* refcount)
+{
+	return (char*) block_of(refcount)+DATA_OFFSET;
+}
+
+void SGArena::close()
+{
+	m_open=false;
+	for (int32_t i=0; i<NUM_SIZE_CLASSES; i++)
+	{
+		while (m_free[i])
+		{
+			SGArenaBlock* next=m_free[i]->next;
+			SG_FREE((char*) m_free[i]);
+			m_free[i]=next;
+		}
+	}
+	unref();
+}
+
+void SGArena::unref()
+{
+#ifdef HAVE_CXX11_ATOMIC
+	if (m_refs.fetch_sub(1, std::memory_order_acq_rel)==1)
+		delete this;
+#else
+	delete this;
+#endif
+}
+
+SGArenaScope::SGArenaScope()
+{
+#ifdef HAVE_CXX11_ATOMIC
+	m_previous=current_arena;
+	m_arena=new SGArena();
+	current_arena=m_arena;
+#else
+	m_previous=NULL;
+	m_arena=NULL;
+#endif
+}
+
+SGArenaScope::~SGArenaScope()
+{
+#ifdef HAVE_CXX11_ATOMIC
+	ASSERT(current_arena==m_arena)
+	current_arena=m_previous;
+	m_arena->close();
+#endif
+}
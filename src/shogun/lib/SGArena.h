@@ -0,0 +1,162 @@
+/*
+ * Copyright (c) The Shogun Machine Learning Toolbox
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation are those
+ * of the authors and should not be interpreted as representing official policies,
+ * either expressed or implied, of the Shogun Development Team.
+ *
+ */
+
+
+#ifndef __SG_ARENA_H__
+#define __SG_ARENA_H__
+
+#include <shogun/lib/config.h>
+#include <shogun/lib/common.h>
+
+#ifdef HAVE_CXX11_ATOMIC
+#include <atomic>
+#include <thread>
+#endif
+
+namespace shogun
+{
+class RefCount;
+struct SGArenaBlock;
+
+/** @brief Pool for the memory of short-lived SGVector and SGMatrix objects.
+ *
+ * While an SGArenaScope is active on a thread, reference counted SGVector
+ * and SGMatrix objects of trivially destructible element types created on
+ * that thread take their memory from the arena of the scope. The reference
+ * counter lives in the same block as the data, and blocks released on the
+ * creating thread while the scope is active go back to a free list of their
+ * size class. Temporaries created in a loop thus reuse a few blocks instead
+ * of calling malloc twice per object.
+ *
+ * Blocks released on another thread or after the scope ended are returned
+ * to the heap, so data may safely outlive the scope it was created in.
+ * Requests larger than the largest size class are served by the heap.
+ */
+class SGArena
+{
+	friend class SGArenaScope;
+
+public:
+	/** @return arena of the innermost scope active on this thread, or NULL */
+	static SGArena* current();
+
+	/** get a block holding a reference counter and data
+	 *
+	 * @param bytes size of the data
+	 * @return reference counter of the block, initialized to zero, or NULL
+	 * if bytes exceeds the largest size class
+	 */
+	RefCount* allocate(size_t bytes);
+
+	/** release the block of a reference counter obtained from allocate()
+	 *
+	 * @param refcount reference counter of the block
+	 */
+	static void release(RefCount* refcount);
+
+	/** @param refcount reference counter obtained from allocate()
+	 * @return data of the block of refcount
+	 */
+	static void* get_data(RefCount* refcount);
+
+	/** @return number of blocks taken from the heap */
+	int64_t get_num_heap_blocks() const { return m_num_heap_blocks; }
+
+	/** @return number of blocks served from the free lists */
+	int64_t get_num_reused_blocks() const { return m_num_reused_blocks; }
+
+	/** largest data size served from the arena */
+	static const size_t MAX_DATA_BYTES;
+
+private:
+	SGArena();
+	~SGArena();
+
+	/** free the cached blocks and drop the reference of the scope */
+	void close();
+
+	/** drop one reference, deleting the arena on the last one */
+	void unref();
+
+	/** number of size classes */
+	static const int32_t NUM_SIZE_CLASSES=15;
+
+#ifdef HAVE_CXX11_ATOMIC
+	/** one reference while open plus one per block handed out */
+	std::atomic<int32_t> m_refs;
+
+	/** thread owning the free lists */
+	std::thread::id m_owner;
+#endif
+
+	/** whether the scope of the arena is still active */
+	bool m_open;
+
+	/** free lists, one per size class */
+	SGArenaBlock* m_free[NUM_SIZE_CLASSES];
+
+	/** blocks taken from the heap */
+	int64_t m_num_heap_blocks;
+
+	/** blocks served from the free lists */
+	int64_t m_num_reused_blocks;
+};
+
+/** @brief Makes a new SGArena the current arena of this thread for its
+ * lifetime.
+ *
+ * Scopes nest; the previous arena becomes current again when the scope ends.
+ * Without C++11 atomics the scope is a no-op and all memory comes from the
+ * heap.
+ */
+class SGArenaScope
+{
+public:
+	/** constructor */
+	SGArenaScope();
+
+	/** destructor */
+	~SGArenaScope();
+
+	/** @return arena of this scope */
+	SGArena* get_arena() const { return m_arena; }
+
+private:
+	SGArenaScope(const SGArenaScope&);
+	SGArenaScope& operator=(const SGArenaScope&);
+
+	/** arena of this scope */
+	SGArena* m_arena;
+
+	/** arena that was current before this scope */
+	SGArena* m_previous;
+};
+}
+#endif // __SG_ARENA_H__
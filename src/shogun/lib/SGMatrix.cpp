@@ -43,9 +43,12 @@ SGMatrix<T>::SGMatrix(T* m, index_t nrows, index_t ncols, bool ref_counting)
 
 template <class T>
 SGMatrix<T>::SGMatrix(index_t nrows, index_t ncols, bool ref_counting)
-	: SGReferencedData(ref_counting), num_rows(nrows), num_cols(ncols)
+	: SGReferencedData(ref_counting, sizeof(T)*((int64_t) nrows)*ncols),
+	num_rows(nrows), num_cols(ncols)
 {
-	matrix=SG_MALLOC(T, ((int64_t) nrows)*ncols);
+	matrix=(T*) get_pooled_data();
+	if (!matrix)
+		matrix=SG_MALLOC(T, ((int64_t) nrows)*ncols);
 }
 
 template <class T>
@@ -1038,7 +1041,8 @@ void SGMatrix<T>::init_data()
 template<class T>
 void SGMatrix<T>::free_data()
 {
-	SG_FREE(matrix);
+	if (!is_pooled_data(matrix))
+		SG_FREE(matrix);
 	matrix=NULL;
 	num_rows=0;
 	num_cols=0;
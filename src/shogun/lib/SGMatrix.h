@@ -54,7 +54,11 @@ template<class T> class SGMatrix : public SGReferencedData
 			: SGReferencedData(false), matrix(m+offset),
 			num_rows(nrows), num_cols(ncols) { }
 
-		/** Constructor to create new matrix in memory */
+		/** Constructor to create new matrix in memory
+		 *
+		 * With reference counting, the memory is taken from the current
+		 * SGArena if an SGArenaScope is active on this thread.
+		 */
 		SGMatrix(index_t nrows, index_t ncols, bool ref_counting=true);
 
 #ifndef SWIG // SWIG should skip this part
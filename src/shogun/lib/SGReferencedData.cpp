@@ -1,11 +1,12 @@
 #include <shogun/lib/SGReferencedData.h>
 #include <shogun/lib/RefCount.h>
+#include <shogun/lib/SGArena.h>
 
 using namespace shogun;
 
 namespace shogun {
 
-SGReferencedData::SGReferencedData(bool ref_counting) : m_refcount(NULL)
+SGReferencedData::SGReferencedData(bool ref_counting) : m_refcount(NULL), m_pooled(false)
 {
 	if (ref_counting)
 	{
@@ -15,6 +16,24 @@ SGReferencedData::SGReferencedData(bool ref_counting) : m_refcount(NULL)
 	ref();
 }
 
+SGReferencedData::SGReferencedData(bool ref_counting, size_t data_bytes)
+	: m_refcount(NULL), m_pooled(false)
+{
+	if (ref_counting)
+	{
+		SGArena* arena=SGArena::current();
+		if (arena && data_bytes>0)
+			m_refcount=arena->allocate(data_bytes);
+
+		if (m_refcount)
+			m_pooled=true;
+		else
+			m_refcount = new RefCount(0);
+	}
+
+	ref();
+}
+
 SGReferencedData::SGReferencedData(const SGReferencedData &orig)
 {
 	copy_refcount(orig);
@@ -35,7 +54,10 @@ SGReferencedData& SGReferencedData::operator= (const SGReferencedData &orig)
 
 SGReferencedData::~SGReferencedData()
 {
-	delete m_refcount;
+	if (m_pooled)
+		SGArena::release(m_refcount);
+	else
+		delete m_refcount;
 }
 
 int32_t SGReferencedData::ref_count()
@@ -55,6 +77,20 @@ int32_t SGReferencedData::ref_count()
 void SGReferencedData::copy_refcount(const SGReferencedData &orig)
 {
 	m_refcount =  orig.m_refcount;
+	m_pooled = orig.m_pooled;
+}
+
+void* SGReferencedData::get_pooled_data() const
+{
+	if (!m_pooled)
+		return NULL;
+
+	return SGArena::get_data(m_refcount);
+}
+
+bool SGReferencedData::is_pooled_data(const void* data) const
+{
+	return m_pooled && data && data==SGArena::get_data(m_refcount);
 }
 
 /** increase reference counter
@@ -98,8 +134,12 @@ int32_t SGReferencedData::unref()
 		SG_SGCDEBUG("unref() refcount %d data %p destroying\n", c, this)
 #endif
 		free_data();
-		delete m_refcount;
+		if (m_pooled)
+			SGArena::release(m_refcount);
+		else
+			delete m_refcount;
 		m_refcount=NULL;
+		m_pooled=false;
 		return 0;
 	}
 	else
@@ -109,6 +149,7 @@ int32_t SGReferencedData::unref()
 #endif
 		init_data();
 		m_refcount=NULL;
+		m_pooled=false;
 		return c;
 	}
 }
@@ -24,6 +24,14 @@ class SGReferencedData
 		/** default constructor */
 		SGReferencedData(bool ref_counting=true);
 
+		/** constructor that takes the memory of the data from the current
+		 * SGArena, if any, together with the reference counter
+		 *
+		 * @param ref_counting whether to use reference counting
+		 * @param data_bytes size of the data
+		 */
+		SGReferencedData(bool ref_counting, size_t data_bytes);
+
 		/** copy constructor */
 		SGReferencedData(const SGReferencedData &orig);
 
@@ -47,6 +55,17 @@ class SGReferencedData
 		/** copy refcount */
 		void copy_refcount(const SGReferencedData &orig);
 
+		/** @return data co-allocated with the reference counter by an
+		 * SGArena, or NULL if the data has to be allocated separately
+		 */
+		void* get_pooled_data() const;
+
+		/** @param data pointer to data
+		 * @return whether data is co-allocated with the reference counter
+		 * and must thus not be freed or reallocated
+		 */
+		bool is_pooled_data(const void* data) const;
+
 		/** increase reference counter
 		 *
 		 * @return reference count
@@ -73,6 +92,9 @@ class SGReferencedData
 
 		/** reference counter */
 		RefCount* m_refcount;
+
+		/** whether m_refcount was allocated by an SGArena */
+		bool m_pooled;
 };
 }
 #endif // __SGREFERENCED_DATA_H__
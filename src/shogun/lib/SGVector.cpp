@@ -83,9 +83,11 @@ SGVector<T>::SGVector(T* v, index_t len, bool ref_counting)
 
 template<class T>
 SGVector<T>::SGVector(index_t len, bool ref_counting)
-: SGReferencedData(ref_counting), vlen(len)
+: SGReferencedData(ref_counting, sizeof(T)*len), vlen(len)
 {
-	vector=SG_MALLOC(T, len);
+	vector=(T*) get_pooled_data();
+	if (!vector)
+		vector=SG_MALLOC(T, len);
 }
 
 template<class T>
@@ -256,7 +258,14 @@ void SGVector<T>::set_element(const T& p_element, index_t index)
 template<class T>
 void SGVector<T>::resize_vector(int32_t n)
 {
-	vector=SG_REALLOC(T, vector, vlen, n);
+	if (is_pooled_data(vector))
+	{
+		T* resized=SG_MALLOC(T, n);
+		memcpy(resized, vector, CMath::min(vlen, n)*sizeof(T));
+		vector=resized;
+	}
+	else
+		vector=SG_REALLOC(T, vector, vlen, n);
 
 	if (n > vlen)
 		memset(&vector[vlen], 0, (n-vlen)*sizeof(T));
@@ -330,7 +339,8 @@ void SGVector<T>::init_data()
 template<class T>
 void SGVector<T>::free_data()
 {
-	SG_FREE(vector);
+	if (!is_pooled_data(vector))
+		SG_FREE(vector);
 	vector=NULL;
 	vlen=0;
 }
@@ -56,7 +56,11 @@ template<class T> class SGVector : public SGReferencedData
 		SGVector(T* m, index_t len, index_t offset)
 			: SGReferencedData(false), vector(m+offset), vlen(len) { }
 
-		/** Constructor to create new vector in memory */
+		/** Constructor to create new vector in memory
+		 *
+		 * With reference counting, the memory is taken from the current
+		 * SGArena if an SGArenaScope is active on this thread.
+		 */
 		SGVector(index_t len, bool ref_counting=true);
 
 		/** Copy constructor */
@@ -43,7 +43,7 @@ void CSignal::handler(int signal)
 {
 	if (signal == SIGINT)
 	{
-		SG_SPRINT("\nImmediately return to prompt / Prematurely finish computations / Do nothing (I/P/D)? ")
+		SG_SPRINT("\nImmediately return to prompt / Prematurely finish computations / Print memory summary / Do nothing (I/P/M/D)? ")
 		char answer=fgetc(stdin);
 
 		if (answer == 'I')
@@ -55,6 +55,8 @@ void CSignal::handler(int signal)
 		}
 		else if (answer == 'P')
 			set_cancel();
+		else if (answer == 'M')
+			sg_memory_summary(stdout);
 		else
 			SG_SPRINT("Continuing...\n")
 	}
@@ -0,0 +1,420 @@
+/*
+ * Copyright (c) The Shogun Machine Learning Toolbox
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation are those
+ * of the authors and should not be interpreted as representing official policies,
+ * either expressed or implied, of the Shogun Development Team.
+ *
+ */
+
+
+#include <shogun/lib/Tracing.h>
+#include <shogun/lib/Lock.h>
+#include <shogun/io/SGIO.h>
+
+#include <string.h>
+
+using namespace shogun;
+
+#ifdef HAVE_CXX11_ATOMIC
+#include <vector>
+#include <chrono>
+
+std::atomic<bool> shogun::sg_trace_on(false);
+
+namespace
+{
+/* number of distinct trace point names that can be registered */
+const int32_t max_trace_points=1024;
+
+/* events a thread stores before it drops further ones */
+const size_t max_trace_events=1<<20;
+
+struct TraceEvent
+{
+	int32_t point;
+	int64_t start;
+	int64_t duration;
+};
+
+/* written only by the owning thread, so the counters need no atomic
+ * read-modify-write, they are atomic only to be read by other threads.
+ * When its thread exits, the buffer is handed over with its statistics and
+ * events to the next thread that starts tracing, so a slot is only ever
+ * written by one thread at a time. */
+struct TraceThreadBuffer
+{
+	int32_t thread;
+	std::atomic<int64_t> calls[max_trace_points];
+	std::atomic<int64_t> totals[max_trace_points];
+	std::vector<TraceEvent> events;
+	int64_t num_dropped;
+};
+
+CLock trace_lock;
+const char* trace_point_names[max_trace_points];
+std::atomic<bool> trace_point_is_counter[max_trace_points];
+std::atomic<int32_t> num_trace_points;
+std::vector<TraceThreadBuffer*> trace_buffers;
+/* buffers of threads that exited, reused by new threads */
+std::vector<TraceThreadBuffer*> trace_free_buffers;
+thread_local TraceThreadBuffer* trace_buffer=NULL;
+
+/* returns the buffer of a thread to the free list when the thread exits,
+ * trace_buffer itself stays trivially destructible for the fast path */
+struct TraceBufferRelease
+{
+	TraceThreadBuffer* buffer;
+
+	TraceBufferRelease() : buffer(NULL)
+	{
+	}
+
+	~TraceBufferRelease()
+	{
+		if (!buffer)
+			return;
+
+		trace_lock.lock();
+		trace_free_buffers.push_back(buffer);
+		trace_lock.unlock();
+		trace_buffer=NULL;
+	}
+};
+thread_local TraceBufferRelease trace_buffer_release;
+
+TraceThreadBuffer* trace_get_buffer()
+{
+	if (!trace_buffer)
+	{
+		TraceThreadBuffer* buffer=NULL;
+		trace_lock.lock();
+		if (!trace_free_buffers.empty())
+		{
+			buffer=trace_free_buffers.back();
+			trace_free_buffers.pop_back();
+		}
+		else
+		{
+			buffer=new TraceThreadBuffer();
+			buffer->thread=trace_buffers.size();
+			trace_buffers.push_back(buffer);
+		}
+		trace_lock.unlock();
+		trace_buffer_release.buffer=buffer;
+		trace_buffer=buffer;
+	}
+
+	return trace_buffer;
+}
+
+inline void trace_add(std::atomic<int64_t>& counter, int64_t value)
+{
+	counter.store(counter.load(std::memory_order_relaxed)+value,
+			std::memory_order_relaxed);
+}
+
+SGTraceStats trace_point_stats(int32_t point)
+{
+	SGTraceStats stats={0, 0};
+	trace_lock.lock();
+	for (size_t i=0; i<trace_buffers.size(); i++)
+	{
+		stats.num_calls+=trace_buffers[i]->calls[point].load(std::memory_order_relaxed);
+		stats.total+=trace_buffers[i]->totals[point].load(std::memory_order_relaxed);
+	}
+	trace_lock.unlock();
+
+	return stats;
+}
+
+void trace_write_json_string(FILE* file, const char* str)
+{
+	fputc('"', file);
+	for (; *str; str++)
+	{
+		if (*str=='"' || *str=='\\')
+			fputc('\\', file);
+		if ((unsigned char) *str>=0x20)
+			fputc(*str, file);
+	}
+	fputc('"', file);
+}
+}
+
+SGTracePoint::SGTracePoint(const char* point_name) : name(point_name), id(-1)
+{
+	trace_lock.lock();
+	int32_t num=num_trace_points.load(std::memory_order_relaxed);
+	for (int32_t i=0; i<num && id<0; i++)
+	{
+		if (!strcmp(trace_point_names[i], name))
+			id=i;
+	}
+
+	if (id<0 && num<max_trace_points)
+	{
+		id=num;
+		trace_point_names[id]=name;
+		num_trace_points.store(num+1, std::memory_order_relaxed);
+	}
+	trace_lock.unlock();
+}
+
+void shogun::sg_trace_enable(bool enable)
+{
+	sg_trace_on.store(enable, std::memory_order_relaxed);
+}
+
+void shogun::sg_trace_clear()
+{
+	trace_lock.lock();
+	for (size_t i=0; i<trace_buffers.size(); i++)
+	{
+		for (int32_t j=0; j<max_trace_points; j++)
+		{
+			trace_buffers[i]->calls[j].store(0, std::memory_order_relaxed);
+			trace_buffers[i]->totals[j].store(0, std::memory_order_relaxed);
+		}
+		trace_buffers[i]->events.clear();
+		trace_buffers[i]->num_dropped=0;
+	}
+	trace_lock.unlock();
+}
+
+int64_t shogun::sg_trace_now()
+{
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(
+			std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void shogun::sg_trace_record(const SGTracePoint& point, int64_t start,
+		int64_t end, bool record_event)
+{
+	if (point.id<0)
+		return;
+
+	TraceThreadBuffer* buffer=trace_get_buffer();
+	trace_add(buffer->calls[point.id], 1);
+	trace_add(buffer->totals[point.id], end-start);
+
+	if (record_event)
+	{
+		if (buffer->events.size()<max_trace_events)
+		{
+			TraceEvent event={point.id, start, end-start};
+			buffer->events.push_back(event);
+		}
+		else
+			buffer->num_dropped++;
+	}
+}
+
+void shogun::sg_trace_count(const SGTracePoint& point, int64_t value)
+{
+	if (point.id<0)
+		return;
+
+	TraceThreadBuffer* buffer=trace_get_buffer();
+	trace_add(buffer->calls[point.id], 1);
+	trace_add(buffer->totals[point.id], value);
+	trace_point_is_counter[point.id].store(true, std::memory_order_relaxed);
+}
+
+SGTraceStats shogun::sg_trace_stats(const char* name)
+{
+	SGTraceStats stats={0, 0};
+	int32_t num=num_trace_points.load(std::memory_order_relaxed);
+	for (int32_t i=0; i<num; i++)
+	{
+		if (!strcmp(trace_point_names[i], name))
+			return trace_point_stats(i);
+	}
+
+	return stats;
+}
+
+void shogun::sg_trace_summary(FILE* target)
+{
+	fprintf(target, "%-48s %12s %16s %14s\n", "trace point", "calls",
+			"total ms/value", "mean ns/value");
+
+	int32_t num=num_trace_points.load(std::memory_order_relaxed);
+	for (int32_t i=0; i<num; i++)
+	{
+		SGTraceStats stats=trace_point_stats(i);
+		if (!stats.num_calls)
+			continue;
+
+		float64_t total=stats.total;
+		if (!trace_point_is_counter[i].load(std::memory_order_relaxed))
+			total/=1e6;
+
+		fprintf(target, "%-48s %12lld %16.3f %14.1f\n", trace_point_names[i],
+				(long long int) stats.num_calls, total,
+				((float64_t) stats.total)/stats.num_calls);
+	}
+}
+
+bool shogun::sg_trace_export_chrome(const char* filename)
+{
+	FILE* file=fopen(filename, "w");
+	if (!file)
+		return false;
+
+	trace_lock.lock();
+
+	int64_t origin=0;
+	int64_t last=0;
+	bool have_events=false;
+	int64_t num_dropped=0;
+	for (size_t i=0; i<trace_buffers.size(); i++)
+	{
+		const std::vector<TraceEvent>& events=trace_buffers[i]->events;
+		for (size_t j=0; j<events.size(); j++)
+		{
+			if (!have_events || events[j].start<origin)
+				origin=events[j].start;
+			if (!have_events || events[j].start+events[j].duration>last)
+				last=events[j].start+events[j].duration;
+			have_events=true;
+		}
+		num_dropped+=trace_buffers[i]->num_dropped;
+	}
+
+	fprintf(file, "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[");
+	const char* separator="\n";
+	for (size_t i=0; i<trace_buffers.size(); i++)
+	{
+		TraceThreadBuffer* buffer=trace_buffers[i];
+		fprintf(file, "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,"
+				"\"tid\":%d,\"args\":{\"name\":\"thread %d\"}}", separator,
+				buffer->thread, buffer->thread);
+		separator=",\n";
+
+		for (size_t j=0; j<buffer->events.size(); j++)
+		{
+			const TraceEvent& event=buffer->events[j];
+			fprintf(file, ",\n{\"name\":");
+			trace_write_json_string(file, trace_point_names[event.point]);
+			fprintf(file, ",\"cat\":\"shogun\",\"ph\":\"X\",\"pid\":1,\"tid\":%d,"
+					"\"ts\":%.3f,\"dur\":%.3f}", buffer->thread,
+					(event.start-origin)/1e3, event.duration/1e3);
+		}
+	}
+
+	/* counters and scopes traced without events only have statistics */
+	int32_t num=num_trace_points.load(std::memory_order_relaxed);
+	for (int32_t i=0; i<num; i++)
+	{
+		if (!trace_point_is_counter[i].load(std::memory_order_relaxed))
+			continue;
+
+		SGTraceStats stats={0, 0};
+		for (size_t j=0; j<trace_buffers.size(); j++)
+			stats.total+=trace_buffers[j]->totals[i].load(std::memory_order_relaxed);
+
+		fprintf(file, "%s{\"name\":", separator);
+		trace_write_json_string(file, trace_point_names[i]);
+		fprintf(file, ",\"ph\":\"C\",\"pid\":1,\"ts\":%.3f,\"args\":{\"value\":%lld}}",
+				(last-origin)/1e3, (long long int) stats.total);
+		separator=",\n";
+	}
+
+	fprintf(file, "\n],\"shogunStats\":[");
+	separator="\n";
+	for (int32_t i=0; i<num; i++)
+	{
+		SGTraceStats stats={0, 0};
+		for (size_t j=0; j<trace_buffers.size(); j++)
+		{
+			stats.num_calls+=trace_buffers[j]->calls[i].load(std::memory_order_relaxed);
+			stats.total+=trace_buffers[j]->totals[i].load(std::memory_order_relaxed);
+		}
+		if (!stats.num_calls)
+			continue;
+
+		fprintf(file, "%s{\"name\":", separator);
+		trace_write_json_string(file, trace_point_names[i]);
+		fprintf(file, ",\"calls\":%lld,\"%s\":%lld}", (long long int) stats.num_calls,
+				trace_point_is_counter[i].load(std::memory_order_relaxed) ? "total" : "total_ns",
+				(long long int) stats.total);
+		separator=",\n";
+	}
+	fprintf(file, "\n]}\n");
+
+	trace_lock.unlock();
+	bool written=!ferror(file);
+	fclose(file);
+
+	if (num_dropped)
+		SG_SWARNING("%lld trace events were dropped, only %lld are kept per thread\n",
+				(long long int) num_dropped, (long long int) max_trace_events)
+
+	return written;
+}
+
+#else //HAVE_CXX11_ATOMIC
+
+SGTracePoint::SGTracePoint(const char* point_name) : name(point_name), id(-1)
+{
+}
+
+void shogun::sg_trace_enable(bool enable)
+{
+}
+
+void shogun::sg_trace_clear()
+{
+}
+
+int64_t shogun::sg_trace_now()
+{
+	return 0;
+}
+
+void shogun::sg_trace_record(const SGTracePoint& point, int64_t start,
+		int64_t end, bool record_event)
+{
+}
+
+void shogun::sg_trace_count(const SGTracePoint& point, int64_t value)
+{
+}
+
+SGTraceStats shogun::sg_trace_stats(const char* name)
+{
+	SGTraceStats stats={0, 0};
+	return stats;
+}
+
+void shogun::sg_trace_summary(FILE* target)
+{
+}
+
+bool shogun::sg_trace_export_chrome(const char* filename)
+{
+	return false;
+}
+#endif //HAVE_CXX11_ATOMIC
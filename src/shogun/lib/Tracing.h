@@ -0,0 +1,216 @@
+/*
+ * Copyright (c) The Shogun Machine Learning Toolbox
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation are those
+ * of the authors and should not be interpreted as representing official policies,
+ * either expressed or implied, of the Shogun Development Team.
+ *
+ */
+
+
+#ifndef __SG_TRACING_H__
+#define __SG_TRACING_H__
+
+#include <shogun/lib/config.h>
+#include <shogun/lib/common.h>
+
+#include <stdio.h>
+
+#ifdef HAVE_CXX11_ATOMIC
+#include <atomic>
+#endif
+
+namespace shogun
+{
+
+/** @brief Named location in the code whose execution is traced.
+ *
+ * Trace points are registered once, usually as function local statics
+ * through the SG_TRACE_* macros, and identify the scopes and counters that
+ * SGTraceScope and sg_trace_count() record.
+ */
+struct SGTracePoint
+{
+	/** constructor
+	 *
+	 * @param point_name name of the trace point, has to outlive it
+	 */
+	SGTracePoint(const char* point_name);
+
+	/** name of the trace point */
+	const char* name;
+
+	/** index of the trace point, -1 if the registry is full */
+	int32_t id;
+};
+
+/** @brief Aggregated statistics of a trace point over all threads */
+struct SGTraceStats
+{
+	/** number of times the scope was executed or the counter updated */
+	int64_t num_calls;
+
+	/** nanoseconds spent in the scope, or sum of the counter values */
+	int64_t total;
+};
+
+#ifdef HAVE_CXX11_ATOMIC
+/** whether tracing is enabled, use sg_trace_is_enabled() */
+extern std::atomic<bool> sg_trace_on;
+
+/** @return whether tracing is enabled */
+inline bool sg_trace_is_enabled()
+{
+	return sg_trace_on.load(std::memory_order_relaxed);
+}
+#else
+/** @return whether tracing is enabled, never without atomics */
+inline bool sg_trace_is_enabled()
+{
+	return false;
+}
+#endif
+
+/** enable or disable tracing, which is disabled by default
+ *
+ * @param enable whether to record traces
+ */
+void sg_trace_enable(bool enable=true);
+
+/** drop all recorded events and statistics; no traced code may run
+ * concurrently
+ */
+void sg_trace_clear();
+
+/** @return monotonic clock in nanoseconds */
+int64_t sg_trace_now();
+
+/** record the execution of a scope by the calling thread
+ *
+ * @param point the scope's trace point
+ * @param start start time as returned by sg_trace_now()
+ * @param end end time as returned by sg_trace_now()
+ * @param record_event whether to store an event for the trace export in
+ * addition to updating the statistics
+ */
+void sg_trace_record(const SGTracePoint& point, int64_t start, int64_t end,
+		bool record_event);
+
+/** add a value to a counter of the calling thread
+ *
+ * @param point the counter's trace point
+ * @param value value to add
+ */
+void sg_trace_count(const SGTracePoint& point, int64_t value);
+
+/** @param name name of a trace point
+ * @return statistics of the trace point summed over all threads
+ */
+SGTraceStats sg_trace_stats(const char* name);
+
+/** print calls and time of all trace points that were hit
+ *
+ * @param target file to print to
+ */
+void sg_trace_summary(FILE* target=stdout);
+
+/** write the recorded events in Chrome trace event format (JSON), which
+ * chrome://tracing and Perfetto can display; no traced code may run
+ * concurrently. Threads that ran one after the other may share a track, as
+ * the buffer of an exited thread is reused by the next one.
+ *
+ * @param filename file to write
+ * @return whether the file could be written
+ */
+bool sg_trace_export_chrome(const char* filename);
+
+/** @brief Times a scope from its construction to its destruction if tracing
+ * is enabled at construction.
+ */
+class SGTraceScope
+{
+public:
+	/** constructor
+	 *
+	 * @param point trace point of the scope
+	 * @param record_event whether to record an event for the trace export,
+	 * false for scopes that are executed too often for that
+	 */
+	SGTraceScope(const SGTracePoint& point, bool record_event)
+		: m_point(NULL), m_record_event(false), m_start(0)
+	{
+		if (sg_trace_is_enabled())
+		{
+			m_point=&point;
+			m_record_event=record_event;
+			m_start=sg_trace_now();
+		}
+	}
+
+	/** destructor */
+	~SGTraceScope()
+	{
+		if (m_point)
+			sg_trace_record(*m_point, m_start, sg_trace_now(), m_record_event);
+	}
+
+private:
+	/** trace point, NULL if tracing was disabled */
+	const SGTracePoint* m_point;
+
+	/** whether to record an event */
+	bool m_record_event;
+
+	/** start time */
+	int64_t m_start;
+};
+
+}
+
+#define SG_TRACE_CONCAT_(a, b) a##b
+#define SG_TRACE_CONCAT(a, b) SG_TRACE_CONCAT_(a, b)
+
+/** trace the enclosing scope, recording an event for every execution */
+#define SG_TRACE_SCOPE(name) \
+	static shogun::SGTracePoint SG_TRACE_CONCAT(sg_trace_point_, __LINE__)(name); \
+	shogun::SGTraceScope SG_TRACE_CONCAT(sg_trace_scope_, __LINE__)( \
+			SG_TRACE_CONCAT(sg_trace_point_, __LINE__), true)
+
+/** trace the enclosing scope in the statistics only, for hot paths */
+#define SG_TRACE_HOT_SCOPE(name) \
+	static shogun::SGTracePoint SG_TRACE_CONCAT(sg_trace_point_, __LINE__)(name); \
+	shogun::SGTraceScope SG_TRACE_CONCAT(sg_trace_scope_, __LINE__)( \
+			SG_TRACE_CONCAT(sg_trace_point_, __LINE__), false)
+
+/** add value to the counter name if tracing is enabled */
+#define SG_TRACE_COUNT(name, value) \
+	do { \
+		if (shogun::sg_trace_is_enabled()) \
+		{ \
+			static shogun::SGTracePoint sg_trace_counter(name); \
+			shogun::sg_trace_count(sg_trace_counter, value); \
+		} \
+	} while (0)
+
+#endif /* __SG_TRACING_H__ */
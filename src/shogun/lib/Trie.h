@@ -239,6 +239,11 @@ IGNORE_IN_CLASSLIST template <class Trie> class CTrie : public CSGObject
 		 */
 		void delete_trees(bool p_use_compact_terminal_nodes=true);
 
+		/** give back the node memory the trees grew beyond the initial
+		 * size, eg after delete_trees() once a compact copy was built
+		 */
+		void shrink_tree_mem();
+
 		/** add to trie
 		 *
 		 * @param i i
@@ -478,6 +483,46 @@ IGNORE_IN_CLASSLIST template <class Trie> class CTrie : public CSGObject
 			return TreeMemPtr;
 		}
 
+		/** get degree
+		 *
+		 * @return degree of the trie
+		 */
+		inline int32_t get_degree()
+		{
+			return degree;
+		}
+
+		/** get number of trees (one per sequence position)
+		 *
+		 * @return number of trees
+		 */
+		inline int32_t get_length()
+		{
+			return length;
+		}
+
+		/** get the root node of a tree
+		 *
+		 * @param tree_pos tree position
+		 * @return index of the root node in tree memory
+		 */
+		inline int32_t get_tree_root(int32_t tree_pos)
+		{
+			ASSERT(trees && tree_pos>=0 && tree_pos<length)
+			return trees[tree_pos];
+		}
+
+		/** get a node from tree memory (read only)
+		 *
+		 * @param node index of the node
+		 * @return the node
+		 */
+		inline const Trie& get_tree_node(int32_t node)
+		{
+			TRIE_ASSERT(node>=0 && node<TreeMemPtr)
+			return TreeMem[node];
+		}
+
 		/** set position weights
 		 *
 		 * @param p_position_weights new position weights
@@ -1181,6 +1226,17 @@ template <class Trie> void CTrie<Trie>::delete_trees(
 	use_compact_terminal_nodes=p_use_compact_terminal_nodes ;
 }
 
+template <class Trie> void CTrie<Trie>::shrink_tree_mem()
+{
+	int32_t new_max=CMath::max((int32_t) (1024*1024/sizeof(Trie)), TreeMemPtr+11);
+	if (new_max>=TreeMemPtrMax)
+		return;
+
+	SG_DEBUG("Shrinking TreeMem from %i to %i elements\n", TreeMemPtrMax, new_max);
+	TreeMem=SG_REALLOC(Trie, TreeMem, TreeMemPtrMax, new_max);
+	TreeMemPtrMax=new_max;
+}
+
 	template <class Trie>
 float64_t CTrie<Trie>::compute_abs_weights_tree(int32_t tree, int32_t depth)
 {
@@ -1823,10 +1879,8 @@ void CTrie<Trie>::compute_by_tree_helper(
 						{
 							if (TreeMem[tree].seq[k]!=vec[seq_pos+j+k])
 								break ;
-							if (weights_in_tree)
-								LevelContrib[weight_pos/mkl_stepsize] += factor*TreeMem[tree].weight ;
-							else
-								LevelContrib[weight_pos/mkl_stepsize] += factor*TreeMem[tree].weight*weights[j+k] ;
+							// weights of terminal nodes are never in the tree
+							LevelContrib[weight_pos/mkl_stepsize] += factor*TreeMem[tree].weight*weights[j+k] ;
 						}
 						break ;
 					}
@@ -1867,10 +1921,8 @@ void CTrie<Trie>::compute_by_tree_helper(
 						{
 							if (TreeMem[tree].seq[k]!=vec[seq_pos+j+k])
 								break ;
-							if (weights_in_tree)
-								LevelContrib[weight_pos/mkl_stepsize] += factor*TreeMem[tree].weight ;
-							else
-								LevelContrib[weight_pos/mkl_stepsize] += factor*TreeMem[tree].weight*weights[j+k+weight_pos*degree] ;
+							// weights of terminal nodes are never in the tree
+							LevelContrib[weight_pos/mkl_stepsize] += factor*TreeMem[tree].weight*weights[j+k+weight_pos*degree] ;
 						}
 						break ;
 					}
@@ -1913,10 +1965,8 @@ void CTrie<Trie>::compute_by_tree_helper(
 					{
 						if (TreeMem[tree].seq[k]!=vec[seq_pos+j+k])
 							break ;
-						if (weights_in_tree)
-							LevelContrib[(j+k)/mkl_stepsize] += factor*TreeMem[tree].weight ;
-						else
-							LevelContrib[(j+k)/mkl_stepsize] += factor*TreeMem[tree].weight*weights[j+k] ;
+						// weights of terminal nodes are never in the tree
+						LevelContrib[(j+k)/mkl_stepsize] += factor*TreeMem[tree].weight*weights[j+k] ;
 					}
 					break ;
 				}
@@ -1976,10 +2026,8 @@ void CTrie<Trie>::compute_by_tree_helper(
 					{
 						if (TreeMem[tree].seq[k]!=vec[seq_pos+j+k])
 							break ;
-						if (weights_in_tree)
-							LevelContrib[(j+k+degree*weight_pos)/mkl_stepsize] += factor*TreeMem[tree].weight ;
-						else
-							LevelContrib[(j+k+degree*weight_pos)/mkl_stepsize] += factor*TreeMem[tree].weight*weights[j+k+weight_pos*degree] ;
+						// weights of terminal nodes are never in the tree
+						LevelContrib[(j+k+degree*weight_pos)/mkl_stepsize] += factor*TreeMem[tree].weight*weights[j+k+weight_pos*degree] ;
 					}
 					break ;
 				}
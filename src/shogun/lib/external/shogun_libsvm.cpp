@@ -108,6 +108,7 @@ private:
 Cache::Cache(int32_t l_, int64_t size_):l(l_),size(size_)
 {
 	head = (head_t *)SG_CALLOC(head_t, l);	// initialized to 0
+	sg_memory_charge(MEMORY_TAG_KERNEL_CACHE, l*sizeof(head_t));
 	size /= sizeof(Qfloat);
 	size -= l * sizeof(head_t) / sizeof(Qfloat);
 	size = CMath::max(size, (int64_t) 2*l);	// cache must be large enough for two columns
@@ -117,8 +118,12 @@ Cache::Cache(int32_t l_, int64_t size_):l(l_),size(size_)
 Cache::~Cache()
 {
 	for(head_t *h = lru_head.next; h != &lru_head; h=h->next)
+	{
+		sg_memory_release(MEMORY_TAG_KERNEL_CACHE, h->len*sizeof(Qfloat));
 		SG_FREE(h->data);
+	}
 	SG_FREE(head);
+	sg_memory_release(MEMORY_TAG_KERNEL_CACHE, l*sizeof(head_t));
 }
 
 void Cache::lru_delete(head_t *h)
@@ -150,6 +155,7 @@ int32_t Cache::get_data(const int32_t index, Qfloat **data, int32_t len)
 		{
 			head_t *old = lru_head.next;
 			lru_delete(old);
+			sg_memory_release(MEMORY_TAG_KERNEL_CACHE, old->len*sizeof(Qfloat));
 			SG_FREE(old->data);
 			size += old->len;
 			old->data = 0;
@@ -158,6 +164,7 @@ int32_t Cache::get_data(const int32_t index, Qfloat **data, int32_t len)
 
 		// allocate new space
 		h->data = SG_REALLOC(Qfloat, h->data, h->len, len);
+		sg_memory_charge(MEMORY_TAG_KERNEL_CACHE, more*sizeof(Qfloat));
 		size -= more;
 		CMath::swap(h->len,len);
 	}
@@ -189,6 +196,7 @@ void Cache::swap_index(int32_t i, int32_t j)
 			{
 				// give up
 				lru_delete(h);
+				sg_memory_release(MEMORY_TAG_KERNEL_CACHE, h->len*sizeof(Qfloat));
 				SG_FREE(h->data);
 				size += h->len;
 				h->data = 0;
@@ -502,6 +510,11 @@ void Solver::Solve(
 	this->eps = p_eps;
 	unshrink = false;
 
+	// p, y, alpha, alpha_status, active_set, G and G_bar
+	int64_t num_bytes=((int64_t) l)*(4*sizeof(float64_t)+sizeof(schar)+
+			sizeof(char)+sizeof(int32_t));
+	sg_memory_charge(MEMORY_TAG_SVM_SOLVER, num_bytes);
+
 	// initialize alpha_status
 	{
 		alpha_status = SG_MALLOC(char, l);
@@ -797,6 +810,7 @@ void Solver::Solve(
 	SG_FREE(active_set);
 	SG_FREE(G);
 	SG_FREE(G_bar);
+	sg_memory_release(MEMORY_TAG_SVM_SOLVER, num_bytes);
 }
 
 // return 1 if already optimal, return 0 otherwise
@@ -14,6 +14,7 @@
 #include <shogun/lib/SGVector.h>
 #include <shogun/lib/SGSparseVector.h>
 #include <shogun/lib/SGMatrix.h>
+#include <shogun/io/SGIO.h>
 
 #include <string.h>
 #include <stdio.h>
@@ -23,6 +24,12 @@
 #include <jemalloc/jemalloc.h>
 #elif USE_TCMALLOC
 #include <gperftools/tcmalloc.h>
+#elif HAVE_MALLOC_USABLE_SIZE
+#include <malloc.h>
+#endif
+
+#ifdef HAVE_CXX11_ATOMIC
+#include <atomic>
 #endif
 
 using namespace shogun;
@@ -90,6 +97,123 @@ void MemoryBlock::set_sgobject()
 }
 #endif
 
+namespace
+{
+#ifdef HAVE_CXX11_ATOMIC
+/* The heap counters are spread over slots which threads pick once, so that
+ * allocating threads do not contend for the same cache line. Slots are only
+ * summed up when statistics are requested. */
+const int32_t num_memory_slots=64;
+
+/* heap bytes a slot accumulates before adding them to the published heap
+ * usage that peak tracking is based on */
+const int64_t memory_publish_bytes=1<<16;
+
+struct alignas(64) MemorySlot
+{
+	std::atomic<int64_t> bytes;
+	std::atomic<int64_t> allocs;
+	std::atomic<int64_t> frees;
+	std::atomic<int64_t> unpublished;
+};
+
+struct MemoryTagCounters
+{
+	std::atomic<int64_t> bytes;
+	std::atomic<int64_t> allocs;
+	std::atomic<int64_t> frees;
+	std::atomic<int64_t> peak;
+};
+
+/* all of these are zero initialized before any allocation can happen */
+MemorySlot memory_slots[num_memory_slots];
+std::atomic<int32_t> memory_next_slot;
+thread_local int32_t memory_slot=-1;
+std::atomic<int64_t> memory_heap_published;
+MemoryTagCounters memory_tags[MEMORY_TAG_NUM];
+
+inline void memory_update_peak(EMemoryTag tag, int64_t bytes)
+{
+	int64_t peak=memory_tags[tag].peak.load(std::memory_order_relaxed);
+	while (bytes>peak && !memory_tags[tag].peak.compare_exchange_weak(peak,
+				bytes, std::memory_order_relaxed));
+}
+
+inline MemorySlot& memory_get_slot()
+{
+	if (memory_slot<0)
+	{
+		memory_slot=memory_next_slot.fetch_add(1, std::memory_order_relaxed)
+			%num_memory_slots;
+	}
+
+	return memory_slots[memory_slot];
+}
+
+inline void memory_publish(MemorySlot& slot, int64_t bytes)
+{
+	int64_t unpublished=slot.unpublished.fetch_add(bytes,
+			std::memory_order_relaxed)+bytes;
+
+	if (unpublished>=memory_publish_bytes || unpublished<=-memory_publish_bytes)
+	{
+		unpublished=slot.unpublished.exchange(0, std::memory_order_relaxed);
+		int64_t heap=memory_heap_published.fetch_add(unpublished,
+				std::memory_order_relaxed)+unpublished;
+		memory_update_peak(MEMORY_TAG_HEAP, heap);
+	}
+}
+
+int64_t memory_heap_bytes()
+{
+	int64_t bytes=0;
+	for (int32_t i=0; i<num_memory_slots; i++)
+		bytes+=memory_slots[i].bytes.load(std::memory_order_relaxed);
+
+	return bytes;
+}
+#endif //HAVE_CXX11_ATOMIC
+
+/* number of bytes the allocator reserved for p, 0 if it cannot tell */
+inline int64_t memory_usable_size(void* p)
+{
+#if defined(USE_JEMALLOC)
+	return je_malloc_usable_size(p);
+#elif defined(USE_TCMALLOC)
+	return tc_malloc_size(p);
+#elif defined(HAVE_MALLOC_USABLE_SIZE)
+	return malloc_usable_size(p);
+#else
+	return 0;
+#endif
+}
+
+inline void memory_account_alloc(void* p)
+{
+#ifdef HAVE_CXX11_ATOMIC
+	if (!p)
+		return;
+
+	int64_t bytes=memory_usable_size(p);
+	MemorySlot& slot=memory_get_slot();
+	slot.bytes.fetch_add(bytes, std::memory_order_relaxed);
+	slot.allocs.fetch_add(1, std::memory_order_relaxed);
+	memory_publish(slot, bytes);
+#endif
+}
+
+/* bytes has to be obtained from memory_usable_size() before freeing */
+inline void memory_account_free(int64_t bytes)
+{
+#ifdef HAVE_CXX11_ATOMIC
+	MemorySlot& slot=memory_get_slot();
+	slot.bytes.fetch_sub(bytes, std::memory_order_relaxed);
+	slot.frees.fetch_add(1, std::memory_order_relaxed);
+	memory_publish(slot, -bytes);
+#endif
+}
+}
+
 #ifdef HAVE_CXX11
 void* operator new(size_t size)
 #else
@@ -108,6 +232,8 @@ void* operator new(size_t size) throw (std::bad_alloc)
 	if (sg_mallocs)
 		sg_mallocs->add(p, MemoryBlock(p,size));
 #endif
+	memory_account_alloc(p);
+
 	if (!p)
 	{
 		const size_t buf_len=128;
@@ -125,6 +251,9 @@ void* operator new(size_t size) throw (std::bad_alloc)
 
 void operator delete(void *p) throw()
 {
+	if (p)
+		memory_account_free(memory_usable_size(p));
+
 #ifdef TRACE_MEMORY_ALLOCS
 	if (sg_mallocs)
 		sg_mallocs->remove(p);
@@ -158,6 +287,8 @@ void* operator new[](size_t size) throw(std::bad_alloc)
 		sg_mallocs->add(p, MemoryBlock(p,size));
 #endif
 
+	memory_account_alloc(p);
+
 	if (!p)
 	{
 		const size_t buf_len=128;
@@ -175,6 +306,9 @@ void* operator new[](size_t size) throw(std::bad_alloc)
 
 void operator delete[](void *p) throw()
 {
+	if (p)
+		memory_account_free(memory_usable_size(p));
+
 #ifdef TRACE_MEMORY_ALLOCS
 	if (sg_mallocs)
 		sg_mallocs->remove(p);
@@ -209,6 +343,8 @@ void* sg_malloc(size_t size
 		sg_mallocs->add(p, MemoryBlock(p,size, file, line));
 #endif
 
+	memory_account_alloc(p);
+
 	if (!p)
 	{
 		const size_t buf_len=128;
@@ -243,6 +379,8 @@ void* sg_calloc(size_t num, size_t size
 		sg_mallocs->add(p, MemoryBlock(p,size, file, line));
 #endif
 
+	memory_account_alloc(p);
+
 	if (!p)
 	{
 		const size_t buf_len=128;
@@ -262,6 +400,9 @@ void* sg_calloc(size_t num, size_t size
 
 void  sg_free(void* ptr)
 {
+	if (ptr)
+		memory_account_free(memory_usable_size(ptr));
+
 #ifdef TRACE_MEMORY_ALLOCS
 	if (sg_mallocs)
 		sg_mallocs->remove(ptr);
@@ -282,6 +423,8 @@ void* sg_realloc(void* ptr, size_t size
 #endif
 )
 {
+	int64_t old_size=ptr ? memory_usable_size(ptr) : 0;
+
 #if defined(USE_JEMALLOC)
 	void* p=je_realloc(ptr, size);
 #elif defined(USE_TCMALLOC)
@@ -298,6 +441,14 @@ void* sg_realloc(void* ptr, size_t size
 		sg_mallocs->add(p, MemoryBlock(p,size, file, line));
 #endif
 
+	/* a failed realloc leaves ptr in place, a zero size one frees it */
+	if (p || !size)
+	{
+		if (ptr)
+			memory_account_free(old_size);
+		memory_account_alloc(p);
+	}
+
 	if (!p && (size || !ptr))
 	{
 		const size_t buf_len=128;
@@ -455,3 +606,103 @@ char* shogun::get_strdup(const char* str)
 
 	return (char*) get_copy((void*) str, strlen(str)+1);
 }
+
+void shogun::sg_memory_charge(EMemoryTag tag, int64_t bytes)
+{
+	ASSERT(tag>MEMORY_TAG_HEAP && tag<MEMORY_TAG_NUM)
+#ifdef HAVE_CXX11_ATOMIC
+	int64_t current=memory_tags[tag].bytes.fetch_add(bytes,
+			std::memory_order_relaxed)+bytes;
+	memory_tags[tag].allocs.fetch_add(1, std::memory_order_relaxed);
+	memory_update_peak(tag, current);
+#endif
+}
+
+void shogun::sg_memory_release(EMemoryTag tag, int64_t bytes)
+{
+	ASSERT(tag>MEMORY_TAG_HEAP && tag<MEMORY_TAG_NUM)
+#ifdef HAVE_CXX11_ATOMIC
+	memory_tags[tag].bytes.fetch_sub(bytes, std::memory_order_relaxed);
+	memory_tags[tag].frees.fetch_add(1, std::memory_order_relaxed);
+#endif
+}
+
+SGMemoryStats shogun::sg_memory_stats(EMemoryTag tag)
+{
+	ASSERT(tag>=MEMORY_TAG_HEAP && tag<MEMORY_TAG_NUM)
+	SGMemoryStats stats={0, 0, 0, 0};
+
+#ifdef HAVE_CXX11_ATOMIC
+	if (tag==MEMORY_TAG_HEAP)
+	{
+		for (int32_t i=0; i<num_memory_slots; i++)
+		{
+			stats.current_bytes+=memory_slots[i].bytes.load(std::memory_order_relaxed);
+			stats.num_allocs+=memory_slots[i].allocs.load(std::memory_order_relaxed);
+			stats.num_frees+=memory_slots[i].frees.load(std::memory_order_relaxed);
+		}
+
+		/* the published usage may lag behind the exact one */
+		memory_update_peak(tag, stats.current_bytes);
+	}
+	else
+	{
+		stats.current_bytes=memory_tags[tag].bytes.load(std::memory_order_relaxed);
+		stats.num_allocs=memory_tags[tag].allocs.load(std::memory_order_relaxed);
+		stats.num_frees=memory_tags[tag].frees.load(std::memory_order_relaxed);
+	}
+	stats.peak_bytes=memory_tags[tag].peak.load(std::memory_order_relaxed);
+#endif
+
+	return stats;
+}
+
+const char* shogun::sg_memory_tag_name(EMemoryTag tag)
+{
+	switch (tag)
+	{
+		case MEMORY_TAG_HEAP:
+			return "heap";
+		case MEMORY_TAG_KERNEL_CACHE:
+			return "kernel cache";
+		case MEMORY_TAG_FEATURE_CACHE:
+			return "feature cache";
+		case MEMORY_TAG_SVM_SOLVER:
+			return "svm solver";
+		case MEMORY_TAG_TREES:
+			return "trees";
+		default:
+			return "unknown";
+	}
+}
+
+void shogun::sg_memory_reset_peaks()
+{
+#ifdef HAVE_CXX11_ATOMIC
+	memory_tags[MEMORY_TAG_HEAP].peak.store(memory_heap_bytes(),
+			std::memory_order_relaxed);
+
+	for (int32_t i=MEMORY_TAG_HEAP+1; i<MEMORY_TAG_NUM; i++)
+	{
+		memory_tags[i].peak.store(memory_tags[i].bytes.load(
+				std::memory_order_relaxed), std::memory_order_relaxed);
+	}
+#endif
+}
+
+void shogun::sg_memory_summary(FILE* target)
+{
+	fprintf(target, "%-16s %16s %16s %12s %12s\n", "memory", "current bytes",
+			"peak bytes", "allocs", "frees");
+
+	for (int32_t i=0; i<MEMORY_TAG_NUM; i++)
+	{
+		SGMemoryStats stats=sg_memory_stats((EMemoryTag) i);
+		fprintf(target, "%-16s %16lld %16lld %12lld %12lld\n",
+				sg_memory_tag_name((EMemoryTag) i),
+				(long long int) stats.current_bytes,
+				(long long int) stats.peak_bytes,
+				(long long int) stats.num_allocs,
+				(long long int) stats.num_frees);
+	}
+}
@@ -201,8 +201,74 @@ SG_SPECIALIZED_MALLOC(SGMatrix<complex128_t>)
 
 void* get_copy(void* src, size_t len);
 char* get_strdup(const char* str);
+
 }
 
 #endif // DOXYGEN_SHOULD_SKIP_THIS
 
+namespace shogun
+{
+/** subsystems memory is accounted for
+ *
+ * MEMORY_TAG_HEAP is maintained by the allocators above and covers all
+ * memory obtained through them; the other tags count what the respective
+ * subsystem reports holding via sg_memory_charge() / sg_memory_release().
+ */
+enum EMemoryTag
+{
+	MEMORY_TAG_HEAP=0,
+	MEMORY_TAG_KERNEL_CACHE,
+	MEMORY_TAG_FEATURE_CACHE,
+	MEMORY_TAG_SVM_SOLVER,
+	MEMORY_TAG_TREES,
+	MEMORY_TAG_NUM
+};
+
+/** @brief memory statistics of one accounting tag */
+struct SGMemoryStats
+{
+	/** bytes currently held */
+	int64_t current_bytes;
+	/** largest number of bytes held at once */
+	int64_t peak_bytes;
+	/** number of allocations or charges */
+	int64_t num_allocs;
+	/** number of frees or releases */
+	int64_t num_frees;
+};
+
+/** account bytes a subsystem starts holding
+ *
+ * @param tag subsystem holding the memory
+ * @param bytes number of bytes
+ */
+void sg_memory_charge(EMemoryTag tag, int64_t bytes);
+
+/** account bytes a subsystem stops holding
+ *
+ * @param tag subsystem that held the memory
+ * @param bytes number of bytes, as previously charged
+ */
+void sg_memory_release(EMemoryTag tag, int64_t bytes);
+
+/** @param tag accounting tag
+ * @return current statistics of tag
+ */
+SGMemoryStats sg_memory_stats(EMemoryTag tag);
+
+/** @param tag accounting tag
+ * @return printable name of tag
+ */
+const char* sg_memory_tag_name(EMemoryTag tag);
+
+/** restart peak tracking of all tags from the current usage */
+void sg_memory_reset_peaks();
+
+/** print a table of the statistics of all tags
+ *
+ * @param target file to print to
+ */
+void sg_memory_summary(FILE* target=stdout);
+}
+
 #endif // __MEMORY_H__
@@ -411,6 +411,16 @@ namespace tapkee
 			 */
 			const ParameterKeyword<ScalarType> squishing_rate("squishing rate", 0.99);
 
+			/** The keyword for the value that stores the number of
+			 * threads used to find neighbors with @ref tapkee::Brute.
+			 *
+			 * Default value is 1.
+			 *
+			 * The corresponding value should have type @ref tapkee::IndexType
+			 * and be positive.
+			 */
+			const ParameterKeyword<IndexType> num_threads("number of threads", 1);
+
 			/** The default value - assigning any keyword to this
 			 * static struct produces a parameter with its default value.
 			 */
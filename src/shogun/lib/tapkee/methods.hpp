@@ -54,6 +54,7 @@ public:
 		check_connectivity(), n_neighbors(), width(), timesteps(),
 		ratio(), max_iteration(), tolerance(), n_updates(), perplexity(),
 		theta(), squishing_rate(), global_strategy(), epsilon(), target_dimension(),
+		n_threads(),
 		n_vectors(0), current_dimension(0)
 	{
 		n_vectors = (end-begin);
@@ -81,6 +82,7 @@ public:
 		n_updates = parameters(keywords::spe_num_updates).checked().positive();
 		theta = parameters(keywords::sne_theta).checked().nonNegative();
 		squishing_rate = parameters(keywords::squishing_rate);
+		n_threads = parameters(keywords::num_threads).checked().positive();
 		global_strategy = parameters(keywords::spe_global_strategy);
 		epsilon = parameters(keywords::fa_epsilon).checked().nonNegative();
 		perplexity = parameters(keywords::sne_perplexity).checked().nonNegative();
@@ -180,6 +182,7 @@ private:
 	Parameter global_strategy;
 	Parameter epsilon;
 	Parameter target_dimension;
+	Parameter n_threads;
 
 	IndexType n_vectors;
 	IndexType current_dimension;
@@ -187,7 +190,7 @@ private:
 	template<class Distance>
 	Neighbors findNeighborsWith(Distance d)
 	{
-		return find_neighbors(neighbors_method,begin,end,d,n_neighbors,check_connectivity);
+		return find_neighbors(neighbors_method,begin,end,d,n_neighbors,check_connectivity,n_threads);
 	}
 
 	static tapkee::ProjectingFunction unimplementedProjectingFunction()
@@ -118,17 +118,20 @@ Neighbors find_neighbors_covertree_impl(RandomAccessIterator begin, RandomAccess
 
 template <class RandomAccessIterator, class Callback>
 Neighbors find_neighbors_bruteforce_impl(const RandomAccessIterator& begin, const RandomAccessIterator& end,
-                                         Callback callback, IndexType k)
+                                         Callback callback, IndexType k, IndexType n_threads)
 {
 	timed_context context("Distance sorting based neighbors search");
 	typedef std::pair<RandomAccessIterator, ScalarType> DistanceRecord;
 	typedef std::vector<DistanceRecord> Distances;
 
-	Neighbors neighbors;
-	neighbors.reserve(end-begin);
-	for (RandomAccessIterator iter=begin; iter!=end; ++iter)
+	const IndexType n_objects = static_cast<IndexType>(end-begin);
+	Neighbors neighbors(n_objects);
+#pragma omp parallel for num_threads(n_threads)
+	for (IndexType i=0; i<n_objects; ++i)
 	{
+		RandomAccessIterator iter = begin+i;
 		Distances distances;
+		distances.reserve(n_objects);
 		for (RandomAccessIterator around_iter=begin; around_iter!=end; ++around_iter)
 			distances.push_back(std::make_pair(around_iter, callback.distance(iter,around_iter)));
 
@@ -143,7 +146,7 @@ Neighbors find_neighbors_bruteforce_impl(const RandomAccessIterator& begin, cons
 			if (neighbors_iter->first != iter)
 				local_neighbors.push_back(neighbors_iter->first - begin);
 		}
-		neighbors.push_back(local_neighbors);
+		neighbors[i] = local_neighbors;
 	}
 	return neighbors;
 }
@@ -172,7 +175,7 @@ Neighbors find_neighbors_vptree_impl(const RandomAccessIterator& begin, const Ra
 template <class RandomAccessIterator, class Callback>
 Neighbors find_neighbors(NeighborsMethod method, const RandomAccessIterator& begin,
                          const RandomAccessIterator& end, const Callback& callback,
-                         IndexType k, bool check_connectivity)
+                         IndexType k, bool check_connectivity, IndexType n_threads=1)
 {
 	if (k > static_cast<IndexType>(end-begin-1))
 	{
@@ -184,7 +187,7 @@ Neighbors find_neighbors(NeighborsMethod method, const RandomAccessIterator& beg
 	Neighbors neighbors;
 	switch (method)
 	{
-		case Brute: neighbors = find_neighbors_bruteforce_impl(begin,end,callback,k); break;
+		case Brute: neighbors = find_neighbors_bruteforce_impl(begin,end,callback,k,n_threads); break;
 		case VpTree: neighbors = find_neighbors_vptree_impl(begin,end,callback,k); break;
 #ifdef USE_GPL_SHOGUN
 		case CoverTree: neighbors = find_neighbors_covertree_impl(begin,end,callback,k); break;
@@ -32,6 +32,7 @@ const ParametersSet defaults = (
 	tapkee::keywords::cancel_function = tapkee::keywords::by_default,
 	tapkee::keywords::sne_perplexity = tapkee::keywords::by_default,
 	tapkee::keywords::squishing_rate = tapkee::keywords::by_default,
+	tapkee::keywords::num_threads = tapkee::keywords::by_default,
 	tapkee::keywords::sne_theta = tapkee::keywords::by_default);
 
 }
@@ -135,6 +135,14 @@ public:
 	 */
 	void reserve(size_t length);
 
+	/**
+	 * Make room for at least num more elements.
+	 * Reallocate if needed, keeping the elements currently in the array.
+	 *
+	 * @param num number of elements to be added
+	 */
+	void grow(size_t num);
+
 	/**
 	 * Reserve space for specified number of elements.
 	 * No reallocation is done, array is replaced.
@@ -207,6 +215,20 @@ inline void v_array<T>::reserve(size_t length)
 	end_array = begin + length;
 }
 
+template<class T>
+inline void v_array<T>::grow(size_t num)
+{
+	if ((size_t)(end_array - end) < num)
+	{
+		size_t length = end - begin;
+		size_t new_length = CMath::max(2 * (size_t)(end_array - begin) + 3,
+					       length + num);
+		begin = SG_REALLOC(T, begin, end_array - begin, new_length);
+		end = begin + length;
+		end_array = begin + new_length;
+	}
+}
+
 template<class T>
 inline void v_array<T>::calloc_reserve(size_t length)
 {
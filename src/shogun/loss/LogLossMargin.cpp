@@ -35,7 +35,7 @@ float64_t CLogLossMargin::second_derivative(float64_t z)
 {
 	float64_t ez = exp(z-1);
 
-	return ez / (ez + 1)*(ez + 1);
+	return ez / ((ez + 1)*(ez + 1));
 }
 
 float64_t CLogLossMargin::get_update(float64_t prediction, float64_t label, float64_t eta_t, float64_t norm)
@@ -100,7 +100,7 @@ public:
 	 */
 	virtual float64_t first_derivative(float64_t prediction, float64_t label)
 	{
-		return loss(prediction * label);
+		return first_derivative(prediction * label) * label;
 	}
 
 	/**
@@ -122,7 +122,7 @@ public:
 	 */
 	virtual float64_t second_derivative(float64_t prediction, float64_t label)
 	{
-		return loss(prediction * label);
+		return second_derivative(prediction * label) * label * label;
 	}
 
 	/**
@@ -76,31 +76,37 @@ SGVector<float64_t> CBaggingMachine::apply_get_outputs(CFeatures* data)
 	SGMatrix<float64_t> output(data->get_num_vectors(), m_num_bags);
 	output.zero();
 
-	/*
-	#pragma omp parallel for num_threads(parallel->get_num_threads())
-	*/
+	int32_t num_invalid = 0;
+	#pragma omp parallel for num_threads(parallel->get_num_threads()) \
+		if (is_apply_thread_safe()) reduction(+:num_invalid)
 	for (int32_t i = 0; i < m_num_bags; ++i)
 	{
 		CMachine* m = dynamic_cast<CMachine*>(m_bags->get_element(i));
 		CLabels* l = m->apply(data);
-		SGVector<float64_t> lv;
 		if (l!=NULL)
-			lv = dynamic_cast<CDenseLabels*>(l)->get_labels();
+		{
+			SGVector<float64_t> lv = dynamic_cast<CDenseLabels*>(l)->get_labels();
+			float64_t* bag_results = output.get_column_vector(i);
+			memcpy(bag_results, lv.vector, lv.vlen*sizeof(float64_t));
+		}
 		else
-			SG_ERROR("NULL returned by apply method\n");
-
-		float64_t* bag_results = output.get_column_vector(i);
-		memcpy(bag_results, lv.vector, lv.vlen*sizeof(float64_t));
+			num_invalid++;
 
 		SG_UNREF(l);
 		SG_UNREF(m);
 	}
+	REQUIRE(num_invalid == 0, "NULL returned by apply method\n");
 
 	SGVector<float64_t> combined = m_combination_rule->combine(output);
 
 	return combined;
 }
 
+bool CBaggingMachine::is_apply_thread_safe() const
+{
+	return false;
+}
+
 bool CBaggingMachine::train_machine(CFeatures* data)
 {
 	REQUIRE(m_machine != NULL, "Machine is not set!");
@@ -139,6 +139,15 @@ namespace shogun
 			 */
 			SGVector<float64_t> apply_get_outputs(CFeatures* data);
 
+			/** whether the machines of different bags may be applied
+			 * concurrently. Subclasses whose bag machines do not modify
+			 * themselves or the features in apply should re-implement
+			 * this to return true.
+			 *
+			 * @return false in this class
+			 */
+			virtual bool is_apply_thread_safe() const;
+
 			/** Register paramaters */
 			void register_parameters();
 
@@ -36,6 +36,7 @@ CLinearMachine::CLinearMachine(CLinearMachine* machine) : CMachine()
 	set_w(machine->get_w().clone());
 	set_bias(machine->get_bias());
 	set_compute_bias(machine->get_compute_bias());
+	set_float32_weights(machine->get_float32_weights());
 }
 
 void CLinearMachine::init()
@@ -43,11 +44,14 @@ void CLinearMachine::init()
 	bias = 0;
 	features = NULL;
 	m_compute_bias = true;
+	m_float32_weights = false;
 
 	SG_ADD(&w, "w", "Parameter vector w.", MS_NOT_AVAILABLE);
 	SG_ADD(&bias, "bias", "Bias b.", MS_NOT_AVAILABLE);
 	SG_ADD((CSGObject**) &features, "features", "Feature object.",
 	    MS_NOT_AVAILABLE);
+	SG_ADD(&m_float32_weights, "float32_weights",
+	    "Whether w is used in single precision.", MS_NOT_AVAILABLE);
 }
 
 
@@ -91,7 +95,17 @@ SGVector<float64_t> CLinearMachine::apply_get_outputs(CFeatures* data)
 	ASSERT(w.vlen==features->get_dim_feature_space())
 
 	float64_t* out=SG_MALLOC(float64_t, num);
-	features->dense_dot_range(out, 0, num, NULL, w.vector, w.vlen, bias);
+	if (m_float32_weights)
+	{
+		SGVector<float32_t> w32(w.vlen);
+		for (int32_t i=0; i<w.vlen; i++)
+			w32[i]=w[i];
+
+		features->dense_dot_range(out, 0, num, NULL, w32.vector, w32.vlen, bias);
+	}
+	else
+		features->dense_dot_range(out, 0, num, NULL, w.vector, w.vlen, bias);
+
 	return SGVector<float64_t>(out,num);
 }
 
@@ -125,6 +139,16 @@ bool CLinearMachine::get_compute_bias()
 	return m_compute_bias;
 }
 
+void CLinearMachine::set_float32_weights(bool float32_weights)
+{
+	m_float32_weights = float32_weights;
+}
+
+bool CLinearMachine::get_float32_weights()
+{
+	return m_float32_weights;
+}
+
 void CLinearMachine::set_features(CDotFeatures* feat)
 {
 	SG_REF(feat);
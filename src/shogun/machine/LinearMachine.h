@@ -122,6 +122,23 @@ class CLinearMachine : public CMachine
 		 */
 		virtual bool get_compute_bias();		
 
+		/** Set whether to compute with single precision weights
+		 *
+		 * Outputs are then computed with a float32_t copy of w, and solvers
+		 * that support it (currently CSGDQN) train in single precision,
+		 * which halves the memory traffic on CDenseFeatures<float32_t>. w
+		 * itself is still exposed as float64_t.
+		 *
+		 * @param float32_weights whether to use single precision weights
+		 */
+		virtual void set_float32_weights(bool float32_weights);
+
+		/** Get whether single precision weights are used
+		 *
+		 * @return float32_weights
+		 */
+		virtual bool get_float32_weights();
+
 		/** set features
 		 *
 		 * @param feat features to set
@@ -194,6 +211,8 @@ class CLinearMachine : public CMachine
 		CDotFeatures* features;
 		/** If true, bias is computed in train method */
 		bool m_compute_bias;
+		/** If true, w is used in single precision */
+		bool m_float32_weights;
 };
 }
 #endif
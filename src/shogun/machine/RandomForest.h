@@ -146,6 +146,12 @@ protected:
 	 */
 	virtual void set_machine_parameters(CMachine* m, SGVector<index_t> idx);
 
+	/** trees of the forest can be applied concurrently
+	 *
+	 * @return true
+	 */
+	virtual bool is_apply_thread_safe() const { return true; }
+
 private:
 	/** initialize parameters */
 	void init();
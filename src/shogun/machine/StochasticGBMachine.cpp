@@ -187,8 +187,9 @@ bool CStochasticGBMachine::train_machine(CFeatures* data)
 	for (int32_t i=0;i<m_num_iter;i++)
 	{
 		// apply subset
+		SGVector<index_t> subset;
 		if (m_subset_frac!=1.0)
-			apply_subset(feats,interf);
+			subset=apply_subset(feats,interf);
 
 		// compute pseudo-residuals
 		CRegressionLabels* pres=compute_pseudo_residuals(interf);
@@ -197,27 +198,36 @@ bool CStochasticGBMachine::train_machine(CFeatures* data)
 		CMachine* wlearner=fit_model(feats,pres);
 		m_weak_learners->push_back(wlearner);
 
-		// compute multiplier
+		// the new learner is applied once on all training vectors, its
+		// outputs on the subset are used for the multiplier
+		if (m_subset_frac!=1.0)
+			feats->remove_subset();
+
 		CRegressionLabels* hm=wlearner->apply_regression(feats);
 		SG_REF(hm);
+		SGVector<float64_t> delta=hm->get_labels();
+
+		// compute multiplier
+		if (m_subset_frac!=1.0)
+			hm->add_subset(subset);
+
 		float64_t gamma=compute_multiplier(interf,hm);
 		m_gamma->push_back(gamma);
 
 		// remove subset
 		if (m_subset_frac!=1.0)
 		{
-			feats->remove_subset();
 			m_labels->remove_subset();
 			interf->remove_subset();
+			hm->remove_subset();
 		}
 
-		// update intermediate function value
-		CRegressionLabels* dlabels=wlearner->apply_regression(feats);
-		SGVector<float64_t> delta=dlabels->get_labels();
-		for (int32_t j=0;j<interf->get_num_labels();j++)
-			interf->set_label(j,interf->get_label(j)+delta[j]*gamma*m_learning_rate);
+		// update intermediate function value with the new learner only
+		SGVector<float64_t> f=interf->get_labels();
+		#pragma omp parallel for num_threads(parallel->get_num_threads())
+		for (int32_t j=0;j<f.vlen;j++)
+			f[j]+=delta[j]*gamma*m_learning_rate;
 
-		SG_UNREF(dlabels);
 		SG_UNREF(hm);
 		SG_UNREF(wlearner);
 	}
@@ -230,6 +240,11 @@ float64_t CStochasticGBMachine::compute_multiplier(CRegressionLabels* f, CRegres
 {
 	REQUIRE(f->get_num_labels()==hm->get_num_labels(),"The number of labels in both input parameters should be equal\n")
 
+	// the loss along hm is smooth and convex for these, newton steps find gamma
+	ELossType loss_type=m_loss->get_loss_type();
+	if (loss_type==L_SQUAREDLOSS || loss_type==L_LOGLOSS)
+		return newton_multiplier(f->get_labels(),hm->get_labels());
+
 	CDynamicObjectArray* instance=new CDynamicObjectArray();
 	instance->push_back(m_labels);
 	instance->push_back(f);
@@ -242,6 +257,43 @@ float64_t CStochasticGBMachine::compute_multiplier(CRegressionLabels* f, CRegres
 	return ret;
 }
 
+float64_t CStochasticGBMachine::newton_multiplier(SGVector<float64_t> f, SGVector<float64_t> hm)
+{
+	SGVector<float64_t> labels=(dynamic_cast<CDenseLabels*>(m_labels))->get_labels();
+	REQUIRE(labels.vlen==f.vlen,"The number of training labels (%d) and intermediate labels (%d) should be equal\n",
+		labels.vlen,f.vlen)
+
+	const int32_t max_iter=20;
+	const float64_t tolerance=1e-10;
+	int32_t num_threads=parallel->get_num_threads();
+
+	float64_t gamma=0;
+	for (int32_t iter=0;iter<max_iter;iter++)
+	{
+		float64_t grad=0;
+		float64_t hess=0;
+		#pragma omp parallel for num_threads(num_threads) reduction(+:grad,hess)
+		for (int32_t i=0;i<f.vlen;i++)
+		{
+			float64_t prediction=f[i]+gamma*hm[i];
+			grad+=m_loss->first_derivative(prediction,labels[i])*hm[i];
+			hess+=m_loss->second_derivative(prediction,labels[i])*hm[i]*hm[i];
+		}
+
+		if (hess<=0)
+			break;
+
+		float64_t step=grad/hess;
+		gamma-=step;
+
+		// squared loss is quadratic in gamma, one step is exact
+		if (m_loss->get_loss_type()==L_SQUAREDLOSS || CMath::abs(step)<=tolerance*(1+CMath::abs(gamma)))
+			break;
+	}
+
+	return gamma;
+}
+
 CMachine* CStochasticGBMachine::fit_model(CDenseFeatures<float64_t>* feats, CRegressionLabels* labels)
 {
 	// clone base machine
@@ -266,13 +318,14 @@ CRegressionLabels* CStochasticGBMachine::compute_pseudo_residuals(CRegressionLab
 	SGVector<float64_t> f=inter_f->get_labels();
 
 	SGVector<float64_t> residuals(f.vlen);
+	#pragma omp parallel for num_threads(parallel->get_num_threads())
 	for (int32_t i=0;i<residuals.vlen;i++)
 		residuals[i]=-m_loss->first_derivative(f[i],labels[i]);
 
 	return new CRegressionLabels(residuals);
 }
 
-void CStochasticGBMachine::apply_subset(CDenseFeatures<float64_t>* f, CLabels* interf)
+SGVector<index_t> CStochasticGBMachine::apply_subset(CDenseFeatures<float64_t>* f, CLabels* interf)
 {
 	int32_t subset_size=m_subset_frac*(f->get_num_vectors());
 	SGVector<index_t> idx(f->get_num_vectors());
@@ -285,6 +338,8 @@ void CStochasticGBMachine::apply_subset(CDenseFeatures<float64_t>* f, CLabels* i
 	f->add_subset(subset);
 	interf->add_subset(subset);
 	m_labels->add_subset(subset);
+
+	return subset;
 }
 
 void CStochasticGBMachine::initialize_learners()
@@ -155,6 +155,15 @@ protected:
 	 */
 	float64_t compute_multiplier(CRegressionLabels* f, CRegressionLabels* hm);
 
+	/** compute gamma by newton steps on the loss along hm, used for losses
+	 * with a well defined second derivative
+	 *
+	 * @param f labels from the intermediate model
+	 * @param hm labels from the newly trained base model
+	 * @return gamma
+	 */
+	float64_t newton_multiplier(SGVector<float64_t> f, SGVector<float64_t> hm);
+
 	/** train base model
 	 *
 	 * @param feats training data
@@ -174,8 +183,9 @@ protected:
 	 *
 	 * @param f training data
 	 * @param interf intermediate boosted model labels for training data
+	 * @return indices of the chosen subset
 	 */
-	void apply_subset(CDenseFeatures<float64_t>* f, CLabels* interf);
+	SGVector<index_t> apply_subset(CDenseFeatures<float64_t>* f, CLabels* interf);
 
 	/** reset arrays of weak learners and gamma values */
 	void initialize_learners();
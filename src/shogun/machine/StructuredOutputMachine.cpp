@@ -14,6 +14,8 @@
 #include <shogun/labels/StructuredLabels.h>
 #include <shogun/loss/LossFunction.h>
 #include <shogun/structure/StructuredModel.h>
+#include <shogun/mathematics/Math.h>
+#include <shogun/base/Parallel.h>
 
 using namespace shogun;
 
@@ -113,21 +115,81 @@ float64_t CStructuredOutputMachine::risk_nslack_margin_rescale(float64_t* subgra
 	SG_UNREF(features);
 
 	float64_t R = 0.0;
+	float64_t delta = 0.0;
 	for (int32_t i=0; i<dim; i++)
 		subgrad[i] = 0;
 
-	for (int32_t i=from; i<to; i++)
+	SGVector<int32_t> examples(CMath::max(to-from, 0));
+	examples.range_fill(from);
+	solve_oracles(SGVector<float64_t>(W,dim,false), examples, subgrad, R, delta);
+
+	// the subgradient is sum_i psi_pred - psi_truth
+	for (int32_t i=0; i<dim; i++)
+		subgrad[i] = -subgrad[i];
+
+	return R;
+}
+
+void CStructuredOutputMachine::solve_oracles(SGVector<float64_t> W,
+		SGVector<int32_t> examples, float64_t* psi_sum, float64_t& score_sum,
+		float64_t& delta_sum)
+{
+	int32_t dim = m_model->get_dim();
+	int32_t num_threads = 1;
+	if (m_model->is_argmax_thread_safe())
+		num_threads = CMath::max(CMath::min(parallel->get_num_threads(), examples.vlen), 1);
+
+	m_model->init_argmax(W);
+
+	// thread t handles examples t, t+num_threads, ... into its own buffers
+	SGMatrix<float64_t> local_psi(dim, num_threads);
+	local_psi.zero();
+	SGVector<float64_t> local_score(num_threads);
+	local_score.zero();
+	SGVector<float64_t> local_delta(num_threads);
+	local_delta.zero();
+	// number of results without psi, reported after the parallel loop
+	int32_t num_missing_psi = 0;
+
+	#pragma omp parallel for num_threads(num_threads)
+	for (int32_t t=0; t<num_threads; t++)
 	{
-		CResultSet* result = m_model->argmax(SGVector<float64_t>(W,dim,false), i, true);
-		SGVector<float64_t> psi_pred = result->psi_pred;
-		SGVector<float64_t> psi_truth = result->psi_truth;
-		SGVector<float64_t>::vec1_plus_scalar_times_vec2(subgrad, 1.0, psi_pred.vector, dim);
-		SGVector<float64_t>::vec1_plus_scalar_times_vec2(subgrad, -1.0, psi_truth.vector, dim);
-		R += result->score;
-		SG_UNREF(result);
+		float64_t* psi = local_psi.get_column_vector(t);
+		for (index_t i=t; i<examples.vlen; i+=num_threads)
+		{
+			CResultSet* result = m_model->argmax(W, examples[i], true);
+			if (result->psi_computed)
+			{
+				SGVector<float64_t>::vec1_plus_scalar_times_vec2(psi, 1.0, result->psi_truth.vector, dim);
+				SGVector<float64_t>::vec1_plus_scalar_times_vec2(psi, -1.0, result->psi_pred.vector, dim);
+			}
+			else if (result->psi_computed_sparse)
+			{
+				result->psi_truth_sparse.add_to_dense(1.0, psi, dim);
+				result->psi_pred_sparse.add_to_dense(-1.0, psi, dim);
+			}
+			else
+			{
+				#pragma omp atomic
+				num_missing_psi++;
+			}
+
+			local_score[t] += result->score;
+			local_delta[t] += result->delta;
+			SG_UNREF(result);
+		}
 	}
 
-	return R;
+	REQUIRE(num_missing_psi == 0, "model(%s) should have either of psi_computed "
+			"or psi_computed_sparse to be set true\n", m_model->get_name())
+
+	for (int32_t t=0; t<num_threads; t++)
+	{
+		SGVector<float64_t>::vec1_plus_scalar_times_vec2(psi_sum, 1.0,
+				local_psi.get_column_vector(t), dim);
+		score_sum += local_score[t];
+		delta_sum += local_delta[t];
+	}
 }
 
 float64_t CStructuredOutputMachine::risk_nslack_slack_rescale(float64_t* subgrad, float64_t* W, TMultipleCPinfo* info)
@@ -205,6 +205,27 @@ class CStructuredOutputMachine : public CMachine
 		 */
 		virtual float64_t risk_customized_formulation(float64_t* subgrad, float64_t* W, TMultipleCPinfo* info=0);
 
+		/** solves the loss-augmented inference problem for a set of training
+		 * examples at a fixed W and accumulates
+		 *
+		 * \f[
+		 * \sum_{i} \Psi(x_i, y_i) - \Psi(x_i, \hat{y}_i)
+		 * \f]
+		 *
+		 * together with the sums of the argmax scores and losses. If the
+		 * model's argmax is thread safe, the examples are distributed over
+		 * the threads of #parallel, each accumulating into its own buffer;
+		 * the buffers are reduced in a fixed order.
+		 *
+		 * @param W Given weight vector
+		 * @param examples Indices of the training examples, each at most once
+		 * @param psi_sum Sum of the joint feature differences (added to)
+		 * @param score_sum Sum of the argmax scores (added to)
+		 * @param delta_sum Sum of the losses \f$ \Delta(y_i, \hat{y}_i) \f$ (added to)
+		 */
+		void solve_oracles(SGVector<float64_t> W, SGVector<int32_t> examples,
+				float64_t* psi_sum, float64_t& score_sum, float64_t& delta_sum);
+
 	private:
 		/** register class members */
 		void register_parameters();
@@ -20,6 +20,7 @@
 #include <shogun/machine/gp/StudentsTLikelihood.h>
 #include <shogun/mathematics/Math.h>
 #include <shogun/lib/external/brent.h>
+#include <shogun/lib/SGArena.h>
 #include <shogun/mathematics/eigen3.h>
 #include <shogun/optimization/FirstOrderMinimizer.h>
 
@@ -142,6 +143,10 @@ float64_t SingleLaplaceNewtonOptimizer::minimize()
 
 	index_t iter=0;
 
+	// W, dlp and the log probabilities recomputed by every step of the line
+	// search reuse the memory released by the previous step
+	SGArenaScope arena;
+
 	while (Psi_Old-Psi_New>m_tolerance && iter<m_iter)
 	{
 		Map<VectorXd> eigen_W( (m_obj->m_W).vector, (m_obj->m_W).vlen);
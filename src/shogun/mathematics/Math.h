@@ -29,6 +29,7 @@
 #include <shogun/mathematics/Random.h>
 #include <shogun/lib/SGVector.h>
 #include <algorithm>
+#include <vector>
 
 #ifndef _USE_MATH_DEFINES
 #define _USE_MATH_DEFINES
@@ -1733,6 +1734,168 @@ class CMath : public CSGObject
 		template <class T1,class T2>
 			static void* parallel_qsort_index(void* p);
 
+		/** Helper functor for parallel sorting of key-value pairs in
+		 * ascending order of keys, ties are ordered by value
+		 */
+		template <class T1,class T2>
+			struct AscendingPairComparator
+			{
+				/** comparison operator */
+				bool operator() (const std::pair<T1,T2>& a, const std::pair<T1,T2>& b) const
+				{
+					return a.first<b.first || (!(b.first<a.first) && a.second<b.second);
+				}
+			};
+
+		/** Helper functor for parallel sorting of key-value pairs in
+		 * descending order of keys, ties are ordered by value
+		 */
+		template <class T1,class T2>
+			struct DescendingPairComparator
+			{
+				/** comparison operator */
+				bool operator() (const std::pair<T1,T2>& a, const std::pair<T1,T2>& b) const
+				{
+					return b.first<a.first || (!(a.first<b.first) && a.second<b.second);
+				}
+			};
+
+		/** Sorts an array with multiple threads: the array is split into
+		 * blocks which are sorted concurrently with introsort (std::sort)
+		 * and then merged pairwise in parallel. Arrays too small to give
+		 * each thread at least limit elements are sorted sequentially.
+		 *
+		 * @param output array to be sorted
+		 * @param size size of array
+		 * @param cmp strict weak ordering
+		 * @param n_threads number of threads
+		 * @param limit minimal number of elements per thread
+		 */
+		template <class T,class Compare>
+			static void parallel_introsort(T* output, index_t size, Compare cmp,
+				int32_t n_threads, index_t limit=65536)
+			{
+				int32_t num_blocks=1;
+				while (2*num_blocks<=n_threads && size/(2*num_blocks)>=limit)
+					num_blocks*=2;
+
+				if (num_blocks==1)
+				{
+					std::sort(output, output+size, cmp);
+					return;
+				}
+
+				SGVector<index_t> bounds(num_blocks+1);
+				for (int32_t b=0; b<=num_blocks; b++)
+					bounds[b]=index_t(int64_t(size)*b/num_blocks);
+
+				#pragma omp parallel for num_threads(num_blocks)
+				for (int32_t b=0; b<num_blocks; b++)
+					std::sort(output+bounds[b], output+bounds[b+1], cmp);
+
+				for (int32_t width=1; width<num_blocks; width*=2)
+				{
+					#pragma omp parallel for num_threads(num_blocks/(2*width))
+					for (int32_t b=0; b<num_blocks; b+=2*width)
+					{
+						std::inplace_merge(output+bounds[b], output+bounds[b+width],
+							output+bounds[b+2*width], cmp);
+					}
+				}
+			}
+
+		/** Sorts an array in ascending order with multiple threads
+		 * (see parallel_introsort)
+		 *
+		 * @param output array to be sorted
+		 * @param size size of array
+		 * @param n_threads number of threads
+		 * @param limit minimal number of elements per thread
+		 */
+		template <class T>
+			static void parallel_sort(T* output, index_t size, int32_t n_threads,
+				index_t limit=65536)
+			{
+				parallel_introsort(output, size, std::less<T>(), n_threads, limit);
+			}
+
+		/** Sorts array output of length size in ascending order and
+		 * permutes index alike (matlab alike [sorted,index]=sort(output))
+		 * with multiple threads. Equal elements are ordered by their index,
+		 * so that the result does not depend on the number of threads.
+		 *
+		 * @param output array to be sorted
+		 * @param index index array
+		 * @param size size of arrays
+		 * @param n_threads number of threads
+		 * @param limit minimal number of elements per thread
+		 */
+		template <class T1,class T2>
+			static void parallel_sort_index(T1* output, T2* index, index_t size,
+				int32_t n_threads, index_t limit=65536)
+			{
+				parallel_sort_pairs(output, index, size,
+					AscendingPairComparator<T1,T2>(), n_threads, limit);
+			}
+
+		/** Sorts array output of length size in descending order and
+		 * permutes index alike with multiple threads. Equal elements are
+		 * ordered by their index, so that the result does not depend on
+		 * the number of threads.
+		 *
+		 * @param output array to be sorted
+		 * @param index index array
+		 * @param size size of arrays
+		 * @param n_threads number of threads
+		 * @param limit minimal number of elements per thread
+		 */
+		template <class T1,class T2>
+			static void parallel_sort_backward_index(T1* output, T2* index,
+				index_t size, int32_t n_threads, index_t limit=65536)
+			{
+				parallel_sort_pairs(output, index, size,
+					DescendingPairComparator<T1,T2>(), n_threads, limit);
+			}
+
+		/** Get sorted index computed with multiple threads, equal
+		 * elements are ordered by their position (stable argsort)
+		 *
+		 * @param vector vector to be sorted
+		 * @param n_threads number of threads
+		 * @param limit minimal number of elements per thread
+		 * @return sorted index for this vector
+		 */
+		template <class T>
+			static SGVector<index_t> parallel_argsort(SGVector<T> vector,
+				int32_t n_threads, index_t limit=65536)
+			{
+				SGVector<T> sorted=vector.clone();
+				SGVector<index_t> idx(vector.vlen);
+				idx.range_fill();
+				parallel_sort_index(sorted.vector, idx.vector, vector.vlen,
+					n_threads, limit);
+
+				return idx;
+			}
+
+		/// helper function for parallel_sort_index and parallel_sort_backward_index
+		template <class T1,class T2,class Compare>
+			static void parallel_sort_pairs(T1* output, T2* index, index_t size,
+				Compare cmp, int32_t n_threads, index_t limit)
+			{
+				std::vector<std::pair<T1,T2> > pairs(size);
+				for (index_t i=0; i<size; i++)
+					pairs[i]=std::make_pair(output[i], index[i]);
+
+				parallel_introsort(pairs.data(), size, cmp, n_threads, limit);
+
+				for (index_t i=0; i<size; i++)
+				{
+					output[i]=pairs[i].first;
+					index[i]=pairs[i].second;
+				}
+			}
+
 
 		/** Finds the smallest element in output and puts that element as the
 		 * first element
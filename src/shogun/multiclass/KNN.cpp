@@ -16,6 +16,7 @@
 #include <shogun/labels/MulticlassLabels.h>
 #include <shogun/mathematics/Math.h>
 #include <shogun/lib/Signal.h>
+#include <shogun/lib/SGArena.h>
 #include <shogun/lib/JLCoverTree.h>
 #include <shogun/lib/Time.h>
 #include <shogun/base/Parameter.h>
@@ -155,6 +156,10 @@ CMulticlassLabels* CKNN::apply_multiclass(CFeatures* data)
 	if (data)
 		init_distance(data);
 
+	// feature vectors computed on the fly for every distance evaluation
+	// reuse the memory of the previous evaluation
+	SGArenaScope arena;
+
 	//redirecting to fast (without sorting) classify if k==1
 	if (m_k == 1)
 		return classify_NN();
@@ -686,107 +686,61 @@ CMulticlassLabels* CC45ClassifierTree::apply_multiclass_from_current_node(CDense
 	REQUIRE(current, "Current node should not be NULL")
 
 	int32_t num_vecs=feats->get_num_vectors();
-	SGVector<float64_t> labels(num_vecs);
 	if (set_certainty)
 		m_certainty=SGVector<float64_t>(num_vecs);
 
-	// classify vectors in feature matrix taking one at a time
-	for (int32_t i=0; i<num_vecs; i++)
-	{
-		// choose the current subtree as the entry point
-		SGVector<float64_t> sample=feats->get_feature_vector(i);
-		node_t* node=current;
-		SG_REF(node);
-		CDynamicObjectArray* children=node->get_children();
-
-		// traverse the subtree until leaf node is reached
-		while (children->get_num_elements())
-		{
-			bool flag=false;
-			// if nominal attribute check for equality
-			if (m_nominal[node->data.attribute_id])
-			{
-				for (int32_t j=0; j<children->get_num_elements(); j++)
-				{
-					CSGObject* el=children->get_element(j);
-					node_t* child=NULL;
-					if (el!=NULL)
-						child=dynamic_cast<node_t*>(el);
-					else
-						SG_ERROR("%d element of children is NULL\n",j);
-
-					if (child->data.transit_if_feature_value==sample[node->data.attribute_id])
-					{
-						flag=true;
+	FlatTree flat_tree;
+	flatten_tree(current, flat_tree.add_nodes(1), flat_tree);
 
-						SG_UNREF(node);
-						node=child;
-
-						SG_UNREF(children);
-						children=node->get_children();
-
-						break;
-					}
-
-					SG_UNREF(child);
-				}
+	// class_label of the node reached is the class to which chosen vector belongs
+	SGVector<float64_t> labels=flat_tree.apply(feats->get_feature_matrix(),
+			parallel->get_num_threads(), set_certainty ? m_certainty : SGVector<float64_t>());
 
-				if (!flag)
-					break;
-			}
-			// if not nominal attribute check if greater or less than threshold
-			else
-			{
-				CSGObject* el=children->get_element(0);
-				node_t* left_child=NULL;
-				if (el!=NULL)
-					left_child=dynamic_cast<node_t*>(el);
-				else
-					SG_ERROR("left child is NULL\n")
-
-				el=children->get_element(1);
-				node_t* right_child=NULL;
-				if (el!=NULL)
-					right_child=dynamic_cast<node_t*>(el);
-				else
-					SG_ERROR("left child is NULL\n")
-
-				if (left_child->data.transit_if_feature_value>=sample[node->data.attribute_id])
-				{
-					SG_UNREF(node);
-					node=left_child;
-					SG_REF(left_child)
+	CMulticlassLabels* ret=new CMulticlassLabels(labels);
+	return ret;
+}
 
-					SG_UNREF(children);
-					children=node->get_children();
-				}
-				else
-				{
-					SG_UNREF(node);
-					node=right_child;
-					SG_REF(right_child)
+void CC45ClassifierTree::flatten_tree(node_t* node, int32_t index, FlatTree& flat_tree)
+{
+	flat_tree.set_output(index, node->data.class_label,
+			(node->data.total_weight-node->data.weight_minus)/node->data.total_weight);
 
-					SG_UNREF(children);
-					children=node->get_children();
-				}
+	CDynamicObjectArray* children=node->get_children();
+	int32_t num_children=children->get_num_elements();
+	if (num_children==0)
+	{
+		SG_UNREF(children);
+		return;
+	}
 
-				SG_UNREF(left_child);
-				SG_UNREF(right_child);
-			}
-		}
+	int32_t first_child=flat_tree.add_nodes(num_children);
+	int32_t attribute=node->data.attribute_id;
+	SGVector<float64_t> values(num_children);
+	SGVector<int32_t> flat_children(num_children);
 
-		// class_label of leaf node is the class to which chosen vector belongs
-		labels[i]=node->data.class_label;
+	for (int32_t j=0; j<num_children; j++)
+	{
+		CSGObject* el=children->get_element(j);
+		node_t* child=NULL;
+		if (el!=NULL)
+			child=dynamic_cast<node_t*>(el);
+		else
+			SG_ERROR("%d element of children is NULL\n",j);
 
-		if (set_certainty)
-			m_certainty[i]=(node->data.total_weight-node->data.weight_minus)/node->data.total_weight;
+		values[j]=child->data.transit_if_feature_value;
+		flat_children[j]=first_child+j;
+		flatten_tree(child, first_child+j, flat_tree);
 
-		SG_UNREF(node);
-		SG_UNREF(children);
+		SG_UNREF(child);
 	}
 
-	CMulticlassLabels* ret=new CMulticlassLabels(labels);
-	return ret;
+	// nominal attributes need equality, others go left if not greater than threshold
+	if (m_nominal[attribute])
+		flat_tree.set_nominal_split(index, attribute, values, flat_children);
+	else
+		flat_tree.set_threshold_split(index, attribute, values[0], first_child);
+
+	SG_UNREF(children);
 }
 
 void CC45ClassifierTree::init()
@@ -36,6 +36,7 @@
 
 #include <shogun/multiclass/tree/TreeMachine.h>
 #include <shogun/multiclass/tree/C45TreeNodeData.h>
+#include <shogun/multiclass/tree/FlatTree.h>
 #include <shogun/features/DenseFeatures.h>
 
 namespace shogun
@@ -205,6 +206,14 @@ private:
 	 */
 	CMulticlassLabels* apply_multiclass_from_current_node(CDenseFeatures<float64_t>* feats, node_t* current, bool set_certainty=false);
 
+	/** copy a subtree into a flat tree
+	 *
+	 * @param node root of the subtree
+	 * @param index index of the flat node corresponding to node
+	 * @param flat_tree flat tree to fill
+	 */
+	void flatten_tree(node_t* node, int32_t index, FlatTree& flat_tree);
+
 	/** initializes members of class */
 	void init();
 
@@ -30,6 +30,10 @@
 
 #include <shogun/mathematics/Math.h>
 #include <shogun/multiclass/tree/CARTree.h>
+#include <shogun/lib/SGArena.h>
+
+#include <algorithm>
+#include <vector>
 
 using namespace shogun;
 
@@ -372,10 +376,11 @@ CBinaryTreeMachineNode<CARTreeNodeData>* CCARTree::CARTtrain(CFeatures* data, SG
 	}
 
 	// choose best attribute
-	// transit_into_values for left child
-	SGVector<float64_t> left(num_feats);
+	// transit_into_values for left child, a nominal attribute has at most
+	// num_vecs distinct values
+	SGVector<float64_t> left(num_vecs);
 	// transit_into_values for right child
-	SGVector<float64_t> right(num_feats);
+	SGVector<float64_t> right(num_vecs);
 	// final data distribution among children
 	SGVector<bool> left_final(num_vecs);
 	int32_t num_missing_final=0;
@@ -504,194 +509,238 @@ int32_t CCARTree::compute_best_attribute(SGMatrix<float64_t> mat, SGVector<float
 	SGVector<float64_t> total_wclasses(n_ulabels);
 	total_wclasses.zero();
 
+	// unique labels are sorted, the first one within delta is the class of a label
 	SGVector<int32_t> simple_labels(num_vecs);
 	for (int32_t i=0;i<num_vecs;i++)
 	{
-		for (int32_t j=0;j<n_ulabels;j++)
-		{
-			if (CMath::abs(labels_vec[i]-ulabels[j])<=delta)
-			{
-				simple_labels[i]=j;
-				total_wclasses[j]+=weights[i];
-				break;
-			}
-		}
+		int32_t j=std::lower_bound(ulabels.vector, ulabels.vector+n_ulabels, labels_vec[i]-delta)-ulabels.vector;
+		simple_labels[i]=j;
+		total_wclasses[j]+=weights[i];
 	}
 
-	float64_t max_gain=MIN_SPLIT_GAIN;
-	int32_t best_attribute=-1;
-	float64_t best_threshold=0;
-	for (int32_t i=0;i<num_feats;i++)
+	REQUIRE(m_mode==PT_MULTICLASS || m_mode==PT_REGRESSION,"Undefined problem statement\n")
+
+	SGVector<index_t> candidates=get_candidate_attributes(num_feats);
+	int32_t num_candidates=candidates.vlen;
+
+	// best split of every candidate attribute, attributes are searched in parallel
+	SGVector<float64_t> attr_gain(num_candidates);
+	SGVector<float64_t> attr_threshold(num_candidates);
+	SGVector<int32_t> attr_case(num_candidates);
+	attr_gain.set_const(MIN_SPLIT_GAIN);
+
+	int32_t num_threads=parallel->get_num_threads();
+	int32_t sort_threads=(num_candidates>1) ? 1 : num_threads;
+
+	// attributes with missing values are sorted upfront, they change the class
+	// weights seen by the attributes searched after them
+	std::vector<SGVector<index_t> > missing_sorted_args(num_candidates);
+	#pragma omp parallel for schedule(dynamic) num_threads(num_threads)
+	for (int32_t i=0;i<num_candidates;i++)
 	{
 		SGVector<float64_t> feats(num_vecs);
+		bool has_missing=false;
 		for (int32_t j=0;j<num_vecs;j++)
-			feats[j]=mat(i,j);
+		{
+			feats[j]=mat(candidates[i],j);
+			has_missing|=(feats[j]==MISSING);
+		}
 
-		// O(N*logN)
-		SGVector<index_t> sorted_args=CMath::argsort(feats);
+		if (has_missing)
+			missing_sorted_args[i]=CMath::parallel_argsort(feats,sort_threads);
+	}
 
-		// number of non-missing vecs
-		int32_t n_nm_vecs=feats.vlen;
-		while (feats[sorted_args[n_nm_vecs-1]]==MISSING)
+	// class weights seen by every attribute, following the bookkeeping of
+	// a sequential search over the attributes
+	SGMatrix<float64_t> attr_wclasses(n_ulabels,num_candidates);
+	for (int32_t i=0;i<num_candidates;i++)
+	{
+		SGVector<index_t> sorted_args=missing_sorted_args[i];
+		int32_t n_nm_vecs=sorted_args.vlen;
+		while (n_nm_vecs && mat(candidates[i],sorted_args[n_nm_vecs-1])==MISSING)
 		{
 			total_wclasses[simple_labels[sorted_args[n_nm_vecs-1]]]-=weights[sorted_args[n_nm_vecs-1]];
 			n_nm_vecs--;
 		}
 
-		// if only one unique value - it cannot be used to split
-		if (feats[sorted_args[n_nm_vecs-1]]<=feats[sorted_args[0]]+EQ_DELTA)
+		memcpy(attr_wclasses.get_column_vector(i),total_wclasses.vector,n_ulabels*sizeof(float64_t));
+
+		// attributes with a single value are skipped before restoring total_wclasses
+		if (!sorted_args.vlen ||
+			mat(candidates[i],sorted_args[n_nm_vecs-1])<=mat(candidates[i],sorted_args[0])+EQ_DELTA)
 			continue;
 
-		if (m_nominal[i])
+		// restore total_wclasses
+		while (n_nm_vecs<sorted_args.vlen)
 		{
-			SGVector<int32_t> simple_feats(num_vecs);
-			simple_feats.fill_vector(simple_feats.vector,simple_feats.vlen,-1);
-
-			// convert to simple values
-			simple_feats[sorted_args[0]]=0;
-			int32_t c=0;
-			for (int32_t j=1;j<n_nm_vecs;j++)
-			{
-				if (feats[sorted_args[j]]==feats[sorted_args[j-1]])
-					simple_feats[sorted_args[j]]=c;
-				else
-					simple_feats[sorted_args[j]]=(++c);
-			}
+			total_wclasses[simple_labels[sorted_args[n_nm_vecs-1]]]+=weights[sorted_args[n_nm_vecs-1]];
+			n_nm_vecs++;
+		}
+	}
 
-			SGVector<float64_t> ufeats(c+1);
-			ufeats[0]=feats[sorted_args[0]];
-			int32_t u=0;
-			for (int32_t j=1;j<n_nm_vecs;j++)
-			{
-				if (feats[sorted_args[j]]==feats[sorted_args[j-1]])
-					continue;
-				else
-					ufeats[++u]=feats[sorted_args[j]];
-			}
+	#pragma omp parallel num_threads(num_threads)
+	{
+		// per-candidate temporaries are recycled within each thread
+		SGArenaScope arena;
 
-			// test all 2^(I-1)-1 possible division between two nodes
-			int32_t num_cases=CMath::pow(2,c);
-			for (int32_t k=1;k<num_cases;k++)
-			{
-				SGVector<float64_t> wleft(n_ulabels);
-				SGVector<float64_t> wright(n_ulabels);
-				wleft.zero();
-				wright.zero();
+		#pragma omp for schedule(dynamic)
+		for (int32_t i=0;i<num_candidates;i++)
+		{
+			int32_t attr=candidates[i];
+			SGVector<float64_t> feats(num_vecs);
+			for (int32_t j=0;j<num_vecs;j++)
+				feats[j]=mat(attr,j);
 
-				// stores which vectors are assigned to left child
-				SGVector<bool> is_left(num_vecs);
-				is_left.fill_vector(is_left.vector,is_left.vlen,false);
+			// O(N*logN)
+			SGVector<index_t> sorted_args=missing_sorted_args[i];
+			if (!sorted_args.vlen)
+				sorted_args=CMath::parallel_argsort(feats,sort_threads);
 
-				// stores which among the categorical values of chosen attribute are assigned left child
-				SGVector<bool> feats_left(c+1);
+			SGVector<float64_t> wclasses(attr_wclasses.get_column_vector(i),n_ulabels,false);
 
-				// fill feats_left in a unique way corresponding to the case
-				for (int32_t p=0;p<c+1;p++)
-					feats_left[p]=((k/CMath::pow(2,p))%(CMath::pow(2,p+1))==1);
+			// number of non-missing vecs
+			int32_t n_nm_vecs=feats.vlen;
+			while (feats[sorted_args[n_nm_vecs-1]]==MISSING)
+				n_nm_vecs--;
 
-				// form is_left
-				for (int32_t j=0;j<n_nm_vecs;j++)
-				{
-					is_left[sorted_args[j]]=feats_left[simple_feats[sorted_args[j]]];
-					if (is_left[sorted_args[j]])
-						wleft[simple_labels[sorted_args[j]]]+=weights[sorted_args[j]];
-					else
-						wright[simple_labels[sorted_args[j]]]+=weights[sorted_args[j]];
-				}
+			// if only one unique value - it cannot be used to split
+			if (feats[sorted_args[n_nm_vecs-1]]<=feats[sorted_args[0]]+EQ_DELTA)
+				continue;
 
-				float64_t g=0;
-				if (m_mode==PT_MULTICLASS)
-					g=gain(wleft,wright,total_wclasses);
-				else if (m_mode==PT_REGRESSION)
-					g=gain(wleft,wright,total_wclasses,ulabels);
-				else
-					SG_ERROR("Undefined problem statement\n");
+			if (m_nominal[attr])
+			{
+				SGVector<int32_t> simple_feats(num_vecs);
+				int32_t c=nominal_feature_classes(feats,sorted_args,n_nm_vecs,simple_feats,NULL);
 
-				if (g>max_gain)
+				// test all 2^(I-1)-1 possible division between two nodes
+				int32_t num_cases=CMath::pow(2,c);
+				SGVector<float64_t> wleft(n_ulabels);
+				SGVector<float64_t> wright(n_ulabels);
+				SGVector<bool> feats_left(c+1);
+				for (int32_t k=1;k<num_cases;k++)
 				{
-					best_attribute=i;
-					max_gain=g;
-					memcpy(is_left_final.vector,is_left.vector,is_left.vlen*sizeof(bool));
-					num_missing_final=num_vecs-n_nm_vecs;
-
-					count_left=0;
-					for (int32_t l=0;l<c+1;l++)
-						count_left=(feats_left[l])?count_left+1:count_left;
+					wleft.zero();
+					wright.zero();
 
-					count_right=c+1-count_left;
+					// fill feats_left in a unique way corresponding to the case
+					for (int32_t p=0;p<c+1;p++)
+						feats_left[p]=((k/CMath::pow(2,p))%(CMath::pow(2,p+1))==1);
 
-					int32_t l=0;
-					int32_t r=0;
-					for (int32_t w=0;w<c+1;w++)
+					for (int32_t j=0;j<n_nm_vecs;j++)
 					{
-						if (feats_left[w])
-							left[l++]=ufeats[w];
+						if (feats_left[simple_feats[sorted_args[j]]])
+							wleft[simple_labels[sorted_args[j]]]+=weights[sorted_args[j]];
 						else
-							right[r++]=ufeats[w];
+							wright[simple_labels[sorted_args[j]]]+=weights[sorted_args[j]];
+					}
+
+					float64_t g=0;
+					if (m_mode==PT_MULTICLASS)
+						g=gain(wleft,wright,wclasses);
+					else
+						g=gain(wleft,wright,wclasses,ulabels);
+
+					if (g>attr_gain[i])
+					{
+						attr_gain[i]=g;
+						attr_case[i]=k;
 					}
 				}
 			}
-		}
-		else
-		{
-			// O(N)
-			SGVector<float64_t> right_wclasses=total_wclasses.clone();
-			SGVector<float64_t> left_wclasses(n_ulabels);
-			left_wclasses.zero();
-
-			// O(N)
-			// find best split for non-nominal attribute - choose threshold (z)
-			float64_t z=feats[sorted_args[0]];
-			right_wclasses[simple_labels[sorted_args[0]]]-=weights[sorted_args[0]];
-			left_wclasses[simple_labels[sorted_args[0]]]+=weights[sorted_args[0]];
-			for (int32_t j=1;j<n_nm_vecs;j++)
+			else
 			{
-				if (feats[sorted_args[j]]<=z+EQ_DELTA)
+				// O(N)
+				SGVector<float64_t> right_wclasses=wclasses.clone();
+				SGVector<float64_t> left_wclasses(n_ulabels);
+				left_wclasses.zero();
+
+				// weighted sums of labels in both children for the regression gain
+				float64_t left_weight=0;
+				float64_t left_sum=0;
+				float64_t total_weight=0;
+				float64_t total_sum=0;
+				if (m_mode==PT_REGRESSION)
 				{
-					right_wclasses[simple_labels[sorted_args[j]]]-=weights[sorted_args[j]];
-					left_wclasses[simple_labels[sorted_args[j]]]+=weights[sorted_args[j]];
-					continue;
+					for (int32_t j=0;j<n_ulabels;j++)
+					{
+						total_weight+=wclasses[j];
+						total_sum+=wclasses[j]*ulabels[j];
+					}
 				}
 
-				// O(F)
-				float64_t g=0;
-				if (m_mode==PT_MULTICLASS)
-					g=gain(left_wclasses,right_wclasses,total_wclasses);
-				else if (m_mode==PT_REGRESSION)
-					g=gain(left_wclasses,right_wclasses,total_wclasses,ulabels);
-				else
-					SG_ERROR("Undefined problem statement\n");
-
-				if (g>max_gain)
+				// O(N)
+				// find best split for non-nominal attribute - choose threshold (z)
+				float64_t z=feats[sorted_args[0]];
+				int32_t first=sorted_args[0];
+				right_wclasses[simple_labels[first]]-=weights[first];
+				left_wclasses[simple_labels[first]]+=weights[first];
+				left_weight+=weights[first];
+				left_sum+=weights[first]*ulabels[simple_labels[first]];
+				for (int32_t j=1;j<n_nm_vecs;j++)
 				{
-					max_gain=g;
-					best_attribute=i;
-					best_threshold=z;
-					num_missing_final=num_vecs-n_nm_vecs;
-				}
+					int32_t idx=sorted_args[j];
+					if (feats[idx]<=z+EQ_DELTA)
+					{
+						right_wclasses[simple_labels[idx]]-=weights[idx];
+						left_wclasses[simple_labels[idx]]+=weights[idx];
+						left_weight+=weights[idx];
+						left_sum+=weights[idx]*ulabels[simple_labels[idx]];
+						continue;
+					}
 
-				z=feats[sorted_args[j]];
-				if (feats[sorted_args[n_nm_vecs-1]]<=z+EQ_DELTA)
-					break;
+					// O(F) for classification, O(1) for regression
+					float64_t g=0;
+					if (m_mode==PT_MULTICLASS)
+						g=gain(left_wclasses,right_wclasses,wclasses);
+					else
+						g=regression_gain(left_weight,left_sum,total_weight,total_sum);
+
+					if (g>attr_gain[i])
+					{
+						attr_gain[i]=g;
+						attr_threshold[i]=z;
+					}
+
+					z=feats[idx];
+					if (feats[sorted_args[n_nm_vecs-1]]<=z+EQ_DELTA)
+						break;
 
-				right_wclasses[simple_labels[sorted_args[j]]]-=weights[sorted_args[j]];
-				left_wclasses[simple_labels[sorted_args[j]]]+=weights[sorted_args[j]];
+					right_wclasses[simple_labels[idx]]-=weights[idx];
+					left_wclasses[simple_labels[idx]]+=weights[idx];
+					left_weight+=weights[idx];
+					left_sum+=weights[idx]*ulabels[simple_labels[idx]];
+				}
 			}
 		}
+	}
 
-		// restore total_wclasses
-		while (n_nm_vecs<feats.vlen)
+	// the first attribute with the highest gain wins, as in a sequential search
+	float64_t max_gain=MIN_SPLIT_GAIN;
+	int32_t best=-1;
+	for (int32_t i=0;i<num_candidates;i++)
+	{
+		if (attr_gain[i]>max_gain)
 		{
-			total_wclasses[simple_labels[sorted_args[n_nm_vecs-1]]]+=weights[sorted_args[n_nm_vecs-1]];
-			n_nm_vecs++;
+			max_gain=attr_gain[i];
+			best=i;
 		}
 	}
 
-	if (best_attribute==-1)
+	if (best==-1)
 		return -1;
 
+	int32_t best_attribute=candidates[best];
+
+	num_missing_final=0;
+	for (int32_t i=0;i<num_vecs;i++)
+	{
+		if (mat(best_attribute,i)==MISSING)
+			num_missing_final++;
+	}
+
 	if (!m_nominal[best_attribute])
 	{
+		float64_t best_threshold=attr_threshold[best];
 		left[0]=best_threshold;
 		right[0]=best_threshold;
 		count_left=1;
@@ -699,10 +748,92 @@ int32_t CCARTree::compute_best_attribute(SGMatrix<float64_t> mat, SGVector<float
 		for (int32_t i=0;i<num_vecs;i++)
 			is_left_final[i]=(mat(best_attribute,i)<=best_threshold);
 	}
+	else
+	{
+		// rebuild the winning division of the nominal values
+		SGVector<float64_t> feats(num_vecs);
+		for (int32_t j=0;j<num_vecs;j++)
+			feats[j]=mat(best_attribute,j);
+
+		SGVector<index_t> sorted_args=CMath::parallel_argsort(feats,num_threads);
+		int32_t n_nm_vecs=num_vecs-num_missing_final;
+		SGVector<int32_t> simple_feats(num_vecs);
+		SGVector<float64_t> ufeats(num_vecs);
+		int32_t c=nominal_feature_classes(feats,sorted_args,n_nm_vecs,simple_feats,ufeats.vector);
+
+		int32_t k=attr_case[best];
+		SGVector<bool> feats_left(c+1);
+		for (int32_t p=0;p<c+1;p++)
+			feats_left[p]=((k/CMath::pow(2,p))%(CMath::pow(2,p+1))==1);
+
+		is_left_final.fill_vector(is_left_final.vector,is_left_final.vlen,false);
+		for (int32_t j=0;j<n_nm_vecs;j++)
+			is_left_final[sorted_args[j]]=feats_left[simple_feats[sorted_args[j]]];
+
+		count_left=0;
+		for (int32_t l=0;l<c+1;l++)
+			count_left=(feats_left[l])?count_left+1:count_left;
+
+		count_right=c+1-count_left;
+
+		int32_t l=0;
+		int32_t r=0;
+		for (int32_t w=0;w<c+1;w++)
+		{
+			if (feats_left[w])
+				left[l++]=ufeats[w];
+			else
+				right[r++]=ufeats[w];
+		}
+	}
 
 	return best_attribute;
 }
 
+SGVector<index_t> CCARTree::get_candidate_attributes(int32_t num_feats)
+{
+	SGVector<index_t> attributes(num_feats);
+	attributes.range_fill();
+	return attributes;
+}
+
+int32_t CCARTree::nominal_feature_classes(SGVector<float64_t> feats, SGVector<index_t> sorted_args, int32_t n_nm_vecs,
+	SGVector<int32_t> simple_feats, float64_t* ufeats)
+{
+	simple_feats.fill_vector(simple_feats.vector,simple_feats.vlen,-1);
+
+	// convert to simple values
+	simple_feats[sorted_args[0]]=0;
+	if (ufeats)
+		ufeats[0]=feats[sorted_args[0]];
+
+	int32_t c=0;
+	for (int32_t j=1;j<n_nm_vecs;j++)
+	{
+		if (feats[sorted_args[j]]==feats[sorted_args[j-1]])
+		{
+			simple_feats[sorted_args[j]]=c;
+		}
+		else
+		{
+			simple_feats[sorted_args[j]]=(++c);
+			if (ufeats)
+				ufeats[c]=feats[sorted_args[j]];
+		}
+	}
+
+	return c;
+}
+
+float64_t CCARTree::regression_gain(float64_t left_weight, float64_t left_sum, float64_t total_weight,
+	float64_t total_sum)
+{
+	// decrease of the weighted squared deviation, the sums of squares cancel out
+	float64_t right_weight=total_weight-left_weight;
+	float64_t right_sum=total_sum-left_sum;
+	return (left_sum*left_sum/left_weight+right_sum*right_sum/right_weight-total_sum*total_sum/total_weight)/total_weight;
+}
+
 SGVector<bool> CCARTree::surrogate_split(SGMatrix<float64_t> m,SGVector<float64_t> weights, SGVector<bool> nm_left, int32_t attr)
 {
 	// return vector - left/right belongingness
@@ -975,65 +1106,11 @@ float64_t CCARTree::least_squares_deviation(SGVector<float64_t> feats, SGVector<
 
 CLabels* CCARTree::apply_from_current_node(CDenseFeatures<float64_t>* feats, bnode_t* current)
 {
-	int32_t num_vecs=feats->get_num_vectors();
-	SGVector<float64_t> labels(num_vecs);
-	for (int32_t i=0;i<num_vecs;i++)
-	{
-		SGVector<float64_t> sample=feats->get_feature_vector(i);
-		bnode_t* node=current;
-		SG_REF(node);
-
-		// until leaf is reached
-		while(node->data.num_leaves!=1)
-		{
-			bnode_t* leftchild=node->left();
+	FlatTree flat_tree;
+	flatten_tree(current, flat_tree.add_nodes(1), flat_tree);
 
-			if (m_nominal[node->data.attribute_id])
-			{
-				SGVector<float64_t> comp=leftchild->data.transit_into_values;
-				bool flag=false;
-				for (int32_t k=0;k<comp.vlen;k++)
-				{
-					if (comp[k]==sample[node->data.attribute_id])
-					{
-						flag=true;
-						break;
-					}
-				}
-
-				if (flag)
-				{
-					SG_UNREF(node);
-					node=leftchild;
-					SG_REF(leftchild);
-				}
-				else
-				{
-					SG_UNREF(node);
-					node=node->right();
-				}
-			}
-			else
-			{
-				if (sample[node->data.attribute_id]<=leftchild->data.transit_into_values[0])
-				{
-					SG_UNREF(node);
-					node=leftchild;
-					SG_REF(leftchild);
-				}
-				else
-				{
-					SG_UNREF(node);
-					node=node->right();
-				}
-			}
-
-			SG_UNREF(leftchild);
-		}
-
-		labels[i]=node->data.node_label;
-		SG_UNREF(node);
-	}
+	SGVector<float64_t> labels=flat_tree.apply(feats->get_feature_matrix(),
+			parallel->get_num_threads());
 
 	switch(m_mode)
 	{
@@ -1056,6 +1133,38 @@ CLabels* CCARTree::apply_from_current_node(CDenseFeatures<float64_t>* feats, bno
 	return NULL;
 }
 
+void CCARTree::flatten_tree(bnode_t* node, int32_t index, FlatTree& flat_tree)
+{
+	flat_tree.set_output(index, node->data.node_label);
+	if (node->data.num_leaves==1)
+		return;
+
+	bnode_t* left=node->left();
+	bnode_t* right=node->right();
+	int32_t first_child=flat_tree.add_nodes(2);
+	int32_t attribute=node->data.attribute_id;
+
+	if (m_nominal[attribute])
+	{
+		// values moving into the left child, everything else goes right
+		SGVector<float64_t> values=left->data.transit_into_values;
+		SGVector<int32_t> children(values.vlen);
+		children.set_const(first_child);
+		flat_tree.set_nominal_split(index, attribute, values, children, first_child+1);
+	}
+	else
+	{
+		flat_tree.set_threshold_split(index, attribute, left->data.transit_into_values[0],
+				first_child);
+	}
+
+	flatten_tree(left, first_child, flat_tree);
+	flatten_tree(right, first_child+1, flat_tree);
+
+	SG_UNREF(left);
+	SG_UNREF(right);
+}
+
 void CCARTree::prune_by_cross_validation(CDenseFeatures<float64_t>* data, int32_t folds)
 {
 	int32_t num_vecs=data->get_num_vectors();
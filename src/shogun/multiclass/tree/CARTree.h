@@ -36,6 +36,7 @@
 
 #include <shogun/multiclass/tree/TreeMachine.h>
 #include <shogun/multiclass/tree/CARTreeNodeData.h>
+#include <shogun/multiclass/tree/FlatTree.h>
 #include <shogun/features/DenseFeatures.h>
 
 namespace shogun
@@ -268,6 +269,37 @@ protected:
 		SGVector<float64_t> left, SGVector<float64_t> right, SGVector<bool> is_left_final, int32_t &num_missing,
 		int32_t &count_left, int32_t &count_right);
 
+	/** attributes among which compute_best_attribute searches the best split
+	 *
+	 * @param num_feats number of attributes
+	 * @return indices of the candidate attributes, all attributes here
+	 */
+	virtual SGVector<index_t> get_candidate_attributes(int32_t num_feats);
+
+	/** map the non-missing values of a nominal attribute to consecutive
+	 * integers
+	 *
+	 * @param feats attribute values of all vectors
+	 * @param sorted_args indices sorting feats in ascending order
+	 * @param n_nm_vecs number of non-missing vectors
+	 * @param simple_feats integer value of each vector, -1 if missing
+	 * @param ufeats if not NULL, the distinct values are stored here
+	 * @return largest integer value used
+	 */
+	int32_t nominal_feature_classes(SGVector<float64_t> feats, SGVector<index_t> sorted_args, int32_t n_nm_vecs,
+		SGVector<int32_t> simple_feats, float64_t* ufeats);
+
+	/** reduction in weighted least squares deviation of a regression split
+	 *
+	 * @param left_weight total weight of vectors in left child
+	 * @param left_sum weighted sum of labels in left child
+	 * @param total_weight total weight of vectors in the node
+	 * @param total_sum weighted sum of labels in the node
+	 * @return gain of the split
+	 */
+	float64_t regression_gain(float64_t left_weight, float64_t left_sum, float64_t total_weight,
+		float64_t total_sum);
+
 
 	/** handles missing values through surrogate splits
 	 *
@@ -356,6 +388,14 @@ protected:
 	 */
 	CLabels* apply_from_current_node(CDenseFeatures<float64_t>* feats, bnode_t* current);
 
+	/** copy a subtree into a flat tree
+	 *
+	 * @param node root of the subtree
+	 * @param index index of the flat node corresponding to node
+	 * @param flat_tree flat tree to fill
+	 */
+	void flatten_tree(bnode_t* node, int32_t index, FlatTree& flat_tree);
+
 	/** prune by cross validation
 	 *
 	 * @param data training data
@@ -677,48 +677,10 @@ CLabels* CCHAIDTree::apply_tree(CFeatures* data)
 
 CLabels* CCHAIDTree::apply_from_current_node(SGMatrix<float64_t> fmat, node_t* current)
 {
-	int32_t num_vecs=fmat.num_cols;
+	FlatTree flat_tree;
+	flatten_tree(current, flat_tree.add_nodes(1), flat_tree);
 
-	SGVector<float64_t> labels(num_vecs);
-	for (int32_t i=0;i<num_vecs;i++)
-	{
-		node_t* node=current;
-		SG_REF(node);
-		CDynamicObjectArray* children=node->get_children();
-		// while leaf node not reached
-		while(children->get_num_elements()>0)
-		{
-			// find feature class (or index of child node) of chosen vector in current node
-			int32_t index=-1;
-			for (int32_t j=0;j<(node->data.distinct_features).vlen;j++)
-			{
-				if (fmat(node->data.attribute_id,i)==node->data.distinct_features[j])
-				{
-					index=j;
-					break;
-				}
-			}
-
-			if (index==-1)
-				break;
-
-			CSGObject* el=children->get_element(node->data.feature_class[index]);
-			if (el!=NULL)
-			{
-				SG_UNREF(node);
-				node=dynamic_cast<node_t*>(el);
-			}
-			else
-				SG_ERROR("%d child is expected to be present. But it is NULL\n",index)
-
-			SG_UNREF(children);
-			children=node->get_children();
-		}
-
-		labels[i]=node->data.node_label;
-		SG_UNREF(node);
-		SG_UNREF(children);
-	}
+	SGVector<float64_t> labels=flat_tree.apply(fmat, parallel->get_num_threads());
 
 	switch (get_machine_problem_type())
 	{
@@ -733,6 +695,37 @@ CLabels* CCHAIDTree::apply_from_current_node(SGMatrix<float64_t> fmat, node_t* c
 	return new CMulticlassLabels();
 }
 
+void CCHAIDTree::flatten_tree(node_t* node, int32_t index, FlatTree& flat_tree)
+{
+	flat_tree.set_output(index, node->data.node_label);
+
+	CDynamicObjectArray* children=node->get_children();
+	int32_t num_children=children->get_num_elements();
+	if (num_children>0)
+	{
+		int32_t first_child=flat_tree.add_nodes(num_children);
+		for (int32_t j=0;j<num_children;j++)
+		{
+			CSGObject* el=children->get_element(j);
+			if (el==NULL)
+				SG_ERROR("%d child is expected to be present. But it is NULL\n",j)
+
+			flatten_tree(dynamic_cast<node_t*>(el), first_child+j, flat_tree);
+			SG_UNREF(el);
+		}
+
+		// feature class (or index of child node) of each distinct feature value
+		SGVector<int32_t> flat_children(node->data.distinct_features.vlen);
+		for (int32_t j=0;j<flat_children.vlen;j++)
+			flat_children[j]=first_child+node->data.feature_class[j];
+
+		flat_tree.set_nominal_split(index, node->data.attribute_id,
+				node->data.distinct_features, flat_children);
+	}
+
+	SG_UNREF(children);
+}
+
 bool CCHAIDTree::handle_missing_ordinal(SGVector<int32_t> cat, SGVector<float64_t> feats, SGVector<float64_t> labels,
 									 		SGVector<float64_t> weights)
 {
@@ -36,6 +36,7 @@
 
 #include <shogun/multiclass/tree/TreeMachine.h>
 #include <shogun/multiclass/tree/CHAIDTreeNodeData.h>
+#include <shogun/multiclass/tree/FlatTree.h>
 #include <shogun/features/DenseFeatures.h>
 
 namespace shogun
@@ -281,6 +282,14 @@ private:
 	 */
 	CLabels* apply_from_current_node(SGMatrix<float64_t> fmat, node_t* current);
 
+	/** copy a subtree into a flat tree
+	 *
+	 * @param node root of the subtree
+	 * @param index index of the flat node corresponding to node
+	 * @param flat_tree flat tree to fill
+	 */
+	void flatten_tree(node_t* node, int32_t index, FlatTree& flat_tree);
+
 	/** handles missing values category for ordinal feature type
 	 *
 	 * @param cat category vector
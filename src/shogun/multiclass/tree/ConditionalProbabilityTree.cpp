@@ -31,15 +31,29 @@ CMulticlassLabels* CConditionalProbabilityTree::apply_multiclass(CFeatures* data
 	}
 
 	vector<int32_t> predicts;
+	vector<SGVector<float32_t> > batch;
 
 	m_feats->start_parser();
 	while (m_feats->get_next_example())
 	{
-		predicts.push_back(apply_multiclass_example(m_feats->get_vector()));
+		if (m_batch_size > 1)
+		{
+			batch.push_back(m_feats->get_vector().clone());
+			if (int32_t(batch.size()) == m_batch_size)
+			{
+				predict_batch(batch, predicts);
+				batch.clear();
+			}
+		}
+		else
+			predicts.push_back(apply_multiclass_example(m_feats->get_vector()));
 		m_feats->release_example();
 	}
 	m_feats->end_parser();
 
+	if (!batch.empty())
+		predict_batch(batch, predicts);
+
 	CMulticlassLabels *labels = new CMulticlassLabels(predicts.size());
 	for (size_t i=0; i < predicts.size(); ++i)
 		labels->set_int_label(i, predicts[i]);
@@ -57,6 +71,114 @@ int32_t CConditionalProbabilityTree::apply_multiclass_example(SGVector<float32_t
 	return CMath::arg_max(probs.vector, 1, probs.vlen);
 }
 
+SGVector<int32_t> CConditionalProbabilityTree::apply_multiclass_batch(SGMatrix<float32_t> examples)
+{
+	vector<SGVector<float32_t> > batch;
+	for (index_t i=0; i < examples.num_cols; ++i)
+		batch.push_back(SGVector<float32_t>(examples.get_column_vector(i), examples.num_rows, false));
+
+	vector<int32_t> predicts;
+	predict_batch(batch, predicts);
+
+	SGVector<int32_t> result(predicts.size());
+	for (size_t i=0; i < predicts.size(); ++i)
+		result[i] = predicts[i];
+	return result;
+}
+
+void CConditionalProbabilityTree::predict_batch(const vector<SGVector<float32_t> >& examples,
+	vector<int32_t>& predicts)
+{
+	REQUIRE(m_root, "The tree has not been trained\n");
+
+	int32_t num_examples = examples.size();
+	if (num_examples == 0)
+		return;
+
+	// number the inner nodes, only they have a machine used in prediction
+	map<bnode_t*, int32_t> node_ids;
+	vector<COnlineLibLinear*> machines;
+	stack<bnode_t *> nodes;
+	nodes.push((bnode_t*) m_root);
+	while (!nodes.empty())
+	{
+		bnode_t *node = nodes.top();
+		nodes.pop();
+		if (node->left())
+		{
+			nodes.push(node->left());
+			nodes.push(node->right());
+
+			COnlineLibLinear *mch = dynamic_cast<COnlineLibLinear *>(m_machines->get_element(node->machine()));
+			REQUIRE(mch, "Instance of %s could not be casted to COnlineLibLinear\n", node->get_name());
+			node_ids.insert(make_pair(node, int32_t(machines.size())));
+			machines.push_back(mch);
+		}
+	}
+
+	// path of every leaf up to the root as (node id, whether it is right)
+	int32_t num_leaves = m_leaves.size();
+	vector<int32_t> leaf_labels;
+	vector<vector<pair<int32_t, bool> > > paths;
+	for (map<int32_t,bnode_t*>::iterator it = m_leaves.begin(); it != m_leaves.end(); ++it)
+	{
+		vector<pair<int32_t, bool> > path;
+		bnode_t *leaf = it->second;
+		bnode_t *par = (bnode_t*) leaf->parent();
+		while (par != NULL)
+		{
+			path.push_back(make_pair(node_ids[par], leaf != par->left()));
+			leaf = par;
+			par = (bnode_t*) leaf->parent();
+		}
+		leaf_labels.push_back(it->first);
+		paths.push_back(path);
+	}
+
+	int32_t num_nodes = machines.size();
+	SGMatrix<float64_t> p_right(num_examples, num_nodes);
+
+	#pragma omp parallel for schedule(dynamic) num_threads(parallel->get_num_threads())
+	for (int32_t k=0; k < num_nodes; ++k)
+	{
+		for (int32_t i=0; i < num_examples; ++i)
+		{
+			float64_t pred = machines[k]->apply_one(examples[i].vector, examples[i].vlen);
+			// use sigmoid function to turn the decision value into valid probability
+			p_right(i, k) = 1.0/(1+CMath::exp(-pred));
+		}
+	}
+
+	for (int32_t k=0; k < num_nodes; ++k)
+		SG_UNREF(machines[k]);
+
+	size_t offset = predicts.size();
+	predicts.resize(offset+num_examples);
+
+	#pragma omp parallel num_threads(parallel->get_num_threads())
+	{
+		SGVector<float64_t> probs(num_leaves);
+
+		#pragma omp for
+		for (int32_t i=0; i < num_examples; ++i)
+		{
+			for (int32_t l=0; l < num_leaves; ++l)
+			{
+				float64_t prob = 1;
+				for (size_t j=0; j < paths[l].size(); ++j)
+				{
+					if (paths[l][j].second)
+						prob *= p_right(i, paths[l][j].first);
+					else
+						prob *= (1-p_right(i, paths[l][j].first));
+				}
+				probs[leaf_labels[l]] = prob;
+			}
+			predicts[offset+i] = CMath::arg_max(probs.vector, 1, probs.vlen);
+		}
+	}
+}
+
 void CConditionalProbabilityTree::compute_conditional_probabilities(SGVector<float32_t> ex)
 {
 	stack<bnode_t *> nodes;
@@ -117,15 +239,38 @@ bool CConditionalProbabilityTree::train_machine(CFeatures* data)
 
 	m_leaves.clear();
 
+	vector<SGVector<float32_t> > batch;
+	vector<int32_t> batch_labels;
+
 	m_feats->start_parser();
 	for (int32_t ipass=0; ipass < m_num_passes; ++ipass)
 	{
 		while (m_feats->get_next_example())
 		{
-			train_example(m_feats->get_vector(), static_cast<int32_t>(m_feats->get_label()));
+			int32_t label = static_cast<int32_t>(m_feats->get_label());
+			if (m_batch_size > 1)
+			{
+				batch.push_back(m_feats->get_vector().clone());
+				batch_labels.push_back(label);
+				if (int32_t(batch.size()) == m_batch_size)
+				{
+					train_batch(batch, batch_labels);
+					batch.clear();
+					batch_labels.clear();
+				}
+			}
+			else
+				train_example(m_feats->get_vector(), label);
 			m_feats->release_example();
 		}
 
+		if (!batch.empty())
+		{
+			train_batch(batch, batch_labels);
+			batch.clear();
+			batch_labels.clear();
+		}
+
 		if (ipass < m_num_passes-1)
 			m_feats->reset_stream();
 	}
@@ -206,6 +351,79 @@ void CConditionalProbabilityTree::train_example(SGVector<float32_t> ex, int32_t
 	}
 }
 
+void CConditionalProbabilityTree::train_batch(const vector<SGVector<float32_t> >& examples,
+	const vector<int32_t>& labels)
+{
+	int32_t start = 0;
+	for (int32_t i=0; i < int32_t(examples.size()); ++i)
+	{
+		// examples of new labels change the tree, so everything before them
+		// has to be trained first
+		if (m_root == NULL || m_leaves.find(labels[i]) == m_leaves.end())
+		{
+			train_paths(examples, labels, start, i);
+			train_example(examples[i], labels[i]);
+			start = i+1;
+		}
+	}
+	train_paths(examples, labels, start, examples.size());
+}
+
+void CConditionalProbabilityTree::train_paths(const vector<SGVector<float32_t> >& examples,
+	const vector<int32_t>& labels, int32_t start, int32_t stop)
+{
+	if (start >= stop)
+		return;
+
+	// collect the updates of every node on the paths, in stream order
+	map<bnode_t*, int32_t> node_ids;
+	vector<bnode_t*> nodes;
+	vector<vector<pair<int32_t, float64_t> > > updates;
+	for (int32_t i=start; i < stop; ++i)
+	{
+		bnode_t *node = m_leaves[labels[i]];
+		float64_t node_label = 0;
+		while (node != NULL)
+		{
+			map<bnode_t*, int32_t>::iterator it = node_ids.find(node);
+			if (it == node_ids.end())
+			{
+				it = node_ids.insert(make_pair(node, int32_t(nodes.size()))).first;
+				nodes.push_back(node);
+				updates.push_back(vector<pair<int32_t, float64_t> >());
+			}
+			updates[it->second].push_back(make_pair(i, node_label));
+
+			bnode_t *par = (bnode_t*) node->parent();
+			if (par != NULL)
+				node_label = (par->left() == node) ? 0 : 1;
+			node = par;
+		}
+	}
+
+	int32_t num_nodes = nodes.size();
+	vector<COnlineLibLinear*> machines(num_nodes);
+	for (int32_t k=0; k < num_nodes; ++k)
+	{
+		machines[k] = dynamic_cast<COnlineLibLinear *>(m_machines->get_element(nodes[k]->machine()));
+		REQUIRE(machines[k], "Instance of %s could not be casted to COnlineLibLinear\n", nodes[k]->get_name());
+	}
+
+	// nodes have their own machines, so they are trained independently
+	#pragma omp parallel for schedule(dynamic) num_threads(parallel->get_num_threads())
+	for (int32_t k=0; k < num_nodes; ++k)
+	{
+		for (size_t j=0; j < updates[k].size(); ++j)
+		{
+			const SGVector<float32_t>& ex = examples[updates[k][j].first];
+			machines[k]->train_one(SGVector<float32_t>(ex.vector, ex.vlen, false), updates[k][j].second);
+		}
+	}
+
+	for (int32_t k=0; k < num_nodes; ++k)
+		SG_UNREF(machines[k]);
+}
+
 void CConditionalProbabilityTree::train_path(SGVector<float32_t> ex, bnode_t *node)
 {
 	float64_t node_label = 0;
@@ -12,6 +12,7 @@
 #define CONDITIONALPROBABILITYTREE_H__
 
 #include <map>
+#include <vector>
 
 #include <shogun/lib/config.h>
 
@@ -35,7 +36,7 @@ class CConditionalProbabilityTree: public CTreeMachine<ConditionalProbabilityTre
 public:
     /** constructor */
 	CConditionalProbabilityTree(int32_t num_passes=1)
-		:m_num_passes(num_passes), m_feats(NULL)
+		:m_num_passes(num_passes), m_batch_size(1), m_feats(NULL)
 	{
 	}
 
@@ -57,6 +58,27 @@ public:
 		return m_num_passes;
 	}
 
+	/** set the number of examples processed together
+	 *
+	 * With a batch size larger than one, training updates the node machines
+	 * of a batch in parallel, each node applying its updates in stream order,
+	 * so the learned tree is the same as with online training. Prediction
+	 * evaluates every node on the whole batch at once.
+	 *
+	 * @param batch_size number of examples per batch, 1 for online processing
+	 */
+	void set_batch_size(int32_t batch_size)
+	{
+		REQUIRE(batch_size>0, "Batch size (%d) has to be positive\n", batch_size);
+		m_batch_size = batch_size;
+	}
+
+	/** get number of examples processed together */
+	int32_t get_batch_size() const
+	{
+		return m_batch_size;
+	}
+
 	/** set features
 	 * @param feats features
 	 */
@@ -75,6 +97,14 @@ public:
 	 */
 	virtual int32_t apply_multiclass_example(SGVector<float32_t> ex);
 
+	/** apply machine to a batch of examples, evaluating the node machines
+	 * in parallel
+	 *
+	 * @param examples examples in the columns
+	 * @return predicted label of each example
+	 */
+	SGVector<int32_t> apply_multiclass_batch(SGMatrix<float32_t> examples);
+
 	/** print the tree structure for debug purpose */
 	void print_tree();
 protected:
@@ -95,6 +125,36 @@ protected:
 	 */
 	void train_example(SGVector<float32_t> ex, int32_t label);
 
+	/** train on a batch of examples
+	 *
+	 * Runs of examples whose labels are already in the tree are trained
+	 * with train_paths(), examples of new labels with train_example().
+	 *
+	 * @param examples the examples being trained
+	 * @param labels the labels of the examples
+	 */
+	void train_batch(const std::vector<SGVector<float32_t> >& examples,
+			const std::vector<int32_t>& labels);
+
+	/** train examples whose labels have leaves on the paths from their
+	 * leaves up to the root, updating different nodes in parallel
+	 *
+	 * @param examples the examples being trained
+	 * @param labels the labels of the examples
+	 * @param start index of the first example to train
+	 * @param stop index after the last example to train
+	 */
+	void train_paths(const std::vector<SGVector<float32_t> >& examples,
+			const std::vector<int32_t>& labels, int32_t start, int32_t stop);
+
+	/** predict a batch of examples
+	 *
+	 * @param examples the examples being predicted
+	 * @param predicts predicted labels, appended to
+	 */
+	void predict_batch(const std::vector<SGVector<float32_t> >& examples,
+			std::vector<int32_t>& predicts);
+
 	/** train on a path from a node up to the root
 	 * @param ex the instance of the training example
 	 * @param node the leaf node
@@ -135,6 +195,7 @@ protected:
 	float64_t accumulate_conditional_probability(bnode_t *leaf);
 
 	int32_t m_num_passes; ///< number of passes for online training
+	int32_t m_batch_size; ///< number of examples processed together
 	std::map<int32_t, bnode_t*> m_leaves; ///< class => leaf mapping
 	CStreamingDenseFeatures<float32_t> *m_feats; ///< online features
 };
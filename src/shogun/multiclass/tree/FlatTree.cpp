@@ -0,0 +1,199 @@
+/*
+ * Copyright (c) The Shogun Machine Learning Toolbox
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation are those
+ * of the authors and should not be interpreted as representing official policies,
+ * either expressed or implied, of the Shogun Development Team.
+ *
+ */
+
+
+#include <shogun/multiclass/tree/FlatTree.h>
+#include <shogun/io/SGIO.h>
+
+#include <algorithm>
+
+using namespace shogun;
+
+namespace
+{
+	/** value of a nominal split and its position in the input table */
+	struct NominalEntry
+	{
+		float64_t value;
+		int32_t child;
+		int32_t position;
+
+		bool operator<(const NominalEntry& other) const
+		{
+			if (value!=other.value)
+				return value<other.value;
+			return position<other.position;
+		}
+	};
+}
+
+FlatTree::FlatTree() : m_num_bytes(0)
+{
+}
+
+FlatTree::~FlatTree()
+{
+	if (m_num_bytes)
+		sg_memory_release(MEMORY_TAG_TREES, m_num_bytes);
+}
+
+int32_t FlatTree::add_nodes(int32_t num)
+{
+	int32_t first=get_num_nodes();
+	int32_t size=first+num;
+
+	m_attribute.resize(size, -1);
+	m_threshold.resize(size, 0.);
+	m_first_child.resize(size, -1);
+	m_values_begin.resize(size, -1);
+	m_values_end.resize(size, -1);
+	m_default_child.resize(size, -1);
+	m_output.resize(size, 0.);
+	m_aux.resize(size, 0.);
+
+	int64_t bytes=((int64_t) num)*(5*sizeof(int32_t)+3*sizeof(float64_t));
+	sg_memory_charge(MEMORY_TAG_TREES, bytes);
+	m_num_bytes+=bytes;
+
+	return first;
+}
+
+void FlatTree::set_output(int32_t node, float64_t output, float64_t aux)
+{
+	m_output[node]=output;
+	m_aux[node]=aux;
+}
+
+void FlatTree::set_threshold_split(int32_t node, int32_t attribute,
+		float64_t threshold, int32_t first_child)
+{
+	REQUIRE(first_child+1<get_num_nodes(), "Children of node %d have to be added first\n", node)
+
+	m_attribute[node]=attribute;
+	m_threshold[node]=threshold;
+	m_first_child[node]=first_child;
+	m_values_begin[node]=-1;
+}
+
+void FlatTree::set_nominal_split(int32_t node, int32_t attribute,
+		SGVector<float64_t> values, SGVector<int32_t> children,
+		int32_t default_child)
+{
+	REQUIRE(values.vlen==children.vlen, "Expected a child for each of the %d values, got %d\n",
+			values.vlen, children.vlen)
+
+	std::vector<NominalEntry> entries(values.vlen);
+	for (index_t i=0; i<values.vlen; i++)
+	{
+		entries[i].value=values[i];
+		entries[i].child=children[i];
+		entries[i].position=i;
+	}
+	std::sort(entries.begin(), entries.end());
+
+	m_attribute[node]=attribute;
+	m_first_child[node]=values.vlen ? children[0] : default_child;
+	m_default_child[node]=default_child;
+	m_values_begin[node]=m_values.size();
+	for (size_t i=0; i<entries.size(); i++)
+	{
+		m_values.push_back(entries[i].value);
+		m_value_child.push_back(entries[i].child);
+	}
+	m_values_end[node]=m_values.size();
+
+	int64_t bytes=((int64_t) entries.size())*(sizeof(float64_t)+sizeof(int32_t));
+	sg_memory_charge(MEMORY_TAG_TREES, bytes);
+	m_num_bytes+=bytes;
+}
+
+int32_t FlatTree::get_num_nodes() const
+{
+	return m_attribute.size();
+}
+
+int32_t FlatTree::nominal_child(int32_t node, float64_t value) const
+{
+	if (m_values_begin[node]==m_values_end[node])
+		return m_default_child[node];
+
+	const float64_t* begin=&m_values[0]+m_values_begin[node];
+	const float64_t* end=&m_values[0]+m_values_end[node];
+	const float64_t* pos=std::lower_bound(begin, end, value);
+
+	if (pos!=end && *pos==value)
+		return m_value_child[pos-&m_values[0]];
+
+	return m_default_child[node];
+}
+
+int32_t FlatTree::find_node(const float64_t* sample) const
+{
+	int32_t node=0;
+	while (m_attribute[node]>=0)
+	{
+		float64_t value=sample[m_attribute[node]];
+		if (m_values_begin[node]<0)
+		{
+			// NaN goes to the second child, as in the trees
+			node=m_first_child[node]+!(value<=m_threshold[node]);
+		}
+		else
+		{
+			int32_t child=nominal_child(node, value);
+			if (child<0)
+				break;
+			node=child;
+		}
+	}
+
+	return node;
+}
+
+SGVector<float64_t> FlatTree::apply(SGMatrix<float64_t> data, int32_t num_threads,
+		SGVector<float64_t> aux) const
+{
+	REQUIRE(get_num_nodes()>0, "Tree is empty\n")
+
+	int32_t num_vecs=data.num_cols;
+	SGVector<float64_t> outputs(num_vecs);
+	bool set_aux=(aux.vlen==num_vecs);
+
+	#pragma omp parallel for schedule(static, 256) num_threads(num_threads)
+	for (int32_t i=0; i<num_vecs; i++)
+	{
+		int32_t node=find_node(data.get_column_vector(i));
+		outputs[i]=m_output[node];
+		if (set_aux)
+			aux[i]=m_aux[node];
+	}
+
+	return outputs;
+}
@@ -0,0 +1,184 @@
+/*
+ * Copyright (c) The Shogun Machine Learning Toolbox
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation are those
+ * of the authors and should not be interpreted as representing official policies,
+ * either expressed or implied, of the Shogun Development Team.
+ *
+ */
+
+
+#ifndef _FLATTREE_H__
+#define _FLATTREE_H__
+
+#include <shogun/lib/config.h>
+
+#include <shogun/lib/common.h>
+#include <shogun/lib/SGVector.h>
+#include <shogun/lib/SGMatrix.h>
+
+#include <vector>
+
+namespace shogun
+{
+
+/** @brief Flat, array based copy of a trained decision tree used for
+ * prediction.
+ *
+ * Nodes are stored as a struct of arrays and refer to each other by
+ * index, and the children of a node are stored next to each other. A
+ * threshold split sends a sample to the first child if its attribute is
+ * not greater than the threshold and to the second child otherwise. A
+ * nominal split looks the attribute value up in a sorted table of values
+ * and falls back to a default child when the value is not found; if
+ * there is no default child the traversal stops at the splitting node.
+ *
+ * Prediction touches no reference counted objects, so a single flat tree
+ * can be evaluated by several threads at once. CCARTree, CC45ClassifierTree,
+ * CID3ClassifierTree and CCHAIDTree compile their trees into this form when
+ * they are applied.
+ */
+class FlatTree
+{
+public:
+	/** constructor */
+	FlatTree();
+
+	/** destructor */
+	~FlatTree();
+
+	/** add leaf nodes which are stored next to each other
+	 *
+	 * @param num number of nodes to add
+	 * @return index of the first added node
+	 */
+	int32_t add_nodes(int32_t num);
+
+	/** set output of a node, returned when the traversal ends there
+	 *
+	 * @param node index of the node
+	 * @param output output of the node
+	 * @param aux additional per node value, eg. certainty
+	 */
+	void set_output(int32_t node, float64_t output, float64_t aux=0.);
+
+	/** make a node a threshold split
+	 *
+	 * @param node index of the node
+	 * @param attribute index of the feature to split on
+	 * @param threshold samples with feature value not greater than
+	 * threshold go to the first child
+	 * @param first_child index of the first of the two children
+	 */
+	void set_threshold_split(int32_t node, int32_t attribute,
+			float64_t threshold, int32_t first_child);
+
+	/** make a node a nominal split
+	 *
+	 * @param node index of the node
+	 * @param attribute index of the feature to split on
+	 * @param values feature values, the first occurrence of a value wins
+	 * @param children index of the child for each value
+	 * @param default_child child for values not in the table, -1 to stop
+	 * at this node
+	 */
+	void set_nominal_split(int32_t node, int32_t attribute,
+			SGVector<float64_t> values, SGVector<int32_t> children,
+			int32_t default_child=-1);
+
+	/** @return number of nodes */
+	int32_t get_num_nodes() const;
+
+	/** predict outputs for all samples, in parallel over blocks of
+	 * samples
+	 *
+	 * @param data samples, one per column
+	 * @param num_threads number of threads to use
+	 * @param aux if of length num_vectors, filled with the auxiliary
+	 * value of the node every sample ends in
+	 * @return outputs of the nodes the samples end in
+	 */
+	SGVector<float64_t> apply(SGMatrix<float64_t> data, int32_t num_threads,
+			SGVector<float64_t> aux=SGVector<float64_t>()) const;
+
+	/** get the node in which a sample ends
+	 *
+	 * @param sample the sample
+	 * @return index of the node
+	 */
+	int32_t find_node(const float64_t* sample) const;
+
+private:
+	/** follow a nominal split
+	 *
+	 * @param node index of the node
+	 * @param value feature value of the sample
+	 * @return index of the child or -1
+	 */
+	int32_t nominal_child(int32_t node, float64_t value) const;
+
+	/** disable copying, the tables are charged to MEMORY_TAG_TREES once */
+	FlatTree(const FlatTree& orig);
+
+	/** disable assignment */
+	FlatTree& operator=(const FlatTree& orig);
+
+private:
+	/** feature each node splits on, -1 for leaves */
+	std::vector<int32_t> m_attribute;
+
+	/** threshold of threshold splits */
+	std::vector<float64_t> m_threshold;
+
+	/** index of the first child */
+	std::vector<int32_t> m_first_child;
+
+	/** start of the node's value table, -1 for threshold splits */
+	std::vector<int32_t> m_values_begin;
+
+	/** end of the node's value table */
+	std::vector<int32_t> m_values_end;
+
+	/** child of nominal splits for values not in the table */
+	std::vector<int32_t> m_default_child;
+
+	/** output of each node */
+	std::vector<float64_t> m_output;
+
+	/** auxiliary value of each node */
+	std::vector<float64_t> m_aux;
+
+	/** sorted values of all nominal splits */
+	std::vector<float64_t> m_values;
+
+	/** child of each value */
+	std::vector<int32_t> m_value_child;
+
+	/** bytes of the node and value tables charged to MEMORY_TAG_TREES */
+	int64_t m_num_bytes;
+};
+
+} /* shogun */
+
+#endif /* _FLATTREE_H__ */
@@ -363,53 +363,40 @@ CMulticlassLabels* CID3ClassifierTree::apply_multiclass_from_current_node(CDense
 	REQUIRE(feats, "Features should not be NULL")
 	REQUIRE(current, "Current node should not be NULL")
 
-	int32_t num_vecs = feats->get_num_vectors();
-	SGVector<float64_t> labels = SGVector<float64_t>(num_vecs);
-
-	// classify vectors in feature matrix taking one at a time
-	for (int32_t i=0; i<num_vecs; i++)
-	{
-		// choose the current subtree as the entry point
-		SGVector<float64_t> sample = feats->get_feature_vector(i);
-		node_t* node = current;
-		SG_REF(node);
-		CDynamicObjectArray* children = node->get_children();
-
-		// traverse the subtree until leaf node is reached
-		while (children->get_num_elements())
-		{
-			bool flag = false;
-			for (int32_t j=0; j<children->get_num_elements(); j++)
-			{
-				node_t* child = dynamic_cast<node_t*>(children->get_element(j));
-				if (child->data.transit_if_feature_value
-						== sample[node->data.attribute_id])
-				{
-					flag = true;
+	FlatTree flat_tree;
+	flatten_tree(current, flat_tree.add_nodes(1), flat_tree);
 
-					SG_UNREF(node);
-					node = child;
+	// class_label of the node reached is the class to which chosen vector belongs
+	SGVector<float64_t> labels = flat_tree.apply(feats->get_feature_matrix(),
+			parallel->get_num_threads());
 
-					SG_UNREF(children);
-					children = node->get_children();
+	CMulticlassLabels* ret = new CMulticlassLabels(labels);
+	return ret;
+}
 
-					break;
-				}
+void CID3ClassifierTree::flatten_tree(node_t* node, int32_t index, FlatTree& flat_tree)
+{
+	flat_tree.set_output(index, node->data.class_label);
 
-				SG_UNREF(child);
-			}
+	CDynamicObjectArray* children = node->get_children();
+	int32_t num_children = children->get_num_elements();
+	if (num_children)
+	{
+		int32_t first_child = flat_tree.add_nodes(num_children);
+		SGVector<float64_t> values(num_children);
+		SGVector<int32_t> flat_children(num_children);
 
-			if (!flag)
-				break;
+		for (int32_t j=0; j<num_children; j++)
+		{
+			node_t* child = dynamic_cast<node_t*>(children->get_element(j));
+			values[j] = child->data.transit_if_feature_value;
+			flat_children[j] = first_child+j;
+			flatten_tree(child, first_child+j, flat_tree);
+			SG_UNREF(child);
 		}
 
-		// class_label of leaf node is the class to which chosen vector belongs
-		labels[i] = node->data.class_label;
-
-		SG_UNREF(node);
-		SG_UNREF(children);
+		flat_tree.set_nominal_split(index, node->data.attribute_id, values, flat_children);
 	}
 
-	CMulticlassLabels* ret = new CMulticlassLabels(labels);
-	return ret;
+	SG_UNREF(children);
 }
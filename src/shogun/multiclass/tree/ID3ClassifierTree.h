@@ -36,6 +36,7 @@
 
 #include <shogun/multiclass/tree/TreeMachine.h>
 #include <shogun/multiclass/tree/ID3TreeNodeData.h>
+#include <shogun/multiclass/tree/FlatTree.h>
 #include <shogun/features/DenseFeatures.h>
 #include <shogun/labels/MulticlassLabels.h>
 
@@ -163,6 +164,14 @@ private:
 	 * @return classification labels of input data
 	 */
 	CMulticlassLabels* apply_multiclass_from_current_node(CDenseFeatures<float64_t>* feats, node_t* current);
+
+	/** copy a subtree into a flat tree
+	 *
+	 * @param node root of the subtree
+	 * @param index index of the flat node corresponding to node
+	 * @param flat_tree flat tree to fill
+	 */
+	void flatten_tree(node_t* node, int32_t index, FlatTree& flat_tree);
 };
 } /* namespace shogun */
 
@@ -72,22 +72,12 @@ public:
 	int32_t get_feature_subset_size() const { return m_randsubset_size; }
 
 protected:
-	/** computes best attribute for CARTtrain
+	/** randomly chooses the attributes among which the best split is searched
 	 *
-	 * @param mat data matrix
-	 * @param weights data weights
-	 * @param labels_vec data labels
-	 * @param left stores feature values for left transition
-	 * @param right stores feature values for right transition
-	 * @param is_left_final stores which feature vectors go to the left child
-	 * @param num_missing number of missing attributes
-	 * @param count_left stores number of feature values for left transition
-	 * @param count_right stores number of feature values for right transition
-	 * @return index to the best attribute
+	 * @param num_feats number of attributes
+	 * @return indices of m_randsubset_size randomly chosen attributes
 	 */
-	virtual int32_t compute_best_attribute(SGMatrix<float64_t> mat, SGVector<float64_t> weights, SGVector<float64_t> labels_vec,
-	SGVector<float64_t> left, SGVector<float64_t> right, SGVector<bool> is_left_final, int32_t &num_missing, int32_t &count_left,
-														 int32_t &count_right);
+	virtual SGVector<index_t> get_candidate_attributes(int32_t num_feats);
 
 private:
 	/** initialize parameters */
@@ -57,6 +57,7 @@ public:
 	CTreeMachineNode() : CSGObject()
 	{
 		init();
+		sg_memory_charge(MEMORY_TAG_TREES, sizeof(CTreeMachineNode<T>));
 	}
 
 	/** destructor */
@@ -69,6 +70,7 @@ public:
 			SG_UNREF(child);
 		}
 		SG_UNREF(m_children);
+		sg_memory_release(MEMORY_TAG_TREES, sizeof(CTreeMachineNode<T>));
 	}
 
 	/** get name
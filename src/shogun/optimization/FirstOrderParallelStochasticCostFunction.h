@@ -0,0 +1,123 @@
+/*
+ * Copyright (c) The Shogun Machine Learning Toolbox
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation are those
+ * of the authors and should not be interpreted as representing official policies,
+ * either expressed or implied, of the Shogun Development Team.
+ *
+ */
+
+
+#ifndef FIRSTORDERPARALLELSTOCHASTICCOSTFUNCTION_H
+#define FIRSTORDERPARALLELSTOCHASTICCOSTFUNCTION_H
+#include <shogun/lib/config.h>
+#include <shogun/optimization/FirstOrderStochasticCostFunction.h>
+#include <shogun/lib/SGSparseVector.h>
+namespace shogun
+{
+/** @brief The class is about a stochastic cost function for parallel stochastic minimizers.
+ *
+ * The cost function must be written as a finite sample-specific sum of cost.
+ * For example, least squares cost function,
+ * \f[
+ * f(w)=\frac{ \sum_i^n{ (y_i-w^T x_i)^2 } }{2}
+ * \f]
+ * where \f$n\f$ is the sample size,
+ * \f$(y_i,x_i)\f$ is the i-th sample,
+ * \f$y_i\f$ is the label and \f$x_i\f$ is the features
+ *
+ * Unlike FirstOrderStochasticCostFunction::get_gradient(), which depends on the
+ * sample cursor moved by next_sample(), samples are accessed here by index and
+ * the target variables are passed explicitly, so that several threads can
+ * compute sample gradients at the same time (eg, ParallelSGDMinimizer).
+ */
+class FirstOrderParallelStochasticCostFunction
+	: public FirstOrderStochasticCostFunction
+{
+public:
+	/** Get the sample size
+	 *
+	 * @return the sample size
+	 */
+	virtual int32_t get_sample_size()=0;
+
+	/** Get the SAMPLE gradient value of the idx-th sample wrt given variables
+	 *
+	 * WARNING
+	 * This method may be called concurrently from several threads.
+	 * It must neither modify the cost function nor the given variables.
+	 * The given variables may be updated by other threads during the call.
+	 *
+	 * For least squares cost function, that is the value of
+	 * \f$\frac{\partial f_i(w) }{\partial w}\f$ given \f$w\f$ and \f$i\f$
+	 *
+	 * @param idx the index of the sample
+	 * @param variable the values of target variables
+	 * @return sample gradient of target variables
+	 */
+	virtual SGVector<float64_t> get_sample_gradient(index_t idx,
+		SGVector<float64_t> variable)=0;
+
+	/** Get the SAMPLE gradient value of the idx-th sample wrt given variables
+	 * as a sparse vector of its non-zero entries
+	 *
+	 * The same rules as for get_sample_gradient() apply. The default
+	 * implementation drops the zero entries of get_sample_gradient().
+	 * Cost functions whose sample gradients are sparse (eg, linear models
+	 * on sparse features) should override it, so that a sample costs
+	 * O(number of non-zero features) instead of O(number of variables).
+	 *
+	 * @param idx the index of the sample
+	 * @param variable the values of target variables
+	 * @return non-zero entries of the sample gradient of target variables
+	 */
+	virtual SGSparseVector<float64_t> get_sparse_sample_gradient(index_t idx,
+		SGVector<float64_t> variable)
+	{
+		SGVector<float64_t> grad=get_sample_gradient(idx, variable);
+		index_t num_entries=0;
+		for(index_t i=0; i<grad.vlen; i++)
+		{
+			if(grad[i]!=0.0)
+				num_entries++;
+		}
+
+		SGSparseVector<float64_t> res(num_entries);
+		num_entries=0;
+		for(index_t i=0; i<grad.vlen; i++)
+		{
+			if(grad[i]!=0.0)
+			{
+				res.features[num_entries].feat_index=i;
+				res.features[num_entries].entry=grad[i];
+				num_entries++;
+			}
+		}
+		return res;
+	}
+};
+
+}
+
+#endif
@@ -0,0 +1,276 @@
+/*
+ * Copyright (c) The Shogun Machine Learning Toolbox
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation are those
+ * of the authors and should not be interpreted as representing official policies,
+ * either expressed or implied, of the Shogun Development Team.
+ *
+ */
+
+#include <shogun/optimization/ParallelSGDMinimizer.h>
+#include <shogun/optimization/GradientDescendUpdater.h>
+#include <shogun/optimization/L1PenaltyForTG.h>
+#include <shogun/base/init.h>
+#include <shogun/base/Parallel.h>
+#include <shogun/lib/SGMatrix.h>
+#include <shogun/mathematics/Math.h>
+#include <shogun/lib/config.h>
+#include <vector>
+using namespace shogun;
+
+ParallelSGDMinimizer::ParallelSGDMinimizer()
+	:SGDMinimizer()
+{
+	init();
+}
+
+ParallelSGDMinimizer::~ParallelSGDMinimizer()
+{
+}
+
+ParallelSGDMinimizer::ParallelSGDMinimizer(FirstOrderParallelStochasticCostFunction *fun)
+	:SGDMinimizer(fun)
+{
+	init();
+}
+
+float64_t ParallelSGDMinimizer::minimize()
+{
+	init_minimization();
+
+	SGVector<float64_t> variable_reference=m_fun->obtain_variable_reference();
+	FirstOrderParallelStochasticCostFunction *fun=
+		dynamic_cast<FirstOrderParallelStochasticCostFunction *>(m_fun);
+	REQUIRE(fun,"the cost function must be a parallel stochastic cost function\n");
+	for(;m_cur_passes<m_num_passes;m_cur_passes++)
+	{
+		if(m_update_type==PSGD_HOGWILD)
+			do_hogwild_pass(fun,variable_reference);
+		else
+			do_synchronous_pass(fun,variable_reference);
+	}
+	float64_t cost=m_fun->get_cost();
+	return cost+get_penalty(variable_reference);
+}
+
+void ParallelSGDMinimizer::do_hogwild_pass(FirstOrderParallelStochasticCostFunction* fun,
+	SGVector<float64_t> variable_reference)
+{
+	index_t num_samples=fun->get_sample_size();
+	index_t num_variables=variable_reference.vlen;
+	index_t mini_batch_size=get_mini_batch_size();
+	index_t num_batches=(num_samples+mini_batch_size-1)/mini_batch_size;
+	float64_t* w=variable_reference.vector;
+
+	/* soft-thresholding twice equals soft-thresholding once with the sum of
+	 * both weights, so stateless sparse penalties are applied lazily: a
+	 * coordinate catches up on the penalty accumulated since it was last
+	 * touched, the rest of them at the end of the pass */
+	SparsePenalty* lazy_penalty=get_lazy_penalty();
+	float64_t cumulative_penalty=0.0;
+	SGVector<float64_t> applied_penalty;
+	if(lazy_penalty)
+	{
+		applied_penalty=SGVector<float64_t>(num_variables);
+		applied_penalty.zero();
+	}
+
+#pragma omp parallel num_threads(m_num_threads)
+	{
+		/* sum of the sample gradients of a mini-batch and its non-zero entries */
+		SGVector<float64_t> grad(num_variables);
+		grad.zero();
+		std::vector<index_t> touched;
+		std::vector<bool> is_touched(num_variables, false);
+
+#pragma omp for schedule(static)
+		for(index_t batch=0; batch<num_batches; batch++)
+		{
+			int32_t iter_counter;
+#pragma omp atomic capture
+			iter_counter=++m_iter_counter;
+
+			float64_t learning_rate=1.0;
+			if(m_learning_rate)
+				learning_rate=m_learning_rate->get_learning_rate(iter_counter);
+
+			index_t start=batch*mini_batch_size;
+			index_t end=CMath::min(start+mini_batch_size, num_samples);
+			for(index_t i=start; i<end; i++)
+			{
+				SGSparseVector<float64_t> sample_grad=
+					fun->get_sparse_sample_gradient(i,variable_reference);
+				for(index_t k=0; k<sample_grad.num_feat_entries; k++)
+				{
+					index_t idx=sample_grad.features[k].feat_index;
+					if(!is_touched[idx])
+					{
+						is_touched[idx]=true;
+						touched.push_back(idx);
+					}
+					grad[idx]+=sample_grad.features[k].entry;
+				}
+			}
+			float64_t scale=1.0/(end-start);
+
+			/* coordinates are written without locking, see Niu et al. (2011),
+			 * penalty gradients are only added to the touched ones */
+			for(size_t k=0; k<touched.size(); k++)
+			{
+				index_t idx=touched[k];
+				float64_t g=scale*grad[idx];
+				if(m_penalty_type)
+					g+=m_penalty_weight*m_penalty_type->get_penalty_gradient(w[idx],g);
+				w[idx]-=learning_rate*g;
+				grad[idx]=0.0;
+				is_touched[idx]=false;
+			}
+
+			if(lazy_penalty)
+			{
+				float64_t total_penalty;
+#pragma omp atomic capture
+				total_penalty=cumulative_penalty+=learning_rate*m_penalty_weight;
+
+				for(size_t k=0; k<touched.size(); k++)
+				{
+					index_t idx=touched[k];
+					float64_t pending=total_penalty-applied_penalty[idx];
+					if(pending>0.0)
+					{
+						w[idx]=lazy_penalty->get_sparse_variable(w[idx],pending);
+						applied_penalty[idx]=total_penalty;
+					}
+				}
+			}
+			else
+				do_hogwild_proximal_operation(variable_reference,learning_rate);
+
+			touched.clear();
+		}
+	}
+
+	if(lazy_penalty)
+	{
+		for(index_t idx=0; idx<num_variables; idx++)
+		{
+			float64_t pending=cumulative_penalty-applied_penalty[idx];
+			if(pending>0.0)
+				w[idx]=lazy_penalty->get_sparse_variable(w[idx],pending);
+		}
+	}
+}
+
+SparsePenalty* ParallelSGDMinimizer::get_lazy_penalty()
+{
+	/* the truncated gradient keeps a state per coordinate and update */
+	if(dynamic_cast<L1PenaltyForTG*>(m_penalty_type))
+		return NULL;
+	return dynamic_cast<SparsePenalty*>(m_penalty_type);
+}
+
+void ParallelSGDMinimizer::do_hogwild_proximal_operation(SGVector<float64_t> variable_reference,
+	float64_t learning_rate)
+{
+	ProximalPenalty* proximal_penalty=dynamic_cast<ProximalPenalty*>(m_penalty_type);
+	if(!proximal_penalty)
+		return;
+
+	float64_t proximal_weight=m_penalty_weight;
+	if(dynamic_cast<SparsePenalty*>(m_penalty_type))
+		proximal_weight*=learning_rate;
+
+	/* such penalties keep a state, eg, L1PenaltyForTG */
+#pragma omp critical
+	proximal_penalty->update_variable_for_proximity(variable_reference,proximal_weight);
+}
+
+void ParallelSGDMinimizer::do_synchronous_pass(FirstOrderParallelStochasticCostFunction* fun,
+	SGVector<float64_t> variable_reference)
+{
+	index_t num_samples=fun->get_sample_size();
+	index_t num_variables=variable_reference.vlen;
+	index_t mini_batch_size=get_mini_batch_size();
+	SGMatrix<float64_t> sample_gradients(num_variables, mini_batch_size);
+
+	for(index_t start=0; start<num_samples; start+=mini_batch_size)
+	{
+		index_t end=CMath::min(start+mini_batch_size, num_samples);
+
+#pragma omp parallel for num_threads(m_num_threads)
+		for(index_t i=start; i<end; i++)
+		{
+			SGVector<float64_t> grad=fun->get_sample_gradient(i,variable_reference);
+			memcpy(sample_gradients.get_column_vector(i-start), grad.vector,
+				sizeof(float64_t)*num_variables);
+		}
+
+		/* sum in sample order so that the update does not depend on threads */
+		SGVector<float64_t> grad(num_variables);
+		grad.zero();
+		for(index_t i=0; i<end-start; i++)
+		{
+			float64_t* col=sample_gradients.get_column_vector(i);
+			for(index_t idx=0; idx<num_variables; idx++)
+				grad[idx]+=col[idx];
+		}
+		grad.scale(1.0/(end-start));
+
+		m_iter_counter++;
+		float64_t learning_rate=1.0;
+		if(m_learning_rate)
+			learning_rate=m_learning_rate->get_learning_rate(m_iter_counter);
+		update_gradient(grad,variable_reference);
+		m_gradient_updater->update_variable(variable_reference,grad,learning_rate);
+
+		do_proximal_operation(variable_reference);
+	}
+}
+
+void ParallelSGDMinimizer::init()
+{
+	m_update_type=PSGD_HOGWILD;
+	m_mini_batch_size=0;
+	m_num_threads=1;
+	Parallel* parallel=get_global_parallel();
+	if(parallel)
+		m_num_threads=parallel->get_num_threads();
+	SG_UNREF(parallel);
+}
+
+void ParallelSGDMinimizer::init_minimization()
+{
+	SGDMinimizer::init_minimization();
+	if(m_update_type==PSGD_HOGWILD)
+	{
+		GradientDescendUpdater* updater=dynamic_cast<GradientDescendUpdater*>(m_gradient_updater);
+		REQUIRE(updater && !updater->enables_descend_correction(),
+			"Hogwild updates require a GradientDescendUpdater without descend correction. "
+			"Use PSGD_SYNCHRONOUS for other descend updaters\n");
+		REQUIRE(!dynamic_cast<SparsePenalty*>(m_penalty_type) || m_learning_rate,
+			"Learning rate must set when Sparse Penalty (eg, L1) is used\n");
+		REQUIRE(!m_penalty_type || m_penalty_weight>0,
+			"The weight of penalty must be set first\n");
+	}
+}
@@ -0,0 +1,214 @@
+/*
+ * Copyright (c) The Shogun Machine Learning Toolbox
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation are those
+ * of the authors and should not be interpreted as representing official policies,
+ * either expressed or implied, of the Shogun Development Team.
+ *
+ */
+
+
+#ifndef PARALLELSGDMINIMIZER_H
+#define PARALLELSGDMINIMIZER_H
+#include <shogun/optimization/SGDMinimizer.h>
+#include <shogun/optimization/FirstOrderParallelStochasticCostFunction.h>
+
+namespace shogun
+{
+
+/** the way ParallelSGDMinimizer applies sample gradients */
+enum EParallelSGDUpdate
+{
+	/** lock-free asynchronous updates of the shared variables (Hogwild!) */
+	PSGD_HOGWILD=0,
+	/** deterministic synchronous averaging of mini-batch gradients */
+	PSGD_SYNCHRONOUS=10
+};
+
+/** @brief The class implements a multi-threaded stochastic gradient descend (SGD) minimizer.
+ *
+ * Two update schemes are supported (see EParallelSGDUpdate):
+ *
+ * PSGD_HOGWILD: mini-batches of a pass (one sample each by default) are
+ * split across threads and every thread subtracts the scaled mean gradient
+ * of its mini-batch from the shared target variables without locking. Sample
+ * gradients are obtained with
+ * FirstOrderParallelStochasticCostFunction::get_sparse_sample_gradient and
+ * only their non-zero entries are written, so threads rarely touch the same
+ * coordinates when the model is sparse. Penalty gradients (eg, L2Penalty)
+ * are only added to these coordinates. The descend updater must be a
+ * GradientDescendUpdater without descend correction since the update has to
+ * be stateless. Sparse penalties (eg, L1Penalty) are applied lazily: an
+ * update soft-thresholds the coordinates it touches by the penalty
+ * accumulated since they were last touched, and all others catch up at the
+ * end of the pass. When every update touches all coordinates, this is the
+ * per-update proximal operation of SGDMinimizer, otherwise sample gradients
+ * may see coordinates whose penalty is still pending, like with the
+ * cumulative penalty of Tsuruoka et al. (2009). Proximal penalties
+ * with a state (eg, L1PenaltyForTG) are applied to all coordinates after
+ * every update, serialized between threads.
+ *
+ * Niu, Feng, et al. "Hogwild!: A lock-free approach to parallelizing
+ * stochastic gradient descent." Advances in Neural Information Processing
+ * Systems. 2011.
+ *
+ * PSGD_SYNCHRONOUS: sample gradients of a mini-batch are computed in
+ * parallel, averaged in sample order and passed to the descend updater.
+ * The result does not depend on the number of threads, and any
+ * DescendUpdater and LearningRate can be used.
+ *
+ * The cost function must be a FirstOrderParallelStochasticCostFunction.
+ */
+class ParallelSGDMinimizer: public SGDMinimizer
+{
+public:
+	/** Default constructor */
+	ParallelSGDMinimizer();
+
+	/** Constructor
+	 * @param fun parallel stochastic cost function
+	 */
+	ParallelSGDMinimizer(FirstOrderParallelStochasticCostFunction *fun);
+
+	/** Destructor */
+	virtual ~ParallelSGDMinimizer();
+
+	/** Does minimizer support batch update
+	 *
+	 * @return whether minimizer supports batch update
+	 */
+	virtual bool supports_batch_update() const {return true;}
+
+	/** Do minimization and get the optimal value
+	 *
+	 * @return optimal value
+	 */
+	virtual float64_t minimize();
+
+	/** Set the update scheme
+	 *
+	 * @param update_type PSGD_HOGWILD or PSGD_SYNCHRONOUS
+	 */
+	virtual void set_update_type(EParallelSGDUpdate update_type)
+	{
+		m_update_type=update_type;
+	}
+
+	/** Get the update scheme
+	 *
+	 * @return the update scheme
+	 */
+	virtual EParallelSGDUpdate get_update_type() const {return m_update_type;}
+
+	/** Set the number of samples per mini-batch. If not set, a mini-batch
+	 * is one sample for PSGD_HOGWILD and 256 samples for PSGD_SYNCHRONOUS
+	 *
+	 * @param mini_batch_size the size of a mini-batch
+	 */
+	virtual void set_mini_batch_size(int32_t mini_batch_size)
+	{
+		REQUIRE(mini_batch_size>0, "The size of a mini-batch (%d) must be positive\n",
+			mini_batch_size);
+		m_mini_batch_size=mini_batch_size;
+	}
+
+	/** Get the number of samples per mini-batch
+	 *
+	 * @return the size of a mini-batch
+	 */
+	virtual int32_t get_mini_batch_size() const
+	{
+		if(m_mini_batch_size>0)
+			return m_mini_batch_size;
+		return m_update_type==PSGD_HOGWILD ? 1 : 256;
+	}
+
+	/** Set the number of threads
+	 *
+	 * @param num_threads the number of threads
+	 */
+	virtual void set_num_threads(int32_t num_threads)
+	{
+		REQUIRE(num_threads>0, "The number of threads (%d) must be positive\n",
+			num_threads);
+		m_num_threads=num_threads;
+	}
+
+	/** Get the number of threads
+	 *
+	 * @return the number of threads
+	 */
+	virtual int32_t get_num_threads() const {return m_num_threads;}
+
+protected:
+	/*  init the minimization process */
+	virtual void init_minimization();
+
+	/** Do one pass with lock-free asynchronous updates
+	 *
+	 * @param fun cost function
+	 * @param variable_reference variables to be updated
+	 */
+	virtual void do_hogwild_pass(FirstOrderParallelStochasticCostFunction* fun,
+		SGVector<float64_t> variable_reference);
+
+	/** Get the penalty that Hogwild applies lazily
+	 *
+	 * @return the penalty if it is a stateless SparsePenalty, otherwise NULL
+	 */
+	virtual SparsePenalty* get_lazy_penalty();
+
+	/** Do the proximal operation of penalties that are not applied lazily
+	 * after a Hogwild update
+	 *
+	 * @param variable_reference variables to be updated
+	 * @param learning_rate learning rate of the update
+	 */
+	virtual void do_hogwild_proximal_operation(SGVector<float64_t> variable_reference,
+		float64_t learning_rate);
+
+	/** Do one pass with synchronous mini-batch updates
+	 *
+	 * @param fun cost function
+	 * @param variable_reference variables to be updated
+	 */
+	virtual void do_synchronous_pass(FirstOrderParallelStochasticCostFunction* fun,
+		SGVector<float64_t> variable_reference);
+
+	/** update scheme */
+	EParallelSGDUpdate m_update_type;
+
+	/** size of a mini-batch, 0 for the default of the update scheme */
+	int32_t m_mini_batch_size;
+
+	/** number of threads */
+	int32_t m_num_threads;
+
+private:
+	  /* Init */
+	void init();
+};
+
+}
+#endif /* PARALLELSGDMINIMIZER_H */
@@ -6,6 +6,7 @@
 #include <shogun/lib/config.h>
 #include <shogun/lib/Signal.h>
 #include <shogun/lib/Time.h>
+#include <shogun/lib/Tracing.h>
 
 #include <shogun/mathematics/lapack.h>
 #include <shogun/mathematics/Math.h>
@@ -71,6 +72,8 @@ CTron::~CTron()
 
 void CTron::tron(float64_t *w, float64_t max_train_time)
 {
+	SG_TRACE_SCOPE("CTron::tron");
+
 	// Parameters for updating the iterates.
 	float64_t eta0 = 1e-4, eta1 = 0.25, eta2 = 0.75;
 
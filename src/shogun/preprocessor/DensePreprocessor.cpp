@@ -7,6 +7,20 @@ CDensePreprocessor<ST>::CDensePreprocessor() : CPreprocessor()
 {
 }
 
+template <class ST>
+bool CDensePreprocessor<ST>::apply_in_place(SGVector<ST> vector)
+{
+	return false;
+}
+
+template <class ST>
+bool CDensePreprocessor<ST>::get_affine_map(int32_t num_features,
+		SGVector<int32_t>& idx, SGVector<float64_t>& scale,
+		SGVector<float64_t>& shift)
+{
+	return false;
+}
+
 template<> EFeatureType CDensePreprocessor<floatmax_t>::get_feature_type()
 {
 	return F_LONGREAL;
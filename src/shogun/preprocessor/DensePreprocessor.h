@@ -54,6 +54,31 @@ template <class ST> class CDensePreprocessor : public CPreprocessor
 		/// result in feature matrix
 		virtual SGVector<ST> apply_to_feature_vector(SGVector<ST> vector)=0;
 
+		/** apply preproc in place on a single feature vector whose length it
+		 * does not change, without allocating a result
+		 *
+		 * @param vector vector to be preprocessed
+		 * @return false if the preprocessor can not be applied in place, in
+		 * which case vector is unchanged and apply_to_feature_vector() has to
+		 * be used
+		 */
+		virtual bool apply_in_place(SGVector<ST> vector);
+
+		/** describe the preprocessor as an affine map, which turns a vector x
+		 * into the vector with the elements x[idx[i]]*scale[i]+shift[i]
+		 *
+		 * Affine preprocessors are merged into a single pass by
+		 * CFusedPreprocessor.
+		 *
+		 * @param num_features dimension of the input vectors
+		 * @param idx input element of each output element
+		 * @param scale factor of each output element
+		 * @param shift offset of each output element
+		 * @return false if the preprocessor is not affine (or not initialized)
+		 */
+		virtual bool get_affine_map(int32_t num_features, SGVector<int32_t>& idx,
+				SGVector<float64_t>& scale, SGVector<float64_t>& shift);
+
 		/// return that we are dense features (just fixed size matrices)
 		virtual EFeatureClass get_feature_class();
 		/// return feature type
@@ -0,0 +1,309 @@
+/*
+ * Copyright (c) The Shogun Machine Learning Toolbox
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation are those
+ * of the authors and should not be interpreted as representing official policies,
+ * either expressed or implied, of the Shogun Development Team.
+ *
+ */
+
+#include <shogun/preprocessor/FusedPreprocessor.h>
+#include <shogun/features/DenseFeatures.h>
+#include <shogun/base/Parallel.h>
+#include <shogun/mathematics/Math.h>
+
+using namespace shogun;
+
+/** number of vectors preprocessed at once */
+static const int32_t FUSED_BLOCK_SIZE=128;
+
+CFusedPreprocessor::CFusedPreprocessor() : CDensePreprocessor<float64_t>()
+{
+	init();
+}
+
+CFusedPreprocessor::~CFusedPreprocessor()
+{
+	SG_UNREF(m_preprocessors);
+}
+
+void CFusedPreprocessor::init()
+{
+	m_preprocessors=new CDynamicObjectArray();
+	SG_REF(m_preprocessors);
+	m_compiled_features=-1;
+	m_max_features=0;
+
+	SG_ADD((CSGObject**) &m_preprocessors, "preprocessors",
+		"Preprocessors of the chain", MS_NOT_AVAILABLE);
+}
+
+void CFusedPreprocessor::add_preprocessor(CDensePreprocessor<float64_t>* preproc)
+{
+	REQUIRE(preproc, "Preprocessor must not be NULL\n");
+	m_preprocessors->append_element(preproc);
+	m_compiled_features=-1;
+}
+
+int32_t CFusedPreprocessor::get_num_preprocessors() const
+{
+	return m_preprocessors->get_num_elements();
+}
+
+bool CFusedPreprocessor::init(CFeatures* features)
+{
+	REQUIRE(features->get_feature_class()==C_DENSE, "Dense features expected\n");
+	REQUIRE(features->get_feature_type()==F_DREAL, "float64_t features expected\n");
+
+	CDenseFeatures<float64_t>* dense=(CDenseFeatures<float64_t>*) features;
+	int32_t num_features=dense->get_num_features();
+	int32_t num=get_num_preprocessors();
+
+	// every preprocessor is fit to the output of the previous ones, which are
+	// computed on a copy of the features
+	CDenseFeatures<float64_t>* current=NULL;
+	if (num>1)
+	{
+		current=new CDenseFeatures<float64_t>(dense->get_feature_matrix().clone());
+		SG_REF(current);
+	}
+
+	for (int32_t i=0; i<num; i++)
+	{
+		CDensePreprocessor<float64_t>* p=
+			(CDensePreprocessor<float64_t>*) m_preprocessors->get_element(i);
+		p->init(current ? current : dense);
+		if (i<num-1)
+			p->apply_to_feature_matrix(current);
+		SG_UNREF(p);
+	}
+	SG_UNREF(current);
+
+	compile(num_features);
+	return true;
+}
+
+void CFusedPreprocessor::cleanup()
+{
+	for (int32_t i=0; i<get_num_preprocessors(); i++)
+	{
+		CPreprocessor* p=(CPreprocessor*) m_preprocessors->get_element(i);
+		p->cleanup();
+		SG_UNREF(p);
+	}
+	m_stages.clear();
+	m_compiled_features=-1;
+}
+
+void CFusedPreprocessor::compile(int32_t num_features)
+{
+	m_stages.clear();
+	m_max_features=num_features;
+
+	int32_t dim=num_features;
+	for (int32_t i=0; i<get_num_preprocessors(); i++)
+	{
+		CDensePreprocessor<float64_t>* p=
+			(CDensePreprocessor<float64_t>*) m_preprocessors->get_element(i);
+
+		FusedStage stage;
+		stage.preproc=NULL;
+		stage.in_place=false;
+		if (p->get_affine_map(dim, stage.idx, stage.scale, stage.shift))
+		{
+			REQUIRE(stage.idx.vlen==stage.scale.vlen && stage.idx.vlen==stage.shift.vlen,
+				"Inconsistent affine map of %s\n", p->get_name());
+			stage.num_out=stage.idx.vlen;
+
+			if (!m_stages.empty() && m_stages.back().preproc==NULL)
+			{
+				// compose with the previous affine map
+				FusedStage& prev=m_stages.back();
+				for (int32_t j=0; j<stage.num_out; j++)
+				{
+					int32_t k=stage.idx[j];
+					stage.idx[j]=prev.idx[k];
+					stage.shift[j]+=stage.scale[j]*prev.shift[k];
+					stage.scale[j]*=prev.scale[k];
+				}
+				prev=stage;
+			}
+			else
+				m_stages.push_back(stage);
+		}
+		else
+		{
+			// find out how the preprocessor applies by trying it on zeros
+			SGVector<float64_t> probe(dim);
+			probe.zero();
+			stage.preproc=p;
+			stage.in_place=p->apply_in_place(probe);
+			if (stage.in_place)
+				stage.num_out=dim;
+			else
+			{
+				probe.zero();
+				stage.num_out=p->apply_to_feature_vector(probe).vlen;
+			}
+			m_stages.push_back(stage);
+		}
+
+		dim=stage.num_out;
+		m_max_features=CMath::max(m_max_features, dim);
+		SG_UNREF(p);
+	}
+
+	m_compiled_features=num_features;
+}
+
+void CFusedPreprocessor::ensure_compiled(int32_t num_features)
+{
+	if (m_compiled_features==num_features)
+		return;
+
+	m_lock.lock();
+	if (m_compiled_features!=num_features)
+		compile(num_features);
+	m_lock.unlock();
+}
+
+float64_t* CFusedPreprocessor::apply_stages(float64_t* input,
+		int32_t num_features, int32_t num_vectors, SGVector<float64_t>& buffer,
+		SGVector<float64_t>& other, int32_t& dim)
+{
+	float64_t* current=input;
+	dim=num_features;
+
+	for (size_t s=0; s<m_stages.size(); s++)
+	{
+		const FusedStage& stage=m_stages[s];
+		int64_t num_out=int64_t(stage.num_out)*num_vectors;
+
+		if (stage.in_place)
+		{
+			if (current==input)
+			{
+				if (buffer.vlen<num_out)
+					buffer=SGVector<float64_t>(num_out);
+				memcpy(buffer.vector, input, sizeof(float64_t)*num_out);
+				current=buffer.vector;
+			}
+
+			for (int32_t j=0; j<num_vectors; j++)
+			{
+				stage.preproc->apply_in_place(
+					SGVector<float64_t>(current+int64_t(j)*dim, dim, false));
+			}
+			continue;
+		}
+
+		SGVector<float64_t>& target=(current==buffer.vector) ? other : buffer;
+		if (target.vlen<num_out)
+			target=SGVector<float64_t>(num_out);
+
+		if (stage.preproc)
+		{
+			for (int32_t j=0; j<num_vectors; j++)
+			{
+				SGVector<float64_t> out=stage.preproc->apply_to_feature_vector(
+					SGVector<float64_t>(current+int64_t(j)*dim, dim, false));
+				memcpy(target.vector+int64_t(j)*stage.num_out, out.vector,
+					sizeof(float64_t)*stage.num_out);
+			}
+		}
+		else
+		{
+			const int32_t* idx=stage.idx.vector;
+			const float64_t* scale=stage.scale.vector;
+			const float64_t* shift=stage.shift.vector;
+			for (int32_t j=0; j<num_vectors; j++)
+			{
+				const float64_t* x=current+int64_t(j)*dim;
+				float64_t* y=target.vector+int64_t(j)*stage.num_out;
+				for (int32_t i=0; i<stage.num_out; i++)
+					y[i]=x[idx[i]]*scale[i]+shift[i];
+			}
+		}
+
+		current=target.vector;
+		dim=stage.num_out;
+	}
+
+	return current;
+}
+
+SGMatrix<float64_t> CFusedPreprocessor::apply_to_feature_matrix(CFeatures* features)
+{
+	REQUIRE(features->get_feature_class()==C_DENSE, "Dense features expected\n");
+	REQUIRE(features->get_feature_type()==F_DREAL, "float64_t features expected\n");
+
+	CDenseFeatures<float64_t>* dense=(CDenseFeatures<float64_t>*) features;
+	SGMatrix<float64_t> matrix=dense->get_feature_matrix();
+	int32_t num_features=matrix.num_rows;
+	int32_t num_vectors=matrix.num_cols;
+
+	ensure_compiled(num_features);
+	int32_t num_out=m_stages.empty() ? num_features : m_stages.back().num_out;
+	int32_t num_blocks=(num_vectors+FUSED_BLOCK_SIZE-1)/FUSED_BLOCK_SIZE;
+
+	SGMatrix<float64_t> result(num_out, num_vectors);
+
+	#pragma omp parallel num_threads(parallel->get_num_threads())
+	{
+		SGVector<float64_t> buffer(int64_t(m_max_features)*FUSED_BLOCK_SIZE);
+		SGVector<float64_t> other;
+
+		#pragma omp for schedule(dynamic)
+		for (int32_t k=0; k<num_blocks; k++)
+		{
+			int32_t first=k*FUSED_BLOCK_SIZE;
+			int32_t n=CMath::min(FUSED_BLOCK_SIZE, num_vectors-first);
+			int32_t dim;
+			float64_t* out=apply_stages(matrix.get_column_vector(first),
+				num_features, n, buffer, other, dim);
+			memcpy(result.get_column_vector(first), out,
+				sizeof(float64_t)*int64_t(dim)*n);
+		}
+	}
+
+	dense->set_feature_matrix(result);
+	return result;
+}
+
+SGVector<float64_t> CFusedPreprocessor::apply_to_feature_vector(SGVector<float64_t> vector)
+{
+	ensure_compiled(vector.vlen);
+
+	SGVector<float64_t> buffer(m_max_features);
+	SGVector<float64_t> other;
+	int32_t dim;
+	float64_t* out=apply_stages(vector.vector, vector.vlen, 1, buffer, other, dim);
+
+	if (out==buffer.vector && dim==buffer.vlen)
+		return buffer;
+
+	SGVector<float64_t> result(dim);
+	memcpy(result.vector, out, sizeof(float64_t)*dim);
+	return result;
+}
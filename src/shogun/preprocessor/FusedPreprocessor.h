@@ -0,0 +1,162 @@
+/*
+ * Copyright (c) The Shogun Machine Learning Toolbox
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation are those
+ * of the authors and should not be interpreted as representing official policies,
+ * either expressed or implied, of the Shogun Development Team.
+ *
+ */
+
+#ifndef _FUSEDPREPROCESSOR__H__
+#define _FUSEDPREPROCESSOR__H__
+
+#include <shogun/lib/config.h>
+
+#include <shogun/preprocessor/DensePreprocessor.h>
+#include <shogun/lib/DynamicObjectArray.h>
+#include <shogun/lib/Lock.h>
+
+#include <vector>
+
+namespace shogun
+{
+
+/** @brief Preprocessor that applies a chain of dense preprocessors in a single
+ * pass over blocks of vectors.
+ *
+ * Consecutive preprocessors that describe themselves as affine maps (see
+ * CDensePreprocessor::get_affine_map(), e.g. CPruneVarSubMean and
+ * CRescaleFeatures) are composed into one affine map, preprocessors that can
+ * be applied in place (e.g. CNormOne, CLogPlusOne) work on the block buffer,
+ * and all others are applied vector by vector through
+ * apply_to_feature_vector(). Blocks of vectors are processed in parallel and
+ * no memory is allocated per vector.
+ *
+ * The composed maps are a snapshot of the preprocessors, init() or
+ * add_preprocessor() take a new one.
+ */
+class CFusedPreprocessor : public CDensePreprocessor<float64_t>
+{
+	public:
+		/** default constructor */
+		CFusedPreprocessor();
+
+		/** destructor */
+		virtual ~CFusedPreprocessor();
+
+		/** append a preprocessor to the chain
+		 *
+		 * @param preproc preprocessor applied after the previously added ones
+		 */
+		void add_preprocessor(CDensePreprocessor<float64_t>* preproc);
+
+		/** @return number of preprocessors in the chain */
+		int32_t get_num_preprocessors() const;
+
+		/** initialize the preprocessors of the chain in order, each on the
+		 * features preprocessed by the previous ones
+		 *
+		 * @param features dense float64_t features
+		 */
+		virtual bool init(CFeatures* features);
+
+		/// cleanup the preprocessors of the chain
+		virtual void cleanup();
+
+		/// apply the chain on the feature matrix, replacing it
+		virtual SGMatrix<float64_t> apply_to_feature_matrix(CFeatures* features);
+
+		/// apply the chain on a single feature vector
+		virtual SGVector<float64_t> apply_to_feature_vector(SGVector<float64_t> vector);
+
+		/** @return object name */
+		virtual const char* get_name() const { return "FusedPreprocessor"; }
+
+		/// return a type of preprocessor
+		virtual EPreprocessorType get_type() const { return P_FUSED; }
+
+	private:
+		void init();
+
+		/** compose the preprocessors into stages for input vectors of the
+		 * given dimension
+		 *
+		 * @param num_features dimension of the input vectors
+		 */
+		void compile(int32_t num_features);
+
+		/** compose the stages unless they are for the given dimension */
+		void ensure_compiled(int32_t num_features);
+
+		/** apply the stages to a block of vectors
+		 *
+		 * @param input input vectors in the columns, not modified
+		 * @param num_features dimension of the input vectors
+		 * @param num_vectors number of vectors
+		 * @param buffer scratch buffer, grown as needed
+		 * @param other second scratch buffer, grown as needed
+		 * @param dim dimension of the output vectors
+		 * @return output vectors, in one of the buffers or input
+		 */
+		float64_t* apply_stages(float64_t* input, int32_t num_features,
+				int32_t num_vectors, SGVector<float64_t>& buffer,
+				SGVector<float64_t>& other, int32_t& dim);
+
+	private:
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+		/** step of the fused chain */
+		struct FusedStage
+		{
+			/** preprocessor applied per vector, NULL for an affine stage */
+			CDensePreprocessor<float64_t>* preproc;
+			/** whether preproc is applied in place */
+			bool in_place;
+			/** dimension of the output vectors */
+			int32_t num_out;
+			/** input element of each output element of an affine stage */
+			SGVector<int32_t> idx;
+			/** factor of each output element of an affine stage */
+			SGVector<float64_t> scale;
+			/** offset of each output element of an affine stage */
+			SGVector<float64_t> shift;
+		};
+#endif
+
+		/** preprocessors of the chain */
+		CDynamicObjectArray* m_preprocessors;
+
+		/** composed stages */
+		std::vector<FusedStage> m_stages;
+
+		/** input dimension the stages were composed for, -1 if none */
+		int32_t m_compiled_features;
+
+		/** largest dimension of the vectors between the stages */
+		int32_t m_max_features;
+
+		/** lock for composing the stages */
+		CLock m_lock;
+};
+}
+#endif
@@ -22,8 +22,10 @@
 #include <shogun/preprocessor/DimensionReductionPreprocessor.h>
 #include <shogun/features/Features.h>
 #include <shogun/io/SGIO.h>
+#include <shogun/mathematics/eigen3.h>
 
 using namespace shogun;
+using namespace Eigen;
 
 CKernelPCA::CKernelPCA() : CDimensionReductionPreprocessor()
 {
@@ -42,11 +44,27 @@ void CKernelPCA::init()
 	m_init_features = NULL;
 	m_transformation_matrix = SGMatrix<float64_t>();
 	m_bias_vector = SGVector<float64_t>();
+	m_approximation = NULL;
 
 	SG_ADD(&m_transformation_matrix, "transformation_matrix",
 		"matrix used to transform data", MS_NOT_AVAILABLE);
 	SG_ADD(&m_bias_vector, "bias_vector",
 		"bias vector used to transform data", MS_NOT_AVAILABLE);
+	SG_ADD((CSGObject**)&m_approximation, "approximation",
+		"Nystrom approximation of kernel matrix", MS_NOT_AVAILABLE);
+}
+
+void CKernelPCA::set_approximation(CNystromApproximation* approximation)
+{
+	SG_REF(approximation);
+	SG_UNREF(m_approximation);
+	m_approximation = approximation;
+}
+
+CNystromApproximation* CKernelPCA::get_approximation() const
+{
+	SG_REF(m_approximation);
+	return m_approximation;
 }
 
 void CKernelPCA::cleanup()
@@ -64,6 +82,7 @@ CKernelPCA::~CKernelPCA()
 {
 	if (m_init_features)
 		SG_UNREF(m_init_features);
+	SG_UNREF(m_approximation);
 }
 
 bool CKernelPCA::init(CFeatures* features)
@@ -73,6 +92,9 @@ bool CKernelPCA::init(CFeatures* features)
 		SG_REF(features);
 		m_init_features = features;
 
+		if (m_approximation)
+			return init_with_approximation(features);
+
 		m_kernel->init(features,features);
 		SGMatrix<float64_t> kernel_matrix = m_kernel->get_kernel_matrix();
 		m_kernel->cleanup();
@@ -125,12 +147,69 @@ bool CKernelPCA::init(CFeatures* features)
 	return false;
 }
 
+bool CKernelPCA::init_with_approximation(CFeatures* features)
+{
+	m_approximation->set_kernel(m_kernel);
+	m_approximation->compute(features);
+	m_kernel->cleanup();
+
+	SGMatrix<float64_t> factor = m_approximation->get_factor();
+	int32_t n = factor.num_rows;
+	int32_t rank = factor.num_cols;
+	REQUIRE(m_target_dim<=rank, "Target dimension (%d) exceeds rank of "
+		"Nystrom approximation (%d)\n", m_target_dim, rank)
+
+	// PCA of the centered explicit feature map given by the factor rows
+	Map<MatrixXd> eigen_factor(factor.matrix, n, rank);
+	VectorXd mean = eigen_factor.colwise().sum().transpose()/n;
+	MatrixXd centered = eigen_factor.rowwise()-mean.transpose();
+	MatrixXd covariance = centered.transpose()*centered;
+
+	SelfAdjointEigenSolver<MatrixXd> solver(covariance);
+
+	m_transformation_matrix = SGMatrix<float64_t>(rank, m_target_dim);
+	Map<MatrixXd> transformation(m_transformation_matrix.matrix, rank, m_target_dim);
+	for (int32_t k=0; k<m_target_dim; k++)
+		transformation.col(k) = solver.eigenvectors().col(rank-k-1);
+
+	m_bias_vector = SGVector<float64_t>(m_target_dim);
+	Map<VectorXd> bias(m_bias_vector.vector, m_target_dim);
+	bias = -transformation.transpose()*mean;
+
+	m_initialized=true;
+	SG_INFO("Done\n")
+	return true;
+}
+
+SGMatrix<float64_t> CKernelPCA::apply_with_approximation(CFeatures* features)
+{
+	SGMatrix<float64_t> factor = m_approximation->compute_factor(features);
+	m_kernel->cleanup();
+
+	int32_t num_vectors = factor.num_rows;
+	Map<MatrixXd> eigen_factor(factor.matrix, num_vectors, factor.num_cols);
+	Map<MatrixXd> transformation(m_transformation_matrix.matrix,
+			m_transformation_matrix.num_rows, m_transformation_matrix.num_cols);
+	Map<VectorXd> bias(m_bias_vector.vector, m_bias_vector.vlen);
+
+	SGMatrix<float64_t> result(m_target_dim, num_vectors);
+	Map<MatrixXd> eigen_result(result.matrix, m_target_dim, num_vectors);
+	eigen_result = (transformation.transpose()*eigen_factor.transpose()).colwise()+bias;
+
+	return result;
+}
 
 SGMatrix<float64_t> CKernelPCA::apply_to_feature_matrix(CFeatures* features)
 {
 	ASSERT(m_initialized)
 	CDenseFeatures<float64_t>* simple_features = (CDenseFeatures<float64_t>*)features;
 
+	if (m_approximation)
+	{
+		simple_features->set_feature_matrix(apply_with_approximation(features));
+		return simple_features->get_feature_matrix();
+	}
+
 	int32_t num_vectors = simple_features->get_num_vectors();
 	int32_t i,j,k;
 	int32_t n = m_transformation_matrix.num_cols;
@@ -161,6 +240,17 @@ SGMatrix<float64_t> CKernelPCA::apply_to_feature_matrix(CFeatures* features)
 SGVector<float64_t> CKernelPCA::apply_to_feature_vector(SGVector<float64_t> vector)
 {
 	ASSERT(m_initialized)
+
+	if (m_approximation)
+	{
+		CDenseFeatures<float64_t>* vector_features = new CDenseFeatures<float64_t>(
+				SGMatrix<float64_t>(vector.vector,vector.vlen,1,false));
+		SG_REF(vector_features);
+		SGMatrix<float64_t> projected = apply_with_approximation(vector_features);
+		SG_UNREF(vector_features);
+		return SGVector<float64_t>(projected.matrix, m_target_dim, false).clone();
+	}
+
 	SGVector<float64_t> result = SGVector<float64_t>(m_target_dim);
 	m_kernel->init(new CDenseFeatures<float64_t>(SGMatrix<float64_t>(vector.vector,vector.vlen,1)),
 	               m_init_features);
@@ -187,6 +277,9 @@ CDenseFeatures<float64_t>* CKernelPCA::apply_to_string_features(CFeatures* featu
 {
 	ASSERT(m_initialized)
 
+	if (m_approximation)
+		return new CDenseFeatures<float64_t>(apply_with_approximation(features));
+
 	int32_t num_vectors = features->get_num_vectors();
 	int32_t i,j,k;
 	int32_t n = m_transformation_matrix.num_cols;
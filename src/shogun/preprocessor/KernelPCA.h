@@ -16,6 +16,7 @@
 #include <shogun/preprocessor/DimensionReductionPreprocessor.h>
 #include <shogun/features/Features.h>
 #include <shogun/kernel/Kernel.h>
+#include <shogun/kernel/NystromApproximation.h>
 #include <shogun/lib/common.h>
 
 namespace shogun
@@ -23,6 +24,7 @@ namespace shogun
 
 class CFeatures;
 class CKernel;
+class CNystromApproximation;
 
 /** @brief Preprocessor KernelPCA performs kernel principal component analysis
  *
@@ -31,6 +33,11 @@ class CKernel;
  * Advances in kernel methods support vector learning, 1327(3), 327-352. MIT Press.
  * Retrieved from http://citeseerx.ist.psu.edu/viewdoc/summary?doi=10.1.1.32.8744
  *
+ * If a CNystromApproximation is set, the kernel matrix is never formed:
+ * principal components are computed from the centered \f$n\times r\f$
+ * low-rank factor in \f$O(nm^2)\f$ and new vectors are projected with
+ * \f$m\f$ kernel evaluations against the landmarks only.
+ *
  */
 class CKernelPCA: public CDimensionReductionPreprocessor
 {
@@ -81,6 +88,19 @@ public:
 			return m_bias_vector;
 		}
 
+		/** set Nystrom approximation used instead of the full
+		 * kernel matrix, the kernel of this preprocessor is approximated
+		 *
+		 * @param approximation approximation or NULL to use the full
+		 * kernel matrix
+		 */
+		void set_approximation(CNystromApproximation* approximation);
+
+		/** @return Nystrom approximation or NULL if the full
+		 * kernel matrix is used
+		 */
+		CNystromApproximation* get_approximation() const;
+
 		/** @return object name */
 		virtual const char* get_name() const { return "KernelPCA"; }
 
@@ -92,6 +112,17 @@ public:
 		/** default init */
 		void init();
 
+		/** initialize from Nystrom approximation
+		 * @param features features
+		 */
+		bool init_with_approximation(CFeatures* features);
+
+		/** project features using Nystrom approximation
+		 * @param features features
+		 * @return projected features with target dim rows
+		 */
+		SGMatrix<float64_t> apply_with_approximation(CFeatures* features);
+
 	protected:
 
 		/** features used by init. needed for apply */
@@ -106,6 +137,9 @@ public:
 		/** true when already initialized */
 		bool m_initialized;
 
+		/** Nystrom approximation of kernel matrix */
+		CNystromApproximation* m_approximation;
+
 };
 }
 #endif
@@ -83,3 +83,11 @@ SGVector<float64_t> CLogPlusOne::apply_to_feature_vector(SGVector<float64_t> vec
 
 	return SGVector<float64_t>(log_vec,vector.vlen);
 }
+
+bool CLogPlusOne::apply_in_place(SGVector<float64_t> vector)
+{
+	for (int32_t i=0; i<vector.vlen; i++)
+		vector.vector[i]=CMath::log(vector.vector[i]+1.0);
+
+	return true;
+}
@@ -59,6 +59,9 @@ class CLogPlusOne : public CDensePreprocessor<float64_t>
 		/// result in feature matrix
 		virtual SGVector<float64_t> apply_to_feature_vector(SGVector<float64_t> vector);
 
+		/// apply preproc in place on single feature vector
+		virtual bool apply_in_place(SGVector<float64_t> vector);
+
 		/** @return object name */
 		virtual const char* get_name() const { return "LogPlusOne"; }
 
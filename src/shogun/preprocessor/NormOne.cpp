@@ -82,3 +82,13 @@ SGVector<float64_t> CNormOne::apply_to_feature_vector(SGVector<float64_t> vector
 
 	return SGVector<float64_t>(normed_vec,vector.vlen);
 }
+
+bool CNormOne::apply_in_place(SGVector<float64_t> vector)
+{
+	float64_t norm=CMath::sqrt(CMath::dot(vector.vector, vector.vector, vector.vlen));
+
+	for (int32_t i=0; i<vector.vlen; i++)
+		vector.vector[i]/=norm;
+
+	return true;
+}
@@ -16,6 +16,7 @@
 #include <shogun/mathematics/Math.h>
 #include <shogun/preprocessor/DensePreprocessor.h>
 #include <shogun/features/Features.h>
+#include <shogun/features/streaming/StreamingDenseFeatures.h>
 #include <shogun/io/SGIO.h>
 #include <shogun/mathematics/eigen3.h>
 
@@ -55,6 +56,9 @@ void CPCA::init()
 	m_mem_mode = MEM_REALLOCATE;
 	m_method = AUTO;
 	m_eigenvalue_zero_tolerance=1e-15;
+	m_block_size=1000;
+	m_oversampling=10;
+	m_power_iterations=2;
 
 	SG_ADD(&m_transformation_matrix, "transformation_matrix",
 	    "Transformation matrix (Eigenvectors of covariance matrix).",
@@ -74,6 +78,12 @@ void CPCA::init()
 		"Method used for PCA calculation", MS_NOT_AVAILABLE);
 	SG_ADD(&m_eigenvalue_zero_tolerance, "eigenvalue_zero_tolerance", "zero tolerance"
 	" for determining zero eigenvalues during whitening to avoid numerical issues", MS_NOT_AVAILABLE);
+	SG_ADD(&m_block_size, "block_size", "Number of vectors in each block of "
+	"incremental PCA", MS_NOT_AVAILABLE);
+	SG_ADD(&m_oversampling, "oversampling", "Number of additional random "
+	"directions of randomized SVD", MS_NOT_AVAILABLE);
+	SG_ADD(&m_power_iterations, "power_iterations", "Number of power iterations "
+	"of randomized SVD", MS_NOT_AVAILABLE);
 }
 
 CPCA::~CPCA()
@@ -84,6 +94,9 @@ bool CPCA::init(CFeatures* features)
 {
 	if (!m_initialized)
 	{
+		if (features->get_feature_class()==C_STREAMING_DENSE)
+			return init_incremental(features);
+
 		REQUIRE(features->get_feature_class()==C_DENSE, "PCA only works with dense features")
 		REQUIRE(features->get_feature_type()==F_DREAL, "PCA only works with real features")
 
@@ -189,6 +202,72 @@ bool CPCA::init(CFeatures* features)
 			}
 		}
 
+		else if (m_method == RANDOMIZED)
+		{
+			REQUIRE(m_mode==FIXED_NUMBER, "Randomized PCA only supports "
+				"FIXED_NUMBER mode\n")
+
+			num_dim = m_target_dim;
+			int32_t rank = CMath::min(num_dim+m_oversampling, max_dim_allowed);
+
+			SG_INFO("Computing randomized SVD of rank %d ... ", rank)
+			// sample range of data matrix
+			MatrixXd omega(num_vectors, rank);
+			for (int32_t j=0; j<rank; j++)
+			{
+				for (int32_t i=0; i<num_vectors; i++)
+					omega(i,j) = CMath::normal_random(0.0, 1.0);
+			}
+			MatrixXd range = fmatrix*omega;
+
+			// power iterations to sharpen the spectrum, re-orthonormalized
+			// each time to avoid loss of precision
+			for (int32_t q=0; q<m_power_iterations; q++)
+			{
+				HouseholderQR<MatrixXd> range_qr(range);
+				range = range_qr.householderQ()*MatrixXd::Identity(num_features, rank);
+				MatrixXd corange = fmatrix.transpose()*range;
+				HouseholderQR<MatrixXd> corange_qr(corange);
+				corange = corange_qr.householderQ()*MatrixXd::Identity(num_vectors, rank);
+				range = fmatrix*corange;
+			}
+			HouseholderQR<MatrixXd> range_qr(range);
+			MatrixXd basis = range_qr.householderQ()*MatrixXd::Identity(num_features, rank);
+
+			// exact SVD of data projected to the found basis
+			MatrixXd projected = basis.transpose()*fmatrix;
+			JacobiSVD<MatrixXd> svd(projected, ComputeThinU);
+
+			eigenValues.setZero();
+			eigenValues.head(rank) = svd.singularValues();
+			eigenValues = eigenValues.cwiseProduct(eigenValues)/(num_vectors-1);
+			SG_INFO("Done\nReducing from %i to %i features..", num_features, num_dim)
+
+			m_transformation_matrix = SGMatrix<float64_t>(num_features,num_dim);
+			Map<MatrixXd> transformMatrix(m_transformation_matrix.matrix, num_features, num_dim);
+			num_old_dim = num_features;
+			transformMatrix = basis*svd.matrixU().leftCols(num_dim);
+			if (m_whitening)
+			{
+				for (int32_t i=0; i<num_dim; i++)
+				{
+					if (CMath::fequals_abs<float64_t>(0.0, eigenValues[i],
+								m_eigenvalue_zero_tolerance))
+					{
+						SG_WARNING("Covariance matrix has almost zero Eigenvalue (ie "
+							"Eigenvalue within a tolerance of %E around 0) at "
+							"dimension %d. Consider reducing its dimension.",
+							m_eigenvalue_zero_tolerance, i+1)
+
+						transformMatrix.col(i) = MatrixXd::Zero(num_features,1);
+						continue;
+					}
+
+					transformMatrix.col(i) /= CMath::sqrt(eigenValues[i]*(num_vectors-1));
+				}
+			}
+		}
+
 		else
 		{
 			// compute SVD of data matrix
@@ -266,6 +345,126 @@ bool CPCA::init(CFeatures* features)
 	return false;
 }
 
+bool CPCA::init_incremental(CFeatures* features)
+{
+	REQUIRE(features->get_feature_type()==F_DREAL, "PCA only works with real features")
+	REQUIRE(m_mode==FIXED_NUMBER, "Incremental PCA only supports FIXED_NUMBER mode\n")
+	REQUIRE(m_block_size>0, "Block size (%d) must be positive\n", m_block_size)
+
+	CStreamingDenseFeatures<float64_t>* streaming_features =
+		(CStreamingDenseFeatures<float64_t>*) features;
+
+	int32_t num_features = 0;
+	int64_t num_seen = 0;
+	SGMatrix<float64_t> block;
+	// leading components as rows scaled by singular values
+	MatrixXd components;
+	VectorXd singular_values;
+	VectorXd data_mean;
+
+	streaming_features->start_parser();
+	bool stream_ended = false;
+	while (!stream_ended)
+	{
+		int32_t num_block = 0;
+		while (num_block<m_block_size)
+		{
+			if (!streaming_features->get_next_example())
+			{
+				stream_ended = true;
+				break;
+			}
+
+			SGVector<float64_t> vec = streaming_features->get_vector();
+			if (!block.matrix)
+			{
+				num_features = vec.vlen;
+				block = SGMatrix<float64_t>(num_features, m_block_size);
+				data_mean = VectorXd::Zero(num_features);
+			}
+			REQUIRE(vec.vlen==num_features, "All streamed vectors must have "
+				"the same dimension (%d), got %d\n", num_features, vec.vlen)
+
+			memcpy(block.get_column_vector(num_block), vec.vector,
+				sizeof(float64_t)*num_features);
+			streaming_features->release_example();
+			num_block++;
+		}
+
+		if (num_block==0)
+			break;
+
+		SG_DEBUG("Updating components with block of %d vectors\n", num_block)
+		Map<MatrixXd> block_matrix(block.matrix, num_features, num_block);
+		VectorXd block_mean = block_matrix.rowwise().sum()/(float64_t) num_block;
+
+		// stack previous components, centered block and mean correction
+		int32_t num_components = components.rows();
+		int32_t num_correction = num_seen>0 ? 1 : 0;
+		MatrixXd stacked(num_components+num_block+num_correction, num_features);
+		if (num_components>0)
+			stacked.topRows(num_components) = singular_values.asDiagonal()*components;
+		stacked.middleRows(num_components, num_block) =
+			(block_matrix.colwise()-block_mean).transpose();
+		if (num_correction)
+		{
+			float64_t scale = CMath::sqrt(float64_t(num_seen)*num_block/(num_seen+num_block));
+			stacked.bottomRows(1) = scale*(data_mean-block_mean).transpose();
+		}
+
+		data_mean = (float64_t(num_seen)*data_mean+float64_t(num_block)*block_mean)/
+			float64_t(num_seen+num_block);
+		num_seen += num_block;
+
+		JacobiSVD<MatrixXd> svd(stacked, ComputeThinV);
+		int32_t num_keep = CMath::min(m_target_dim, (int32_t) svd.singularValues().size());
+		components = svd.matrixV().leftCols(num_keep).transpose();
+		singular_values = svd.singularValues().head(num_keep);
+	}
+	streaming_features->end_parser();
+
+	REQUIRE(num_seen>1, "Incremental PCA requires at least two vectors\n")
+	REQUIRE(m_target_dim<=components.rows(), "target dimension should be less "
+		"or equal to than minimum of N and D")
+
+	SG_INFO("num_examples: %ld num_features: %ld \n", num_seen, num_features)
+	num_dim = m_target_dim;
+	num_old_dim = num_features;
+
+	m_mean_vector = SGVector<float64_t>(num_features);
+	Map<VectorXd>(m_mean_vector.vector, num_features) = data_mean;
+
+	m_eigenvalues_vector = SGVector<float64_t>(num_dim);
+	Map<VectorXd> eigenValues(m_eigenvalues_vector.vector, num_dim);
+	eigenValues = singular_values.cwiseProduct(singular_values)/(num_seen-1);
+
+	m_transformation_matrix = SGMatrix<float64_t>(num_features,num_dim);
+	Map<MatrixXd> transformMatrix(m_transformation_matrix.matrix, num_features, num_dim);
+	transformMatrix = components.transpose();
+	if (m_whitening)
+	{
+		for (int32_t i=0; i<num_dim; i++)
+		{
+			if (CMath::fequals_abs<float64_t>(0.0, eigenValues[i],
+						m_eigenvalue_zero_tolerance))
+			{
+				SG_WARNING("Covariance matrix has almost zero Eigenvalue (ie "
+					"Eigenvalue within a tolerance of %E around 0) at "
+					"dimension %d. Consider reducing its dimension.",
+					m_eigenvalue_zero_tolerance, i+1)
+
+				transformMatrix.col(i) = MatrixXd::Zero(num_features,1);
+				continue;
+			}
+
+			transformMatrix.col(i) /= CMath::sqrt(eigenValues[i]*(num_seen-1));
+		}
+	}
+
+	m_initialized = true;
+	return true;
+}
+
 void CPCA::cleanup()
 {
 	m_transformation_matrix=SGMatrix<float64_t>();
@@ -381,3 +580,36 @@ float64_t CPCA::get_eigenvalue_zero_tolerance() const
 	return m_eigenvalue_zero_tolerance;
 }
 
+void CPCA::set_block_size(int32_t block_size)
+{
+	REQUIRE(block_size>0, "Block size (%d) must be positive\n", block_size)
+	m_block_size = block_size;
+}
+
+int32_t CPCA::get_block_size() const
+{
+	return m_block_size;
+}
+
+void CPCA::set_oversampling(int32_t oversampling)
+{
+	REQUIRE(oversampling>=0, "Oversampling (%d) must be non-negative\n", oversampling)
+	m_oversampling = oversampling;
+}
+
+int32_t CPCA::get_oversampling() const
+{
+	return m_oversampling;
+}
+
+void CPCA::set_power_iterations(int32_t power_iterations)
+{
+	REQUIRE(power_iterations>=0, "Number of power iterations (%d) must be "
+		"non-negative\n", power_iterations)
+	m_power_iterations = power_iterations;
+}
+
+int32_t CPCA::get_power_iterations() const
+{
+	return m_power_iterations;
+}
@@ -34,7 +34,12 @@ enum EPCAMethod
 	/** Eigenvalue decomposition of covariance matrix.
 	 * Time complexity ~10d^3 (d-dimensions n-number of vectors)
 	 */
-	EVD = 30
+	EVD = 30,
+	/** Randomized SVD of feature matrix, only the leading target
+	 * dimensions are computed. Time complexity ~(2q+2)dnk
+	 * (k-target dimensions plus oversampling, q-power iterations)
+	 */
+	RANDOMIZED = 40
 };
 
 /** mode of pca */
@@ -88,9 +93,27 @@ enum EPCAMemoryMode
  * using the formula \f$e_i = \frac{\sqrt{d_i}}{N-1}\f$.
  * The time complexity of this method is \f$~14DN^2\f$ and should be used when N < D.
  *
+ * <em>RANDOMIZED</em> : Randomized SVD of feature matrix X as described in
+ * Halko, N., Martinsson, P. G., & Tropp, J. A. (2011). Finding structure with
+ * randomness: Probabilistic algorithms for constructing approximate matrix
+ * decompositions. SIAM review, 53(2), 217-288.
+ * The range of X is approximated by an orthonormal basis Q of \f$X\Omega\f$
+ * (refined with a few power iterations) where \f$\Omega\f$ is a Gaussian random
+ * matrix with T+oversampling columns, then the small matrix \f$Q^TX\f$ is
+ * decomposed exactly. Neither covariance matrix nor full SVD is formed.
+ * Only FIXED_NUMBER mode is supported.
+ *
  * <em>AUTO</em> : This mode automagically chooses one of the above modes for the user
  * based on whether N > D (chooses EVD) or N < D (chooses SVD).
  *
+ * If PCA is initialized with CStreamingDenseFeatures, incremental PCA as described in
+ * Ross, D. A., Lim, J., Lin, R. S., & Yang, M. H. (2008). Incremental learning for
+ * robust visual tracking. International Journal of Computer Vision, 77(1-3), 125-141.
+ * is used instead: the stream is consumed in blocks of set_block_size vectors and
+ * the T leading components are updated with the SVD of the current components
+ * stacked on the centered block, so that only \f$O((T+B)D)\f$ memory is required
+ * (B-block size). Only FIXED_NUMBER mode is supported.
+ *
  * This class provides 3 modes to determine the value of T :
  *
  * <em>FIXED_NUMBER</em> : T is supplied by user directly using set_target_dims method
@@ -192,10 +215,46 @@ class CPCA: public CDimensionReductionPreprocessor
 		 */
 		float64_t get_eigenvalue_zero_tolerance() const;
 
+		/** set number of vectors consumed at once by incremental PCA
+		 * @param block_size number of vectors in each block
+		 */
+		void set_block_size(int32_t block_size);
+
+		/** get number of vectors consumed at once by incremental PCA
+		 * @return number of vectors in each block
+		 */
+		int32_t get_block_size() const;
+
+		/** set number of additional random directions used by randomized SVD
+		 * @param oversampling number of additional directions
+		 */
+		void set_oversampling(int32_t oversampling);
+
+		/** get number of additional random directions used by randomized SVD
+		 * @return number of additional directions
+		 */
+		int32_t get_oversampling() const;
+
+		/** set number of power iterations used by randomized SVD
+		 * @param power_iterations number of power iterations
+		 */
+		void set_power_iterations(int32_t power_iterations);
+
+		/** get number of power iterations used by randomized SVD
+		 * @return number of power iterations
+		 */
+		int32_t get_power_iterations() const;
+
 	protected:
 
 		void init();
 
+		/** initialize preprocessor with incremental PCA over
+		 * blocks of streamed vectors
+		 * @param features streaming features
+		 */
+		bool init_incremental(CFeatures* features);
+
 	protected:
 
 		/** transformation matrix */
@@ -225,6 +284,15 @@ class CPCA: public CDimensionReductionPreprocessor
 		 * whitening to tackle numerical issues
 		 */
 		float64_t m_eigenvalue_zero_tolerance;
+
+		/** number of vectors in each block of incremental PCA */
+		int32_t m_block_size;
+
+		/** number of additional random directions of randomized SVD */
+		int32_t m_oversampling;
+
+		/** number of power iterations of randomized SVD */
+		int32_t m_power_iterations;
 };
 }
 #endif // PCA_H_
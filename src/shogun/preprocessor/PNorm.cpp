@@ -97,6 +97,16 @@ SGVector<float64_t> CPNorm::apply_to_feature_vector (SGVector<float64_t> vector)
 	return SGVector<float64_t>(normed_vec,vector.vlen);
 }
 
+bool CPNorm::apply_in_place (SGVector<float64_t> vector)
+{
+	float64_t norm = get_pnorm (vector.vector, vector.vlen);
+
+	for (int32_t i=0; i<vector.vlen; i++)
+		vector.vector[i]/=norm;
+
+	return true;
+}
+
 void CPNorm::set_pnorm (double pnorm)
 {
 	ASSERT (pnorm >= 1.0)
@@ -149,11 +149,14 @@ SGMatrix<float64_t> CPruneVarSubMean::apply_to_feature_matrix(CFeatures* feature
 		}
 	}
 
-	((CDenseFeatures<float64_t>*) features)->set_num_features(m_num_idx);
-	((CDenseFeatures<float64_t>*) features)->get_feature_matrix(num_features, num_vectors);
-	SG_INFO("new Feature matrix: %ix%i\n", num_vectors, num_features)
-
-	return ((CDenseFeatures<float64_t>*) features)->get_feature_matrix();
+	// keep the (shared) storage but shrink the matrix so that its shape
+	// matches the pruned features for preprocessors applied afterwards
+	SGMatrix<float64_t> pruned=((CDenseFeatures<float64_t>*) features)->get_feature_matrix();
+	pruned.num_rows=m_num_idx;
+	((CDenseFeatures<float64_t>*) features)->set_feature_matrix(pruned);
+	SG_INFO("new Feature matrix: %ix%i\n", num_vectors, m_num_idx)
+
+	return pruned;
 }
 
 /// apply preproc on single feature vector
@@ -187,6 +190,24 @@ SGVector<float64_t> CPruneVarSubMean::apply_to_feature_vector(SGVector<float64_t
 	return SGVector<float64_t>(ret,m_num_idx);
 }
 
+bool CPruneVarSubMean::get_affine_map(int32_t num_features,
+		SGVector<int32_t>& idx, SGVector<float64_t>& scale, SGVector<float64_t>& shift)
+{
+	if (!m_initialized)
+		return false;
+
+	idx=m_idx.clone();
+	scale=SGVector<float64_t>(m_num_idx);
+	shift=SGVector<float64_t>(m_num_idx);
+	for (int32_t i=0; i<m_num_idx; i++)
+	{
+		scale[i]=m_divide_by_std ? 1.0/m_std[i] : 1.0;
+		shift[i]=-m_mean[i]*scale[i];
+	}
+
+	return true;
+}
+
 void CPruneVarSubMean::init()
 {
 	m_initialized = false;
@@ -112,6 +112,24 @@ SGVector<float64_t> CRescaleFeatures::apply_to_feature_vector(SGVector<float64_t
 	return SGVector<float64_t>(ret,vector.vlen);
 }
 
+bool CRescaleFeatures::get_affine_map(int32_t num_features,
+		SGVector<int32_t>& idx, SGVector<float64_t>& scale, SGVector<float64_t>& shift)
+{
+	if (!m_initialized)
+		return false;
+
+	ASSERT(m_min.vlen == num_features);
+
+	idx=SGVector<int32_t>(num_features);
+	idx.range_fill();
+	scale=m_range.clone();
+	shift=SGVector<float64_t>(num_features);
+	for (index_t i = 0; i < num_features; i++)
+		shift[i] = -m_min[i]*m_range[i];
+
+	return true;
+}
+
 void CRescaleFeatures::register_parameters()
 {
 	SG_ADD(&m_min, "min", "minimum values of each feature", MS_NOT_AVAILABLE);
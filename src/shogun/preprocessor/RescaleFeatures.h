@@ -61,6 +61,12 @@ namespace shogun
 			 */
 			virtual SGVector<float64_t> apply_to_feature_vector(SGVector<float64_t> vector);
 
+			/**
+			 * Describe preproc as affine map, see CDensePreprocessor
+			 */
+			virtual bool get_affine_map(int32_t num_features, SGVector<int32_t>& idx,
+					SGVector<float64_t>& scale, SGVector<float64_t>& shift);
+
 			/** @return object name */
 			virtual const char* get_name() const { return "RescaleFeatures"; }
 
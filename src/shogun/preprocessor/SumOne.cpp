@@ -82,3 +82,13 @@ SGVector<float64_t> CSumOne::apply_to_feature_vector(SGVector<float64_t> vector)
 
 	return SGVector<float64_t>(normed_vec,vector.vlen);
 }
+
+bool CSumOne::apply_in_place(SGVector<float64_t> vector)
+{
+	float64_t sum = SGVector<float64_t>::sum(vector.vector, vector.vlen);
+
+	for (int32_t i=0; i<vector.vlen; i++)
+		vector.vector[i]/=sum;
+
+	return true;
+}
@@ -35,11 +35,71 @@ CKernelRidgeRegression::CKernelRidgeRegression(float64_t tau, CKernel* k, CLabel
 	set_kernel(k);
 }
 
+CKernelRidgeRegression::~CKernelRidgeRegression()
+{
+	SG_UNREF(m_approximation);
+}
+
 void CKernelRidgeRegression::init()
 {
 	m_tau=1e-6;
 	m_epsilon=0.0001;
+	m_approximation=NULL;
 	SG_ADD(&m_tau, "tau", "Regularization parameter", MS_AVAILABLE);
+	SG_ADD((CSGObject**)&m_approximation, "approximation",
+		"Nystrom approximation of kernel matrix", MS_NOT_AVAILABLE);
+}
+
+void CKernelRidgeRegression::set_approximation(CNystromApproximation* approximation)
+{
+	SG_REF(approximation);
+	SG_UNREF(m_approximation);
+	m_approximation=approximation;
+}
+
+CNystromApproximation* CKernelRidgeRegression::get_approximation() const
+{
+	SG_REF(m_approximation);
+	return m_approximation;
+}
+
+bool CKernelRidgeRegression::solve_approximated_krr_system()
+{
+	CFeatures* features=kernel->get_lhs();
+	m_approximation->set_kernel(kernel);
+	m_approximation->compute(features);
+	// restore kernel for training features on both sides
+	kernel->init(features, features);
+	SG_UNREF(features);
+
+	SGMatrix<float64_t> factor=m_approximation->get_factor();
+	SGMatrix<float64_t> transform=m_approximation->get_landmark_transform();
+	SGVector<float64_t> y=((CRegressionLabels*)m_labels)->get_labels();
+	int32_t n=factor.num_rows;
+	int32_t rank=factor.num_cols;
+
+	Map<MatrixXd> eigen_factor(factor.matrix, n, rank);
+	Map<MatrixXd> eigen_transform(transform.matrix, transform.num_rows, rank);
+	Map<VectorXd> eigen_y(y.vector, n);
+
+	MatrixXd system=eigen_factor.transpose()*eigen_factor;
+	system.diagonal().array()+=m_tau;
+
+	LLT<MatrixXd> llt;
+	llt.compute(system);
+	if (llt.info() != Eigen::Success)
+	{
+		SG_WARNING("Approximated features covariance matrix was not positive definite\n");
+		return false;
+	}
+
+	set_alphas(SGVector<float64_t>(transform.num_rows));
+	Map<VectorXd> eigen_alphas(m_alpha.vector, m_alpha.vlen);
+	eigen_alphas=eigen_transform*llt.solve(eigen_factor.transpose()*eigen_y);
+
+	/* only landmarks are support vectors */
+	m_svs=m_approximation->get_landmarks().clone();
+	return true;
 }
 
 bool CKernelRidgeRegression::solve_krr_system()
@@ -88,6 +148,9 @@ bool CKernelRidgeRegression::train_machine(CFeatures *data)
 			" columns (num_labels=%d cols=%d\n", m_labels->get_num_labels(), kernel->get_num_vec_rhs());
 	}
 
+	if (m_approximation)
+		return solve_approximated_krr_system();
+
 	// allocate alpha vector
 	set_alphas(SGVector<float64_t>(m_labels->get_num_labels()));
 
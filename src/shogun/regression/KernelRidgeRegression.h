@@ -15,6 +15,7 @@
 #include <shogun/lib/config.h>
 #include <shogun/regression/Regression.h>
 #include <shogun/kernel/Kernel.h>
+#include <shogun/kernel/NystromApproximation.h>
 #include <shogun/machine/KernelMachine.h>
 
 namespace shogun
@@ -49,6 +50,14 @@ namespace shogun
  * where K is the kernel matrix and y the vector of labels. The expressed
  * solution can again be written as a linear combination of kernels (cf.
  * CKernelMachine) with bias \f$b=0\f$.
+ *
+ * If a CNystromApproximation with low-rank factor \f$K\approx FF^T\f$ is set,
+ * the full kernel matrix is never formed and
+ * \f[
+ * {\bf \alpha}=T\left(F^TF+\tau{\bf I}\right)^{-1}F^T{\bf y}
+ * \f]
+ * is computed in \f$O(nm^2)\f$ where T is the landmark transform of the
+ * approximation. Only the m landmarks become support vectors.
  */
 class CKernelRidgeRegression : public CKernelMachine
 {
@@ -68,7 +77,7 @@ class CKernelRidgeRegression : public CKernelMachine
 		CKernelRidgeRegression(float64_t tau, CKernel* k, CLabels* lab);
 
 		/** default destructor */
-		virtual ~CKernelRidgeRegression() {}
+		virtual ~CKernelRidgeRegression();
 
 		/** set regularization constant
 		 *
@@ -82,6 +91,19 @@ class CKernelRidgeRegression : public CKernelMachine
 		 */
 		inline void set_epsilon(float64_t epsilon) { m_epsilon = epsilon; }
 
+		/** set Nystrom approximation used instead of the full
+		 * kernel matrix, the kernel of this machine is approximated
+		 *
+		 * @param approximation approximation or NULL to use the full
+		 * kernel matrix
+		 */
+		void set_approximation(CNystromApproximation* approximation);
+
+		/** @return Nystrom approximation or NULL if the full
+		 * kernel matrix is used
+		 */
+		CNystromApproximation* get_approximation() const;
+
 		/** load regression from file
 		 *
 		 * @param srcfile file to load from
@@ -127,6 +149,13 @@ class CKernelRidgeRegression : public CKernelMachine
 		 */
 		bool solve_krr_system();
 
+		/** Train regression from low-rank factor of Nystrom
+		 * approximation, sets alphas and support vectors.
+		 *
+		 * @return boolean to indicate success
+		 */
+		bool solve_approximated_krr_system();
+
 	private:
 		void init();
 
@@ -137,6 +166,9 @@ class CKernelRidgeRegression : public CKernelMachine
 		/** epsilon constant */
 		float64_t m_epsilon;
 
+		/** Nystrom approximation of kernel matrix */
+		CNystromApproximation* m_approximation;
+
 };
 }
 
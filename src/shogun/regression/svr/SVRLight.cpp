@@ -599,8 +599,9 @@ void CSVRLight::update_linear_component_mkl_linadd(
 	}
 
 	// determine contributions of different kernels
-	for (int32_t i=0; i<num_vectors; i++)
-		kernel->compute_by_subkernel(i,&W[i*num_kernels]) ;
+	SGVector<int32_t> vec_idx(num_vectors);
+	vec_idx.range_fill();
+	kernel->compute_by_subkernel_batch(num_vectors, vec_idx.vector, W);
 
 	// restore old weights
 	kernel->set_subkernel_weights(SGVector<float64_t>(w_backup,num_weights));
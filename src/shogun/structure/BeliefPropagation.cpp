@@ -11,10 +11,14 @@
 #include <shogun/structure/BeliefPropagation.h>
 #include <shogun/lib/DynamicObjectArray.h>
 #include <shogun/io/SGIO.h>
+#include <shogun/mathematics/Math.h>
+#include <shogun/base/Parallel.h>
 #include <numeric>
 #include <algorithm>
 #include <functional>
 #include <stack>
+#include <limits>
+#include <cmath>
 
 using namespace shogun;
 
@@ -555,3 +559,338 @@ void CTreeMaxProduct::top_down_pass()
 	SG_DEBUG("***leave top_down_pass().\n");
 }
 
+
+// -----------------------------------------------------------------
+
+CLoopyMaxProduct::CLoopyMaxProduct()
+	: CBeliefPropagation()
+{
+	SG_UNSTABLE("CLoopyMaxProduct::CLoopyMaxProduct()", "\n");
+	init();
+}
+
+CLoopyMaxProduct::CLoopyMaxProduct(CFactorGraph* fg)
+	: CBeliefPropagation(fg)
+{
+	ASSERT(m_fg != NULL);
+	init();
+}
+
+CLoopyMaxProduct::~CLoopyMaxProduct()
+{
+}
+
+void CLoopyMaxProduct::init()
+{
+	m_max_iter = 100;
+	m_tolerance = 1e-6;
+	m_damping = 0;
+	m_schedule = LBP_RESIDUAL;
+	m_sum_product = false;
+	m_num_iter = 0;
+	m_converged = false;
+}
+
+void CLoopyMaxProduct::set_damping(float64_t damping)
+{
+	REQUIRE(damping >= 0 && damping < 1, "%s::set_damping(): damping (%f) "
+		"must be in [0,1)!\n", get_name(), damping);
+	m_damping = damping;
+}
+
+void CLoopyMaxProduct::build_edges()
+{
+	CDynamicObjectArray* facs = m_fg->get_factors();
+	m_cards = m_fg->get_cardinalities();
+	int32_t num_facs = facs->get_num_elements();
+	int32_t num_vars = m_cards.size();
+
+	// edges of factor fi are m_fac_edges[fi], ..., m_fac_edges[fi+1]-1
+	m_fac_edges.assign(num_facs+1, 0);
+	m_energy_offsets.assign(num_facs+1, 0);
+	m_edge_var.clear();
+	m_edge_stride.clear();
+	m_edge_fac.clear();
+	m_msg_offsets.assign(1, 0);
+	m_energies.clear();
+
+	for (int32_t fi = 0; fi < num_facs; ++fi)
+	{
+		CFactor* fac = dynamic_cast<CFactor*>(facs->get_element(fi));
+		SGVector<int32_t> fvars = fac->get_variables();
+		SGVector<float64_t> fenrgs = fac->get_energies();
+		SG_UNREF(fac);
+
+		// the first variable of a factor changes fastest in its table
+		int32_t stride = 1;
+		for (int32_t vi = 0; vi < fvars.size(); ++vi)
+		{
+			m_edge_var.push_back(fvars[vi]);
+			m_edge_stride.push_back(stride);
+			m_edge_fac.push_back(fi);
+			m_msg_offsets.push_back(m_msg_offsets.back() + m_cards[fvars[vi]]);
+			stride *= m_cards[fvars[vi]];
+		}
+		REQUIRE(fenrgs.size() == stride, "%s::build_edges(): energy table of "
+			"factor %d has %d entries, expected %d!\n", get_name(), fi,
+			fenrgs.size(), stride);
+
+		m_fac_edges[fi+1] = m_edge_var.size();
+		m_energies.insert(m_energies.end(), fenrgs.vector, fenrgs.vector + fenrgs.size());
+		m_energy_offsets[fi+1] = m_energies.size();
+	}
+	SG_UNREF(facs);
+
+	// incident edges of each variable
+	int32_t num_edges = m_edge_var.size();
+	m_var_edges_begin.assign(num_vars+1, 0);
+	for (int32_t ei = 0; ei < num_edges; ++ei)
+		m_var_edges_begin[m_edge_var[ei]+1]++;
+	for (int32_t vi = 0; vi < num_vars; ++vi)
+		m_var_edges_begin[vi+1] += m_var_edges_begin[vi];
+
+	m_var_edges.resize(num_edges);
+	std::vector<int32_t> pos(m_var_edges_begin.begin(), m_var_edges_begin.end()-1);
+	for (int32_t ei = 0; ei < num_edges; ++ei)
+		m_var_edges[pos[m_edge_var[ei]]++] = ei;
+
+	m_belief_offsets.assign(num_vars+1, 0);
+	for (int32_t vi = 0; vi < num_vars; ++vi)
+		m_belief_offsets[vi+1] = m_belief_offsets[vi] + m_cards[vi];
+
+	m_f2v.assign(m_msg_offsets.back(), 0);
+	m_f2v_new.assign(m_msg_offsets.back(), 0);
+	m_v2f.assign(m_msg_offsets.back(), 0);
+	m_beliefs.assign(m_belief_offsets.back(), 0);
+}
+
+float64_t CLoopyMaxProduct::compute_factor_messages(int32_t fi,
+	std::vector<float64_t>& buf)
+{
+	int32_t e_begin = m_fac_edges[fi];
+	int32_t e_end = m_fac_edges[fi+1];
+	const float64_t* fenrgs = &m_energies[m_energy_offsets[fi]];
+	int32_t num_states = m_energy_offsets[fi+1] - m_energy_offsets[fi];
+	buf.resize(num_states);
+
+	float64_t residual = 0;
+	for (int32_t e = e_begin; e < e_end; ++e)
+	{
+		int32_t card = m_cards[m_edge_var[e]];
+		float64_t* msg = &m_f2v_new[m_msg_offsets[e]];
+		const float64_t* old_msg = &m_f2v[m_msg_offsets[e]];
+
+		// r_f2v(y_v) = min_{y_f, y_v fixed} E_f(y_f) + sum_{u != v} q_u2f(y_u)
+		// in the energy domain, see Eq.(3.19) and Eq.(3.20) in [1]
+		std::fill(msg, msg + card, std::numeric_limits<float64_t>::infinity());
+		for (int32_t ei = 0; ei < num_states; ++ei)
+		{
+			float64_t val = fenrgs[ei];
+			for (int32_t u = e_begin; u < e_end; ++u)
+			{
+				if (u == e)
+					continue;
+				int32_t state = (ei / m_edge_stride[u]) % m_cards[m_edge_var[u]];
+				val += m_v2f[m_msg_offsets[u] + state];
+			}
+			buf[ei] = val;
+
+			int32_t state = (ei / m_edge_stride[e]) % card;
+			if (val < msg[state])
+				msg[state] = val;
+		}
+
+		// sum-product: r_f2v(y_v) = -log sum_{y_f, y_v fixed} exp(-...)
+		if (m_sum_product)
+		{
+			std::vector<float64_t> sums(card, 0);
+			for (int32_t ei = 0; ei < num_states; ++ei)
+			{
+				int32_t state = (ei / m_edge_stride[e]) % card;
+				if (msg[state] < std::numeric_limits<float64_t>::infinity())
+					sums[state] += std::exp(msg[state] - buf[ei]);
+			}
+			for (int32_t si = 0; si < card; ++si)
+			{
+				if (sums[si] > 0)
+					msg[si] -= std::log(sums[si]);
+			}
+		}
+
+		// normalize, damp and measure the change
+		float64_t min_msg = *std::min_element(msg, msg + card);
+		for (int32_t si = 0; si < card; ++si)
+		{
+			if (min_msg < std::numeric_limits<float64_t>::infinity())
+				msg[si] -= min_msg;
+			if (m_damping > 0)
+				msg[si] = (1-m_damping)*msg[si] + m_damping*old_msg[si];
+
+			if (msg[si] != old_msg[si])
+			{
+				float64_t diff = std::fabs(msg[si] - old_msg[si]);
+				residual = (diff > residual) ? diff : residual;
+			}
+		}
+	}
+
+	return residual;
+}
+
+void CLoopyMaxProduct::update_variable(int32_t vi)
+{
+	int32_t card = m_cards[vi];
+	int32_t b = m_var_edges_begin[vi];
+	int32_t b_end = m_var_edges_begin[vi+1];
+
+	// beliefs: sum of all incoming factor messages
+	float64_t* belief = &m_beliefs[m_belief_offsets[vi]];
+	std::fill(belief, belief + card, 0);
+	for (int32_t i = b; i < b_end; ++i)
+	{
+		const float64_t* r = &m_f2v[m_msg_offsets[m_var_edges[i]]];
+		for (int32_t si = 0; si < card; ++si)
+			belief[si] += r[si];
+	}
+	float64_t min_belief = *std::min_element(belief, belief + card);
+	if (min_belief < std::numeric_limits<float64_t>::infinity())
+	{
+		for (int32_t si = 0; si < card; ++si)
+			belief[si] -= min_belief;
+	}
+
+	// q_v2f = sum of the messages from all other factors
+	for (int32_t i = b; i < b_end; ++i)
+	{
+		float64_t* q = &m_v2f[m_msg_offsets[m_var_edges[i]]];
+		std::fill(q, q + card, 0);
+		for (int32_t j = b; j < b_end; ++j)
+		{
+			if (j == i)
+				continue;
+			const float64_t* r = &m_f2v[m_msg_offsets[m_var_edges[j]]];
+			for (int32_t si = 0; si < card; ++si)
+				q[si] += r[si];
+		}
+
+		float64_t min_q = *std::min_element(q, q + card);
+		if (min_q < std::numeric_limits<float64_t>::infinity())
+		{
+			for (int32_t si = 0; si < card; ++si)
+				q[si] -= min_q;
+		}
+	}
+}
+
+float64_t CLoopyMaxProduct::inference(SGVector<int32_t> assignment)
+{
+	REQUIRE(assignment.size() == m_fg->get_cardinalities().size(),
+		"%s::inference(): the output assignment should be prepared as"
+		"the same size as variables!\n", get_name());
+
+	build_edges();
+
+	int32_t num_facs = m_fac_edges.size() - 1;
+	int32_t num_vars = m_cards.size();
+	int32_t num_threads = parallel->get_num_threads();
+
+	std::vector<float64_t> residuals(num_facs, 0);
+	// factors whose incoming messages changed since their last candidates
+	std::vector<char> fac_dirty(num_facs, 1);
+	std::vector<char> var_dirty(num_vars, 0);
+
+	m_converged = false;
+	for (m_num_iter = 0; m_num_iter < m_max_iter; )
+	{
+		// 1) candidate messages, in parallel over factors
+		#pragma omp parallel num_threads(num_threads)
+		{
+			std::vector<float64_t> buf;
+			#pragma omp for schedule(dynamic, 16)
+			for (int32_t fi = 0; fi < num_facs; ++fi)
+			{
+				if (fac_dirty[fi])
+				{
+					residuals[fi] = compute_factor_messages(fi, buf);
+					fac_dirty[fi] = 0;
+				}
+			}
+		}
+		m_num_iter++;
+
+		float64_t max_residual = 0;
+		for (int32_t fi = 0; fi < num_facs; ++fi)
+			max_residual = CMath::max(max_residual, residuals[fi]);
+
+		SG_DEBUG("iteration %d, largest message change %f\n", m_num_iter, max_residual);
+		if (max_residual < m_tolerance)
+		{
+			m_converged = true;
+			break;
+		}
+
+		// 2) send the messages of the scheduled factors
+		float64_t threshold = (m_schedule == LBP_RESIDUAL) ? 0.5*max_residual : 0;
+		std::fill(var_dirty.begin(), var_dirty.end(), 0);
+		for (int32_t fi = 0; fi < num_facs; ++fi)
+		{
+			if (residuals[fi] == 0 || residuals[fi] < threshold)
+				continue;
+
+			std::copy(m_f2v_new.begin() + m_msg_offsets[m_fac_edges[fi]],
+				m_f2v_new.begin() + m_msg_offsets[m_fac_edges[fi+1]],
+				m_f2v.begin() + m_msg_offsets[m_fac_edges[fi]]);
+			residuals[fi] = 0;
+
+			for (int32_t e = m_fac_edges[fi]; e < m_fac_edges[fi+1]; ++e)
+				var_dirty[m_edge_var[e]] = 1;
+		}
+
+		// 3) variable-to-factor messages of the affected variables
+		#pragma omp parallel for num_threads(num_threads) schedule(dynamic, 64)
+		for (int32_t vi = 0; vi < num_vars; ++vi)
+		{
+			if (var_dirty[vi])
+				update_variable(vi);
+		}
+
+		// 4) neighbouring factors need new candidates
+		for (int32_t vi = 0; vi < num_vars; ++vi)
+		{
+			if (!var_dirty[vi])
+				continue;
+
+			for (int32_t i = m_var_edges_begin[vi]; i < m_var_edges_begin[vi+1]; ++i)
+				fac_dirty[m_edge_fac[m_var_edges[i]]] = 1;
+		}
+	}
+
+	if (!m_converged)
+		SG_DEBUG("%s::inference(): no convergence after %d iterations\n", get_name(), m_num_iter);
+
+	// decode: minimal belief per variable
+	for (int32_t vi = 0; vi < num_vars; ++vi)
+	{
+		const float64_t* belief = &m_beliefs[m_belief_offsets[vi]];
+		assignment[vi] = static_cast<int32_t>(
+			std::min_element(belief, belief + m_cards[vi]) - belief);
+	}
+
+	m_map_energy = m_fg->evaluate_energy(assignment);
+	SG_DEBUG("energy of the decoded assignment = %f\n", m_map_energy);
+
+	return m_map_energy;
+}
+
+SGVector<float64_t> CLoopyMaxProduct::get_beliefs(int32_t var_id) const
+{
+	REQUIRE(var_id >= 0 && var_id < m_cards.size(), "%s::get_beliefs(): "
+		"variable %d does not exist or inference has not been run!\n",
+		get_name(), var_id);
+
+	SGVector<float64_t> beliefs(m_cards[var_id]);
+	std::copy(m_beliefs.begin() + m_belief_offsets[var_id],
+		m_beliefs.begin() + m_belief_offsets[var_id+1], beliefs.vector);
+
+	return beliefs;
+}
@@ -146,6 +146,148 @@ private:
 	msgset_map_type m_msgset_map_var;
 };
 
+/** message schedules of loopy belief propagation */
+enum ELoopySchedule
+{
+	/** all factors send new messages in every iteration (flooding) */
+	LBP_PARALLEL = 0,
+	/** only factors whose pending messages changed most are updated */
+	LBP_RESIDUAL = 1
+};
+
+/** loopy belief propagation for graphs with cycles, see chapter 3.2 of [1].
+ *
+ * Messages are kept in the energy domain in two contiguous buffers
+ * (factor-to-variable and variable-to-factor) with one slice per edge.
+ * In each iteration the candidate messages of all factors whose inputs
+ * changed are computed in parallel. With LBP_PARALLEL every factor then
+ * sends its messages, with LBP_RESIDUAL only the factors whose largest
+ * message change is at least half of the overall largest change [2].
+ * Messages can be damped, and sum-product can be used instead of
+ * max-product, in which case the assignment maximizes the marginals.
+ *
+ * [1] Sebastian Nowozin and Christoph H. Lampert,
+ * Structured Learning and Prediction for Computer Vision,
+ * Foundations and Trends in Computer Graphics and Vision series
+ * of now publishers, 2011.
+ * [2] Gal Elidan, Ian McGraw and Daphne Koller, Residual Belief
+ * Propagation: Informed Scheduling for Asynchronous Message Passing,
+ * UAI 2006.
+ */
+IGNORE_IN_CLASSLIST class CLoopyMaxProduct : public CBeliefPropagation
+{
+public:
+	CLoopyMaxProduct();
+	CLoopyMaxProduct(CFactorGraph* fg);
+
+	virtual ~CLoopyMaxProduct();
+
+	/** @return class name */
+	virtual const char* get_name() const { return "LoopyMaxProduct"; }
+
+	virtual float64_t inference(SGVector<int32_t> assignment);
+
+	/** set maximum number of iterations (default 100) */
+	void set_max_iter(int32_t max_iter) { m_max_iter = max_iter; }
+
+	/** set convergence tolerance on the largest message change (default 1e-6) */
+	void set_tolerance(float64_t tolerance) { m_tolerance = tolerance; }
+
+	/** set damping in [0,1), the weight of the previous message (default 0) */
+	void set_damping(float64_t damping);
+
+	/** set message schedule (default LBP_RESIDUAL) */
+	void set_schedule(ELoopySchedule schedule) { m_schedule = schedule; }
+
+	/** use sum-product instead of max-product (default false) */
+	void set_sum_product(bool sum_product) { m_sum_product = sum_product; }
+
+	/** @return number of iterations of the last inference */
+	int32_t get_num_iter() const { return m_num_iter; }
+
+	/** @return whether the last inference converged */
+	bool get_converged() const { return m_converged; }
+
+	/** get beliefs (negative log max-marginals or marginals up to a
+	 * constant, minimum zero) of a variable after inference
+	 *
+	 * @param var_id variable
+	 * @return beliefs, one per state
+	 */
+	SGVector<float64_t> get_beliefs(int32_t var_id) const;
+
+protected:
+	/** flatten the factor graph into edge and message buffers */
+	void build_edges();
+
+	/** compute the candidate factor-to-variable messages of a factor
+	 * from the current variable-to-factor messages
+	 *
+	 * @param fi factor
+	 * @param buf scratch buffer of at least the size of the factor's table
+	 * @return largest change compared to the current messages
+	 */
+	float64_t compute_factor_messages(int32_t fi, std::vector<float64_t>& buf);
+
+	/** update the variable-to-factor messages and beliefs of a variable
+	 *
+	 * @param vi variable
+	 */
+	void update_variable(int32_t vi);
+
+private:
+	void init();
+
+private:
+	/** maximum number of iterations */
+	int32_t m_max_iter;
+	/** convergence tolerance */
+	float64_t m_tolerance;
+	/** damping */
+	float64_t m_damping;
+	/** message schedule */
+	ELoopySchedule m_schedule;
+	/** sum-product instead of max-product */
+	bool m_sum_product;
+	/** iterations of the last inference */
+	int32_t m_num_iter;
+	/** whether the last inference converged */
+	bool m_converged;
+
+	/** cardinalities of the variables */
+	SGVector<int32_t> m_cards;
+	/** first edge of each factor, edge e connects factor f to its
+	 * (e-m_fac_edges[f])-th variable */
+	std::vector<int32_t> m_fac_edges;
+	/** variable of each edge */
+	std::vector<int32_t> m_edge_var;
+	/** stride of the edge's variable in the factor's energy table */
+	std::vector<int32_t> m_edge_stride;
+	/** first message entry of each edge */
+	std::vector<int32_t> m_msg_offsets;
+	/** first incident edge of each variable */
+	std::vector<int32_t> m_var_edges_begin;
+	/** incident edges of all variables */
+	std::vector<int32_t> m_var_edges;
+	/** first belief entry of each variable */
+	std::vector<int32_t> m_belief_offsets;
+	/** factor of each edge */
+	std::vector<int32_t> m_edge_fac;
+	/** first energy of each factor */
+	std::vector<int32_t> m_energy_offsets;
+	/** energy tables of all factors */
+	std::vector<float64_t> m_energies;
+
+	/** factor-to-variable messages */
+	std::vector<float64_t> m_f2v;
+	/** candidate factor-to-variable messages */
+	std::vector<float64_t> m_f2v_new;
+	/** variable-to-factor messages */
+	std::vector<float64_t> m_v2f;
+	/** beliefs of the variables */
+	std::vector<float64_t> m_beliefs;
+};
+
 }
 
 #endif /* DOXYGEN_SHOULD_SKIP_THIS */
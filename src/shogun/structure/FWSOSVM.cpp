@@ -104,6 +104,8 @@ bool CFWSOSVM::train_machine(CFeatures* data)
 	int32_t k = 0;
 	SGVector<float64_t> w_s(M);
 	float64_t ell_s = 0;
+	SGVector<int32_t> examples(N);
+	examples.range_fill();
 	for (int32_t pi = 0; pi < m_num_iter; ++pi)
 	{
 		// init w_s and ell_s
@@ -111,43 +113,13 @@ bool CFWSOSVM::train_machine(CFeatures* data)
 		w_s.zero();
 		ell_s = 0;
 
-		for (int32_t si = 0; si < N; ++si)
-		{
-			// 1) solve the loss-augmented inference for point si
-			CResultSet* result = m_model->argmax(m_w, si);
-
-			// 2) get the subgradient
-			// psi_i(y) := phi(x_i,y_i) - phi(x_i, y_pred)
-			SGVector<float64_t> psi_i(M);
-			if (result->psi_computed)
-			{
-				SGVector<float64_t>::add(psi_i.vector,
-					1.0, result->psi_truth.vector, -1.0, result->psi_pred.vector,
-					psi_i.vlen);
-			}
-			else if(result->psi_computed_sparse)
-			{
-				psi_i.zero();
-				result->psi_pred_sparse.add_to_dense(1.0, psi_i.vector, psi_i.vlen);
-				result->psi_truth_sparse.add_to_dense(-1.0, psi_i.vector, psi_i.vlen);
-			}
-			else
-			{
-				SG_ERROR("model(%s) should have either of psi_computed or psi_computed_sparse"
-						"to be set true\n", m_model->get_name());
-			}
-
-			// 3) loss_i = L(y_i, y_pred)
-			float64_t loss_i = result->delta;
-			ASSERT(loss_i - CMath::dot(m_w.vector, psi_i.vector, m_w.vlen) >= -1e-12);
-
-			// 4) update w_s and ell_s
-			w_s.add(psi_i);
-			ell_s += loss_i;
-
-			SG_UNREF(result);
-
-		} // end si
+		// 1) solve the loss-augmented inference for all points, in parallel
+		// if the model allows it, and 2) sum up the subgradients
+		// psi_i(y) := phi(x_i,y_i) - phi(x_i, y_pred)
+		// and 3) the losses loss_i = L(y_i, y_pred) into w_s and ell_s
+		float64_t score_s = 0;
+		solve_oracles(m_w, examples, w_s.vector, score_s, ell_s);
+		ASSERT(ell_s - CMath::dot(m_w.vector, w_s.vector, m_w.vlen) >= -N*1e-12);
 
 		w_s.scale(1.0 / (N*m_lambda));
 		ell_s /= N;
@@ -285,6 +285,11 @@ SGVector< float64_t > CFactorGraphModel::get_joint_feature_vector(int32_t feat_i
 //            := argmin_y { -L(y_i, y) + E(x_i, y; w) } - E(x_i, y_i; w)
 // we do energy minimization in inference, so get back to max oracle value is:
 // [ L(y_i, y_star) - E(x_i, y_star; w) ] + E(x_i, y_i; w)
+void CFactorGraphModel::init_argmax(SGVector<float64_t> w)
+{
+	w_to_fparams(w);
+}
+
 CResultSet* CFactorGraphModel::argmax(SGVector<float64_t> w, int32_t feat_idx, bool const training)
 {
 	// factor graph instance
@@ -63,6 +63,12 @@ SGVector< float64_t > CMulticlassModel::get_joint_feature_vector(int32_t feat_id
 	return psi;
 }
 
+void CMulticlassModel::init_argmax(SGVector< float64_t > w)
+{
+	if (m_labels)
+		m_num_classes = ((CMulticlassSOLabels*) m_labels)->get_num_classes();
+}
+
 CResultSet* CMulticlassModel::argmax(
 		SGVector< float64_t > w,
 		int32_t feat_idx,
@@ -74,7 +80,9 @@ CResultSet* CMulticlassModel::argmax(
 	if ( training )
 	{
 		CMulticlassSOLabels* ml = (CMulticlassSOLabels*) m_labels;
-		m_num_classes = ml->get_num_classes();
+		// only written if changed, argmax may run concurrently
+		if ( m_num_classes != ml->get_num_classes() )
+			m_num_classes = ml->get_num_classes();
 	}
 	else
 	{
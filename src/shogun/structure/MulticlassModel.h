@@ -79,6 +79,15 @@ class CMulticlassModel : public CStructuredModel
 		 */
 		virtual CResultSet* argmax(SGVector< float64_t > w, int32_t feat_idx, bool const training = true);
 
+		/** fixes the number of classes from the training labels
+		 *
+		 * @param w weight vector
+		 */
+		virtual void init_argmax(SGVector< float64_t > w);
+
+		/** @return true, argmax can be called concurrently for different examples */
+		virtual bool is_argmax_thread_safe() const { return true; }
+
 		/** computes \f$ \Delta(y_{1}, y_{2}) \f$
 		 *
 		 * @param y1 an instance of structured data
@@ -47,12 +47,14 @@ void CStochasticSOSVM::init()
 	SG_ADD(&m_do_weighted_averaging, "do_weighted_averaging", "Do weighted averaging", MS_NOT_AVAILABLE);
 	SG_ADD(&m_debug_multiplier, "debug_multiplier", "Debug multiplier", MS_NOT_AVAILABLE);
 	SG_ADD(&m_rand_seed, "rand_seed", "Random seed", MS_NOT_AVAILABLE);
+	SG_ADD(&m_batch_size, "batch_size", "Mini-batch size", MS_NOT_AVAILABLE);
 
 	m_lambda = 1.0;
 	m_num_iter = 50;
 	m_do_weighted_averaging = true;
 	m_debug_multiplier = 0;
 	m_rand_seed = 1;
+	m_batch_size = 1;
 }
 
 CStochasticSOSVM::~CStochasticSOSVM()
@@ -110,6 +112,20 @@ bool CStochasticSOSVM::train_machine(CFeatures* data)
 
 	CMath::init_random(m_rand_seed);
 
+	if (m_batch_size > 1)
+	{
+		train_mini_batch(w_avg);
+
+		if (m_do_weighted_averaging)
+			m_w = w_avg.clone();
+
+		if (m_verbose)
+			m_helper->terminate();
+
+		SG_DEBUG("Leaving CStochasticSOSVM::train_machine.\n");
+		return true;
+	}
+
 	// Main loop
 	int32_t k = 0;
 	for (int32_t pi = 0; pi < m_num_iter; ++pi)
@@ -198,6 +214,67 @@ bool CStochasticSOSVM::train_machine(CFeatures* data)
 	return true;
 }
 
+void CStochasticSOSVM::train_mini_batch(SGVector<float64_t> w_avg)
+{
+	int32_t M = m_w.vlen;
+	int32_t N = CLabelsFactory::to_structured(m_labels)->get_num_labels();
+
+	SGVector<int32_t> perm(N);
+	SGVector<float64_t> psi_sum(M);
+	int32_t k = 0;
+	for (int32_t pi = 0; pi < m_num_iter; ++pi)
+	{
+		// 1) Random order of the examples, a batch holds distinct examples
+		perm.range_fill();
+		CMath::permute(perm);
+
+		for (int32_t bi = 0; bi < N; bi += m_batch_size)
+		{
+			SGVector<int32_t> batch(perm.vector+bi,
+				CMath::min(m_batch_size, N-bi), false);
+
+			// 2) solve the loss-augmented inference for the batch at the
+			// current w and sum up psi_i(y) := phi(x_i,y_i) - phi(x_i, y)
+			float64_t score = 0, delta = 0;
+			psi_sum.zero();
+			solve_oracles(m_w, batch, psi_sum.vector, score, delta);
+
+			// 3) step-size gamma
+			float64_t gamma = 1.0 / (k+1.0);
+
+			// 4) update the weights with the averaged subgradient
+			SGVector<float64_t>::add(m_w.vector,
+				1.0-gamma, m_w.vector, gamma/(m_lambda*batch.vlen),
+				psi_sum.vector, m_w.vlen);
+
+			// 5) Optionally, update the weighted average
+			if (m_do_weighted_averaging)
+			{
+				float64_t rho = 2.0 / (k+2.0);
+				SGVector<float64_t>::add(w_avg.vector,
+					1.0-rho, w_avg.vector, rho, m_w.vector, w_avg.vlen);
+			}
+
+			k += 1;
+		}
+
+		// Debug: compute objective and training error after each pass
+		if (m_verbose)
+		{
+			SGVector<float64_t> w_debug = m_do_weighted_averaging ?
+				w_avg.clone() : m_w.clone();
+
+			float64_t primal = CSOSVMHelper::primal_objective(w_debug, m_model, m_lambda);
+			float64_t train_error = CSOSVMHelper::average_loss(w_debug, m_model);
+
+			SG_DEBUG("pass %d (iteration %d), SVM primal = %f, train_error = %f \n",
+				pi, k, primal, train_error);
+
+			m_helper->add_debug_info(primal, pi+1.0, train_error);
+		}
+	}
+}
+
 float64_t CStochasticSOSVM::get_lambda() const
 {
 	return m_lambda;
@@ -238,3 +315,15 @@ void CStochasticSOSVM::set_rand_seed(uint32_t rand_seed)
 	m_rand_seed = rand_seed;
 }
 
+
+int32_t CStochasticSOSVM::get_batch_size() const
+{
+	return m_batch_size;
+}
+
+void CStochasticSOSVM::set_batch_size(int32_t batch_size)
+{
+	REQUIRE(batch_size > 0, "%s::set_batch_size(): batch size (%d) must be "
+		"positive!\n", get_name(), batch_size);
+	m_batch_size = batch_size;
+}
@@ -93,6 +93,20 @@ public:
 	 */
 	void set_rand_seed(uint32_t rand_seed);
 
+	/** @return mini-batch size */
+	int32_t get_batch_size() const;
+
+	/** set mini-batch size. With a batch size larger than one, each pass
+	 * visits the examples in a random order in batches whose loss-augmented
+	 * inference problems are all solved at the same w (in parallel if the
+	 * model's argmax is thread safe); w then takes one step along the
+	 * averaged subgradient of the batch. Debug information is computed
+	 * after each pass in this mode.
+	 *
+	 * @param batch_size number of examples per step (default: 1)
+	 */
+	void set_batch_size(int32_t batch_size);
+
 protected:
 	/** train primal SO-SVM
 	 *
@@ -101,6 +115,12 @@ protected:
 	 */
 	virtual bool train_machine(CFeatures* data = NULL);
 
+	/** mini-batch passes, see set_batch_size
+	 *
+	 * @param w_avg weighted average of the iterates (updated in place)
+	 */
+	void train_mini_batch(SGVector<float64_t> w_avg);
+
 private:
 	/** register and initialize parameters */
 	void init();
@@ -126,6 +146,9 @@ private:
 	 */
 	int32_t m_debug_multiplier;
 
+	/** Number of examples per step (default: 1) */
+	int32_t m_batch_size;
+
 }; /* CStochasticSOSVM */
 
 } /* namespace shogun */
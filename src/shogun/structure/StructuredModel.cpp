@@ -180,6 +180,16 @@ void CStructuredModel::init_training()
 	// Nothing to do here
 }
 
+void CStructuredModel::init_argmax(SGVector< float64_t > w)
+{
+	// Nothing to do here
+}
+
+bool CStructuredModel::is_argmax_thread_safe() const
+{
+	return false;
+}
+
 bool CStructuredModel::check_training_setup() const
 {
 	// Nothing to do here
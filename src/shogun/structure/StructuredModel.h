@@ -238,6 +238,24 @@ class CStructuredModel : public CSGObject
 		 */
 		virtual CResultSet* argmax(SGVector< float64_t > w, int32_t feat_idx, bool const training = true) = 0;
 
+		/** prepares the model for a series of argmax calls with the same
+		 * weight vector, e.g. to update parameters shared by all examples.
+		 * In this class this method is empty.
+		 *
+		 * @param w weight vector
+		 */
+		virtual void init_argmax(SGVector< float64_t > w);
+
+		/** whether argmax may be called concurrently for different training
+		 * examples once init_argmax has been called with the same weight
+		 * vector. Models that keep no state between argmax calls should
+		 * re-implement this method to return true, so that SO machines can
+		 * solve the loss-augmented inference problems in parallel.
+		 *
+		 * @return false in this class
+		 */
+		virtual bool is_argmax_thread_safe() const;
+
 		/** computes \f$ \Delta(y_{\text{true}}, y_{\text{pred}}) \f$
 		 *
 		 * @param ytrue_idx index of the true label in labels
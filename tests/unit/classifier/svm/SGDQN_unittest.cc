@@ -0,0 +1,47 @@
+#include <shogun/classifier/svm/SGDQN.h>
+#include <shogun/features/DataGenerator.h>
+#include <shogun/features/DenseFeatures.h>
+#include <shogun/labels/BinaryLabels.h>
+#include <gtest/gtest.h>
+
+using namespace shogun;
+
+#ifdef HAVE_LAPACK
+TEST(SGDQNTest, train_float32_weights)
+{
+	index_t num_samples = 100;
+	CMath::init_random(5);
+	SGMatrix<float64_t> data =
+		CDataGenerator::generate_gaussians(num_samples, 2, 2);
+	SGMatrix<float32_t> data32(data.num_rows, data.num_cols);
+	for (index_t i = 0; i < data.num_rows*data.num_cols; ++i)
+		data32.matrix[i] = data.matrix[i];
+
+	SGVector<float64_t> labels(data.num_cols);
+	for (index_t i = 0; i < data.num_cols; ++i)
+		labels[i] = (i < data.num_cols/2) ? 1.0 : -1.0;
+
+	CDenseFeatures<float32_t>* features = new CDenseFeatures<float32_t>(data32);
+	CBinaryLabels* ground_truth = new CBinaryLabels(labels);
+
+	CSGDQN* sgdqn = new CSGDQN(1.0, features, ground_truth);
+	sgdqn->train();
+	SGVector<float64_t> w = sgdqn->get_w().clone();
+	float64_t bias = sgdqn->get_bias();
+
+	sgdqn->set_float32_weights(true);
+	sgdqn->train();
+	SGVector<float64_t> w32 = sgdqn->get_w();
+
+	EXPECT_NEAR(bias, sgdqn->get_bias(), 1e-3);
+	for (index_t i = 0; i < w.vlen; ++i)
+		EXPECT_NEAR(w[i], w32[i], 1e-3);
+
+	CBinaryLabels* pred = sgdqn->apply_binary(features);
+	for (index_t i = 0; i < data.num_cols; ++i)
+		EXPECT_EQ(ground_truth->get_int_label(i), pred->get_int_label(i));
+
+	SG_UNREF(pred);
+	SG_UNREF(sgdqn);
+}
+#endif // HAVE_LAPACK
@@ -49,6 +49,38 @@ TEST(SVMOcasTest,train)
 	SG_UNREF(test_feats);
 	SG_UNREF(pred);
 }
+
+TEST(SVMOcasTest,train_parallel)
+{
+	index_t num_samples = 200;
+	CMath::init_random(7);
+	SGMatrix<float64_t> data =
+		CDataGenerator::generate_gaussians(num_samples, 2, 10);
+	CDenseFeatures<float64_t>* features = new CDenseFeatures<float64_t>(data);
+	SGVector<float64_t> labels(data.num_cols);
+	for (index_t i = 0; i < data.num_cols; ++i)
+		labels[i] = (i < data.num_cols/2) ? 1.0 : -1.0;
+	CBinaryLabels* ground_truth = new CBinaryLabels(labels);
+
+	CSVMOcas* ocas = new CSVMOcas(1.0, features, ground_truth);
+	ocas->parallel->set_num_threads(1);
+	ocas->set_epsilon(1e-5);
+	ocas->train();
+	SGVector<float64_t> w = ocas->get_w().clone();
+	float64_t bias = ocas->get_bias();
+	float64_t objective = ocas->compute_primal_objective();
+
+	ocas->parallel->set_num_threads(4);
+	ocas->train();
+	SGVector<float64_t> w_parallel = ocas->get_w();
+
+	EXPECT_NEAR(objective, ocas->compute_primal_objective(), 1e-8);
+	EXPECT_NEAR(bias, ocas->get_bias(), 1e-6);
+	for (index_t i = 0; i < w.vlen; ++i)
+		EXPECT_NEAR(w[i], w_parallel[i], 1e-6);
+
+	SG_UNREF(ocas);
+}
 #endif // HAVE_LAPACK
 #endif //USE_GPL_SHOGUN
 
@@ -0,0 +1,64 @@
+#include <shogun/classifier/svm/WDSVMOcas.h>
+#include <shogun/features/StringFeatures.h>
+#include <shogun/lib/SGStringList.h>
+#include <shogun/labels/BinaryLabels.h>
+#include <shogun/mathematics/Math.h>
+#include <gtest/gtest.h>
+
+using namespace shogun;
+
+#ifdef USE_GPL_SHOGUN
+TEST(WDSVMOcasTest,train_parallel)
+{
+	index_t num_strings = 100, length = 30;
+	const char* acgt = "ACGT";
+	CMath::init_random(17);
+
+	SGStringList<char> strings(num_strings, length);
+	SGVector<float64_t> labels(num_strings);
+	for (index_t i = 0; i < num_strings; ++i)
+	{
+		strings.strings[i] = SGString<char>(length);
+		for (index_t j = 0; j < length; ++j)
+			strings.strings[i].string[j] = acgt[CMath::random(0, 3)];
+
+		/* plant a motif in the positive examples */
+		labels[i] = i % 2 ? 1.0 : -1.0;
+		if (labels[i] > 0)
+			memcpy(strings.strings[i].string + length/2, "GATTACA", 7);
+	}
+
+	CStringFeatures<char>* char_feats = new CStringFeatures<char>(strings, DNA);
+	CStringFeatures<uint8_t>* feats = new CStringFeatures<uint8_t>(RAWDNA);
+	feats->obtain_from_char(char_feats, 0, 1, 0, false);
+	SG_REF(feats);
+	CBinaryLabels* lab = new CBinaryLabels(labels);
+
+	/* training works on one string per position, applying on one per example */
+	CStringFeatures<uint8_t>* train_feats = feats->get_transposed();
+	SG_REF(train_feats);
+
+	CWDSVMOcas* ocas = new CWDSVMOcas(1.0, 5, 5, train_feats, lab);
+	ocas->set_epsilon(1e-5);
+	ocas->parallel->set_num_threads(1);
+	ocas->train(train_feats);
+	CBinaryLabels* out = (CBinaryLabels*) ocas->apply(feats);
+
+	ocas->parallel->set_num_threads(4);
+	ocas->train(train_feats);
+	CBinaryLabels* out_parallel = (CBinaryLabels*) ocas->apply(feats);
+
+	for (index_t i = 0; i < num_strings; ++i)
+	{
+		EXPECT_NEAR(out->get_value(i), out_parallel->get_value(i), 1e-4);
+		EXPECT_EQ(lab->get_int_label(i), out_parallel->get_int_label(i));
+	}
+
+	SG_UNREF(out);
+	SG_UNREF(out_parallel);
+	SG_UNREF(ocas);
+	SG_UNREF(train_feats);
+	SG_UNREF(feats);
+	SG_UNREF(char_feats);
+}
+#endif //USE_GPL_SHOGUN
@@ -0,0 +1,127 @@
+/*
+ * Copyright (c) The Shogun Machine Learning Toolbox
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation are those
+ * of the authors and should not be interpreted as representing official policies,
+ * either expressed or implied, of the Shogun Development Team.
+ *
+ */
+
+#include <shogun/classifier/vw/VowpalWabbit.h>
+#include <shogun/features/streaming/StreamingVwFeatures.h>
+#include <shogun/io/streaming/StreamingVwFile.h>
+#include <shogun/mathematics/Math.h>
+#include <gtest/gtest.h>
+
+#include <stdio.h>
+
+using namespace shogun;
+
+static void write_separable_data(const char* filename, int32_t num_examples,
+		int32_t dim)
+{
+	CMath::init_random(7);
+	SGVector<float64_t> w_true(dim);
+	for (int32_t j=0; j<dim; j++)
+		w_true[j] = CMath::random(-1.0, 1.0);
+
+	FILE* file = fopen(filename, "w");
+	ASSERT_TRUE(file != NULL);
+	SGVector<float64_t> x(dim);
+	for (int32_t i=0; i<num_examples; i++)
+	{
+		float64_t dot = 0;
+		for (int32_t j=0; j<dim; j++)
+		{
+			x[j] = CMath::random(-1.0, 1.0);
+			dot += w_true[j]*x[j];
+		}
+		fprintf(file, "%d", dot >= 0 ? 1 : -1);
+		for (int32_t j=0; j<dim; j++)
+			fprintf(file, " %d:%f", j+1, x[j]);
+		fprintf(file, "\n");
+	}
+	fclose(file);
+}
+
+static CVowpalWabbit* train_vw(const char* filename, int32_t num_threads)
+{
+	CStreamingVwFile* file = new CStreamingVwFile(filename);
+	file->set_parser_type(T_SVMLIGHT);
+	CStreamingVwFeatures* features = new CStreamingVwFeatures(file, true, 1024);
+
+	CVowpalWabbit* vw = new CVowpalWabbit(features);
+	SG_REF(vw);
+	vw->set_adaptive(false);
+	vw->set_num_learner_threads(num_threads);
+	vw->train_machine();
+	file->close();
+
+	return vw;
+}
+
+/* learning a batch concurrently has to give nearly the same model and
+ * exactly the same statistics as learning the stream one by one */
+TEST(VowpalWabbit, learner_threads_match_serial)
+{
+	const char* filename = "vowpalwabbit_unittest.light";
+	const int32_t num_examples = 2000;
+	const int32_t dim = 8;
+	write_separable_data(filename, num_examples, dim);
+
+	CVowpalWabbit* serial = train_vw(filename, 1);
+	CVowpalWabbit* parallel = train_vw(filename, 4);
+
+	CVwEnvironment* serial_env = serial->get_env();
+	CVwEnvironment* parallel_env = parallel->get_env();
+	EXPECT_EQ(num_examples, serial_env->example_number);
+	EXPECT_EQ(serial_env->example_number, parallel_env->example_number);
+	EXPECT_EQ(serial_env->weighted_examples, parallel_env->weighted_examples);
+	EXPECT_EQ(serial_env->weighted_labels, parallel_env->weighted_labels);
+	EXPECT_EQ(serial_env->total_features, parallel_env->total_features);
+
+	float64_t serial_loss = serial_env->sum_loss/serial_env->weighted_examples;
+	float64_t parallel_loss = parallel_env->sum_loss/parallel_env->weighted_examples;
+	EXPECT_GT(serial_loss, 0);
+	EXPECT_NEAR(serial_loss, parallel_loss, 0.05*serial_loss);
+
+	SGVector<float32_t> serial_w = serial->get_w();
+	SGVector<float32_t> parallel_w = parallel->get_w();
+	ASSERT_EQ(serial_w.vlen, parallel_w.vlen);
+	float64_t diff = 0;
+	float64_t norm = 0;
+	for (int32_t i=0; i<serial_w.vlen; i++)
+	{
+		diff += CMath::sq(serial_w[i]-parallel_w[i]);
+		norm += CMath::sq(serial_w[i]);
+	}
+	EXPECT_GT(norm, 0);
+	EXPECT_LT(CMath::sqrt(diff), 0.05*CMath::sqrt(norm));
+
+	SG_UNREF(serial_env);
+	SG_UNREF(parallel_env);
+	SG_UNREF(serial);
+	SG_UNREF(parallel);
+	remove(filename);
+}
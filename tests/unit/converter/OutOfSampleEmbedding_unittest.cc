@@ -0,0 +1,133 @@
+#include <shogun/converter/MultidimensionalScaling.h>
+#include <shogun/converter/OutOfSampleEmbedding.h>
+#include <shogun/distance/EuclideanDistance.h>
+#include <shogun/distance/MinkowskiMetric.h>
+#include <shogun/features/DenseFeatures.h>
+#include <shogun/mathematics/Math.h>
+#include <gtest/gtest.h>
+
+using namespace shogun;
+
+#ifdef HAVE_LAPACK
+/* points on a plane in 3d: MDS yields an isometry of the plane and
+ * barycentric reconstruction weights are preserved by it, so embedded
+ * new points have to keep their mutual distances */
+TEST(OutOfSampleEmbeddingTest,plane_is_embedded_isometrically)
+{
+	const index_t grid = 10;
+	SGMatrix<float64_t> train(3, grid*grid);
+	for (index_t i=0; i<grid; i++)
+	{
+		for (index_t j=0; j<grid; j++)
+		{
+			train(0,i*grid+j) = i;
+			train(1,i*grid+j) = j;
+			train(2,i*grid+j) = 0.5*i-0.25*j;
+		}
+	}
+	CDenseFeatures<float64_t>* train_features = new CDenseFeatures<float64_t>(train);
+
+	const index_t n_test = 4;
+	SGMatrix<float64_t> test(3, n_test);
+	const float64_t coords[n_test][2] = {{2.5,3.5},{4.2,6.7},{7.1,1.9},{5.5,5.5}};
+	for (index_t i=0; i<n_test; i++)
+	{
+		test(0,i) = coords[i][0];
+		test(1,i) = coords[i][1];
+		test(2,i) = 0.5*coords[i][0]-0.25*coords[i][1];
+	}
+	CDenseFeatures<float64_t>* test_features = new CDenseFeatures<float64_t>(test);
+	SG_REF(test_features);
+
+	CMultidimensionalScaling* mds = new CMultidimensionalScaling();
+	mds->set_target_dim(2);
+	COutOfSampleEmbedding* model = mds->fit(train_features, 4);
+	model->set_reconstruction_shift(1e-9);
+	EXPECT_EQ(2, model->get_target_dim());
+	EXPECT_EQ(4, model->get_k());
+	EXPECT_EQ(grid*grid, model->get_embedding().num_cols);
+
+	CDenseFeatures<float64_t>* embedded = model->embed(test_features);
+	EXPECT_EQ(2, embedded->get_num_features());
+	EXPECT_EQ(n_test, embedded->get_num_vectors());
+
+	CEuclideanDistance* original_distance =
+		new CEuclideanDistance(test_features, test_features);
+	CEuclideanDistance* embedded_distance =
+		new CEuclideanDistance(embedded, embedded);
+	for (index_t i=0; i<n_test; i++)
+	{
+		for (index_t j=0; j<n_test; j++)
+		{
+			EXPECT_NEAR(original_distance->distance(i,j),
+					embedded_distance->distance(i,j), 1e-5);
+		}
+	}
+
+	SGVector<float64_t> single = model->embed_vector(test_features->get_feature_vector(1));
+	EXPECT_EQ(2, single.vlen);
+	for (index_t t=0; t<2; t++)
+		EXPECT_NEAR(embedded->get_feature_matrix()(t,1), single[t], 1e-9);
+
+	SG_UNREF(original_distance);
+	SG_UNREF(embedded_distance);
+	SG_UNREF(model);
+	SG_UNREF(mds);
+	SG_UNREF(test_features);
+}
+#endif // HAVE_LAPACK
+
+/* neighbors of Euclidean distance come from a kd-tree, those of the
+ * equivalent Minkowski metric from a scan, both have to agree */
+TEST(OutOfSampleEmbeddingTest,kd_tree_neighbors_match_scan)
+{
+	const index_t dim = 3;
+	const index_t n_train = 200;
+	const index_t n_test = 30;
+	const index_t target_dim = 2;
+
+	CMath::init_random(17);
+	SGMatrix<float64_t> train(dim, n_train);
+	for (index_t i=0; i<dim*n_train; i++)
+		train.matrix[i] = CMath::random(-1.0, 1.0);
+	SGMatrix<float64_t> test(dim, n_test);
+	for (index_t i=0; i<dim*n_test; i++)
+		test.matrix[i] = CMath::random(-1.0, 1.0);
+	SGMatrix<float64_t> embedding(target_dim, n_train);
+	for (index_t i=0; i<target_dim*n_train; i++)
+		embedding.matrix[i] = CMath::random(-1.0, 1.0);
+
+	CDenseFeatures<float64_t>* train_features = new CDenseFeatures<float64_t>(train);
+	CDenseFeatures<float64_t>* test_features = new CDenseFeatures<float64_t>(test);
+	SG_REF(test_features);
+
+	COutOfSampleEmbedding* tree_model = new COutOfSampleEmbedding(
+			train_features, embedding, new CEuclideanDistance(), 5);
+	COutOfSampleEmbedding* scan_model = new COutOfSampleEmbedding(
+			train_features, embedding, new CMinkowskiMetric(2.0), 5);
+	SG_REF(tree_model);
+	SG_REF(scan_model);
+
+	CDenseFeatures<float64_t>* tree_embedded = tree_model->embed(test_features);
+	CDenseFeatures<float64_t>* scan_embedded = scan_model->embed(test_features);
+	SG_REF(tree_embedded);
+	SG_REF(scan_embedded);
+	SGMatrix<float64_t> tree_matrix = tree_embedded->get_feature_matrix();
+	SGMatrix<float64_t> scan_matrix = scan_embedded->get_feature_matrix();
+	for (index_t i=0; i<target_dim*n_test; i++)
+		EXPECT_NEAR(tree_matrix.matrix[i], scan_matrix.matrix[i], 1e-9);
+
+	/* repeated embedding reuses the tree */
+	CDenseFeatures<float64_t>* again = tree_model->embed(test_features);
+	SG_REF(again);
+	SGMatrix<float64_t> again_matrix = again->get_feature_matrix();
+	for (index_t i=0; i<target_dim*n_test; i++)
+		EXPECT_EQ(tree_matrix.matrix[i], again_matrix.matrix[i]);
+
+	SG_UNREF(again);
+	SG_UNREF(tree_embedded);
+	SG_UNREF(scan_embedded);
+	SG_UNREF(tree_model);
+	SG_UNREF(scan_model);
+	SG_UNREF(test_features);
+}
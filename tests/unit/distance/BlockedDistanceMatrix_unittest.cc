@@ -0,0 +1,109 @@
+/*
+ * Copyright (c) The Shogun Machine Learning Toolbox
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation are those
+ * of the authors and should not be interpreted as representing official policies,
+ * either expressed or implied, of the Shogun Development Team.
+ *
+ */
+
+#include <shogun/distance/CosineDistance.h>
+#include <shogun/distance/EuclideanDistance.h>
+#include <shogun/distance/ManhattanMetric.h>
+#include <shogun/features/DenseFeatures.h>
+#include <shogun/mathematics/Math.h>
+#include <gtest/gtest.h>
+
+using namespace shogun;
+
+static CDenseFeatures<float64_t>* random_dense_features(int32_t dim, int32_t num)
+{
+	SGMatrix<float64_t> data(dim, num);
+	for (index_t i=0; i<dim*num; i++)
+		data[i]=CMath::random(-5.0, 5.0);
+
+	return new CDenseFeatures<float64_t>(data);
+}
+
+/* distance matrices cover several blocks and are compared with the
+ * distances computed element by element */
+static void check_distance_matrix(CDistance* distance, float64_t eps)
+{
+	CDenseFeatures<float64_t>* lhs=random_dense_features(7, 300);
+	CDenseFeatures<float64_t>* rhs=random_dense_features(7, 280);
+	SG_REF(lhs);
+
+	distance->init(lhs, rhs);
+	distance->parallel->set_num_threads(4);
+	SGMatrix<float64_t> matrix=distance->get_distance_matrix();
+	ASSERT_EQ(300, matrix.num_rows);
+	ASSERT_EQ(280, matrix.num_cols);
+	for (index_t j=0; j<matrix.num_cols; j++)
+	{
+		for (index_t i=0; i<matrix.num_rows; i++)
+			EXPECT_NEAR(distance->distance(i, j), matrix(i, j), eps);
+	}
+
+	// symmetric matrix into a float32 matrix allocated by the caller
+	distance->init(lhs, lhs);
+	SGMatrix<float32_t> matrix32(300, 300);
+	distance->compute_distance_matrix(matrix32);
+	for (index_t j=0; j<matrix32.num_cols; j++)
+	{
+		for (index_t i=0; i<matrix32.num_rows; i++)
+		{
+			EXPECT_NEAR(distance->distance(i, j), matrix32(i, j), 1E-4);
+			EXPECT_EQ(matrix32(j, i), matrix32(i, j));
+		}
+	}
+
+	SG_UNREF(distance);
+	SG_UNREF(lhs);
+}
+
+TEST(BlockedDistanceMatrix, euclidean)
+{
+	CMath::init_random(17);
+	check_distance_matrix(new CEuclideanDistance(), 1E-10);
+}
+
+TEST(BlockedDistanceMatrix, squared_euclidean)
+{
+	CMath::init_random(17);
+	CEuclideanDistance* distance=new CEuclideanDistance();
+	distance->set_disable_sqrt(true);
+	check_distance_matrix(distance, 1E-10);
+}
+
+TEST(BlockedDistanceMatrix, cosine)
+{
+	CMath::init_random(17);
+	check_distance_matrix(new CCosineDistance(), 1E-12);
+}
+
+TEST(BlockedDistanceMatrix, manhattan)
+{
+	CMath::init_random(17);
+	check_distance_matrix(new CManhattanMetric(), 1E-12);
+}
@@ -8,10 +8,38 @@
  */
 
 #include <shogun/features/DenseFeatures.h>
+#include <shogun/preprocessor/HomogeneousKernelMap.h>
 #include <gtest/gtest.h>
 
 using namespace shogun;
 
+/* dense features that are computed on the fly instead of being stored */
+class CComputedDenseFeatures : public CDenseFeatures<float64_t>
+{
+public:
+	CComputedDenseFeatures(int32_t cache_size, int32_t dim, int32_t n)
+		: CDenseFeatures<float64_t>(cache_size)
+	{
+		set_num_features(dim);
+		set_num_vectors(n);
+	}
+
+	virtual const char* get_name() const { return "ComputedDenseFeatures"; }
+
+protected:
+	virtual float64_t* compute_feature_vector(int32_t num, int32_t& len,
+		float64_t* target)
+	{
+		len=num_features;
+		if (!target)
+			target=SG_MALLOC(float64_t, len);
+
+		for (index_t i=0; i<len; i++)
+			target[i]=num+0.1*(i+1);
+		return target;
+	}
+};
+
 TEST(DenseFeaturesTest,create_merged_copy)
 {
 	/* create two matrices, feature objects for them, call create_merged_copy,
@@ -119,3 +147,87 @@ TEST(DenseFeaturesTest, copy_dimension_subset_with_subsets)
 	SG_UNREF(features);
 	SG_UNREF(f_reduced);
 }
+
+TEST(DenseFeaturesTest, float32_dense_dot_add_to_dense_vec)
+{
+	index_t dim=5;
+	index_t n=4;
+
+	SGMatrix<float32_t> data(dim, n);
+	for (index_t i=0; i<dim*n; ++i)
+		data.matrix[i]=i-7;
+
+	CDenseFeatures<float32_t>* features=new CDenseFeatures<float32_t>(data);
+	CDenseFeatures<float64_t>* features64=new CDenseFeatures<float64_t>(
+		SGMatrix<float64_t>(dim, n));
+	for (index_t i=0; i<dim*n; ++i)
+		features64->get_feature_matrix().matrix[i]=data.matrix[i];
+
+	SGVector<float32_t> w(dim);
+	SGVector<float64_t> w64(dim);
+	for (index_t i=0; i<dim; ++i)
+	{
+		w[i]=0.5*i-1;
+		w64[i]=w[i];
+	}
+
+	CDotFeatures* dot_features[]={features, features64};
+	for (index_t k=0; k<2; ++k)
+	{
+		for (index_t j=0; j<n; ++j)
+		{
+			EXPECT_NEAR(features64->dense_dot(j, w64.vector, dim),
+				dot_features[k]->dense_dot(j, w.vector, dim), 1E-5);
+
+			SGVector<float32_t> result(dim);
+			result.set_const(1);
+			dot_features[k]->add_to_dense_vec(2, j, result.vector, dim, true);
+			for (index_t i=0; i<dim; ++i)
+				EXPECT_NEAR(1+2*CMath::abs(data(i,j)), result[i], 1E-5);
+		}
+	}
+
+	SG_UNREF(features);
+	SG_UNREF(features64);
+}
+
+TEST(DenseFeaturesTest, preprocessor_grows_computed_vector)
+{
+	index_t dim=4;
+	index_t n=3;
+
+	CHomogeneousKernelMap* map=new CHomogeneousKernelMap(
+		HomogeneousKernelChi2, HomogeneousKernelMapWindowRectangular);
+	SG_REF(map);
+
+	/* without a cache the vector is reallocated to the mapped dimension */
+	CComputedDenseFeatures* features=new CComputedDenseFeatures(0, dim, n);
+	features->add_preprocessor(map);
+	for (index_t j=0; j<n; j++)
+	{
+		SGVector<float64_t> raw(dim);
+		for (index_t i=0; i<dim; i++)
+			raw[i]=j+0.1*(i+1);
+		SGVector<float64_t> expected=map->apply_to_feature_vector(raw);
+		ASSERT_GT(expected.vlen, dim);
+
+		int32_t len=0;
+		bool dofree=false;
+		float64_t* vec=features->get_feature_vector(j, len, dofree);
+		ASSERT_EQ(expected.vlen, len);
+		for (index_t i=0; i<len; i++)
+			EXPECT_NEAR(expected[i], vec[i], 1E-12);
+		features->free_feature_vector(vec, j, dofree);
+	}
+	SG_UNREF(features);
+
+	/* cache entries only hold the original dimension */
+	CComputedDenseFeatures* cached=new CComputedDenseFeatures(1, dim, n);
+	cached->add_preprocessor(map);
+	int32_t len=0;
+	bool dofree=false;
+	EXPECT_THROW(cached->get_feature_vector(0, len, dofree), ShogunException);
+	SG_UNREF(cached);
+
+	SG_UNREF(map);
+}
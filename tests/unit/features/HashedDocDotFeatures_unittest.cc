@@ -304,3 +304,64 @@ TEST(HashedDocDotFeaturesTest, quadratic_add_to_dense)
 	SG_UNREF(hddf);
 	SG_FREE(hashes);
 }
+
+TEST(HashedDocDotFeaturesTest, hashed_cache)
+{
+	const char* docs[] = {"You're never too old to rock and roll, if you're too young to die",
+		"Give me some rope, tie me to dream, give me the hope to run out of steam",
+		"Thank you Jack Daniels, Old Number Seven, Tennessee Whiskey got me drinking in heaven"};
+	const index_t num_docs = 3;
+
+	SGStringList<char> list(num_docs, 85);
+	for (index_t i=0; i<num_docs; i++)
+	{
+		index_t len = strlen(docs[i]);
+		list.strings[i] = SGString<char>(len);
+		for (index_t j=0; j<len; j++)
+			list.strings[i].string[j] = docs[i][j];
+	}
+
+	int32_t hash_bits = 6;
+	int32_t dimension = 64;
+
+	CNGramTokenizer* tokenizer = new CNGramTokenizer(4);
+	CStringFeatures<char>* doc_collection = new CStringFeatures<char>(list, RAWBYTE);
+	CHashedDocDotFeatures* hddf = new CHashedDocDotFeatures(hash_bits, doc_collection,
+			tokenizer, true, 2, 1);
+	CHashedDocDotFeatures* cached = (CHashedDocDotFeatures*) hddf->duplicate();
+	cached->build_hashed_cache();
+	EXPECT_FALSE(hddf->has_hashed_cache());
+	EXPECT_TRUE(cached->has_hashed_cache());
+
+	SGVector<float64_t> dense_vec(dimension);
+	for (index_t i=0; i<dimension; i++)
+		dense_vec[i] = CMath::random(-1.0, 1.0);
+
+	for (index_t i=0; i<num_docs; i++)
+	{
+		EXPECT_NEAR(hddf->dense_dot(i, dense_vec.vector, dense_vec.vlen),
+				cached->dense_dot(i, dense_vec.vector, dense_vec.vlen), 1E-10);
+
+		for (index_t j=0; j<num_docs; j++)
+		{
+			float64_t expected = hddf->dot(i, hddf, j);
+			EXPECT_NEAR(cached->dot(i, cached, j), expected, 1E-10);
+			EXPECT_NEAR(cached->dot(i, hddf, j), expected, 1E-10);
+		}
+
+		SGVector<float64_t> sum(dimension);
+		SGVector<float64_t> cached_sum(dimension);
+		sum.zero();
+		cached_sum.zero();
+		hddf->add_to_dense_vec(0.5, i, sum.vector, sum.vlen);
+		cached->add_to_dense_vec(0.5, i, cached_sum.vector, cached_sum.vlen);
+		for (index_t j=0; j<dimension; j++)
+			EXPECT_NEAR(sum[j], cached_sum[j], 1E-10);
+	}
+
+	cached->free_hashed_cache();
+	EXPECT_FALSE(cached->has_hashed_cache());
+
+	SG_UNREF(cached);
+	SG_UNREF(hddf);
+}
@@ -0,0 +1,344 @@
+#include <shogun/features/PackedDNAStringFeatures.h>
+#include <shogun/features/StringFeatures.h>
+#include <shogun/features/hashed/HashedWDFeatures.h>
+#include <shogun/kernel/string/WeightedDegreeStringKernel.h>
+#include <shogun/kernel/normalizer/IdentityKernelNormalizer.h>
+#include <shogun/lib/SGStringList.h>
+#include <shogun/mathematics/Math.h>
+#include <gtest/gtest.h>
+
+using namespace shogun;
+
+static SGStringList<char> generate_dna(int32_t num_strings, int32_t min_len,
+		int32_t max_len, const char* symbols)
+{
+	int32_t num_symbols=strlen(symbols);
+	SGStringList<char> list(num_strings, 0);
+	for (index_t i=0; i<num_strings; i++)
+	{
+		int32_t len=CMath::random(min_len, max_len);
+		list.strings[i]=SGString<char>(len);
+		for (index_t j=0; j<len; j++)
+			list.strings[i].string[j]=symbols[CMath::random(0, num_symbols-1)];
+		list.max_string_length=CMath::max(list.max_string_length, len);
+	}
+	return list;
+}
+
+/* string features take over the strings they are given */
+static SGStringList<char> copy_dna(SGStringList<char> list)
+{
+	SGStringList<char> copy(list.num_strings, list.max_string_length);
+	for (index_t i=0; i<list.num_strings; i++)
+	{
+		copy.strings[i]=SGString<char>(list.strings[i].slen);
+		memcpy(copy.strings[i].string, list.strings[i].string, list.strings[i].slen);
+	}
+	return copy;
+}
+
+static void free_dna(SGStringList<char> list)
+{
+	for (index_t i=0; i<list.num_strings; i++)
+		list.strings[i].free_string();
+}
+
+TEST(PackedDNAStringFeaturesTest, unpack)
+{
+	CMath::init_random(3);
+	SGStringList<char> list=generate_dna(7, 1, 100, "ACGTNacgt");
+	CPackedDNAStringFeatures* f=new CPackedDNAStringFeatures(list);
+	EXPECT_EQ(f->get_num_vectors(), 7);
+	EXPECT_TRUE(f->has_ambiguous_nucleotides());
+
+	for (index_t i=0; i<7; i++)
+	{
+		SGString<char> s=list.strings[i];
+		int32_t len;
+		bool free_vec;
+		char* vec=f->get_feature_vector(i, len, free_vec);
+		ASSERT_EQ(len, s.slen);
+		EXPECT_EQ(f->get_vector_length(i), s.slen);
+		for (index_t j=0; j<len; j++)
+		{
+			EXPECT_EQ(vec[j], toupper(s.string[j]));
+			EXPECT_EQ(f->get_feature(i, j), toupper(s.string[j]));
+		}
+		f->free_feature_vector(vec, i, free_vec);
+	}
+
+	SG_UNREF(f);
+	free_dna(list);
+}
+
+TEST(PackedDNAStringFeaturesTest, subset)
+{
+	CMath::init_random(5);
+	SGStringList<char> list=generate_dna(5, 30, 70, "ACGT");
+	CPackedDNAStringFeatures* f=new CPackedDNAStringFeatures(list);
+	EXPECT_FALSE(f->has_ambiguous_nucleotides());
+
+	SGVector<index_t> subset(2);
+	subset[0]=3;
+	subset[1]=1;
+	f->add_subset(subset);
+	EXPECT_EQ(f->get_num_vectors(), 2);
+	for (index_t i=0; i<2; i++)
+	{
+		SGString<char> s=list.strings[subset[i]];
+		ASSERT_EQ(f->get_vector_length(i), s.slen);
+		SGVector<uint8_t> codes(s.slen);
+		f->get_codes(i, codes.vector, 0, s.slen);
+		for (index_t j=0; j<s.slen; j++)
+			EXPECT_EQ("ACGT"[codes[j]], s.string[j]);
+	}
+
+	SG_UNREF(f);
+	free_dna(list);
+}
+
+template <class ST>
+static void compare_obtain(SGStringList<char> list, int32_t start,
+		int32_t order)
+{
+	CStringFeatures<char>* chars=new CStringFeatures<char>(copy_dna(list), DNA);
+	CPackedDNAStringFeatures* packed=new CPackedDNAStringFeatures(list);
+
+	CStringFeatures<ST>* expected=new CStringFeatures<ST>(DNA);
+	expected->obtain_from_char(chars, start, order, 0, false);
+	CStringFeatures<ST>* result=new CStringFeatures<ST>(DNA);
+	EXPECT_TRUE(result->obtain_from_packed_dna(packed, start, order));
+
+	ASSERT_EQ(expected->get_num_vectors(), result->get_num_vectors());
+	EXPECT_EQ(expected->get_max_vector_length(), result->get_max_vector_length());
+	for (index_t i=0; i<expected->get_num_vectors(); i++)
+	{
+		int32_t len1, len2;
+		bool free1, free2;
+		ST* vec1=expected->get_feature_vector(i, len1, free1);
+		ST* vec2=result->get_feature_vector(i, len2, free2);
+		ASSERT_EQ(len1, len2);
+		for (index_t j=0; j<len1; j++)
+			EXPECT_EQ(vec1[j], vec2[j]);
+		expected->free_feature_vector(vec1, i, free1);
+		result->free_feature_vector(vec2, i, free2);
+	}
+
+	SG_UNREF(result);
+	SG_UNREF(expected);
+	SG_UNREF(packed);
+	SG_UNREF(chars);
+}
+
+TEST(PackedDNAStringFeaturesTest, obtain_from_packed_dna)
+{
+	CMath::init_random(7);
+	SGStringList<char> list=generate_dna(6, 40, 90, "ACGT");
+
+	for (int32_t order=1; order<=8; order+=3)
+	{
+		compare_obtain<uint16_t>(list, 0, order);
+		compare_obtain<uint16_t>(list, order-1, order);
+		compare_obtain<uint16_t>(list, 2, order);
+	}
+
+	for (int32_t order=10; order<=32; order+=11)
+	{
+		compare_obtain<uint64_t>(list, 0, order);
+		compare_obtain<uint64_t>(list, order-1, order);
+	}
+
+	free_dna(list);
+}
+
+TEST(PackedDNAStringFeaturesTest, weighted_degree_kernel)
+{
+	CMath::init_random(11);
+	int32_t num_train=20;
+	int32_t num_test=8;
+	SGStringList<char> train_list=generate_dna(num_train, 45, 45, "ACGT");
+	SGStringList<char> test_list=generate_dna(num_test, 45, 45, "ACGT");
+
+	CStringFeatures<char>* train=new CStringFeatures<char>(train_list, DNA);
+	CStringFeatures<char>* test=new CStringFeatures<char>(test_list, DNA);
+	CPackedDNAStringFeatures* packed_train=new CPackedDNAStringFeatures(train_list);
+	CPackedDNAStringFeatures* packed_test=new CPackedDNAStringFeatures(test_list);
+
+	CWeightedDegreeStringKernel* kernel=new CWeightedDegreeStringKernel(6);
+	kernel->set_normalizer(new CIdentityKernelNormalizer());
+	CWeightedDegreeStringKernel* packed_kernel=new CWeightedDegreeStringKernel(6);
+	packed_kernel->set_normalizer(new CIdentityKernelNormalizer());
+
+	kernel->init(train, test);
+	packed_kernel->init(packed_train, packed_test);
+	for (index_t i=0; i<num_train; i++)
+	{
+		for (index_t j=0; j<num_test; j++)
+			EXPECT_NEAR(kernel->kernel(i, j), packed_kernel->kernel(i, j), 1e-10);
+	}
+
+	SGVector<int32_t> idx(num_train);
+	idx.range_fill();
+	SGVector<float64_t> alphas(num_train);
+	for (index_t i=0; i<num_train; i++)
+		alphas[i]=CMath::random(-1.0, 1.0);
+
+	kernel->init_optimization(num_train, idx.vector, alphas.vector);
+	packed_kernel->init_optimization(num_train, idx.vector, alphas.vector);
+	for (index_t j=0; j<num_test; j++)
+	{
+		EXPECT_NEAR(kernel->compute_optimized(j),
+			packed_kernel->compute_optimized(j), 1e-8);
+	}
+
+	SGVector<int32_t> test_idx(num_test);
+	test_idx.range_fill();
+	SGVector<float64_t> batch(num_test);
+	SGVector<float64_t> packed_batch(num_test);
+	batch.zero();
+	packed_batch.zero();
+	kernel->compute_batch(num_test, test_idx.vector, batch.vector,
+		num_train, idx.vector, alphas.vector);
+	packed_kernel->compute_batch(num_test, test_idx.vector, packed_batch.vector,
+		num_train, idx.vector, alphas.vector);
+	for (index_t j=0; j<num_test; j++)
+		EXPECT_NEAR(batch[j], packed_batch[j], 1e-8);
+
+	SG_UNREF(packed_kernel);
+	SG_UNREF(kernel);
+}
+
+TEST(PackedDNAStringFeaturesTest, copy_subset_and_ambiguous_kmers)
+{
+	CMath::init_random(5);
+	SGStringList<char> list=generate_dna(9, 20, 80, "ACGTN");
+	CPackedDNAStringFeatures* f=new CPackedDNAStringFeatures(list);
+
+	SGVector<index_t> indices(4);
+	indices[0]=7;
+	indices[1]=2;
+	indices[2]=2;
+	indices[3]=5;
+	CPackedDNAStringFeatures* sub=(CPackedDNAStringFeatures*) f->copy_subset(indices);
+	ASSERT_EQ(sub->get_num_vectors(), indices.vlen);
+	for (index_t i=0; i<indices.vlen; i++)
+	{
+		SGString<char> s=list.strings[indices[i]];
+		ASSERT_EQ(sub->get_vector_length(i), s.slen);
+		for (index_t j=0; j<s.slen; j++)
+			EXPECT_EQ(sub->get_feature(i, j), s.string[j]);
+	}
+
+	int32_t k=5;
+	for (index_t i=0; i<list.num_strings; i++)
+	{
+		SGString<char> s=list.strings[i];
+		SGVector<uint16_t> kmers(s.slen);
+		SGVector<bool> ambiguous(s.slen);
+		SGVector<int32_t> lengths(s.slen);
+		int32_t num_kmers=f->get_kmers(i, k, kmers.vector, ambiguous.vector);
+		f->get_unambiguous_lengths(i, lengths.vector);
+		ASSERT_EQ(num_kmers, s.slen-k+1);
+
+		for (index_t p=0; p<s.slen; p++)
+		{
+			int32_t run=0;
+			while (p+run<s.slen && s.string[p+run]!='N')
+				run++;
+			EXPECT_EQ(lengths[p], run);
+			if (p<num_kmers)
+				EXPECT_EQ(ambiguous[p], run<k);
+		}
+	}
+
+	SG_UNREF(sub);
+	SG_UNREF(f);
+	free_dna(list);
+}
+
+static CHashedWDFeatures* hashed_wd_from_bytes(SGStringList<char> list,
+		int32_t order, int32_t start_order=0)
+{
+	CStringFeatures<char>* chars=new CStringFeatures<char>(copy_dna(list), DNA);
+	CStringFeatures<uint8_t>* bytes=new CStringFeatures<uint8_t>(RAWDNA);
+	bytes->obtain_from_char(chars, 0, 1, 0, false);
+	SG_UNREF(chars);
+
+	return new CHashedWDFeatures(bytes, start_order, order, order, 10);
+}
+
+TEST(PackedDNAStringFeaturesTest, hashed_wd_features)
+{
+	CMath::init_random(13);
+	int32_t order=5;
+	SGStringList<char> list=generate_dna(6, 30, 30, "ACGT");
+
+	for (int32_t start_order=0; start_order<=2; start_order+=2)
+	{
+		CHashedWDFeatures* expected=hashed_wd_from_bytes(list, order, start_order);
+		CHashedWDFeatures* result=new CHashedWDFeatures(
+			new CPackedDNAStringFeatures(list), start_order, order, order, 10);
+
+		int32_t dim=expected->get_dim_feature_space();
+		ASSERT_EQ(result->get_dim_feature_space(), dim);
+		SGVector<float64_t> w(dim);
+		for (index_t i=0; i<dim; i++)
+			w[i]=CMath::random(-1.0, 1.0);
+
+		for (index_t i=0; i<list.num_strings; i++)
+		{
+			EXPECT_NEAR(expected->dense_dot(i, w.vector, dim),
+				result->dense_dot(i, w.vector, dim), 1e-10);
+			for (index_t j=0; j<list.num_strings; j++)
+			{
+				EXPECT_NEAR(expected->dot(i, expected, j),
+					result->dot(i, result, j), 1e-10);
+			}
+		}
+
+		SG_UNREF(result);
+		SG_UNREF(expected);
+	}
+	free_dna(list);
+}
+
+/* substrings overlapping an 'N' must not contribute, as if 'N' matched
+ * no other nucleotide */
+TEST(PackedDNAStringFeaturesTest, hashed_wd_features_skip_ambiguous)
+{
+	const char* with_n[3]={ "ACGTNACGTA", "ACGTAACGTA", "NNNNNNNNNN" };
+	const char* with_c[3]={ "ACGTCACGTA", "ACGTAACGTA", "CCCCCCCCCC" };
+	SGStringList<char> list_n(3, 10);
+	SGStringList<char> list_c(3, 10);
+	for (index_t i=0; i<3; i++)
+	{
+		list_n.strings[i]=SGString<char>(10);
+		memcpy(list_n.strings[i].string, with_n[i], 10);
+		list_c.strings[i]=SGString<char>(10);
+		memcpy(list_c.strings[i].string, with_c[i], 10);
+	}
+
+	int32_t order=4;
+	CHashedWDFeatures* packed=new CHashedWDFeatures(
+		new CPackedDNAStringFeatures(list_n), 0, order, order, 10);
+	CHashedWDFeatures* bytes=hashed_wd_from_bytes(list_c, order);
+
+	/* the mismatch at position 4 cuts off the same substrings as the 'N' */
+	EXPECT_NEAR(packed->dot(0, packed, 1), bytes->dot(0, bytes, 1), 1e-10);
+	EXPECT_NEAR(packed->dot(0, packed, 0), packed->dot(0, packed, 1), 1e-10);
+	EXPECT_LT(packed->dot(0, packed, 0), packed->dot(1, packed, 1));
+	EXPECT_EQ(packed->dot(2, packed, 2), 0);
+
+	int32_t dim=packed->get_dim_feature_space();
+	SGVector<float64_t> w(dim);
+	w.zero();
+	packed->add_to_dense_vec(1.0, 0, w.vector, dim);
+	EXPECT_NEAR(packed->dense_dot(0, w.vector, dim),
+		packed->dot(0, packed, 0), 1e-10);
+	EXPECT_EQ(packed->dense_dot(2, w.vector, dim), 0);
+
+	SG_UNREF(bytes);
+	SG_UNREF(packed);
+	free_dna(list_c);
+	free_dna(list_n);
+}
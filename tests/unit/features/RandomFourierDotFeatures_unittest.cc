@@ -171,3 +171,147 @@ TEST(RandomFourierDotFeatures, add_to_dense_test)
 	SG_UNREF(r_feats);
 }
 
+
+TEST(RandomFourierDotFeatures, dense_dot_range_test)
+{
+	int32_t num_dims = 20;
+	int32_t vecs = 600;
+	int32_t D = 150;
+
+	CMath::init_random(17);
+	SGMatrix<float64_t> data(num_dims, vecs);
+	for (index_t i=0; i<num_dims*vecs; i++)
+		data[i] = CMath::random(-1.0, 1.0);
+
+	CDenseFeatures<float64_t>* d_feats = new CDenseFeatures<float64_t>(data);
+	SGVector<float64_t> params(1);
+	params[0] = 8;
+	CRandomFourierDotFeatures* r_feats = new CRandomFourierDotFeatures(
+			d_feats, D, GAUSSIAN, params);
+
+	SGVector<float64_t> w(D);
+	SGVector<float64_t> alphas(vecs);
+	w.range_fill();
+	alphas.range_fill(1.5);
+
+	SGVector<float64_t> output(vecs);
+	r_feats->dense_dot_range(output.vector, 0, vecs, alphas.vector, w.vector, D, 0.5);
+
+	SGMatrix<float64_t> transformed = r_feats->get_transformed_vectors(0, vecs);
+	for (index_t i=0; i<vecs; i++)
+	{
+		float64_t expected = alphas[i]*r_feats->dense_dot(i, w.vector, D)+0.5;
+		EXPECT_NEAR(expected, output[i], 1e-9);
+		for (index_t j=0; j<D; j+=37)
+		{
+			SGVector<float64_t> e_j(D);
+			e_j.zero();
+			e_j[j] = 1;
+			EXPECT_NEAR(r_feats->dense_dot(i, e_j.vector, D), transformed(j,i), 1e-12);
+		}
+	}
+
+	SGVector<int32_t> sub_index(3);
+	sub_index[0] = 599;
+	sub_index[1] = 0;
+	sub_index[2] = 300;
+	SGVector<float64_t> sub_output(3);
+	r_feats->dense_dot_range_subset(sub_index.vector, 3, sub_output.vector,
+			NULL, w.vector, D, 0);
+	for (index_t i=0; i<3; i++)
+		EXPECT_NEAR(r_feats->dense_dot(sub_index[i], w.vector, D), sub_output[i], 1e-9);
+
+	SGVector<float32_t> w32(D);
+	w32.range_fill();
+	SGVector<float64_t> output32(vecs);
+	r_feats->dense_dot_range(output32.vector, 0, vecs, alphas.vector, w32.vector, D, 0.5);
+	for (index_t i=0; i<vecs; i++)
+		EXPECT_NEAR(output[i], output32[i], 1e-9);
+
+	SG_UNREF(r_feats);
+}
+
+TEST(RandomFourierDotFeatures, cache_transformed_test)
+{
+	int32_t num_dims = 10;
+	int32_t vecs = 50;
+	int32_t D = 64;
+
+	CMath::init_random(17);
+	SGMatrix<float64_t> data(num_dims, vecs);
+	for (index_t i=0; i<num_dims*vecs; i++)
+		data[i] = CMath::random(-1.0, 1.0);
+
+	CDenseFeatures<float64_t>* d_feats = new CDenseFeatures<float64_t>(data);
+	SGVector<float64_t> params(1);
+	params[0] = 2;
+	CRandomFourierDotFeatures* r_feats = new CRandomFourierDotFeatures(
+			d_feats, D, GAUSSIAN, params);
+	SGVector<float64_t> w(D);
+	w.range_fill();
+
+	SGVector<float64_t> uncached(vecs);
+	for (index_t i=0; i<vecs; i++)
+		uncached[i] = r_feats->dense_dot(i, w.vector, D);
+	float64_t uncached_dot = r_feats->dot(3, r_feats, 7);
+
+	EXPECT_FALSE(r_feats->get_cache_transformed());
+	r_feats->set_cache_transformed(true);
+	EXPECT_TRUE(r_feats->get_cache_transformed());
+
+	for (index_t i=0; i<vecs; i++)
+		EXPECT_NEAR(uncached[i], r_feats->dense_dot(i, w.vector, D), 1e-10);
+	EXPECT_NEAR(uncached_dot, r_feats->dot(3, r_feats, 7), 1e-12);
+
+	r_feats->set_cache_transformed(false);
+	EXPECT_FALSE(r_feats->get_cache_transformed());
+	SG_UNREF(r_feats);
+}
+
+TEST(RandomFourierDotFeatures, fastfood_kernel_approximation)
+{
+	int32_t num_dims = 12;
+	int32_t vecs = 20;
+	int32_t D = 4096;
+	float64_t width = 4;
+
+	CMath::init_random(17);
+	SGMatrix<float64_t> data(num_dims, vecs);
+	for (index_t i=0; i<num_dims*vecs; i++)
+		data[i] = CMath::random(-0.5, 0.5);
+
+	CDenseFeatures<float64_t>* d_feats = new CDenseFeatures<float64_t>(data);
+	SGVector<float64_t> params(1);
+	params[0] = width;
+	CRandomFourierDotFeatures* r_feats = new CRandomFourierDotFeatures(
+			d_feats, D, GAUSSIAN, params, RFP_FASTFOOD);
+	EXPECT_EQ(RFP_FASTFOOD, r_feats->get_projection());
+	EXPECT_EQ(1, r_feats->get_random_coefficients().num_rows);
+
+	float64_t error = 0;
+	for (index_t i=0; i<vecs; i++)
+	{
+		for (index_t j=0; j<vecs; j++)
+		{
+			float64_t sq_dist = 0;
+			for (index_t k=0; k<num_dims; k++)
+				sq_dist += CMath::sq(data(k,i)-data(k,j));
+
+			error += CMath::abs(r_feats->dot(i, r_feats, j)-CMath::exp(-sq_dist/width));
+		}
+	}
+	EXPECT_LT(error/(vecs*vecs), 0.03);
+
+	SGMatrix<float64_t> transformed = r_feats->get_transformed_vectors(0, vecs);
+	SGVector<float64_t> w(D);
+	w.range_fill();
+	for (index_t i=0; i<vecs; i++)
+	{
+		float64_t expected = 0;
+		for (index_t j=0; j<D; j++)
+			expected += transformed(j,i)*w[j];
+		EXPECT_NEAR(expected, r_feats->dense_dot(i, w.vector, D), 1e-8);
+	}
+
+	SG_UNREF(r_feats);
+}
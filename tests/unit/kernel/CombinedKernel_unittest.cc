@@ -1,5 +1,9 @@
 #include <shogun/kernel/CombinedKernel.h>
 #include <shogun/kernel/GaussianKernel.h>
+#include <shogun/kernel/LinearKernel.h>
+#include <shogun/features/DenseFeatures.h>
+#include <shogun/features/CombinedFeatures.h>
+#include <shogun/mathematics/Math.h>
 #include <shogun/io/SerializableAsciiFile.h>
 #include <gtest/gtest.h>
 
@@ -217,3 +221,104 @@ TEST(CombinedKernelTest,combination)
 	SG_UNREF(combined_list);
 	SG_UNREF(kernel_list);
 }
+
+TEST(CombinedKernelTest,subkernel_rows)
+{
+	CMath::init_random(3);
+	index_t dim=3, num=40;
+	SGMatrix<float64_t> data(dim, num);
+	for (index_t i=0; i<dim*num; i++)
+		data.matrix[i]=CMath::randn_double();
+	CDenseFeatures<float64_t>* feats=new CDenseFeatures<float64_t>(data);
+
+	CCombinedKernel* combined=new CCombinedKernel();
+	combined->append_kernel(new CGaussianKernel(10, 0.5));
+	combined->append_kernel(new CGaussianKernel(10, 2));
+	combined->append_kernel(new CGaussianKernel(10, 8));
+	combined->init(feats, feats);
+
+	SGVector<float64_t> weights(3);
+	weights[0]=0.2;
+	weights[1]=0.3;
+	weights[2]=0.5;
+	combined->set_subkernel_weights(weights);
+
+	for (index_t i=0; i<num; i+=7)
+	{
+		SGMatrix<float64_t> rows=combined->get_subkernel_rows(i);
+		EXPECT_EQ(num, rows.num_rows);
+		EXPECT_EQ(3, rows.num_cols);
+
+		for (index_t k=0; k<3; k++)
+		{
+			CKernel* kn=combined->get_kernel(k);
+			for (index_t j=0; j<num; j++)
+				EXPECT_NEAR(kn->kernel(i, j), rows(j, k), 1e-15);
+			SG_UNREF(kn);
+		}
+
+		/* cached rows stay valid when the weights change */
+		weights[0]+=0.1;
+		combined->set_subkernel_weights(weights);
+		SGMatrix<float64_t> cached=combined->get_subkernel_rows(i);
+		for (index_t j=0; j<num; j++)
+		{
+			float64_t k_ij=0;
+			for (index_t k=0; k<3; k++)
+			{
+				EXPECT_EQ(rows(j, k), cached(j, k));
+				k_ij+=weights[k]*cached(j, k);
+			}
+			EXPECT_NEAR(combined->kernel(i, j), k_ij, 1e-12);
+		}
+	}
+
+	SG_UNREF(combined);
+}
+
+TEST(CombinedKernelTest,compute_by_subkernel_batch)
+{
+	CMath::init_random(5);
+	index_t num=30;
+	SGMatrix<float64_t> data_1(2, num);
+	SGMatrix<float64_t> data_2(4, num);
+	for (index_t i=0; i<2*num; i++)
+		data_1.matrix[i]=CMath::randn_double();
+	for (index_t i=0; i<4*num; i++)
+		data_2.matrix[i]=CMath::randn_double();
+
+	CCombinedFeatures* feats=new CCombinedFeatures();
+	feats->append_feature_obj(new CDenseFeatures<float64_t>(data_1));
+	feats->append_feature_obj(new CDenseFeatures<float64_t>(data_2));
+
+	CCombinedKernel* combined=new CCombinedKernel();
+	combined->append_kernel(new CLinearKernel());
+	combined->append_kernel(new CLinearKernel());
+	combined->init(feats, feats);
+
+	SGVector<float64_t> weights(2);
+	weights[0]=2.0;
+	weights[1]=0.5;
+	combined->set_subkernel_weights(weights);
+
+	combined->clear_normal();
+	for (index_t i=0; i<num; i+=3)
+		combined->add_to_normal(i, CMath::random(-1.0, 1.0));
+
+	SGVector<float64_t> expected(2*num);
+	expected.zero();
+	for (index_t i=0; i<num; i++)
+		combined->compute_by_subkernel(i, &expected[2*i]);
+
+	SGVector<int32_t> vec_idx(num);
+	vec_idx.range_fill();
+	SGVector<float64_t> contrib(2*num);
+	contrib.zero();
+	combined->parallel->set_num_threads(4);
+	combined->compute_by_subkernel_batch(num, vec_idx.vector, contrib.vector);
+
+	for (index_t i=0; i<2*num; i++)
+		EXPECT_NEAR(expected[i], contrib[i], 1e-12);
+
+	SG_UNREF(combined);
+}
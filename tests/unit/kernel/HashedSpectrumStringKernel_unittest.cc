@@ -0,0 +1,144 @@
+#include <shogun/kernel/string/HashedSpectrumStringKernel.h>
+#include <shogun/kernel/string/CommUlongStringKernel.h>
+#include <shogun/kernel/normalizer/IdentityKernelNormalizer.h>
+#include <shogun/preprocessor/SortUlongString.h>
+#include <shogun/features/StringFeatures.h>
+#include <shogun/lib/SGStringList.h>
+#include <shogun/mathematics/Math.h>
+#include <gtest/gtest.h>
+
+using namespace shogun;
+
+static CStringFeatures<uint64_t>* generate_kmers(int32_t num_strings,
+		int32_t len, int32_t k)
+{
+	const char* acgt="ACGT";
+	SGStringList<char> list(num_strings, len);
+	for (index_t i=0; i<num_strings; i++)
+	{
+		list.strings[i]=SGString<char>(len);
+		for (index_t j=0; j<len; j++)
+			list.strings[i].string[j]=acgt[CMath::random(0, 3)];
+	}
+
+	CStringFeatures<char>* chars=new CStringFeatures<char>(list, DNA);
+	CStringFeatures<uint64_t>* kmers=new CStringFeatures<uint64_t>(DNA);
+	kmers->obtain_from_char(chars, k-1, k, 0, false);
+	SG_UNREF(chars);
+	return kmers;
+}
+
+TEST(HashedSpectrumStringKernel, equals_comm_ulong)
+{
+	CMath::init_random(17);
+	CStringFeatures<uint64_t>* feats=generate_kmers(10, 60, 3);
+	SG_REF(feats);
+
+	for (int32_t use_sign=0; use_sign<2; use_sign++)
+	{
+		CHashedSpectrumStringKernel* kernel=new CHashedSpectrumStringKernel(
+				feats, feats, 0, use_sign==1);
+		kernel->set_normalizer(new CIdentityKernelNormalizer());
+		SGMatrix<float64_t> km=kernel->get_kernel_matrix();
+
+		/* CommUlong needs sorted k-mers */
+		CStringFeatures<uint64_t>* sorted=(CStringFeatures<uint64_t>*) feats->duplicate();
+		CSortUlongString* preproc=new CSortUlongString();
+		preproc->init(sorted);
+		sorted->add_preprocessor(preproc);
+		sorted->apply_preprocessor();
+		CCommUlongStringKernel* reference=new CCommUlongStringKernel(
+				sorted, sorted, use_sign==1);
+		reference->set_normalizer(new CIdentityKernelNormalizer());
+		SGMatrix<float64_t> ref_km=reference->get_kernel_matrix();
+
+		for (index_t i=0; i<km.num_rows; i++)
+		{
+			for (index_t j=0; j<km.num_cols; j++)
+				EXPECT_EQ(ref_km(i,j), km(i,j));
+		}
+
+		SG_UNREF(reference);
+		SG_UNREF(kernel);
+	}
+
+	SG_UNREF(feats);
+}
+
+TEST(HashedSpectrumStringKernel, linadd_and_batch)
+{
+	CMath::init_random(3);
+	int32_t num_train=25;
+	int32_t num_test=12;
+	/* 4^20 entries would not fit a dense dictionary */
+	CStringFeatures<uint64_t>* train=generate_kmers(num_train, 80, 20);
+	CStringFeatures<uint64_t>* test=generate_kmers(num_test, 80, 20);
+
+	CHashedSpectrumStringKernel* kernel=new CHashedSpectrumStringKernel(
+			train, test);
+
+	SGVector<int32_t> idx(num_train);
+	idx.range_fill();
+	SGVector<float64_t> alphas(num_train);
+	for (index_t i=0; i<num_train; i++)
+		alphas[i]=CMath::random(-1.0, 1.0);
+
+	SGVector<float64_t> reference(num_test);
+	reference.zero();
+	for (index_t j=0; j<num_test; j++)
+	{
+		for (index_t i=0; i<num_train; i++)
+			reference[j]+=alphas[i]*kernel->kernel(i, j);
+	}
+
+	kernel->init_optimization(num_train, idx.vector, alphas.vector);
+	EXPECT_GT(kernel->get_num_normal_entries(), 0);
+	for (index_t j=0; j<num_test; j++)
+		EXPECT_NEAR(reference[j], kernel->compute_optimized(j), 1e-10);
+
+	kernel->clear_normal();
+	for (index_t i=0; i<num_train; i++)
+		kernel->add_to_normal(i, alphas[i]);
+	for (index_t j=0; j<num_test; j++)
+		EXPECT_NEAR(reference[j], kernel->compute_optimized(j), 1e-10);
+
+	SGVector<int32_t> test_idx(num_test);
+	test_idx.range_fill();
+	SGVector<float64_t> batch(num_test);
+	batch.zero();
+	kernel->compute_batch(num_test, test_idx.vector, batch.vector,
+			num_train, idx.vector, alphas.vector);
+	for (index_t j=0; j<num_test; j++)
+		EXPECT_NEAR(reference[j], batch[j], 1e-10);
+
+	SG_UNREF(kernel);
+}
+
+TEST(HashedSpectrumStringKernel, hashed_upper_bound)
+{
+	CMath::init_random(5);
+	CStringFeatures<uint64_t>* feats=generate_kmers(8, 50, 8);
+	SG_REF(feats);
+
+	CHashedSpectrumStringKernel* exact=new CHashedSpectrumStringKernel(feats, feats);
+	exact->set_normalizer(new CIdentityKernelNormalizer());
+	CHashedSpectrumStringKernel* hashed=new CHashedSpectrumStringKernel(feats, feats, 4);
+	hashed->set_normalizer(new CIdentityKernelNormalizer());
+	EXPECT_EQ(hashed->get_hash_bits(), 4);
+
+	/* collisions only merge nonnegative counts */
+	SGMatrix<float64_t> exact_km=exact->get_kernel_matrix();
+	SGMatrix<float64_t> hashed_km=hashed->get_kernel_matrix();
+	for (index_t i=0; i<exact_km.num_rows; i++)
+	{
+		for (index_t j=0; j<exact_km.num_cols; j++)
+		{
+			EXPECT_GE(hashed_km(i,j), exact_km(i,j));
+			EXPECT_EQ(hashed_km(i,j), hashed_km(j,i));
+		}
+	}
+
+	SG_UNREF(hashed);
+	SG_UNREF(exact);
+	SG_UNREF(feats);
+}
@@ -0,0 +1,134 @@
+#include <shogun/kernel/NystromApproximation.h>
+#include <shogun/kernel/GaussianKernel.h>
+#include <shogun/features/DenseFeatures.h>
+#include <shogun/labels/RegressionLabels.h>
+#include <shogun/regression/KernelRidgeRegression.h>
+#include <shogun/mathematics/Math.h>
+#include <gtest/gtest.h>
+
+using namespace shogun;
+
+static CDenseFeatures<float64_t>* generate_nystrom_features(index_t num)
+{
+	CMath::init_random(5);
+	SGMatrix<float64_t> data(2, num);
+	for (index_t i=0; i<2*num; i++)
+		data.matrix[i]=CMath::normal_random(0.0, 1.0);
+	return new CDenseFeatures<float64_t>(data);
+}
+
+static void check_exact_approximation(ENystromLandmarkSelection selection)
+{
+	const index_t num=20;
+	CDenseFeatures<float64_t>* features=generate_nystrom_features(num);
+	CGaussianKernel* kernel=new CGaussianKernel(10, 2.0);
+	CNystromApproximation* nystrom=new CNystromApproximation(kernel, num, selection);
+	nystrom->compute(features);
+
+	SGVector<index_t> landmarks=nystrom->get_landmarks();
+	EXPECT_EQ(num, landmarks.vlen);
+	SGMatrix<float64_t> factor=nystrom->get_factor();
+	EXPECT_EQ(num, factor.num_rows);
+	EXPECT_EQ(nystrom->get_rank(), factor.num_cols);
+
+	// with all vectors as landmarks approximation is exact
+	kernel->init(features, features);
+	for (index_t i=0; i<num; i++)
+	{
+		for (index_t j=0; j<num; j++)
+		{
+			float64_t approximated=0;
+			for (index_t r=0; r<factor.num_cols; r++)
+				approximated+=factor(i,r)*factor(j,r);
+			EXPECT_NEAR(kernel->kernel(i,j), approximated, 1e-6);
+		}
+	}
+
+	// mapping training features again reproduces the factor
+	SGMatrix<float64_t> recomputed=nystrom->compute_factor(features);
+	for (index_t i=0; i<num*factor.num_cols; i++)
+		EXPECT_NEAR(factor.matrix[i], recomputed.matrix[i], 1e-9);
+
+	SG_UNREF(nystrom);
+}
+
+TEST(NystromApproximation, uniform_all_landmarks_exact)
+{
+	check_exact_approximation(NLS_UNIFORM);
+}
+
+TEST(NystromApproximation, kmeans_plus_plus_all_landmarks_exact)
+{
+	check_exact_approximation(NLS_KMEANS_PLUS_PLUS);
+}
+
+TEST(NystromApproximation, leverage_scores_all_landmarks_exact)
+{
+	check_exact_approximation(NLS_LEVERAGE_SCORES);
+}
+
+TEST(NystromApproximation, landmarks_are_distinct)
+{
+	const index_t num=50;
+	const index_t num_landmarks=10;
+	CDenseFeatures<float64_t>* features=generate_nystrom_features(num);
+	CGaussianKernel* kernel=new CGaussianKernel(10, 2.0);
+	CNystromApproximation* nystrom=new CNystromApproximation(kernel,
+			num_landmarks, NLS_LEVERAGE_SCORES);
+	nystrom->compute(features);
+
+	SGVector<index_t> landmarks=nystrom->get_landmarks();
+	EXPECT_EQ(num_landmarks, landmarks.vlen);
+	SGVector<bool> used(num);
+	used.set_const(false);
+	for (index_t i=0; i<landmarks.vlen; i++)
+	{
+		EXPECT_GE(landmarks[i], 0);
+		EXPECT_LT(landmarks[i], num);
+		EXPECT_FALSE(used[landmarks[i]]);
+		used[landmarks[i]]=true;
+	}
+	EXPECT_EQ(num, nystrom->get_factor().num_rows);
+	EXPECT_LE(nystrom->get_rank(), num_landmarks);
+
+	SG_UNREF(nystrom);
+}
+
+TEST(NystromApproximation, kernel_ridge_regression_all_landmarks)
+{
+	const index_t num=30;
+	CDenseFeatures<float64_t>* features=generate_nystrom_features(num);
+	SG_REF(features);
+	SGVector<float64_t> targets(num);
+	for (index_t i=0; i<num; i++)
+	{
+		SGVector<float64_t> vec=features->get_feature_vector(i);
+		targets[i]=CMath::sin(vec[0])+vec[1];
+	}
+	CRegressionLabels* labels=new CRegressionLabels(targets);
+	SG_REF(labels);
+
+	CGaussianKernel* kernel=new CGaussianKernel(10, 2.0);
+	CKernelRidgeRegression* krr=new CKernelRidgeRegression(0.1, kernel, labels);
+	krr->train(features);
+	CRegressionLabels* predictions=krr->apply_regression(features);
+
+	CGaussianKernel* approximated_kernel=new CGaussianKernel(10, 2.0);
+	CKernelRidgeRegression* approximated_krr=new CKernelRidgeRegression(0.1,
+			approximated_kernel, labels);
+	approximated_krr->set_approximation(new CNystromApproximation(approximated_kernel,
+			num, NLS_UNIFORM));
+	approximated_krr->train(features);
+	EXPECT_EQ(num, approximated_krr->get_support_vectors().vlen);
+	CRegressionLabels* approximated_predictions=approximated_krr->apply_regression(features);
+
+	for (index_t i=0; i<num; i++)
+		EXPECT_NEAR(predictions->get_label(i), approximated_predictions->get_label(i), 1e-6);
+
+	SG_UNREF(predictions);
+	SG_UNREF(approximated_predictions);
+	SG_UNREF(krr);
+	SG_UNREF(approximated_krr);
+	SG_UNREF(labels);
+	SG_UNREF(features);
+}
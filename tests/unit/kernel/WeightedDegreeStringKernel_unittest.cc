@@ -0,0 +1,159 @@
+#include <shogun/kernel/string/WeightedDegreeStringKernel.h>
+#include <shogun/kernel/normalizer/IdentityKernelNormalizer.h>
+#include <shogun/features/StringFeatures.h>
+#include <shogun/lib/SGStringList.h>
+#include <shogun/mathematics/Math.h>
+#include <gtest/gtest.h>
+
+using namespace shogun;
+
+static CStringFeatures<char>* generate_dna(int32_t num_strings, int32_t len)
+{
+	const char* acgt="ACGT";
+	SGStringList<char> list(num_strings, len);
+	for (index_t i=0; i<num_strings; i++)
+	{
+		list.strings[i]=SGString<char>(len);
+		for (index_t j=0; j<len; j++)
+			list.strings[i].string[j]=acgt[CMath::random(0, 3)];
+	}
+	return new CStringFeatures<char>(list, DNA);
+}
+
+TEST(WeightedDegreeStringKernel, compact_tries_compute_optimized)
+{
+	CMath::init_random(17);
+	int32_t num_train=30;
+	int32_t num_test=10;
+	int32_t len=40;
+
+	CStringFeatures<char>* train=generate_dna(num_train, len);
+	CStringFeatures<char>* test=generate_dna(num_test, len);
+	SG_REF(train);
+	SG_REF(test);
+
+	for (int32_t degree=1; degree<=20; degree+=19)
+	{
+		CWeightedDegreeStringKernel* kernel=new CWeightedDegreeStringKernel(degree);
+		kernel->set_normalizer(new CIdentityKernelNormalizer());
+		kernel->init(train, test);
+
+		SGVector<int32_t> idx(num_train);
+		SGVector<float64_t> alphas(num_train);
+		for (index_t i=0; i<num_train; i++)
+		{
+			idx[i]=i;
+			alphas[i]=CMath::random(-1.0, 1.0);
+		}
+
+		SGVector<float64_t> reference(num_test);
+		reference.zero();
+		for (index_t j=0; j<num_test; j++)
+		{
+			for (index_t i=0; i<num_train; i++)
+				reference[j]+=alphas[i]*kernel->kernel(i, j);
+		}
+
+		kernel->set_use_compact_tries(false);
+		kernel->init_optimization(num_train, idx.vector, alphas.vector);
+		SGVector<float64_t> by_trie(num_test);
+		for (index_t j=0; j<num_test; j++)
+			by_trie[j]=kernel->compute_optimized(j);
+
+		kernel->set_use_compact_tries(true);
+		kernel->init_optimization(num_train, idx.vector, alphas.vector);
+		for (index_t j=0; j<num_test; j++)
+		{
+			float64_t by_compact=kernel->compute_optimized(j);
+			EXPECT_NEAR(by_trie[j], by_compact, 1e-5);
+			EXPECT_NEAR(reference[j], by_compact, 1e-5);
+		}
+
+		SGVector<int32_t> test_idx(num_test);
+		test_idx.range_fill();
+		SGVector<float64_t> batch(num_test);
+		batch.zero();
+		kernel->compute_batch(num_test, test_idx.vector, batch.vector,
+			num_train, idx.vector, alphas.vector);
+		for (index_t j=0; j<num_test; j++)
+			EXPECT_NEAR(reference[j], batch[j], 1e-5);
+
+		SG_UNREF(kernel);
+	}
+
+	SG_UNREF(train);
+	SG_UNREF(test);
+}
+
+TEST(WeightedDegreeStringKernel, compact_tries_release_trie)
+{
+	CMath::init_random(17);
+	int32_t num_train=30;
+	int32_t num_test=10;
+	int32_t len=40;
+	int32_t degree=8;
+
+	CStringFeatures<char>* train=generate_dna(num_train, len);
+	CStringFeatures<char>* test=generate_dna(num_test, len);
+	CWeightedDegreeStringKernel* kernel=new CWeightedDegreeStringKernel(degree);
+	kernel->set_normalizer(new CIdentityKernelNormalizer());
+	kernel->init(train, test);
+
+	SGVector<int32_t> idx(num_train);
+	SGVector<float64_t> alphas(num_train);
+	for (index_t i=0; i<num_train; i++)
+	{
+		idx[i]=i;
+		alphas[i]=CMath::random(-1.0, 1.0);
+	}
+
+	int32_t num_subkernels=kernel->get_num_subkernels();
+	SGMatrix<float64_t> by_trie(num_subkernels, num_test);
+	by_trie.zero();
+
+	kernel->set_use_compact_tries(false);
+	kernel->init_optimization(num_train, idx.vector, alphas.vector);
+	EXPECT_GT(kernel->get_num_used_trie_nodes(), len);
+	for (index_t j=0; j<num_test; j++)
+		kernel->compute_by_subkernel(j, by_trie.get_column_vector(j));
+
+	/* only the root of each tree is left once the compact copy is built */
+	kernel->set_use_compact_tries(true);
+	kernel->init_optimization(num_train, idx.vector, alphas.vector);
+	EXPECT_EQ(len, kernel->get_num_used_trie_nodes());
+
+	/* the subkernel contributions come from the compact copy now */
+	SGVector<float64_t> by_compact(num_subkernels);
+	for (index_t j=0; j<num_test; j++)
+	{
+		by_compact.zero();
+		kernel->compute_by_subkernel(j, by_compact.vector);
+		float64_t sum=0;
+		for (index_t k=0; k<num_subkernels; k++)
+		{
+			EXPECT_NEAR(by_trie(k, j), by_compact[k], 1e-5);
+			sum+=by_compact[k];
+		}
+		EXPECT_NEAR(kernel->compute_optimized(j), sum, 1e-5);
+	}
+
+	int32_t abs_len=0;
+	float64_t* abs_weights=kernel->compute_abs_weights(abs_len);
+	EXPECT_EQ(len, abs_len);
+	EXPECT_GT(SGVector<float64_t>::twonorm(abs_weights, abs_len*4), 0);
+	SG_FREE(abs_weights);
+
+	/* the normal can be rebuilt incrementally once cleared */
+	kernel->clear_normal();
+	for (index_t i=0; i<num_train; i++)
+		kernel->add_to_normal(idx[i], alphas[i]);
+	for (index_t j=0; j<num_test; j++)
+	{
+		float64_t reference=0;
+		for (index_t i=0; i<num_train; i++)
+			reference+=alphas[i]*kernel->kernel(i, j);
+		EXPECT_NEAR(reference, kernel->compute_optimized(j), 1e-5);
+	}
+
+	SG_UNREF(kernel);
+}
@@ -0,0 +1,155 @@
+#include <shogun/latent/LatentModel.h>
+#include <shogun/labels/BinaryLabels.h>
+#include <shogun/mathematics/Math.h>
+#include <gtest/gtest.h>
+
+using namespace shogun;
+
+namespace
+{
+	/** index of the selected candidate of an example */
+	class CCandidate : public CData
+	{
+		public:
+			CCandidate(int32_t i) : CData(), index(i) {}
+
+			virtual const char* get_name() const { return "Candidate"; }
+
+			int32_t index;
+	};
+
+	/** every example has a fixed set of candidate vectors, the latent
+	 * variable selects one of them */
+	class CCandidateModel : public CLatentModel
+	{
+		public:
+			CCandidateModel(CLatentFeatures* feats, CLatentLabels* labels,
+					SGMatrix<float64_t> candidates, int32_t num_candidates)
+				: CLatentModel(feats, labels), m_candidates(candidates),
+				m_num_candidates(num_candidates), m_num_psi_calls(0)
+			{
+			}
+
+			virtual int32_t get_dim() const { return m_candidates.num_rows; }
+
+			virtual CDotFeatures* get_psi_feature_vectors()
+			{
+				SG_NOTIMPLEMENTED
+				return NULL;
+			}
+
+			virtual SGVector<float64_t> get_psi_feature_vector(index_t idx)
+			{
+				#pragma omp atomic
+				m_num_psi_calls++;
+
+				CCandidate* h = (CCandidate*) m_labels->get_latent_label(idx);
+				SGVector<float64_t> psi(m_candidates.get_column_vector(
+						idx*m_num_candidates + h->index), get_dim(), false);
+				SG_UNREF(h);
+				return psi.clone();
+			}
+
+			virtual CData* infer_latent_variable(const SGVector<float64_t>& w, index_t idx)
+			{
+				int32_t best = 0;
+				float64_t best_score = -CMath::INFTY;
+				for (int32_t c = 0; c < m_num_candidates; ++c)
+				{
+					float64_t score = CMath::dot(w.vector,
+							m_candidates.get_column_vector(idx*m_num_candidates + c), w.vlen);
+					if (score > best_score)
+					{
+						best = c;
+						best_score = score;
+					}
+				}
+				return new CCandidate(best);
+			}
+
+			virtual bool latent_variable_equals(CData* h1, CData* h2) const
+			{
+				return ((CCandidate*) h1)->index == ((CCandidate*) h2)->index;
+			}
+
+			virtual bool is_thread_safe() const { return true; }
+
+			virtual const char* get_name() const { return "CandidateModel"; }
+
+			SGMatrix<float64_t> m_candidates;
+			int32_t m_num_candidates;
+			int32_t m_num_psi_calls;
+	};
+}
+
+TEST(LatentModel, argmax_h_cached_psi)
+{
+	CMath::init_random(42);
+	int32_t dim = 5, num = 50, num_candidates = 4;
+	SGMatrix<float64_t> candidates(dim, num*num_candidates);
+	for (index_t i = 0; i < candidates.num_rows*candidates.num_cols; ++i)
+		candidates.matrix[i] = CMath::randn_double();
+
+	CLatentFeatures* feats = new CLatentFeatures(num);
+	CLatentLabels* labels = new CLatentLabels(num);
+	SGVector<float64_t> y(num);
+	for (index_t i = 0; i < num; ++i)
+	{
+		feats->add_sample(new CData());
+		labels->add_latent_label(new CCandidate(0));
+		y[i] = i % 3 ? 1 : -1;
+	}
+	labels->set_labels(new CBinaryLabels(y));
+
+	CCandidateModel* model = new CCandidateModel(feats, labels, candidates, num_candidates);
+	SG_REF(model);
+	model->cache_psi_features();
+	EXPECT_EQ(num, model->m_num_psi_calls);
+
+	SGVector<float64_t> w(dim);
+	for (index_t i = 0; i < dim; ++i)
+		w[i] = CMath::randn_double();
+
+	model->argmax_h(w);
+	int32_t num_changed = 0;
+	for (index_t i = 0; i < num; ++i)
+	{
+		CCandidate* h = (CCandidate*) labels->get_latent_label(i);
+		CCandidate* expected = (CCandidate*) model->infer_latent_variable(w, i);
+		if (y[i] == 1)
+			EXPECT_EQ(expected->index, h->index);
+		else
+			EXPECT_EQ(0, h->index);
+		if (h->index != 0)
+			num_changed++;
+		SG_UNREF(expected);
+		SG_UNREF(h);
+	}
+
+	/* only the changed examples are recomputed */
+	model->m_num_psi_calls = 0;
+	model->cache_psi_features();
+	EXPECT_EQ(num_changed, model->m_num_psi_calls);
+
+	/* same w, nothing changes */
+	model->argmax_h(w);
+	model->m_num_psi_calls = 0;
+	model->cache_psi_features();
+	EXPECT_EQ(0, model->m_num_psi_calls);
+
+	CDenseFeatures<float64_t>* psi = (CDenseFeatures<float64_t>*) model->get_cached_psi_features();
+	ASSERT_TRUE(psi != NULL);
+	EXPECT_EQ(num, psi->get_num_vectors());
+	for (index_t i = 0; i < num; ++i)
+	{
+		CCandidate* h = (CCandidate*) labels->get_latent_label(i);
+		SGVector<float64_t> v = psi->get_feature_vector(i);
+		for (index_t j = 0; j < dim; ++j)
+			EXPECT_EQ(candidates(j, i*num_candidates + h->index), v[j]);
+		psi->free_feature_vector(v, i);
+		SG_UNREF(h);
+	}
+
+	SG_UNREF(psi);
+	SG_UNREF(model);
+}
@@ -3,6 +3,7 @@ namespace shogun { template <class T> class SGMatrix; }
 namespace shogun { template <class T> class SGSparseVector; }
 namespace shogun { template <class T> class SGVector; }
 
+#include <shogun/lib/Cache.h>
 #include <gtest/gtest.h>
 
 using namespace shogun;
@@ -54,3 +55,93 @@ TEST(MemoryTest,SGMatrix)
 	EXPECT_NE((SGMatrix<float64_t>*) NULL, m);
 	SG_FREE(m);
 }
+
+#ifdef HAVE_CXX11_ATOMIC
+TEST(MemoryTest,accounting_heap)
+{
+	SGMemoryStats before=sg_memory_stats(MEMORY_TAG_HEAP);
+	char* block=SG_MALLOC(char, 1<<20);
+	SGMemoryStats allocated=sg_memory_stats(MEMORY_TAG_HEAP);
+	SG_FREE(block);
+	SGMemoryStats after=sg_memory_stats(MEMORY_TAG_HEAP);
+
+	EXPECT_EQ(before.num_allocs+1, allocated.num_allocs);
+	EXPECT_EQ(allocated.num_frees+1, after.num_frees);
+#ifdef HAVE_MALLOC_USABLE_SIZE
+	EXPECT_GE(allocated.current_bytes, before.current_bytes+(1<<20));
+	EXPECT_GE(allocated.peak_bytes, allocated.current_bytes);
+	EXPECT_EQ(before.current_bytes, after.current_bytes);
+#endif
+}
+
+TEST(MemoryTest,accounting_charge_release)
+{
+	SGMemoryStats before=sg_memory_stats(MEMORY_TAG_KERNEL_CACHE);
+
+	sg_memory_charge(MEMORY_TAG_KERNEL_CACHE, 1000);
+	sg_memory_charge(MEMORY_TAG_KERNEL_CACHE, 500);
+	sg_memory_release(MEMORY_TAG_KERNEL_CACHE, 1000);
+	SGMemoryStats stats=sg_memory_stats(MEMORY_TAG_KERNEL_CACHE);
+
+	EXPECT_EQ(before.current_bytes+500, stats.current_bytes);
+	EXPECT_GE(stats.peak_bytes, before.current_bytes+1500);
+	EXPECT_EQ(before.num_allocs+2, stats.num_allocs);
+	EXPECT_EQ(before.num_frees+1, stats.num_frees);
+
+	sg_memory_reset_peaks();
+	stats=sg_memory_stats(MEMORY_TAG_KERNEL_CACHE);
+	EXPECT_EQ(stats.current_bytes, stats.peak_bytes);
+
+	sg_memory_release(MEMORY_TAG_KERNEL_CACHE, 500);
+	EXPECT_EQ(before.current_bytes, sg_memory_stats(MEMORY_TAG_KERNEL_CACHE).current_bytes);
+}
+
+TEST(MemoryTest,accounting_threads)
+{
+	SGMemoryStats before=sg_memory_stats(MEMORY_TAG_FEATURE_CACHE);
+	const int32_t num=10000;
+
+	#pragma omp parallel for num_threads(4)
+	for (int32_t i=0; i<num; i++)
+	{
+		sg_memory_charge(MEMORY_TAG_FEATURE_CACHE, i);
+		char* block=SG_MALLOC(char, i+1);
+		SG_FREE(block);
+		sg_memory_release(MEMORY_TAG_FEATURE_CACHE, i);
+	}
+
+	SGMemoryStats after=sg_memory_stats(MEMORY_TAG_FEATURE_CACHE);
+	EXPECT_EQ(before.current_bytes, after.current_bytes);
+	EXPECT_EQ(before.num_allocs+num, after.num_allocs);
+	EXPECT_EQ(before.num_frees+num, after.num_frees);
+}
+
+TEST(MemoryTest,accounting_cache)
+{
+	int64_t before=sg_memory_stats(MEMORY_TAG_FEATURE_CACHE).current_bytes;
+
+	CCache<float64_t>* cache=new CCache<float64_t>(1, 10, 100);
+	SG_REF(cache);
+	EXPECT_GE(sg_memory_stats(MEMORY_TAG_FEATURE_CACHE).current_bytes,
+			before+100*10*(int64_t) sizeof(float64_t));
+
+	SG_UNREF(cache);
+	EXPECT_EQ(before, sg_memory_stats(MEMORY_TAG_FEATURE_CACHE).current_bytes);
+}
+
+TEST(MemoryTest,accounting_summary)
+{
+	FILE* file=tmpfile();
+	ASSERT_TRUE(file!=NULL);
+	sg_memory_summary(file);
+
+	rewind(file);
+	char buf[4096];
+	size_t len=fread(buf, 1, sizeof(buf)-1, file);
+	buf[len]='\0';
+	fclose(file);
+
+	for (int32_t i=0; i<MEMORY_TAG_NUM; i++)
+		EXPECT_TRUE(strstr(buf, sg_memory_tag_name((EMemoryTag) i))!=NULL);
+}
+#endif
@@ -0,0 +1,146 @@
+/*
+ * Copyright (c) The Shogun Machine Learning Toolbox
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation are those
+ * of the authors and should not be interpreted as representing official policies,
+ * either expressed or implied, of the Shogun Development Team.
+ *
+ */
+
+
+#include <shogun/lib/SGArena.h>
+#include <shogun/lib/SGVector.h>
+#include <shogun/lib/SGMatrix.h>
+#include <gtest/gtest.h>
+
+#ifdef HAVE_CXX11_ATOMIC
+#include <thread>
+#endif
+
+using namespace shogun;
+
+#ifdef HAVE_CXX11_ATOMIC
+TEST(SGArena, no_scope)
+{
+	EXPECT_TRUE(SGArena::current()==NULL);
+
+	SGVector<float64_t> vec(10);
+	EXPECT_EQ(1, vec.ref_count());
+}
+
+TEST(SGArena, reuse)
+{
+	SGArenaScope scope;
+	SGArena* arena=scope.get_arena();
+	EXPECT_EQ(arena, SGArena::current());
+
+	for (index_t i=0; i<100; i++)
+	{
+		SGVector<float64_t> vec(50);
+		vec.set_const(i);
+		SGMatrix<int32_t> mat(5, 5);
+		mat.set_const(i);
+		EXPECT_EQ(i, vec[49]);
+		EXPECT_EQ(i, mat(4,4));
+	}
+
+	EXPECT_EQ(2, arena->get_num_heap_blocks());
+	EXPECT_EQ(198, arena->get_num_reused_blocks());
+}
+
+TEST(SGArena, nested)
+{
+	SGArenaScope outer;
+	{
+		SGArenaScope inner;
+		EXPECT_EQ(inner.get_arena(), SGArena::current());
+	}
+	EXPECT_EQ(outer.get_arena(), SGArena::current());
+}
+
+TEST(SGArena, shared_refcount)
+{
+	SGArenaScope scope;
+
+	SGVector<float64_t> vec(6);
+	vec.range_fill();
+	{
+		SGVector<float64_t> copy=vec;
+		SGMatrix<float64_t> mat(vec);
+		EXPECT_EQ(3, vec.ref_count());
+		EXPECT_EQ(5, mat(5,0));
+	}
+	EXPECT_EQ(1, vec.ref_count());
+
+	vec.resize_vector(8);
+	EXPECT_EQ(5, vec[5]);
+	EXPECT_EQ(0, vec[7]);
+}
+
+TEST(SGArena, outlive_scope)
+{
+	SGVector<float64_t> vec;
+	SGMatrix<float64_t> mat;
+	{
+		SGArenaScope scope;
+		vec=SGVector<float64_t>(100);
+		vec.set_const(1.0);
+		mat=SGMatrix<float64_t>(10, 10);
+		mat.set_const(2.0);
+		EXPECT_EQ(2, scope.get_arena()->get_num_heap_blocks());
+	}
+
+	EXPECT_EQ(100, SGVector<float64_t>::sum(vec));
+	EXPECT_EQ(200, SGVector<float64_t>::sum(mat.matrix, 100));
+}
+
+TEST(SGArena, large_from_heap)
+{
+	SGArenaScope scope;
+
+	SGVector<uint8_t> vec(SGArena::MAX_DATA_BYTES+1);
+	vec.zero();
+	EXPECT_EQ(0, scope.get_arena()->get_num_heap_blocks());
+}
+
+TEST(SGArena, release_on_other_thread)
+{
+	SGArenaScope scope;
+	SGVector<float64_t> vec(20);
+	vec.set_const(3.0);
+
+	std::thread worker([&vec]()
+	{
+		SGArenaScope worker_scope;
+		EXPECT_EQ(60, SGVector<float64_t>::sum(vec));
+		vec=SGVector<float64_t>();
+	});
+	worker.join();
+	EXPECT_EQ(0, vec.vlen);
+
+	SGVector<float64_t> other(20);
+	EXPECT_EQ(2, scope.get_arena()->get_num_heap_blocks());
+	EXPECT_EQ(0, scope.get_arena()->get_num_reused_blocks());
+}
+#endif // HAVE_CXX11_ATOMIC
@@ -0,0 +1,201 @@
+/*
+ * Copyright (c) The Shogun Machine Learning Toolbox
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation are those
+ * of the authors and should not be interpreted as representing official policies,
+ * either expressed or implied, of the Shogun Development Team.
+ *
+ */
+
+
+#include <shogun/lib/Tracing.h>
+#include <shogun/features/DenseFeatures.h>
+#include <shogun/kernel/GaussianKernel.h>
+#include <gtest/gtest.h>
+
+#include <stdio.h>
+#include <string.h>
+
+#ifdef HAVE_CXX11_ATOMIC
+#include <string>
+#include <thread>
+#endif
+
+using namespace shogun;
+
+#ifdef HAVE_CXX11_ATOMIC
+static void traced_function()
+{
+	SG_TRACE_SCOPE("Tracing.traced_function");
+	SG_TRACE_COUNT("Tracing.counter", 3);
+}
+
+static void traced_hot_function()
+{
+	SG_TRACE_HOT_SCOPE("Tracing.traced_hot_function");
+}
+
+TEST(Tracing, disabled)
+{
+	sg_trace_clear();
+	traced_function();
+
+	SGTraceStats stats=sg_trace_stats("Tracing.traced_function");
+	EXPECT_EQ(0, stats.num_calls);
+	EXPECT_EQ(0, sg_trace_stats("Tracing.counter").num_calls);
+}
+
+TEST(Tracing, scope_and_counter)
+{
+	sg_trace_clear();
+	sg_trace_enable();
+	for (int32_t i=0; i<5; i++)
+		traced_function();
+	sg_trace_enable(false);
+
+	SGTraceStats stats=sg_trace_stats("Tracing.traced_function");
+	EXPECT_EQ(5, stats.num_calls);
+	EXPECT_GE(stats.total, 0);
+
+	stats=sg_trace_stats("Tracing.counter");
+	EXPECT_EQ(5, stats.num_calls);
+	EXPECT_EQ(15, stats.total);
+
+	sg_trace_clear();
+	EXPECT_EQ(0, sg_trace_stats("Tracing.traced_function").num_calls);
+}
+
+TEST(Tracing, threads)
+{
+	sg_trace_clear();
+	sg_trace_enable();
+
+	#pragma omp parallel for num_threads(4)
+	for (int32_t i=0; i<1000; i++)
+		traced_hot_function();
+
+	sg_trace_enable(false);
+	EXPECT_EQ(1000, sg_trace_stats("Tracing.traced_hot_function").num_calls);
+	sg_trace_clear();
+}
+
+/* number of per thread buffers, each is named once in the export */
+static int32_t count_trace_threads()
+{
+	const char* filename="tracing_unittest_threads.json";
+	EXPECT_TRUE(sg_trace_export_chrome(filename));
+
+	std::string content;
+	FILE* file=fopen(filename, "r");
+	if (file)
+	{
+		char buf[4096];
+		size_t len;
+		while ((len=fread(buf, 1, sizeof(buf), file))>0)
+			content.append(buf, len);
+		fclose(file);
+	}
+	remove(filename);
+
+	int32_t num=0;
+	for (size_t pos=content.find("\"thread_name\""); pos!=std::string::npos;
+			pos=content.find("\"thread_name\"", pos+1))
+		num++;
+	return num;
+}
+
+TEST(Tracing, exited_threads_reuse_buffers)
+{
+	sg_trace_clear();
+	sg_trace_enable();
+
+	/* a first thread may add a buffer, the ones after it reuse it */
+	std::thread first(traced_hot_function);
+	first.join();
+	int32_t num_threads=count_trace_threads();
+
+	for (int32_t i=0; i<8; i++)
+	{
+		std::thread thread(traced_hot_function);
+		thread.join();
+	}
+	sg_trace_enable(false);
+
+	EXPECT_EQ(num_threads, count_trace_threads());
+	EXPECT_EQ(9, sg_trace_stats("Tracing.traced_hot_function").num_calls);
+	sg_trace_clear();
+}
+
+TEST(Tracing, kernel)
+{
+	SGMatrix<float64_t> data(2, 10);
+	for (index_t i=0; i<data.num_rows*data.num_cols; i++)
+		data.matrix[i]=i;
+
+	CDenseFeatures<float64_t>* feats=new CDenseFeatures<float64_t>(data);
+	CGaussianKernel* kernel=new CGaussianKernel(feats, feats, 1.0);
+	SG_REF(kernel);
+
+	sg_trace_clear();
+	sg_trace_enable();
+	kernel->kernel(1, 2);
+	kernel->kernel(3, 4);
+	sg_trace_enable(false);
+
+	EXPECT_EQ(2, sg_trace_stats("CKernel::kernel").num_calls);
+
+	sg_trace_clear();
+	SG_UNREF(kernel);
+}
+
+TEST(Tracing, export_chrome)
+{
+	sg_trace_clear();
+	sg_trace_enable();
+	traced_function();
+	traced_hot_function();
+	sg_trace_enable(false);
+
+	const char* filename="tracing_unittest.json";
+	ASSERT_TRUE(sg_trace_export_chrome(filename));
+
+	FILE* file=fopen(filename, "r");
+	ASSERT_TRUE(file!=NULL);
+	char buf[65536];
+	size_t len=fread(buf, 1, sizeof(buf)-1, file);
+	buf[len]='\0';
+	fclose(file);
+	remove(filename);
+
+	EXPECT_TRUE(strstr(buf, "\"traceEvents\"")!=NULL);
+	EXPECT_TRUE(strstr(buf, "\"name\":\"Tracing.traced_function\",\"cat\":\"shogun\",\"ph\":\"X\"")!=NULL);
+	EXPECT_TRUE(strstr(buf, "\"name\":\"Tracing.counter\",\"ph\":\"C\"")!=NULL);
+	EXPECT_TRUE(strstr(buf, "\"name\":\"Tracing.traced_hot_function\",\"calls\":1")!=NULL);
+
+	/* hot scopes are not recorded as events */
+	EXPECT_TRUE(strstr(buf, "\"name\":\"Tracing.traced_hot_function\",\"cat\"")==NULL);
+
+	sg_trace_clear();
+}
+#endif
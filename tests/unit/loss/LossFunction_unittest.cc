@@ -33,6 +33,9 @@
 #include <shogun/loss/AbsoluteDeviationLoss.h>
 #include <shogun/loss/SquaredLoss.h>
 #include <shogun/loss/HuberLoss.h>
+#include <shogun/loss/LogLoss.h>
+#include <shogun/loss/LogLossMargin.h>
+#include <shogun/loss/SquaredHingeLoss.h>
 #include <shogun/lib/SGVector.h>
 #include <shogun/mathematics/Math.h>
 #include <gtest/gtest.h>
@@ -217,3 +220,81 @@ TEST(LossFunction, huber_loss_test)
 
 	SG_UNREF(lossf);
 }
+
+TEST(LossFunction, log_loss_test)
+{
+	SGVector<float64_t> predicted(5);
+	SGVector<float64_t> actual(5);
+	set_values(predicted,actual);
+	for (int32_t i=0;i<5;i++)
+		actual[i]=(i==1 || i==2) ? -1 : 1;
+
+	CLossFunction* lossf=new CLogLoss();
+
+	SGVector<float64_t> loss(5);
+	SGVector<float64_t> firstd(5);
+	SGVector<float64_t> secondd(5);
+	SGVector<float64_t> squareg(5);
+
+	for (int32_t i=0;i<5;i++)
+	{
+		loss[i]=lossf->loss(predicted[i],actual[i]);
+		firstd[i]=lossf->first_derivative(predicted[i],actual[i]);
+		secondd[i]=lossf->second_derivative(predicted[i],actual[i]);
+		squareg[i]=lossf->get_square_grad(predicted[i],actual[i]);
+	}
+
+	float64_t epsilon=1e-7;
+	EXPECT_NEAR(loss[0],1.797282204,epsilon);
+	EXPECT_NEAR(loss[1],1.318821451,epsilon);
+	EXPECT_NEAR(loss[2],3.533026127,epsilon);
+	EXPECT_NEAR(loss[3],0.010136464,epsilon);
+	EXPECT_NEAR(loss[4],2.523763379,epsilon);
+
+	EXPECT_NEAR(firstd[0],-0.834251252,epsilon);
+	EXPECT_NEAR(firstd[1],0.732549680,epsilon);
+	EXPECT_NEAR(firstd[2],0.970783630,epsilon);
+	EXPECT_NEAR(firstd[3],-0.010085263,epsilon);
+	EXPECT_NEAR(firstd[4],-0.919842624,epsilon);
+
+	EXPECT_NEAR(secondd[0],0.138276101,epsilon);
+	EXPECT_NEAR(secondd[1],0.195920646,epsilon);
+	EXPECT_NEAR(secondd[2],0.028362773,epsilon);
+	EXPECT_NEAR(secondd[3],0.009983551,epsilon);
+	EXPECT_NEAR(secondd[4],0.073732171,epsilon);
+
+	EXPECT_NEAR(squareg[0],0.695975152,epsilon);
+	EXPECT_NEAR(squareg[1],0.536629034,epsilon);
+	EXPECT_NEAR(squareg[2],0.942420857,epsilon);
+	EXPECT_NEAR(squareg[3],0.000101713,epsilon);
+	EXPECT_NEAR(squareg[4],0.846110453,epsilon);
+
+	SG_UNREF(lossf);
+}
+
+TEST(LossFunction, margin_loss_derivatives_by_prediction)
+{
+	CLossFunction* losses[]={new CLogLoss(), new CLogLossMargin(),
+		new CSquaredHingeLoss()};
+	float64_t predictions[]={-2.5, -0.3, 0.4, 2.2};
+	float64_t h=1e-5;
+
+	for (int32_t k=0;k<3;k++)
+	{
+		CLossFunction* lossf=losses[k];
+		for (int32_t i=0;i<4;i++)
+		{
+			for (float64_t label=-1;label<=1;label+=2)
+			{
+				float64_t p=predictions[i];
+				float64_t firstd=(lossf->loss(p+h,label)-lossf->loss(p-h,label))/(2*h);
+				float64_t secondd=(lossf->first_derivative(p+h,label)-
+					lossf->first_derivative(p-h,label))/(2*h);
+
+				EXPECT_NEAR(firstd,lossf->first_derivative(p,label),1e-6);
+				EXPECT_NEAR(secondd,lossf->second_derivative(p,label),1e-6);
+			}
+		}
+		SG_UNREF(lossf);
+	}
+}
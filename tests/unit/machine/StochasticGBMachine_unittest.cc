@@ -32,6 +32,7 @@
 #include <shogun/lib/SGMatrix.h>
 #include <shogun/labels/RegressionLabels.h>
 #include <shogun/loss/SquaredLoss.h>
+#include <shogun/loss/LogLoss.h>
 #include <shogun/machine/StochasticGBMachine.h>
 #include <shogun/multiclass/tree/CARTree.h>
 #include <shogun/evaluation/MeanSquaredError.h>
@@ -39,6 +40,37 @@
 
 using namespace shogun;
 
+/* exposes the steps of boosting */
+class CStochasticGBMachineSteps : public CStochasticGBMachine
+{
+public:
+	CStochasticGBMachineSteps(CMachine* machine, CLossFunction* loss,
+		int32_t num_iterations, float64_t learning_rate)
+		: CStochasticGBMachine(machine,loss,num_iterations,learning_rate,1.0)
+	{
+	}
+
+	float64_t newton_multiplier(SGVector<float64_t> f, SGVector<float64_t> hm)
+	{
+		return CStochasticGBMachine::newton_multiplier(f,hm);
+	}
+
+	SGVector<float64_t> pseudo_residuals(SGVector<float64_t> f)
+	{
+		CRegressionLabels* inter_f=new CRegressionLabels(f);
+		CRegressionLabels* residuals=compute_pseudo_residuals(inter_f);
+		SGVector<float64_t> ret=residuals->get_labels();
+		SG_UNREF(residuals);
+		SG_UNREF(inter_f);
+		return ret;
+	}
+
+	float64_t get_multiplier(int32_t i)
+	{
+		return m_gamma->get_element(i);
+	}
+};
+
 SGMatrix<float64_t> get_sinusoid_samples(int32_t num_samples, SGVector<float64_t> labels)
 {
 	SGMatrix<float64_t> ret(1,num_samples);
@@ -119,3 +151,106 @@ TEST(StochasticGBMachine,sinusoid_curve_fitting)
 	SG_UNREF(ret_labels);
 	SG_UNREF(sgbm);
 }
+
+TEST(StochasticGBMachine,squared_loss_newton_multiplier)
+{
+	SGVector<float64_t> lab(3);
+	lab[0]=1;
+	lab[1]=2;
+	lab[2]=3;
+	SGVector<float64_t> f(3);
+	f[0]=0.5;
+	f[1]=1;
+	f[2]=4;
+	SGVector<float64_t> hm(3);
+	hm[0]=1;
+	hm[1]=2;
+	hm[2]=-1;
+
+	CStochasticGBMachineSteps* sgbm=new CStochasticGBMachineSteps(NULL,new CSquaredLoss(),1,1.0);
+	sgbm->set_labels(new CRegressionLabels(lab));
+
+	// residuals are -2(f-y), gamma=sum((y-f)*hm)/sum(hm^2)=3.5/6
+	SGVector<float64_t> res=sgbm->pseudo_residuals(f);
+	EXPECT_NEAR(res[0],1,1e-12);
+	EXPECT_NEAR(res[1],2,1e-12);
+	EXPECT_NEAR(res[2],-2,1e-12);
+	EXPECT_NEAR(sgbm->newton_multiplier(f,hm),3.5/6,1e-12);
+
+	SG_UNREF(sgbm);
+}
+
+TEST(StochasticGBMachine,log_loss_newton_multiplier)
+{
+	SGVector<float64_t> lab(5);
+	lab[0]=1;
+	lab[1]=-1;
+	lab[2]=1;
+	lab[3]=1;
+	lab[4]=-1;
+	SGVector<float64_t> f(5);
+	f[0]=0.2;
+	f[1]=-0.1;
+	f[2]=0.5;
+	f[3]=-0.3;
+	f[4]=0.4;
+	SGVector<float64_t> hm(5);
+	hm[0]=1;
+	hm[1]=-0.5;
+	hm[2]=0.8;
+	hm[3]=1.2;
+	hm[4]=0.3;
+
+	CStochasticGBMachineSteps* sgbm=new CStochasticGBMachineSteps(NULL,new CLogLoss(),1,1.0);
+	sgbm->set_labels(new CRegressionLabels(lab));
+
+	// residuals are y/(1+exp(y*f))
+	SGVector<float64_t> res=sgbm->pseudo_residuals(f);
+	EXPECT_NEAR(res[0],0.450166002688,1e-10);
+	EXPECT_NEAR(res[1],-0.475020812521,1e-10);
+	EXPECT_NEAR(res[2],0.377540668798,1e-10);
+	EXPECT_NEAR(res[3],0.574442516812,1e-10);
+	EXPECT_NEAR(res[4],-0.598687660112,1e-10);
+
+	// minimizer of sum(log(1+exp(-y*(f+gamma*hm)))) over gamma
+	EXPECT_NEAR(sgbm->newton_multiplier(f,hm),2.842667277975,1e-8);
+
+	SG_UNREF(sgbm);
+}
+
+TEST(StochasticGBMachine,incremental_model_update)
+{
+	SGMatrix<float64_t> data(1,4);
+	SGVector<float64_t> lab(4);
+	for (int32_t i=0;i<4;i++)
+	{
+		data(0,i)=i+1;
+		lab[i]=(i<2) ? 1 : 3;
+	}
+	CDenseFeatures<float64_t>* feats=new CDenseFeatures<float64_t>(data);
+
+	SGVector<bool> ft(1);
+	ft[0]=false;
+	CCARTree* tree=new CCARTree(ft,PT_REGRESSION);
+	tree->set_max_depth(1);
+
+	// residuals 2*(y-f) are fit exactly by one split, so the learners are
+	// h1=[2,2,6,6] with gamma 0.5 and h2=[1,1,3,3] with gamma 0.5, which
+	// gives f=0.5*0.5*h1+0.5*0.5*h2
+	CStochasticGBMachineSteps* sgbm=new CStochasticGBMachineSteps(tree,new CSquaredLoss(),2,0.5);
+	sgbm->set_labels(new CRegressionLabels(lab));
+	sgbm->train(feats);
+
+	EXPECT_NEAR(sgbm->get_multiplier(0),0.5,1e-12);
+	EXPECT_NEAR(sgbm->get_multiplier(1),0.5,1e-12);
+
+	CRegressionLabels* ret=sgbm->apply_regression(feats);
+	EXPECT_NEAR(ret->get_label(0),0.75,1e-12);
+	EXPECT_NEAR(ret->get_label(1),0.75,1e-12);
+	EXPECT_NEAR(ret->get_label(2),2.25,1e-12);
+	EXPECT_NEAR(ret->get_label(3),2.25,1e-12);
+
+	SG_UNREF(ret);
+	SG_UNREF(feats);
+	SG_UNREF(sgbm);
+}
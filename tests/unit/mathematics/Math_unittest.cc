@@ -76,6 +76,79 @@ TEST(CMath, parallel_qsort_index_test)
 	SG_FREE(i1);
 }
 
+TEST(CMath, parallel_sort_test)
+{
+	// small limit so that the blocked path and the merge rounds are used
+	index_t size=1003;
+	SGVector<float64_t> v(size);
+	CMath::init_random(17);
+	for (index_t i=0; i<size; i++)
+		v[i]=CMath::random(-100.0, 100.0);
+
+	SGVector<float64_t> ref=v.clone();
+	CMath::qsort(ref.vector, size);
+	CMath::parallel_sort(v.vector, size, 4, 16);
+
+	for (index_t i=0; i<size; i++)
+		EXPECT_EQ(ref[i], v[i]);
+
+	// degenerate sizes
+	CMath::parallel_sort((float64_t*)NULL, 0, 4, 16);
+	float64_t single=3.0;
+	CMath::parallel_sort(&single, 1, 4, 16);
+	EXPECT_EQ(3.0, single);
+}
+
+TEST(CMath, parallel_sort_index_test)
+{
+	index_t size=517;
+	SGVector<int32_t> v(size);
+	SGVector<index_t> idx(size);
+	CMath::init_random(17);
+	for (index_t i=0; i<size; i++)
+	{
+		v[i]=CMath::random(0, 50);
+		idx[i]=i;
+	}
+	SGVector<int32_t> orig=v.clone();
+
+	CMath::parallel_sort_index(v.vector, idx.vector, size, 4, 16);
+	for (index_t i=0; i<size; i++)
+	{
+		EXPECT_EQ(orig[idx[i]], v[i]);
+		if (i>0)
+		{
+			EXPECT_LE(v[i-1], v[i]);
+		}
+	}
+
+	for (index_t i=0; i<size; i++)
+		idx[i]=i;
+	CMath::parallel_sort_backward_index(v.vector, idx.vector, size, 4, 16);
+	for (index_t i=1; i<size; i++)
+		EXPECT_GE(v[i-1], v[i]);
+}
+
+TEST(CMath, parallel_argsort_test)
+{
+	index_t size=300;
+	SGVector<int32_t> v(size);
+	for (index_t i=0; i<size; i++)
+		v[i]=(i*7)%10;
+
+	SGVector<index_t> idx=CMath::parallel_argsort(v, 4, 8);
+	EXPECT_EQ(size, idx.vlen);
+	for (index_t i=1; i<size; i++)
+	{
+		EXPECT_LE(v[idx[i-1]], v[idx[i]]);
+		// ties keep their original order
+		if (v[idx[i-1]]==v[idx[i]])
+		{
+			EXPECT_LT(idx[i-1], idx[i]);
+		}
+	}
+}
+
 TEST(CMath, float64_tests)
 {
 	// round, ceil, floor
@@ -29,6 +29,9 @@
  */
 
 #include <shogun/features/DenseFeatures.h>
+#include <shogun/labels/MulticlassLabels.h>
+#include <shogun/labels/RegressionLabels.h>
+#include <shogun/mathematics/Math.h>
 #include <shogun/lib/SGMatrix.h>
 #include <shogun/multiclass/tree/CARTree.h>
 #include <gtest/gtest.h>
@@ -642,3 +645,95 @@ TEST(CARTree,cv_prune_simple)
 	SG_UNREF(feats);
 	SG_UNREF(root);
 }
+
+typedef CTreeMachineNode<CARTreeNodeData> cart_node_t;
+
+static void expect_same_tree(cart_node_t* a, cart_node_t* b)
+{
+	EXPECT_EQ(a->data.attribute_id, b->data.attribute_id);
+	EXPECT_EQ(a->data.node_label, b->data.node_label);
+	ASSERT_EQ(a->data.transit_into_values.vlen, b->data.transit_into_values.vlen);
+	for (int32_t i=0;i<a->data.transit_into_values.vlen;i++)
+		EXPECT_EQ(a->data.transit_into_values[i], b->data.transit_into_values[i]);
+
+	CDynamicObjectArray* a_children=a->get_children();
+	CDynamicObjectArray* b_children=b->get_children();
+	ASSERT_EQ(a_children->get_num_elements(), b_children->get_num_elements());
+	for (int32_t i=0;i<a_children->get_num_elements();i++)
+	{
+		cart_node_t* a_child=(cart_node_t*) a_children->get_element(i);
+		cart_node_t* b_child=(cart_node_t*) b_children->get_element(i);
+		expect_same_tree(a_child, b_child);
+		SG_UNREF(a_child);
+		SG_UNREF(b_child);
+	}
+	SG_UNREF(a_children);
+	SG_UNREF(b_children);
+}
+
+static CCARTree* train_cart(CDenseFeatures<float64_t>* feats, CLabels* labels,
+	SGVector<bool> ft, EProblemType problem_type, int32_t num_threads)
+{
+	CCARTree* tree=new CCARTree(ft, problem_type);
+	tree->parallel->set_num_threads(num_threads);
+	tree->set_labels(labels);
+	tree->train(feats);
+	return tree;
+}
+
+TEST(CARTree, parallel_split_search_matches_serial)
+{
+	CMath::init_random(3);
+	int32_t dim=6;
+	int32_t num=200;
+
+	// the last attribute duplicates the first so that ties must be broken
+	// towards the first best attribute as in the serial search
+	SGMatrix<float64_t> data(dim,num);
+	SGVector<float64_t> reg(num);
+	SGVector<float64_t> cls(num);
+	for (int32_t i=0;i<num;i++)
+	{
+		for (int32_t j=0;j<dim-1;j++)
+			data(j,i)=CMath::random(0.0,9.0);
+		data(1,i)=CMath::random(0,9);
+		data(dim-1,i)=data(0,i);
+
+		reg[i]=data(0,i)-0.5*data(2,i)+CMath::random(-0.5,0.5);
+		cls[i]=(data(0,i)+data(3,i)>9) ? 1 : ((data(1,i)>4) ? 2 : 0);
+	}
+	CDenseFeatures<float64_t>* feats=new CDenseFeatures<float64_t>(data);
+	SG_REF(feats);
+
+	SGVector<bool> ft(dim);
+	ft.set_const(false);
+	ft[1]=true;
+
+	CLabels* labels[]={new CRegressionLabels(reg), new CMulticlassLabels(cls)};
+	EProblemType problem_types[]={PT_REGRESSION, PT_MULTICLASS};
+	for (int32_t k=0;k<2;k++)
+	{
+		CCARTree* serial=train_cart(feats, labels[k], ft, problem_types[k], 1);
+		CCARTree* parallel=train_cart(feats, labels[k], ft, problem_types[k], 4);
+
+		cart_node_t* serial_root=serial->get_root();
+		cart_node_t* parallel_root=parallel->get_root();
+		expect_same_tree(serial_root, parallel_root);
+		SG_UNREF(serial_root);
+		SG_UNREF(parallel_root);
+
+		CLabels* serial_out=serial->apply(feats);
+		CLabels* parallel_out=parallel->apply(feats);
+		SGVector<float64_t> serial_values=((CDenseLabels*) serial_out)->get_labels();
+		SGVector<float64_t> parallel_values=((CDenseLabels*) parallel_out)->get_labels();
+		for (int32_t i=0;i<num;i++)
+			EXPECT_EQ(serial_values[i], parallel_values[i]);
+
+		SG_UNREF(serial_out);
+		SG_UNREF(parallel_out);
+		SG_UNREF(serial);
+		SG_UNREF(parallel);
+	}
+
+	SG_UNREF(feats);
+}
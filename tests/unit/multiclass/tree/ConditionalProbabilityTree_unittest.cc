@@ -0,0 +1,97 @@
+/*
+ * Copyright (c) The Shogun Machine Learning Toolbox
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation are those
+ * of the authors and should not be interpreted as representing official policies,
+ * either expressed or implied, of the Shogun Development Team.
+ *
+ */
+
+#include <shogun/features/DenseFeatures.h>
+#include <shogun/features/streaming/StreamingDenseFeatures.h>
+#include <shogun/labels/MulticlassLabels.h>
+#include <shogun/multiclass/tree/BalancedConditionalProbabilityTree.h>
+#include <gtest/gtest.h>
+
+using namespace shogun;
+
+static CDenseFeatures<float32_t>* generate_cpt_data(SGVector<float64_t>& labels)
+{
+	index_t num_classes=12;
+	index_t num_vectors=600;
+	index_t dim=8;
+
+	SGMatrix<float32_t> data(dim, num_vectors);
+	labels=SGVector<float64_t>(num_vectors);
+	for (index_t i=0; i<num_vectors; ++i)
+	{
+		labels[i]=CMath::random(0, num_classes-1);
+		for (index_t j=0; j<dim; ++j)
+			data(j, i)=CMath::normal_random(0.0, 0.5)+((int32_t(labels[i])>>(j%4))&1)*(j<4 ? 2 : -2);
+	}
+
+	return new CDenseFeatures<float32_t>(data);
+}
+
+TEST(ConditionalProbabilityTree, batch_train_apply)
+{
+	CMath::init_random(17);
+	SGVector<float64_t> labels;
+	CDenseFeatures<float32_t>* features=generate_cpt_data(labels);
+	SG_REF(features);
+	SGMatrix<float32_t> data=features->get_feature_matrix();
+
+	CBalancedConditionalProbabilityTree* online=new CBalancedConditionalProbabilityTree();
+	online->train(new CStreamingDenseFeatures<float32_t>(features, labels.vector));
+	CMulticlassLabels* online_pred=online->apply_multiclass(
+		new CStreamingDenseFeatures<float32_t>(features, labels.vector));
+
+	CBalancedConditionalProbabilityTree* batched=new CBalancedConditionalProbabilityTree();
+	batched->set_batch_size(64);
+	batched->parallel->set_num_threads(4);
+	batched->train(new CStreamingDenseFeatures<float32_t>(features, labels.vector));
+	CMulticlassLabels* batched_pred=batched->apply_multiclass(
+		new CStreamingDenseFeatures<float32_t>(features, labels.vector));
+	SGVector<int32_t> matrix_pred=online->apply_multiclass_batch(data);
+
+	ASSERT_EQ(data.num_cols, online_pred->get_num_labels());
+	ASSERT_EQ(data.num_cols, batched_pred->get_num_labels());
+	ASSERT_EQ(data.num_cols, matrix_pred.vlen);
+
+	index_t num_correct=0;
+	for (index_t i=0; i<data.num_cols; ++i)
+	{
+		EXPECT_EQ(online_pred->get_int_label(i), batched_pred->get_int_label(i));
+		EXPECT_EQ(online_pred->get_int_label(i), matrix_pred[i]);
+		if (online_pred->get_int_label(i)==labels[i])
+			num_correct++;
+	}
+	EXPECT_GT(num_correct, data.num_cols/2);
+
+	SG_UNREF(online_pred);
+	SG_UNREF(batched_pred);
+	SG_UNREF(online);
+	SG_UNREF(batched);
+	SG_UNREF(features);
+}
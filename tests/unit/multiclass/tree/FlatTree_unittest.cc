@@ -0,0 +1,109 @@
+/*
+ * Copyright (c) The Shogun Machine Learning Toolbox
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation are those
+ * of the authors and should not be interpreted as representing official policies,
+ * either expressed or implied, of the Shogun Development Team.
+ */
+
+#include <shogun/multiclass/tree/FlatTree.h>
+#include <shogun/mathematics/Math.h>
+#include <gtest/gtest.h>
+
+using namespace shogun;
+
+TEST(FlatTree, threshold_and_nominal_splits)
+{
+	// root splits on feature 0 at 0.5; left child is a nominal split on
+	// feature 1 that stops for unknown values, right child is a leaf
+	FlatTree tree;
+	int32_t root=tree.add_nodes(1);
+	int32_t first=tree.add_nodes(2);
+	tree.set_output(root, -1);
+	tree.set_threshold_split(root, 0, 0.5, first);
+
+	int32_t grandchildren=tree.add_nodes(2);
+	SGVector<float64_t> values(3);
+	values[0]=3;
+	values[1]=1;
+	values[2]=3;
+	SGVector<int32_t> children(3);
+	children[0]=grandchildren;
+	children[1]=grandchildren+1;
+	children[2]=grandchildren+1;
+	tree.set_output(first, 10, 0.5);
+	tree.set_nominal_split(first, 1, values, children);
+	tree.set_output(grandchildren, 11, 0.25);
+	tree.set_output(grandchildren+1, 12, 0.75);
+	tree.set_output(first+1, 20, 1);
+
+	EXPECT_EQ(tree.get_num_nodes(), 5);
+
+	SGMatrix<float64_t> data(2,5);
+	data(0,0)=0.5;
+	data(1,0)=3;
+	data(0,1)=-1;
+	data(1,1)=1;
+	data(0,2)=0;
+	data(1,2)=2;
+	data(0,3)=0.7;
+	data(1,3)=3;
+	data(0,4)=CMath::NOT_A_NUMBER;
+	data(1,4)=1;
+
+	SGVector<float64_t> aux(5);
+	SGVector<float64_t> outputs=tree.apply(data, 2, aux);
+
+	// the first occurrence of a repeated value wins
+	EXPECT_EQ(outputs[0], 11);
+	EXPECT_EQ(aux[0], 0.25);
+	EXPECT_EQ(outputs[1], 12);
+	EXPECT_EQ(aux[1], 0.75);
+	// unknown nominal value stops at the splitting node
+	EXPECT_EQ(outputs[2], 10);
+	EXPECT_EQ(aux[2], 0.5);
+	EXPECT_EQ(outputs[3], 20);
+	// NaN is not less or equal than the threshold
+	EXPECT_EQ(outputs[4], 20);
+}
+
+TEST(FlatTree, nominal_default_child)
+{
+	FlatTree tree;
+	int32_t root=tree.add_nodes(1);
+	int32_t first=tree.add_nodes(2);
+	SGVector<float64_t> values(2);
+	values[0]=2;
+	values[1]=5;
+	SGVector<int32_t> children(2);
+	children.set_const(first);
+	tree.set_nominal_split(root, 0, values, children, first+1);
+	tree.set_output(first, 1);
+	tree.set_output(first+1, 2);
+
+	float64_t sample=5;
+	EXPECT_EQ(tree.find_node(&sample), first);
+	sample=3;
+	EXPECT_EQ(tree.find_node(&sample), first+1);
+}
@@ -50,6 +50,8 @@
 #include <shogun/optimization/ElasticNetPenalty.h>
 #include <shogun/optimization/SMIDASMinimizer.h>
 #include <shogun/optimization/PNormMappingFunction.h>
+#include <shogun/optimization/ParallelSGDMinimizer.h>
+#include <shogun/optimization/AdaGradUpdater.h>
 using namespace shogun;
 using namespace Eigen;
 
@@ -242,6 +244,59 @@ SGVector<float64_t> RegressionForTestCostFunction::get_gradient()
 	return grad;
 }
 
+ParallelRegressionForTestCostFunction::ParallelRegressionForTestCostFunction(
+	SGMatrix<float64_t> x, SGVector<float64_t> y, SGVector<float64_t> w)
+	:FirstOrderParallelStochasticCostFunction(), m_idx(0), m_x(x), m_y(y), m_w(w)
+{
+}
+
+float64_t ParallelRegressionForTestCostFunction::get_cost()
+{
+	Map<MatrixXd> e_x(m_x.matrix, m_x.num_rows, m_x.num_cols);
+	Map<VectorXd> e_w(m_w.vector, m_w.vlen);
+	Map<VectorXd> e_y(m_y.vector, m_y.vlen);
+
+	return 0.5*(e_y-(e_x*e_w)).array().pow(2.0).sum();
+}
+
+SGVector<float64_t> ParallelRegressionForTestCostFunction::obtain_variable_reference()
+{
+	return m_w;
+}
+
+SGVector<float64_t> ParallelRegressionForTestCostFunction::get_gradient()
+{
+	return get_sample_gradient(m_idx, m_w);
+}
+
+SGVector<float64_t> ParallelRegressionForTestCostFunction::get_sample_gradient(index_t idx,
+	SGVector<float64_t> variable)
+{
+	SGVector<float64_t> res(variable.vlen);
+	float64_t residual=-m_y[idx];
+	for(index_t j=0; j<variable.vlen; j++)
+		residual+=m_x(idx,j)*variable[j];
+	for(index_t j=0; j<variable.vlen; j++)
+		res[j]=residual*m_x(idx,j);
+	return res;
+}
+
+int32_t ParallelRegressionForTestCostFunction::get_sample_size()
+{
+	return m_y.vlen;
+}
+
+void ParallelRegressionForTestCostFunction::begin_sample()
+{
+	m_idx=-1;
+}
+
+bool ParallelRegressionForTestCostFunction::next_sample()
+{
+	m_idx++;
+	return m_idx<m_y.vlen;
+}
+
 void ClassificationForTestCostFunction::set_sample_sequences(SGVector<int32_t> index, index_t num_sequences)
 {
 	REQUIRE(index.vlen>0,"");
@@ -1286,3 +1341,246 @@ TEST(SMIDASMinimizer, test1)
 	delete mapping2;
 	delete bb;
 }
+
+TEST(ParallelSGDMinimizer, synchronous_equals_sgd)
+{
+	RegressionFixture data;
+	ConstLearningRate rate;
+	rate.set_const_learning_rate(0.01);
+	GradientDescendUpdater updater;
+
+	//with mini-batches of one sample the synchronous update is plain SGD
+	for(int32_t num_threads=1; num_threads<=4; num_threads+=3)
+	{
+		SGVector<float64_t> w(3);
+		w.set_const(0.0);
+		ParallelRegressionForTestCostFunction fun(data.x, data.y, w);
+		ParallelSGDMinimizer opt(&fun);
+		opt.set_update_type(PSGD_SYNCHRONOUS);
+		opt.set_mini_batch_size(1);
+		opt.set_num_threads(num_threads);
+		opt.set_gradient_updater(&updater);
+		opt.set_learning_rate(&rate);
+		opt.set_number_passes(20);
+
+		float64_t cost=opt.minimize()/data.y.vlen;
+		//same as SGDMinimizer.test1
+		EXPECT_NEAR(cost,0.491198269864709, 1e-10);
+	}
+}
+
+TEST(ParallelSGDMinimizer, synchronous_deterministic)
+{
+	RegressionFixture data;
+	ConstLearningRate rate;
+	rate.set_const_learning_rate(0.05);
+
+	SGVector<float64_t> w1(3);
+	SGVector<float64_t> w4(3);
+	w1.set_const(0.0);
+	w4.set_const(0.0);
+	ParallelRegressionForTestCostFunction fun1(data.x, data.y, w1);
+	ParallelRegressionForTestCostFunction fun4(data.x, data.y, w4);
+
+	AdaGradUpdater updater1;
+	AdaGradUpdater updater4;
+	ParallelSGDMinimizer opt1(&fun1);
+	ParallelSGDMinimizer opt4(&fun4);
+	opt1.set_num_threads(1);
+	opt4.set_num_threads(4);
+	opt1.set_gradient_updater(&updater1);
+	opt4.set_gradient_updater(&updater4);
+
+	ParallelSGDMinimizer* opts[2]={&opt1, &opt4};
+	for(index_t i=0; i<2; i++)
+	{
+		opts[i]->set_update_type(PSGD_SYNCHRONOUS);
+		opts[i]->set_mini_batch_size(4);
+		opts[i]->set_learning_rate(&rate);
+		opts[i]->set_number_passes(50);
+	}
+
+	float64_t cost1=opt1.minimize();
+	float64_t cost4=opt4.minimize();
+	EXPECT_EQ(cost1, cost4);
+	for(index_t i=0; i<w1.vlen; i++)
+		EXPECT_EQ(w1[i], w4[i]);
+}
+
+TEST(ParallelSGDMinimizer, hogwild)
+{
+	RegressionFixture data;
+	ConstLearningRate rate;
+	rate.set_const_learning_rate(0.01);
+	GradientDescendUpdater updater;
+
+	//a single thread visits samples in order, as SGDMinimizer does
+	SGVector<float64_t> w(3);
+	w.set_const(0.0);
+	ParallelRegressionForTestCostFunction fun(data.x, data.y, w);
+	ParallelSGDMinimizer opt(&fun);
+	opt.set_update_type(PSGD_HOGWILD);
+	opt.set_num_threads(1);
+	opt.set_gradient_updater(&updater);
+	opt.set_learning_rate(&rate);
+	opt.set_number_passes(20);
+	float64_t cost=opt.minimize()/data.y.vlen;
+	EXPECT_NEAR(cost,0.491198269864709, 1e-10);
+	EXPECT_EQ(opt.get_iteration_counter(), 20*data.y.vlen);
+
+	//lock-free updates from several threads still converge, the order of the
+	//updates only matters while the step size is large
+	InverseScalingLearningRate decaying_rate;
+	decaying_rate.set_initial_learning_rate(0.01);
+	decaying_rate.set_exponent(0.5);
+	decaying_rate.set_slope(1.0);
+	decaying_rate.set_intercept(1.0);
+
+	float64_t costs[2];
+	for(index_t i=0; i<2; i++)
+	{
+		SGVector<float64_t> w4(3);
+		w4.set_const(0.0);
+		ParallelRegressionForTestCostFunction fun4(data.x, data.y, w4);
+		ParallelSGDMinimizer opt4(&fun4);
+		opt4.set_update_type(PSGD_HOGWILD);
+		opt4.set_num_threads(i==0 ? 1 : 4);
+		opt4.set_gradient_updater(&updater);
+		opt4.set_learning_rate(&decaying_rate);
+		opt4.set_number_passes(500);
+		costs[i]=opt4.minimize()/data.y.vlen;
+		EXPECT_NEAR(w4[0], 0.3, 0.5);
+		EXPECT_NEAR(w4[1], -1.5, 0.5);
+		EXPECT_NEAR(w4[2], 2.0, 0.5);
+	}
+	EXPECT_NEAR(costs[1], costs[0], 0.05);
+}
+
+TEST(ParallelSGDMinimizer, hogwild_proximal)
+{
+	RegressionFixture data;
+	ConstLearningRate rate;
+	rate.set_const_learning_rate(0.01);
+	GradientDescendUpdater updater;
+	L1Penalty penalty;
+
+	//the proximal step follows every update as in SGDMinimizer
+	SGVector<float64_t> w_sgd(3);
+	w_sgd.set_const(0.0);
+	ParallelRegressionForTestCostFunction fun_sgd(data.x, data.y, w_sgd);
+	SGDMinimizer sgd(&fun_sgd);
+	sgd.set_gradient_updater(&updater);
+	sgd.set_learning_rate(&rate);
+	sgd.set_penalty_type(&penalty);
+	sgd.set_penalty_weight(5.0);
+	sgd.set_number_passes(20);
+	float64_t cost_sgd=sgd.minimize();
+
+	SGVector<float64_t> w(3);
+	w.set_const(0.0);
+	ParallelRegressionForTestCostFunction fun(data.x, data.y, w);
+	ParallelSGDMinimizer opt(&fun);
+	opt.set_update_type(PSGD_HOGWILD);
+	opt.set_num_threads(1);
+	opt.set_gradient_updater(&updater);
+	opt.set_learning_rate(&rate);
+	opt.set_penalty_type(&penalty);
+	opt.set_penalty_weight(5.0);
+	opt.set_number_passes(20);
+	float64_t cost=opt.minimize();
+
+	EXPECT_NEAR(cost, cost_sgd, 1e-10);
+	for(index_t i=0; i<w.vlen; i++)
+		EXPECT_NEAR(w[i], w_sgd[i], 1e-10);
+}
+
+TEST(ParallelSGDMinimizer, hogwild_lazy_proximal)
+{
+	RegressionFixture data;
+	ConstLearningRate rate;
+	rate.set_const_learning_rate(0.01);
+	GradientDescendUpdater updater;
+	L1Penalty penalty;
+
+	//the last feature is always zero, so no update touches its variable
+	SGMatrix<float64_t> x(data.x.num_rows, data.x.num_cols+1);
+	x.zero();
+	for(index_t i=0; i<data.x.num_rows; i++)
+	{
+		for(index_t j=0; j<data.x.num_cols; j++)
+			x(i,j)=data.x(i,j);
+	}
+
+	for(int32_t num_passes=1; num_passes<=20; num_passes+=19)
+	{
+		SGVector<float64_t> w_sgd(4);
+		w_sgd.set_const(0.0);
+		w_sgd[3]=1.0;
+		ParallelRegressionForTestCostFunction fun_sgd(x, data.y, w_sgd);
+		SGDMinimizer sgd(&fun_sgd);
+		sgd.set_gradient_updater(&updater);
+		sgd.set_learning_rate(&rate);
+		sgd.set_penalty_type(&penalty);
+		sgd.set_penalty_weight(5.0);
+		sgd.set_number_passes(num_passes);
+		sgd.minimize();
+
+		SGVector<float64_t> w(4);
+		w.set_const(0.0);
+		w[3]=1.0;
+		ParallelRegressionForTestCostFunction fun(x, data.y, w);
+		ParallelSGDMinimizer opt(&fun);
+		opt.set_update_type(PSGD_HOGWILD);
+		opt.set_num_threads(1);
+		opt.set_gradient_updater(&updater);
+		opt.set_learning_rate(&rate);
+		opt.set_penalty_type(&penalty);
+		opt.set_penalty_weight(5.0);
+		opt.set_number_passes(num_passes);
+		opt.minimize();
+
+		//the untouched variable catches up on the whole penalty of a pass
+		EXPECT_NEAR(w[3], num_passes==1 ? 0.5 : 0.0, 1e-10);
+		for(index_t i=0; i<w.vlen; i++)
+			EXPECT_NEAR(w[i], w_sgd[i], 1e-10);
+	}
+}
+
+TEST(ParallelSGDMinimizer, hogwild_mini_batch)
+{
+	RegressionFixture data;
+	ConstLearningRate rate;
+	rate.set_const_learning_rate(0.01);
+	GradientDescendUpdater updater;
+
+	//a single thread updates once per mini-batch like the synchronous scheme
+	SGVector<float64_t> w_sync(3);
+	SGVector<float64_t> w(3);
+	w_sync.set_const(0.0);
+	w.set_const(0.0);
+	ParallelRegressionForTestCostFunction fun_sync(data.x, data.y, w_sync);
+	ParallelRegressionForTestCostFunction fun(data.x, data.y, w);
+	ParallelSGDMinimizer opt_sync(&fun_sync);
+	ParallelSGDMinimizer opt(&fun);
+	opt_sync.set_update_type(PSGD_SYNCHRONOUS);
+	opt.set_update_type(PSGD_HOGWILD);
+	EXPECT_EQ(opt_sync.get_mini_batch_size(), 256);
+	EXPECT_EQ(opt.get_mini_batch_size(), 1);
+
+	ParallelSGDMinimizer* opts[2]={&opt_sync, &opt};
+	for(index_t i=0; i<2; i++)
+	{
+		opts[i]->set_num_threads(1);
+		opts[i]->set_mini_batch_size(4);
+		opts[i]->set_gradient_updater(&updater);
+		opts[i]->set_learning_rate(&rate);
+		opts[i]->set_number_passes(20);
+	}
+
+	float64_t cost_sync=opt_sync.minimize();
+	float64_t cost=opt.minimize();
+	EXPECT_EQ(opt.get_iteration_counter(), 20*3);
+	EXPECT_NEAR(cost, cost_sync, 1e-10);
+	for(index_t i=0; i<w.vlen; i++)
+		EXPECT_NEAR(w[i], w_sync[i], 1e-10);
+}
@@ -33,6 +33,7 @@
 #ifndef STOCHASTICMINIMIZERS_UNITTEST_H
 #define STOCHASTICMINIMIZERS_UNITTEST_H
 #include <shogun/optimization/FirstOrderSAGCostFunction.h>
+#include <shogun/optimization/FirstOrderParallelStochasticCostFunction.h>
 #include <shogun/lib/SGMatrix.h>
 #include <shogun/lib/SGVector.h>
 #include <shogun/base/SGObject.h>
@@ -96,6 +97,26 @@ public:
 	virtual bool next_sample();
 };
 
+class ParallelRegressionForTestCostFunction: public FirstOrderParallelStochasticCostFunction
+{
+public:
+	ParallelRegressionForTestCostFunction(SGMatrix<float64_t> x, SGVector<float64_t> y,
+		SGVector<float64_t> w);
+	virtual ~ParallelRegressionForTestCostFunction(){}
+	virtual float64_t get_cost();
+	virtual SGVector<float64_t> obtain_variable_reference();
+	virtual SGVector<float64_t> get_gradient();
+	virtual SGVector<float64_t> get_sample_gradient(index_t idx, SGVector<float64_t> variable);
+	virtual int32_t get_sample_size();
+	virtual void begin_sample();
+	virtual bool next_sample();
+private:
+	index_t m_idx;
+	SGMatrix<float64_t> m_x;
+	SGVector<float64_t> m_y;
+	SGVector<float64_t> m_w;
+};
+
 class CRegressionExample: public CSGObject
 {
 friend class RegressionForTestCostFunction;
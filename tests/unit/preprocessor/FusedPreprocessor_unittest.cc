@@ -0,0 +1,100 @@
+/*
+ * Copyright (c) The Shogun Machine Learning Toolbox
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation are those
+ * of the authors and should not be interpreted as representing official policies,
+ * either expressed or implied, of the Shogun Development Team.
+ *
+ */
+
+#include <shogun/features/DenseFeatures.h>
+#include <shogun/mathematics/Math.h>
+#include <shogun/preprocessor/FusedPreprocessor.h>
+#include <shogun/preprocessor/LogPlusOne.h>
+#include <shogun/preprocessor/NormOne.h>
+#include <shogun/preprocessor/PruneVarSubMean.h>
+#include <shogun/preprocessor/RescaleFeatures.h>
+#include <gtest/gtest.h>
+
+using namespace shogun;
+
+TEST(FusedPreprocessor, apply_matches_chain)
+{
+	int32_t num_features=6;
+	int32_t num_vectors=300;
+
+	CMath::init_random(12);
+	SGMatrix<float64_t> data(num_features, num_vectors);
+	for (index_t i=0; i<num_vectors; i++)
+	{
+		for (index_t j=0; j<num_features; j++)
+			data(j, i)=CMath::random(0.0, 10.0)*(j+1);
+		// constant feature, pruned by CPruneVarSubMean
+		data(3, i)=1;
+	}
+
+	// reference: preprocessors initialized and applied one after the other
+	CDenseFeatures<float64_t>* expected=new CDenseFeatures<float64_t>(data.clone());
+	SG_REF(expected);
+	CDensePreprocessor<float64_t>* chain[]={new CPruneVarSubMean(),
+		new CRescaleFeatures(), new CLogPlusOne(), new CNormOne()};
+	for (index_t i=0; i<4; i++)
+	{
+		chain[i]->init(expected);
+		chain[i]->apply_to_feature_matrix(expected);
+		SG_UNREF(chain[i]);
+	}
+	SGMatrix<float64_t> expected_matrix=expected->get_feature_matrix();
+
+	CFusedPreprocessor* fused=new CFusedPreprocessor();
+	fused->add_preprocessor(new CPruneVarSubMean());
+	fused->add_preprocessor(new CRescaleFeatures());
+	fused->add_preprocessor(new CLogPlusOne());
+	fused->add_preprocessor(new CNormOne());
+	EXPECT_EQ(4, fused->get_num_preprocessors());
+
+	CDenseFeatures<float64_t>* features=new CDenseFeatures<float64_t>(data.clone());
+	fused->init(features);
+
+	for (index_t i=0; i<num_vectors; i++)
+	{
+		SGVector<float64_t> v=fused->apply_to_feature_vector(
+			SGVector<float64_t>(data.get_column_vector(i), num_features, false));
+		ASSERT_EQ(expected_matrix.num_rows, v.vlen);
+		for (index_t j=0; j<v.vlen; j++)
+			EXPECT_NEAR(expected_matrix(j, i), v[j], 1E-12);
+	}
+
+	fused->parallel->set_num_threads(4);
+	SGMatrix<float64_t> result=fused->apply_to_feature_matrix(features);
+	EXPECT_EQ(num_features-1, features->get_num_features());
+	ASSERT_EQ(expected_matrix.num_rows, result.num_rows);
+	ASSERT_EQ(num_vectors, result.num_cols);
+	for (index_t i=0; i<num_vectors*result.num_rows; i++)
+		EXPECT_NEAR(expected_matrix[i], result[i], 1E-12);
+
+	SG_UNREF(features);
+	SG_UNREF(fused);
+	SG_UNREF(expected);
+}
@@ -1,11 +1,14 @@
 #include <shogun/preprocessor/KernelPCA.h>
 #include <shogun/kernel/GaussianKernel.h>
+#include <shogun/kernel/NystromApproximation.h>
 #include <shogun/lib/SGMatrix.h>
+#include <shogun/mathematics/eigen3.h>
 
 #include <gtest/gtest.h>
 
 using ::testing::Test;
 using namespace shogun;
+using namespace Eigen;
 
 #ifdef HAVE_LAPACK
 TEST(KernelPCA, DISABLED_apply_to_feature_matrix_input)
@@ -40,4 +43,50 @@ TEST(KernelPCA, DISABLED_apply_to_feature_matrix_input)
 	for (index_t i = 0; i < num_features * num_vectors; ++i)
 		EXPECT_LE(CMath::abs(embedding.matrix[i] - s * resdata[i]), 1E-6);
 }
+
+TEST(KernelPCA, nystrom_all_landmarks_equals_centered_eigenvectors)
+{
+	const index_t num_vectors=15;
+	const index_t target_dim=2;
+	CMath::init_random(3);
+	SGMatrix<float64_t> data(3, num_vectors);
+	for (index_t i=0; i<3*num_vectors; i++)
+		data.matrix[i]=CMath::normal_random(0.0, 1.0);
+	CDenseFeatures<float64_t>* feats=new CDenseFeatures<float64_t>(data);
+	SG_REF(feats);
+
+	CGaussianKernel* kernel=new CGaussianKernel(10, 2.0);
+	CKernelPCA* kpca=new CKernelPCA(kernel);
+	kpca->set_target_dim(target_dim);
+	kpca->set_approximation(new CNystromApproximation(kernel, num_vectors));
+	kpca->init(feats);
+
+	// projections of training vectors are sqrt(lambda)*u for eigenpairs
+	// of the centered kernel matrix
+	kernel->init(feats, feats);
+	SGMatrix<float64_t> kernel_matrix=kernel->get_kernel_matrix();
+	kernel->cleanup();
+	Map<MatrixXd> K(kernel_matrix.matrix, num_vectors, num_vectors);
+	MatrixXd H=MatrixXd::Identity(num_vectors, num_vectors)-
+		MatrixXd::Constant(num_vectors, num_vectors, 1.0/num_vectors);
+	MatrixXd centered=H*K*H;
+	SelfAdjointEigenSolver<MatrixXd> solver(centered);
+
+	for (index_t i=0; i<num_vectors; i++)
+	{
+		SGVector<float64_t> projected=kpca->apply_to_feature_vector(
+				feats->get_feature_vector(i));
+		EXPECT_EQ(target_dim, projected.vlen);
+		for (index_t k=0; k<target_dim; k++)
+		{
+			index_t idx=num_vectors-k-1;
+			float64_t expected=CMath::sqrt(solver.eigenvalues()[idx])*
+				solver.eigenvectors()(i,idx);
+			EXPECT_NEAR(CMath::abs(expected), CMath::abs(projected[k]), 1e-6);
+		}
+	}
+
+	SG_UNREF(kpca);
+	SG_UNREF(feats);
+}
 #endif // HAVE_LAPACK
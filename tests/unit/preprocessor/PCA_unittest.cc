@@ -31,6 +31,7 @@
 #include <gtest/gtest.h>
 #include <shogun/mathematics/Math.h>
 #include <shogun/features/DenseFeatures.h>
+#include <shogun/features/streaming/StreamingDenseFeatures.h>
 #include <shogun/lib/SGMatrix.h>
 #include <shogun/lib/SGVector.h>
 
@@ -607,3 +608,114 @@ TEST(PCA, PCA_WHITEN_EVD)
 	SG_UNREF(pca);
 	SG_UNREF(features);
 }
+
+/* data with exact low rank, so that randomized and incremental PCA
+ * recover the leading components exactly */
+static SGMatrix<float64_t> generate_low_rank_data(index_t dim, index_t num, index_t rank)
+{
+	CMath::init_random(17);
+	SGMatrix<float64_t> basis(dim, rank);
+	SGMatrix<float64_t> coefficients(rank, num);
+	for (index_t i=0; i<dim*rank; i++)
+		basis.matrix[i]=CMath::normal_random(0.0, 1.0);
+	for (index_t i=0; i<rank*num; i++)
+		coefficients.matrix[i]=CMath::normal_random(0.0, 1.0+i%rank);
+
+	SGMatrix<float64_t> data(dim, num);
+	data.set_const(1.0);
+	for (index_t j=0; j<num; j++)
+	{
+		for (index_t r=0; r<rank; r++)
+		{
+			for (index_t i=0; i<dim; i++)
+				data(i,j)+=basis(i,r)*coefficients(r,j);
+		}
+	}
+	return data;
+}
+
+TEST(PCA, PCA_RANDOMIZED_equals_SVD)
+{
+	const index_t dim=10, num=50, rank=3;
+	SGMatrix<float64_t> data=generate_low_rank_data(dim, num, rank);
+
+	CDenseFeatures<float64_t>* features=new CDenseFeatures<float64_t>(data);
+	SG_REF(features);
+
+	CPCA* svd_pca=new CPCA(SVD);
+	svd_pca->set_target_dim(rank);
+	svd_pca->init(features);
+
+	CPCA* randomized_pca=new CPCA(RANDOMIZED);
+	randomized_pca->set_target_dim(rank);
+	randomized_pca->set_oversampling(2);
+	randomized_pca->init(features);
+
+	SGVector<float64_t> svd_eigenvalues=svd_pca->get_eigenvalues();
+	SGVector<float64_t> randomized_eigenvalues=randomized_pca->get_eigenvalues();
+	SGMatrix<float64_t> svd_transmat=svd_pca->get_transformation_matrix();
+	SGMatrix<float64_t> randomized_transmat=randomized_pca->get_transformation_matrix();
+
+	float64_t epsilon=1e-8;
+	for (index_t i=0; i<rank; i++)
+	{
+		EXPECT_NEAR(svd_eigenvalues[i], randomized_eigenvalues[i], epsilon);
+		// eigenvectors are unique up to sign
+		for (index_t j=0; j<dim; j++)
+			EXPECT_NEAR(CMath::abs(svd_transmat(j,i)), CMath::abs(randomized_transmat(j,i)), epsilon);
+	}
+
+	SG_UNREF(randomized_pca);
+	SG_UNREF(svd_pca);
+	SG_UNREF(features);
+}
+
+TEST(PCA, PCA_incremental_equals_SVD)
+{
+	const index_t dim=10, num=53, rank=3;
+	SGMatrix<float64_t> data=generate_low_rank_data(dim, num, rank);
+
+	CDenseFeatures<float64_t>* features=new CDenseFeatures<float64_t>(data);
+	SG_REF(features);
+	CStreamingDenseFeatures<float64_t>* streaming_features=
+		new CStreamingDenseFeatures<float64_t>(features);
+	SG_REF(streaming_features);
+
+	CPCA* svd_pca=new CPCA(SVD);
+	svd_pca->set_target_dim(rank);
+	svd_pca->init(features);
+
+	CPCA* incremental_pca=new CPCA();
+	incremental_pca->set_target_dim(rank);
+	incremental_pca->set_block_size(10);
+	incremental_pca->init(streaming_features);
+
+	SGVector<float64_t> svd_eigenvalues=svd_pca->get_eigenvalues();
+	SGVector<float64_t> incremental_eigenvalues=incremental_pca->get_eigenvalues();
+	SGMatrix<float64_t> svd_transmat=svd_pca->get_transformation_matrix();
+	SGMatrix<float64_t> incremental_transmat=incremental_pca->get_transformation_matrix();
+	SGVector<float64_t> svd_mean=svd_pca->get_mean();
+	SGVector<float64_t> incremental_mean=incremental_pca->get_mean();
+
+	float64_t epsilon=1e-8;
+	EXPECT_EQ(rank, incremental_eigenvalues.vlen);
+	for (index_t j=0; j<dim; j++)
+		EXPECT_NEAR(svd_mean[j], incremental_mean[j], epsilon);
+	for (index_t i=0; i<rank; i++)
+	{
+		EXPECT_NEAR(svd_eigenvalues[i], incremental_eigenvalues[i], epsilon);
+		for (index_t j=0; j<dim; j++)
+			EXPECT_NEAR(CMath::abs(svd_transmat(j,i)), CMath::abs(incremental_transmat(j,i)), epsilon);
+	}
+
+	SGVector<float64_t> vec=features->get_feature_vector(7);
+	SGVector<float64_t> svd_projected=svd_pca->apply_to_feature_vector(vec);
+	SGVector<float64_t> incremental_projected=incremental_pca->apply_to_feature_vector(vec);
+	for (index_t i=0; i<rank; i++)
+		EXPECT_NEAR(CMath::abs(svd_projected[i]), CMath::abs(incremental_projected[i]), epsilon);
+
+	SG_UNREF(incremental_pca);
+	SG_UNREF(svd_pca);
+	SG_UNREF(streaming_features);
+	SG_UNREF(features);
+}
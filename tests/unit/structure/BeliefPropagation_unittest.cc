@@ -6,6 +6,7 @@
 #include <shogun/labels/FactorGraphLabels.h>
 #include <shogun/structure/MAPInference.h>
 #include <shogun/structure/FactorGraphDataGenerator.h>
+#include <shogun/structure/BeliefPropagation.h>
 
 #include <gtest/gtest.h>
 
@@ -174,3 +175,186 @@ TEST(BeliefPropagation, tree_max_product_multi_states)
 	SG_UNREF(fg_test_data);
 }
 
+
+TEST(BeliefPropagation, loopy_max_product_tree)
+{
+	CFactorGraphDataGenerator* fg_test_data = new CFactorGraphDataGenerator();
+	SG_REF(fg_test_data);
+
+	CFactorGraph* fg = fg_test_data->multi_state_tree_graph();
+
+	CMAPInference infer_met(fg, LOOPY_MAX_PROD);
+	infer_met.inference();
+
+	CFactorGraphObservation* fg_observ = infer_met.get_structured_outputs();
+	SGVector<int32_t> assignment = fg_observ->get_data();
+	EXPECT_EQ(assignment[0],2);
+	EXPECT_EQ(assignment[1],0);
+	EXPECT_EQ(assignment[2],2);
+
+	EXPECT_NEAR(-3.8, infer_met.get_energy(), 1E-10);
+
+	SG_UNREF(fg_observ);
+	SG_UNREF(fg);
+	SG_UNREF(fg_test_data);
+}
+
+// 3x3 grid with binary variables, random unaries and Potts pairwise terms
+static CFactorGraph* loopy_grid_graph(CTableFactorType*& unary, CTableFactorType*& pairwise)
+{
+	int32_t width = 3;
+	SGVector<int32_t> card(1);
+	card[0] = 2;
+	SGVector<float64_t> wu(2);
+	wu[0] = 0.0;
+	wu[1] = 1.0;
+	unary = new CTableFactorType(0, card, wu);
+	SG_REF(unary);
+
+	SGVector<int32_t> card2(2);
+	card2[0] = 2;
+	card2[1] = 2;
+	SGVector<float64_t> wp(4);
+	wp[0] = 0.0;
+	wp[1] = 0.3;
+	wp[2] = 0.3;
+	wp[3] = 0.0;
+	pairwise = new CTableFactorType(1, card2, wp);
+	SG_REF(pairwise);
+
+	SGVector<int32_t> vc(width*width);
+	SGVector<int32_t>::fill_vector(vc.vector, vc.vlen, 2);
+	CFactorGraph* fg = new CFactorGraph(vc);
+	SG_REF(fg);
+
+	for (int32_t y = 0; y < width; y++)
+	{
+		for (int32_t x = 0; x < width; x++)
+		{
+			SGVector<float64_t> data(1);
+			data[0] = CMath::random(-1.0, 1.0);
+			SGVector<int32_t> var_index(1);
+			var_index[0] = grid_to_index(x, y, width);
+			fg->add_factor(new CFactor(unary, var_index, data));
+
+			SGVector<float64_t> data2(1);
+			data2[0] = 1.0;
+			if (x > 0)
+			{
+				SGVector<int32_t> var_index2(2);
+				var_index2[0] = grid_to_index(x-1, y, width);
+				var_index2[1] = grid_to_index(x, y, width);
+				fg->add_factor(new CFactor(pairwise, var_index2, data2));
+			}
+			if (y > 0)
+			{
+				SGVector<int32_t> var_index2(2);
+				var_index2[0] = grid_to_index(x, y-1, width);
+				var_index2[1] = grid_to_index(x, y, width);
+				fg->add_factor(new CFactor(pairwise, var_index2, data2));
+			}
+		}
+	}
+
+	fg->connect_components();
+	fg->compute_energies();
+	return fg;
+}
+
+TEST(BeliefPropagation, loopy_max_product_grid)
+{
+	CMath::init_random(17);
+	CTableFactorType* unary;
+	CTableFactorType* pairwise;
+	CFactorGraph* fg = loopy_grid_graph(unary, pairwise);
+	EXPECT_FALSE(fg->is_acyclic_graph());
+
+	// brute force minimum
+	int32_t num_vars = fg->get_num_vars();
+	SGVector<int32_t> state(num_vars);
+	float64_t min_energy = CMath::INFTY;
+	for (int32_t i = 0; i < (1 << num_vars); i++)
+	{
+		for (int32_t vi = 0; vi < num_vars; vi++)
+			state[vi] = (i >> vi) & 1;
+		min_energy = CMath::min(min_energy, fg->evaluate_energy(state));
+	}
+
+	CLoopyMaxProduct residual(fg);
+	SGVector<int32_t> assignment(num_vars);
+	EXPECT_NEAR(min_energy, residual.inference(assignment), 1E-10);
+	EXPECT_TRUE(residual.get_converged());
+
+	CLoopyMaxProduct flooding(fg);
+	flooding.set_schedule(LBP_PARALLEL);
+	flooding.set_damping(0.5);
+	SGVector<int32_t> assignment2(num_vars);
+	EXPECT_NEAR(min_energy, flooding.inference(assignment2), 1E-10);
+	EXPECT_TRUE(flooding.get_converged());
+	for (int32_t vi = 0; vi < num_vars; vi++)
+		EXPECT_EQ(assignment[vi], assignment2[vi]);
+
+	CMAPInference infer_met(fg, LOOPY_MAX_PROD);
+	infer_met.inference();
+	EXPECT_NEAR(min_energy, infer_met.get_energy(), 1E-10);
+
+	SG_UNREF(fg);
+	SG_UNREF(pairwise);
+	SG_UNREF(unary);
+}
+
+TEST(BeliefPropagation, loopy_sum_product_chain_marginals)
+{
+	CFactorGraphDataGenerator* fg_test_data = new CFactorGraphDataGenerator();
+	SG_REF(fg_test_data);
+
+	CFactorGraph* fg = fg_test_data->multi_state_tree_graph();
+	SGVector<int32_t> cards = fg->get_cardinalities();
+	int32_t num_vars = cards.vlen;
+
+	// brute force marginals of p(y) ~ exp(-E(y))
+	int32_t num_states = 1;
+	for (int32_t vi = 0; vi < num_vars; vi++)
+		num_states *= cards[vi];
+
+	int32_t max_card = CMath::max(cards.vector, cards.vlen);
+	SGVector<float64_t> marginals(num_vars*max_card);
+	marginals.zero();
+	SGVector<int32_t> state(num_vars);
+	float64_t z = 0;
+	for (int32_t i = 0; i < num_states; i++)
+	{
+		int32_t rest = i;
+		for (int32_t vi = 0; vi < num_vars; vi++)
+		{
+			state[vi] = rest % cards[vi];
+			rest /= cards[vi];
+		}
+		float64_t p = CMath::exp(-fg->evaluate_energy(state));
+		z += p;
+		for (int32_t vi = 0; vi < num_vars; vi++)
+			marginals[vi*max_card + state[vi]] += p;
+	}
+
+	CLoopyMaxProduct sum_product(fg);
+	sum_product.set_sum_product(true);
+	SGVector<int32_t> assignment(num_vars);
+	sum_product.inference(assignment);
+	EXPECT_TRUE(sum_product.get_converged());
+
+	for (int32_t vi = 0; vi < num_vars; vi++)
+	{
+		SGVector<float64_t> beliefs = sum_product.get_beliefs(vi);
+		float64_t norm = 0;
+		for (int32_t si = 0; si < cards[vi]; si++)
+			norm += CMath::exp(-beliefs[si]);
+		for (int32_t si = 0; si < cards[vi]; si++)
+		{
+			EXPECT_NEAR(marginals[vi*max_card + si] / z,
+				CMath::exp(-beliefs[si]) / norm, 1E-8);
+		}
+	}
+
+	SG_UNREF(fg);
+	SG_UNREF(fg_test_data);
+}
@@ -9,6 +9,13 @@
 #include <shogun/structure/StochasticSOSVM.h>
 #include <shogun/structure/FWSOSVM.h>
 #include <shogun/structure/SOSVMHelper.h>
+#include <shogun/structure/MulticlassModel.h>
+#include <shogun/structure/MulticlassSOLabels.h>
+#include <shogun/features/DenseFeatures.h>
+#include <shogun/features/SparseFeatures.h>
+#include <shogun/structure/HashedMultilabelModel.h>
+#include <shogun/structure/MultilabelSOLabels.h>
+#include <shogun/mathematics/Math.h>
 #include <gtest/gtest.h>
 
 using namespace shogun;
@@ -177,3 +184,157 @@ TEST(SOSVM, fw_check_w_helper)
 	SG_UNREF(instances);
 	SG_UNREF(factortype);
 }
+
+static CMulticlassModel* create_multiclass_model(int32_t num_samples,
+		CMulticlassSOLabels*& labels)
+{
+	int32_t num_classes = 3;
+	int32_t dim = 2;
+	SGMatrix<float64_t> data(dim, num_samples);
+	SGVector<float64_t> labs(num_samples);
+	for (int32_t i = 0; i < num_samples; ++i)
+	{
+		labs[i] = i % num_classes;
+		data(0,i) = 3*CMath::cos(2*M_PI*labs[i]/num_classes) + CMath::randn_double();
+		data(1,i) = 3*CMath::sin(2*M_PI*labs[i]/num_classes) + CMath::randn_double();
+	}
+
+	labels = new CMulticlassSOLabels(labs);
+	CDenseFeatures<float64_t>* features = new CDenseFeatures<float64_t>(data);
+	return new CMulticlassModel(features, labels);
+}
+
+TEST(SOSVM, risk_parallel)
+{
+	CMath::init_random(7);
+	CMulticlassSOLabels* labels;
+	CMulticlassModel* model = create_multiclass_model(50, labels);
+	CStochasticSOSVM* sgd = new CStochasticSOSVM(model, labels);
+
+	int32_t M = model->get_dim();
+	SGVector<float64_t> w(M);
+	for (int32_t i = 0; i < M; ++i)
+		w[i] = CMath::randn_double();
+
+	SGVector<float64_t> subgrad_serial(M);
+	sgd->parallel->set_num_threads(1);
+	float64_t risk_serial = sgd->risk(subgrad_serial.vector, w.vector);
+
+	SGVector<float64_t> subgrad_parallel(M);
+	sgd->parallel->set_num_threads(4);
+	float64_t risk_parallel = sgd->risk(subgrad_parallel.vector, w.vector);
+
+	EXPECT_NEAR(risk_serial, risk_parallel, 1E-10);
+	for (int32_t i = 0; i < M; ++i)
+		EXPECT_NEAR(subgrad_serial[i], subgrad_parallel[i], 1E-10);
+
+	SG_UNREF(sgd);
+}
+
+TEST(SOSVM, fw_parallel)
+{
+	CMath::init_random(11);
+	CMulticlassSOLabels* labels;
+	CMulticlassModel* model = create_multiclass_model(60, labels);
+	SG_REF(model);
+	SG_REF(labels);
+
+	CFWSOSVM* fw = new CFWSOSVM(model, labels);
+	fw->set_num_iter(20);
+	fw->set_gap_threshold(0);
+	fw->parallel->set_num_threads(1);
+	fw->train();
+	SGVector<float64_t> w_serial = fw->get_w();
+	float64_t ell_serial = fw->get_ell();
+
+	fw->parallel->set_num_threads(4);
+	fw->train();
+	SGVector<float64_t> w_parallel = fw->get_w();
+
+	for (int32_t i = 0; i < w_serial.vlen; ++i)
+		EXPECT_NEAR(w_serial[i], w_parallel[i], 1E-10);
+	EXPECT_NEAR(ell_serial, fw->get_ell(), 1E-10);
+
+	SG_UNREF(fw);
+	SG_UNREF(labels);
+	SG_UNREF(model);
+}
+
+TEST(SOSVM, sgd_mini_batch)
+{
+	CMath::init_random(13);
+	CMulticlassSOLabels* labels;
+	CMulticlassModel* model = create_multiclass_model(90, labels);
+	SG_REF(model);
+
+	CStochasticSOSVM* sgd = new CStochasticSOSVM(model, labels);
+	sgd->set_num_iter(30);
+	sgd->set_batch_size(10);
+	EXPECT_EQ(10, sgd->get_batch_size());
+	sgd->parallel->set_num_threads(4);
+	sgd->train();
+	SGVector<float64_t> w_parallel = sgd->get_w();
+
+	// oracles of a batch are evaluated at the same w, so the number of
+	// threads does not change the iterates
+	sgd->parallel->set_num_threads(1);
+	sgd->train();
+	SGVector<float64_t> w_serial = sgd->get_w();
+	for (int32_t i = 0; i < w_serial.vlen; ++i)
+		EXPECT_NEAR(w_serial[i], w_parallel[i], 1E-10);
+
+	// well separated classes are learnt
+	EXPECT_LT(CSOSVMHelper::average_loss(w_parallel, model), 0.1);
+
+	SG_UNREF(sgd);
+	SG_UNREF(model);
+}
+
+TEST(SOSVM, fw_sparse_psi)
+{
+	// the hashed multilabel model only computes sparse psi vectors; label c
+	// of an example is set if its feature c is positive
+	int32_t num_samples = 40;
+	int32_t num_classes = 3;
+	CMath::init_random(17);
+	SGMatrix<float64_t> data(num_classes+1, num_samples);
+	CMultilabelSOLabels* labels = new CMultilabelSOLabels(num_samples, num_classes);
+	SG_REF(labels);
+	for (int32_t i = 0; i < num_samples; ++i)
+	{
+		SGVector<int32_t> label(num_classes);
+		int32_t num_labels = 0;
+		for (int32_t c = 0; c < num_classes; ++c)
+		{
+			data(c,i) = CMath::random(-1.0, 1.0);
+			if (data(c,i) > 0)
+				label[num_labels++] = c;
+		}
+		// bias feature
+		data(num_classes,i) = 1;
+		labels->set_sparse_label(i, SGVector<int32_t>(label.vector, num_labels, false).clone());
+	}
+
+	CSparseFeatures<float64_t>* features = new CSparseFeatures<float64_t>(data);
+	CHashedMultilabelModel* model = new CHashedMultilabelModel(features, labels, 64);
+	SG_REF(model);
+
+	float64_t lambda = 1E-2;
+	SGVector<float64_t> w_zero(model->get_dim());
+	w_zero.zero();
+	float64_t primal_zero = CSOSVMHelper::primal_objective(w_zero, model, lambda);
+
+	CFWSOSVM* fw = new CFWSOSVM(model, labels);
+	fw->set_lambda(lambda);
+	fw->set_num_iter(50);
+	fw->set_gap_threshold(0);
+	fw->train();
+
+	// Frank-Wolfe steps along truth - pred reduce the primal objective
+	float64_t primal = CSOSVMHelper::primal_objective(fw->get_w(), model, lambda);
+	EXPECT_LT(primal, 0.5*primal_zero);
+
+	SG_UNREF(fw);
+	SG_UNREF(model);
+	SG_UNREF(labels);
+}